@@ -31,13 +31,78 @@
 #include "FS.h"
 #include "detail/RequestHandlersImpl.h"
 #include "mbedtls/md5.h"
+#include <lwip/sockets.h>
 
 
 static const char AUTHORIZATION_HEADER[] = "Authorization";
 static const char qop_auth[] = "qop=\"auth\"";
 static const char WWW_Authenticate[] = "WWW-Authenticate";
 static const char Content_Length[] = "Content-Length";
+static const char IF_NONE_MATCH_HEADER[] = "If-None-Match";
+static const char RANGE_HEADER[] = "Range";
+static const char IF_RANGE_HEADER[] = "If-Range";
 
+// Headers collected for every request, ahead of the ones set by collectHeaders()
+#define BUILTIN_HEADER_KEYS_COUNT 4
+
+
+void WebServerListener::begin(uint16_t port) {
+  close();
+  if (port) {
+    _port = port;
+  }
+
+  _fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (_fd < 0) {
+    log_e("socket failed: %d", errno);
+    return;
+  }
+
+  int enable = 1;
+  setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+  struct sockaddr_in server;
+  memset(&server, 0, sizeof(server));
+  server.sin_family = AF_INET;
+  server.sin_addr.s_addr = (uint32_t) _addr;
+  server.sin_port = htons(_port);
+
+  if (bind(_fd, (struct sockaddr *) &server, sizeof(server)) < 0 || listen(_fd, HTTP_MAX_PENDING_CLIENTS) < 0) {
+    log_e("bind/listen failed: %d", errno);
+    close();
+    return;
+  }
+
+  fcntl(_fd, F_SETFL, fcntl(_fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+void WebServerListener::close() {
+  if (_fd >= 0) {
+    ::close(_fd);
+    _fd = -1;
+  }
+}
+
+WiFiClient WebServerListener::available() {
+  if (_fd < 0) {
+    return WiFiClient();
+  }
+
+  struct sockaddr_in client;
+  socklen_t clientLen = sizeof(client);
+  int clientFd = accept(_fd, (struct sockaddr *) &client, &clientLen);
+  if (clientFd < 0) {
+    return WiFiClient();
+  }
+
+  int val = 1;
+  setsockopt(clientFd, SOL_SOCKET, SO_KEEPALIVE, &val, sizeof(val));
+  if (_noDelay) {
+    setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &val, sizeof(val));
+  }
+
+  return WiFiClient(clientFd);
+}
 
 WebServer::WebServer(IPAddress addr, int port)
 : _corsEnabled(false)
@@ -114,7 +179,7 @@ String WebServer::_extractParam(String& authReq,const String& param,const char d
   return authReq.substring(_begin+param.length(),authReq.indexOf(delimit,_begin+param.length()));
 }
 
-static String md5str(String &in){
+static String md5str(const String &in){
   char out[33] = {0};
   mbedtls_md5_context _ctx;
   uint8_t i;
@@ -279,40 +344,218 @@ void WebServer::serveStatic(const char* uri, FS& fs, const char* path, const cha
     _addRequestHandler(new StaticRequestHandler(fs, path, uri, cache_header));
 }
 
-void WebServer::handleClient() {
-  if (_currentStatus == HC_NONE) {
+void WebServer::_acceptPendingClients() {
+  for (int i = 0; i < HTTP_MAX_PENDING_CLIENTS; i++) {
     WiFiClient client = _server.available();
     if (!client) {
-      if (_nullDelay) {
-        delay(1);
-      }
       return;
     }
 
     log_v("New client");
 
-    _currentClient = client;
-    _currentStatus = HC_WAIT_READ;
-    _statusChange = millis();
+    // Use a free slot, otherwise evict the connection that has been idle the longest
+    int slot = -1;
+    for (int j = 0; j < HTTP_MAX_PENDING_CLIENTS; j++) {
+      if (!_pendingClients[j].client) {
+        slot = j;
+        break;
+      }
+      if (slot < 0 || (long) (_pendingClients[j].lastActivity - _pendingClients[slot].lastActivity) < 0) {
+        slot = j;
+      }
+    }
+
+    if (_pendingClients[slot].client) {
+      log_w("Too many pending clients, evicting the oldest idle one");
+      _pendingClients[slot].client.stop();
+    }
+
+    _pendingClients[slot].client       = client;
+    _pendingClients[slot].accepted     = millis();
+    _pendingClients[slot].lastActivity = _pendingClients[slot].accepted;
+    _pendingClients[slot].peeked       = 0;
   }
+}
+
+// Content-Length of a complete request head, 0 without one
+static size_t _headContentLength(const char* head, int len) {
+  static const char name[] = "\r\ncontent-length:";
+  const int nameLen = sizeof(name) - 1;
+
+  for (int i = 0; i + nameLen < len; i++) {
+    if (strncasecmp(head + i, name, nameLen) != 0) {
+      continue;
+    }
+
+    int pos = i + nameLen;
+    while (pos < len && (head[pos] == ' ' || head[pos] == '\t')) {
+      pos++;
+    }
 
-  bool keepCurrentClient = false;
-  bool callYield = false;
+    size_t value = 0;
+    while (pos < len && head[pos] >= '0' && head[pos] <= '9' && value <= HTTP_PEEK_BUFLEN) {
+      value = value * 10 + (head[pos++] - '0');
+    }
+    return value;
+  }
+
+  return 0;
+}
 
-  if (_currentClient.connected()) {
-    switch (_currentStatus) {
-    case HC_NONE:
-      // No-op to avoid C++ compiler warning
+// HEAD_READY once the request head has arrived, with its body when both fit HTTP_PEEK_BUFLEN,
+// HEAD_PARTIAL until then, HEAD_TOO_LARGE for a head longer than HTTP_PEEK_BUFLEN, HEAD_CLOSED if
+// the peer closed. Nothing is consumed from the socket.
+int WebServer::_peekRequestHead(PendingClient& pending) {
+  char buf[HTTP_PEEK_BUFLEN];
+  int len = recv(pending.client.fd(), buf, sizeof(buf), MSG_PEEK | MSG_DONTWAIT);
+
+  if (len == 0) {
+    return HEAD_CLOSED;
+  }
+  if (len < 0) {
+    return (errno == EWOULDBLOCK || errno == EAGAIN) ? HEAD_PARTIAL : HEAD_CLOSED;
+  }
+
+  if (len > pending.peeked) {
+    pending.peeked = len;
+    pending.lastActivity = millis();
+  }
+
+  int headLen = 0;
+  for (int i = 3; i < len; i++) {
+    if (buf[i] == '\n' && buf[i - 1] == '\r' && buf[i - 2] == '\n' && buf[i - 3] == '\r') {
+      headLen = i + 1;
       break;
-    case HC_WAIT_READ:
-      // Wait for data from client to become available
-      if (_currentClient.available()) {
-        if (_parseRequest(_currentClient)) {
-          // because HTTP_MAX_SEND_WAIT is expressed in milliseconds,
-          // it must be divided by 1000
-          _currentClient.setTimeout(HTTP_MAX_SEND_WAIT / 1000);
-          _contentLength = CONTENT_LENGTH_NOT_SET;
-          _handleRequest();
+    }
+  }
+
+  if (headLen == 0) {
+    return (len == (int) sizeof(buf)) ? HEAD_TOO_LARGE : HEAD_PARTIAL;
+  }
+
+  // A form fits with its head : wait for all of it, so parsing it doesn't wait on the network either
+  size_t contentLength = _headContentLength(buf, headLen);
+  if (contentLength <= sizeof(buf) - headLen && (size_t) len < headLen + contentLength) {
+    return HEAD_PARTIAL;
+  }
+
+  return HEAD_READY;
+}
+
+int WebServer::_nextReadyClient() {
+  int ready = -1;
+  unsigned long now = millis();
+
+  for (int i = 0; i < HTTP_MAX_PENDING_CLIENTS; i++) {
+    PendingClient& pending = _pendingClients[i];
+    if (!pending.client) {
+      continue;
+    }
+
+    int head = _peekRequestHead(pending);
+
+    if (head == HEAD_TOO_LARGE) {
+      log_w("Request head larger than HTTP_PEEK_BUFLEN");
+      static const char response[] = "HTTP/1.1 431 Request Header Fields Too Large\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+      pending.client.write((const uint8_t*) response, sizeof(response) - 1);
+    }
+
+    if (head == HEAD_CLOSED || head == HEAD_TOO_LARGE || now - pending.accepted > HTTP_MAX_DATA_WAIT) {
+      // Closed by the peer, rejected or past its deadline
+      pending.client.stop();
+      pending.client = WiFiClient();
+      continue;
+    }
+
+    // Serve complete requests in arrival order
+    if (head == HEAD_READY && (ready < 0 || (long) (pending.accepted - _pendingClients[ready].accepted) < 0)) {
+      ready = i;
+    }
+  }
+
+  return ready;
+}
+
+void WebServer::_dropPendingClients() {
+  for (int i = 0; i < HTTP_MAX_PENDING_CLIENTS; i++) {
+    if (_pendingClients[i].client) {
+      _pendingClients[i].client.stop();
+      _pendingClients[i].client = WiFiClient();
+    }
+  }
+}
+
+bool WebServer::waitForActivity(unsigned long timeout_ms, int extraFd) {
+  fd_set readFds;
+  FD_ZERO(&readFds);
+  int maxFd = -1;
+  unsigned long now = millis();
+
+  if (_server.fd() >= 0) {
+    FD_SET(_server.fd(), &readFds);
+    maxFd = _server.fd();
+  }
+
+  if (extraFd >= 0) {
+    FD_SET(extraFd, &readFds);
+    maxFd = max(maxFd, extraFd);
+  }
+
+  for (int i = 0; i < HTTP_MAX_PENDING_CLIENTS; i++) {
+    PendingClient& pending = _pendingClients[i];
+    if (!pending.client) {
+      continue;
+    }
+
+    // A pending client needs attention again at its deadline
+    unsigned long left = (now - pending.accepted < HTTP_MAX_DATA_WAIT) ? HTTP_MAX_DATA_WAIT - (now - pending.accepted) : 0;
+    timeout_ms = min(timeout_ms, left);
+
+    // A socket holding a partial, already peeked head stays readable, so poll it instead
+    int fd = pending.client.fd();
+    if (pending.peeked > 0 || fd < 0) {
+      timeout_ms = min(timeout_ms, (unsigned long) HTTP_PENDING_POLL_WAIT);
+    } else {
+      FD_SET(fd, &readFds);
+      maxFd = max(maxFd, fd);
+    }
+  }
+
+  if (maxFd < 0) {
+    delay(timeout_ms);
+    return false;
+  }
+
+  struct timeval tv;
+  tv.tv_sec  = timeout_ms / 1000;
+  tv.tv_usec = (timeout_ms % 1000) * 1000;
+
+  return select(maxFd + 1, &readFds, NULL, NULL, &tv) > 0;
+}
+
+void WebServer::handleClient() {
+  _acceptPendingClients();
+
+  int ready = _nextReadyClient();
+  if (ready < 0) {
+    if (_nullDelay) {
+      delay(1);
+    }
+    return;
+  }
+
+  _currentClient = _pendingClients[ready].client;
+  _pendingClients[ready].client = WiFiClient();
+  _currentStatus = HC_WAIT_READ;
+  _statusChange = millis();
+
+  // The request head, and a body that fits with it, are already buffered : parsing doesn't wait on the network
+  if (_currentClient.connected() && _parseRequest(_currentClient)) {
+    // because HTTP_MAX_SEND_WAIT is expressed in milliseconds,
+    // it must be divided by 1000
+    _currentClient.setTimeout(HTTP_MAX_SEND_WAIT / 1000);
+    _contentLength = CONTENT_LENGTH_NOT_SET;
+    _handleRequest();
 
 // Fix for issue with Chrome based browsers: https://github.com/espressif/arduino-esp32/issues/3652
 //           if (_currentClient.connected()) {
@@ -320,36 +563,18 @@ void WebServer::handleClient() {
 //             _statusChange = millis();
 //             keepCurrentClient = true;
 //           }
-        }
-      } else { // !_currentClient.available()
-        if (millis() - _statusChange <= HTTP_MAX_DATA_WAIT) {
-          keepCurrentClient = true;
-        }
-        callYield = true;
-      }
-      break;
-    case HC_WAIT_CLOSE:
-      // Wait for client to close the connection
-      if (millis() - _statusChange <= HTTP_MAX_CLOSE_WAIT) {
-        keepCurrentClient = true;
-        callYield = true;
-      }
-    }
   }
 
-  if (!keepCurrentClient) {
-    _currentClient = WiFiClient();
-    _currentStatus = HC_NONE;
-    _currentUpload.reset();
-  }
+  _currentClient = WiFiClient();
+  _currentStatus = HC_NONE;
+  _currentUpload.reset();
 
-  if (callYield) {
-    yield();
-  }
+  yield();
 }
 
 void WebServer::close() {
   _server.close();
+  _dropPendingClients();
   _currentStatus = HC_NONE;
   if(!_headerKeysCount)
     collectHeaders(0, 0);
@@ -523,6 +748,143 @@ void WebServer::_streamFileCore(const size_t fileSize, const String & fileName,
   send(200, contentType, "");
 }
 
+void WebServer::_streamFileCore(const size_t fileSize, const String & fileName, const String & contentType, const String & etag)
+{
+  if (etag.length()) {
+    sendHeader(F("ETag"), etag);
+  }
+  sendHeader(F("Accept-Ranges"), F("bytes"));
+  _streamFileCore(fileSize, fileName, contentType);
+}
+
+void WebServer::_streamFileCore(const size_t fileSize, const String & fileName, const String & contentType, const String & etag,
+                                const size_t first, const size_t last)
+{
+  using namespace mime;
+  char contentRange[48];
+  snprintf(contentRange, sizeof(contentRange), "bytes %u-%u/%u", (unsigned) first, (unsigned) last, (unsigned) fileSize);
+
+  if (etag.length()) {
+    sendHeader(F("ETag"), etag);
+  }
+  sendHeader(F("Accept-Ranges"), F("bytes"));
+  sendHeader(F("Content-Range"), contentRange);
+  setContentLength(last - first + 1);
+  if (fileName.endsWith(String(FPSTR(mimeTable[gz].endsWith))) &&
+      contentType != String(FPSTR(mimeTable[gz].mimeType)) &&
+      contentType != String(FPSTR(mimeTable[none].mimeType))) {
+    sendHeader(F("Content-Encoding"), F("gzip"));
+  }
+  send(206, contentType, "");
+}
+
+void WebServer::_streamFileNotModified(const String & etag)
+{
+  sendHeader(F("ETag"), etag);
+  send(304);
+}
+
+void WebServer::_streamFileRangeNotSatisfiable(const size_t fileSize)
+{
+  char contentRange[24];
+  snprintf(contentRange, sizeof(contentRange), "bytes */%u", (unsigned) fileSize);
+
+  sendHeader(F("Content-Range"), contentRange);
+  send(416);
+}
+
+// Strong validator derived from size and modification time, cheap enough to compute on every request.
+// Empty without a modification time (SPIFFS) : size alone can't tell two versions of a file apart.
+String WebServer::_fileETag(const size_t fileSize, const time_t lastWrite)
+{
+  if (lastWrite == 0) {
+    return String();
+  }
+
+  char etag[24];
+  snprintf(etag, sizeof(etag), "\"%x-%lx\"", (unsigned) fileSize, (unsigned long) lastWrite);
+  return String(etag);
+}
+
+bool WebServer::_etagMatches(const String & etag)
+{
+  String ifNoneMatch = header(FPSTR(IF_NONE_MATCH_HEADER));
+
+  if (ifNoneMatch.length() == 0 || etag.length() == 0) {
+    return false;
+  }
+
+  return (ifNoneMatch == "*") || (ifNoneMatch.indexOf(etag) >= 0);
+}
+
+// A Range only applies when If-Range, if any, still names this version of the file. Only a strong ETag
+// can match : no Last-Modified is sent, so a date never does.
+bool WebServer::_ifRangeMatches(const String & etag)
+{
+  String ifRange = header(FPSTR(IF_RANGE_HEADER));
+
+  if (ifRange.length() == 0) {
+    return true;
+  }
+
+  return etag.length() && ifRange == etag;
+}
+
+// Returns 0 to send the whole file, 1 for a valid single range and -1 if the range can't be satisfied.
+// Multiple ranges and malformed headers are ignored, as RFC 7233 allows.
+int WebServer::_parseRange(const size_t fileSize, size_t & first, size_t & last)
+{
+  String range = header(FPSTR(RANGE_HEADER));
+
+  if (!range.startsWith(F("bytes=")) || range.indexOf(',') >= 0) {
+    return 0;
+  }
+
+  const char * spec = range.c_str() + 6;
+  const char * dash = strchr(spec, '-');
+
+  if (dash == NULL) {
+    return 0;
+  }
+
+  char * end;
+
+  if (dash == spec) {
+    // bytes=-N : the last N bytes
+    unsigned long suffix = strtoul(dash + 1, &end, 10);
+    if (end == dash + 1 || *end != 0) {
+      return 0;
+    }
+    if (suffix == 0 || fileSize == 0) {
+      return -1;
+    }
+    first = (suffix < fileSize) ? fileSize - suffix : 0;
+    last  = fileSize - 1;
+    return 1;
+  }
+
+  unsigned long from = strtoul(spec, &end, 10);
+  if (end != dash) {
+    return 0;
+  }
+
+  unsigned long to = fileSize ? fileSize - 1 : 0;
+  if (dash[1] != 0) {
+    to = strtoul(dash + 1, &end, 10);
+    if (*end != 0 || to < from) {
+      return 0;
+    }
+  }
+
+  if (from >= fileSize) {
+    return -1;
+  }
+
+  first = from;
+  last  = (to < fileSize) ? to : fileSize - 1;
+  return 1;
+}
+
 String WebServer::pathArg(unsigned int i) {
   if (_currentHandler != nullptr)
     return _currentHandler->pathArg(i);
@@ -579,13 +941,16 @@ String WebServer::header(String name) {
 }
 
 void WebServer::collectHeaders(const char* headerKeys[], const size_t headerKeysCount) {
-  _headerKeysCount = headerKeysCount + 1;
+  _headerKeysCount = headerKeysCount + BUILTIN_HEADER_KEYS_COUNT;
   if (_currentHeaders)
      delete[]_currentHeaders;
   _currentHeaders = new RequestArgument[_headerKeysCount];
   _currentHeaders[0].key = FPSTR(AUTHORIZATION_HEADER);
-  for (int i = 1; i < _headerKeysCount; i++){
-    _currentHeaders[i].key = headerKeys[i-1];
+  _currentHeaders[1].key = FPSTR(IF_NONE_MATCH_HEADER);
+  _currentHeaders[2].key = FPSTR(RANGE_HEADER);
+  _currentHeaders[3].key = FPSTR(IF_RANGE_HEADER);
+  for (int i = BUILTIN_HEADER_KEYS_COUNT; i < _headerKeysCount; i++){
+    _currentHeaders[i].key = headerKeys[i - BUILTIN_HEADER_KEYS_COUNT];
   }
 }
 
@@ -38,7 +38,11 @@ enum HTTPAuthMethod { BASIC_AUTH, DIGEST_AUTH };
 #define HTTP_DOWNLOAD_UNIT_SIZE 1436
 
 #ifndef HTTP_UPLOAD_BUFLEN
-#define HTTP_UPLOAD_BUFLEN 1436
+#define HTTP_UPLOAD_BUFLEN 1436 //4096 : upload handlers get whole flash sectors, for 2.6 KB more RAM per upload
+#endif
+
+#ifndef HTTP_UPLOAD_RX_BUFLEN
+#define HTTP_UPLOAD_RX_BUFLEN 1436 //staging buffer the multipart parser reads and scans for boundaries
 #endif
 
 #define HTTP_MAX_DATA_WAIT 5000 //ms to wait for the client to send the request
@@ -46,6 +50,23 @@ enum HTTPAuthMethod { BASIC_AUTH, DIGEST_AUTH };
 #define HTTP_MAX_SEND_WAIT 5000 //ms to wait for data chunk to be ACKed
 #define HTTP_MAX_CLOSE_WAIT 2000 //ms to wait for the client to close the connection
 
+#ifndef HTTP_MAX_PENDING_CLIENTS
+#define HTTP_MAX_PENDING_CLIENTS 4 //connections allowed to wait for a complete request head at the same time
+#endif
+
+#ifndef HTTP_PENDING_POLL_WAIT
+#define HTTP_PENDING_POLL_WAIT 20 //ms between checks of a client that sent only part of its request head
+#endif
+
+#ifndef HTTP_PEEK_BUFLEN
+#define HTTP_PEEK_BUFLEN 1024 //longest request head, answered 431 beyond. Peeked without consuming it
+#endif
+
+// Lets callers block on socket readiness instead of polling handleClient()
+#define WEBSERVER_HAS_WAIT_FOR_ACTIVITY   1
+// streamFile() sends ETag and honours If-None-Match, Range and If-Range
+#define WEBSERVER_HAS_CONDITIONAL_STREAMFILE   1
+
 #define CONTENT_LENGTH_UNKNOWN ((size_t) -1)
 #define CONTENT_LENGTH_NOT_SET ((size_t) -2)
 
@@ -67,6 +88,27 @@ namespace fs {
 class FS;
 }
 
+// Non-blocking listening socket whose descriptor can be handed to select()
+class WebServerListener
+{
+public:
+  WebServerListener(IPAddress addr, uint16_t port) : _addr(addr), _port(port), _fd(-1), _noDelay(false) {}
+  WebServerListener(uint16_t port) : _addr((uint32_t) 0), _port(port), _fd(-1), _noDelay(false) {}
+  ~WebServerListener() { close(); }
+
+  void begin(uint16_t port = 0);
+  void close();
+  void setNoDelay(bool nodelay) { _noDelay = nodelay; }
+  WiFiClient available();
+  int fd() const { return _fd; }
+
+private:
+  IPAddress _addr;
+  uint16_t  _port;
+  int       _fd;
+  bool      _noDelay;
+};
+
 class WebServer
 {
 public:
@@ -77,6 +119,9 @@ public:
   virtual void begin();
   virtual void begin(uint16_t port);
   virtual void handleClient();
+  // Sleep until a connection, request data or extraFd becomes readable, or timeout_ms elapses.
+  // Returns true if there is something to handle.
+  bool waitForActivity(unsigned long timeout_ms, int extraFd = -1);
 
   virtual void close();
   void stop();
@@ -136,10 +181,52 @@ public:
 
   static String urlDecode(const String& text);
 
+  // Sends ETag/Accept-Ranges, answers If-None-Match with 304 and a single Range with 206. Without a modification
+  // time there is no ETag, so no 304, and a Range only applies without If-Range.
   template<typename T>
   size_t streamFile(T &file, const String& contentType) {
-    _streamFileCore(file.size(), file.name(), contentType);
-    return _currentClient.write(file);
+    const size_t fileSize = file.size();
+    const String etag = _fileETag(fileSize, file.getLastWrite());
+
+    if (_etagMatches(etag)) {
+      _streamFileNotModified(etag);
+      return 0;
+    }
+
+    size_t first = 0;
+    size_t last  = fileSize ? fileSize - 1 : 0;
+    int range = _ifRangeMatches(etag) ? _parseRange(fileSize, first, last) : 0;
+
+    if (range < 0) {
+      _streamFileRangeNotSatisfiable(fileSize);
+      return 0;
+    }
+
+    if (range > 0 && !file.seek(first)) {
+      range = 0;
+    }
+
+    if (range == 0) {
+      _streamFileCore(fileSize, file.name(), contentType, etag);
+      return _currentClient.write(file);
+    }
+
+    _streamFileCore(fileSize, file.name(), contentType, etag, first, last);
+
+    uint8_t buf[HTTP_DOWNLOAD_UNIT_SIZE];
+    size_t left = last - first + 1;
+    size_t sent = 0;
+
+    while (left > 0) {
+      size_t len = file.read(buf, min(left, sizeof(buf)));
+      if (len == 0 || _currentClientWrite((const char *) buf, len) != len) {
+        break;
+      }
+      left -= len;
+      sent += len;
+    }
+
+    return sent;
   }
 
 protected:
@@ -154,11 +241,41 @@ protected:
   bool _parseForm(WiFiClient& client, String boundary, uint32_t len);
   bool _parseFormUploadAborted();
   void _uploadWriteByte(uint8_t b);
+  void _uploadWriteBytes(const uint8_t* b, size_t len);
   int _uploadReadByte(WiFiClient& client);
+
+  class FormReader;
+  bool _parseFormFile(FormReader& reader, const String& delimiter);
   void _prepareHeader(String& response, int code, const char* content_type, size_t contentLength);
   bool _collectHeader(const char* headerName, const char* headerValue);
 
   void _streamFileCore(const size_t fileSize, const String & fileName, const String & contentType);
+  void _streamFileCore(const size_t fileSize, const String & fileName, const String & contentType, const String & etag);
+  void _streamFileCore(const size_t fileSize, const String & fileName, const String & contentType, const String & etag,
+                       const size_t first, const size_t last);
+  void _streamFileNotModified(const String & etag);
+  void _streamFileRangeNotSatisfiable(const size_t fileSize);
+  static String _fileETag(const size_t fileSize, const time_t lastWrite);
+  bool _etagMatches(const String & etag);
+  bool _ifRangeMatches(const String & etag);
+  int  _parseRange(const size_t fileSize, size_t & first, size_t & last);
+
+  // Each accepted connection waits here, with its own deadline, until its request head is complete, and
+  // its body too when both fit HTTP_PEEK_BUFLEN. Only then is it handed to _parseRequest(), so a slow
+  // client never blocks the others. Larger bodies (uploads) are read by _parseRequest().
+  enum { HEAD_CLOSED = -1, HEAD_PARTIAL, HEAD_READY, HEAD_TOO_LARGE };
+
+  struct PendingClient {
+    WiFiClient    client;
+    unsigned long accepted;      // millis() when accepted
+    unsigned long lastActivity;  // millis() when new bytes last arrived
+    int           peeked;        // bytes seen at last peek
+  };
+
+  void _acceptPendingClients();
+  int  _nextReadyClient();
+  int  _peekRequestHead(PendingClient& pending);
+  void _dropPendingClients();
 
   String _getRandomHexString();
   // for extracting Auth parameters
@@ -170,7 +287,7 @@ protected:
   };
 
   boolean           _corsEnabled;
-  WiFiServer        _server;
+  WebServerListener _server;
 
   WiFiClient        _currentClient;
   HTTPMethod        _currentMethod;
@@ -180,6 +297,8 @@ protected:
   unsigned long     _statusChange;
   bool              _nullDelay;
 
+  PendingClient     _pendingClients[HTTP_MAX_PENDING_CLIENTS];
+
   RequestHandler*  _currentHandler;
   RequestHandler*  _firstHandler;
   RequestHandler*  _lastHandler;
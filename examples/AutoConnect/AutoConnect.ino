@@ -189,19 +189,6 @@ bool initialConfig = false;
 // See Issue 23: On Android phone ConfigPortal is unresponsive (https://github.com/khoih-prog/ESP_WiFiManager/issues/23)
 #define USE_ESP_WIFIMANAGER_NTP     true
 
-// Just use enough to save memory. On ESP8266, can cause blank ConfigPortal screen
-// if using too much memory
-#define USING_AFRICA        false
-#define USING_AMERICA       true
-#define USING_ANTARCTICA    false
-#define USING_ASIA          false
-#define USING_ATLANTIC      false
-#define USING_AUSTRALIA     false
-#define USING_EUROPE        false
-#define USING_INDIAN        false
-#define USING_PACIFIC       false
-#define USING_ETC_GMT       false
-
 // Use true to enable CloudFlare NTP service. System can hang if you don't have Internet access while accessing CloudFlare
 // See Issue #21: CloudFlare link in the default portal (https://github.com/khoih-prog/ESP_WiFiManager/issues/21)
 #define USE_CLOUDFLARE_NTP          false
@@ -737,12 +724,7 @@ void setup()
     {
       LOGERROR3(F("Current TZ_Name ="), WM_config.TZ_Name, F(", TZ = "), WM_config.TZ);
 
-  #if ESP8266
-      configTime(WM_config.TZ, "pool.ntp.org"); 
-  #else
-      //configTzTime(WM_config.TZ, "pool.ntp.org" );
-      configTzTime(WM_config.TZ, "time.nist.gov", "0.pool.ntp.org", "1.pool.ntp.org");
-  #endif   
+      ESP_WiFiManager::sntp().begin(WM_config.TZ);
     }
     else
     {
@@ -843,12 +825,7 @@ void setup()
     {
       LOGERROR3(F("Saving current TZ_Name ="), WM_config.TZ_Name, F(", TZ = "), WM_config.TZ);
 
-  #if ESP8266
-      configTime(WM_config.TZ, "pool.ntp.org"); 
-  #else
-      //configTzTime(WM_config.TZ, "pool.ntp.org" );
-      configTzTime(WM_config.TZ, "time.nist.gov", "0.pool.ntp.org", "1.pool.ntp.org");
-  #endif
+      ESP_WiFiManager::sntp().begin(WM_config.TZ);
     }
     else
     {
@@ -908,6 +885,11 @@ void setup()
 
 void loop()
 { 
+#if USE_ESP_WIFIMANAGER_NTP
+  // The manager's SNTP client outlives it : sync started on connect, and the periodic ones
+  ESP_WiFiManager::sntp().loop();
+#endif
+
   // put your main code here, to run repeatedly
   check_status();
 }
@@ -200,19 +200,6 @@ String AP_PASS;
 // See Issue 23: On Android phone ConfigPortal is unresponsive (https://github.com/khoih-prog/ESP_WiFiManager/issues/23)
 #define USE_ESP_WIFIMANAGER_NTP     true
 
-// Just use enough to save memory. On ESP8266, can cause blank ConfigPortal screen
-// if using too much memory
-#define USING_AFRICA        false
-#define USING_AMERICA       true
-#define USING_ANTARCTICA    false
-#define USING_ASIA          false
-#define USING_ATLANTIC      false
-#define USING_AUSTRALIA     false
-#define USING_EUROPE        false
-#define USING_INDIAN        false
-#define USING_PACIFIC       false
-#define USING_ETC_GMT       false
-
 // Use true to enable CloudFlare NTP service. System can hang if you don't have Internet access while accessing CloudFlare
 // See Issue #21: CloudFlare link in the default portal (https://github.com/khoih-prog/ESP_WiFiManager/issues/21)
 #define USE_CLOUDFLARE_NTP          false
@@ -966,12 +953,7 @@ void setup()
     {
       LOGERROR3(F("Current TZ_Name ="), WM_config.TZ_Name, F(", TZ = "), WM_config.TZ);
 
-  #if ESP8266
-      configTime(WM_config.TZ, "pool.ntp.org"); 
-  #else
-      //configTzTime(WM_config.TZ, "pool.ntp.org" );
-      configTzTime(WM_config.TZ, "time.nist.gov", "0.pool.ntp.org", "1.pool.ntp.org");
-  #endif   
+      ESP_WiFiManager::sntp().begin(WM_config.TZ);
     }
     else
     {
@@ -1070,12 +1052,7 @@ void setup()
     {
       LOGERROR3(F("Saving current TZ_Name ="), WM_config.TZ_Name, F(", TZ = "), WM_config.TZ);
 
-  #if ESP8266
-      configTime(WM_config.TZ, "pool.ntp.org"); 
-  #else
-      //configTzTime(WM_config.TZ, "pool.ntp.org" );
-      configTzTime(WM_config.TZ, "time.nist.gov", "0.pool.ntp.org", "1.pool.ntp.org");
-  #endif
+      ESP_WiFiManager::sntp().begin(WM_config.TZ);
     }
     else
     {
@@ -1152,5 +1129,10 @@ void setup()
 
 void loop()
 {  
+#if USE_ESP_WIFIMANAGER_NTP
+  // The manager's SNTP client outlives it : sync started on connect, and the periodic ones
+  ESP_WiFiManager::sntp().loop();
+#endif
+
   check_status();
 }
@@ -173,19 +173,6 @@ bool initialConfig = false;
 // See Issue 23: On Android phone ConfigPortal is unresponsive (https://github.com/khoih-prog/ESP_WiFiManager/issues/23)
 #define USE_ESP_WIFIMANAGER_NTP     true
 
-// Just use enough to save memory. On ESP8266, can cause blank ConfigPortal screen
-// if using too much memory
-#define USING_AFRICA        false
-#define USING_AMERICA       true
-#define USING_ANTARCTICA    false
-#define USING_ASIA          false
-#define USING_ATLANTIC      false
-#define USING_AUSTRALIA     false
-#define USING_EUROPE        false
-#define USING_INDIAN        false
-#define USING_PACIFIC       false
-#define USING_ETC_GMT       false
-
 // Use true to enable CloudFlare NTP service. System can hang if you don't have Internet access while accessing CloudFlare
 // See Issue #21: CloudFlare link in the default portal (https://github.com/khoih-prog/ESP_WiFiManager/issues/21)
 #define USE_CLOUDFLARE_NTP          false
@@ -614,7 +601,7 @@ bool handleFileRead(String path)
     }
     
     File file = filesystem->open(path, "r");
-    server.streamFile(file, contentType);
+    WM_streamFile(server, file, path, contentType);
     file.close();
     return true;
   }
@@ -723,6 +710,40 @@ void handleFileCreate()
   path.clear();
 }
 
+// Entries are batched up to LIST_CHUNK_SIZE and sent as HTTP chunks, so memory use doesn't grow with the directory
+#define LIST_CHUNK_SIZE     512
+
+// Paging argument of /list : 0 when missing, false unless made of digits only (no sign), at most 9 of them
+bool listArg(const char * name, uint32_t& value)
+{
+  value = 0;
+
+  if (!server.hasArg(name))
+  {
+    return true;
+  }
+
+  String arg = server.arg(name);
+
+  if ( (arg.length() == 0) || (arg.length() > 9) )
+  {
+    return false;
+  }
+
+  for (unsigned int i = 0; i < arg.length(); i++)
+  {
+    if (!isDigit(arg[i]))
+    {
+      return false;
+    }
+  }
+
+  value = arg.toInt();
+
+  return true;
+}
+
+// /list?dir=/ lists the whole directory. Optional : offset=N&limit=M for paging and fields=size,mtime
 void handleFileList() 
 {
   if (!server.hasArg("dir")) 
@@ -731,42 +752,80 @@ void handleFileList()
     return;
   }
 
+  uint32_t offset;
+  uint32_t limit;
+
+  if (!listArg("offset", offset) || !listArg("limit", limit))
+  {
+    server.send(400, "text/plain", "BAD ARGS");
+    return;
+  }
+
   String path = server.arg("dir");
   Serial.println("handleFileList: " + path);
+
+  String   fields   = server.arg("fields");
+  bool     withSize = (fields.indexOf("size") >= 0);
+  bool     withTime = (fields.indexOf("mtime") >= 0);
+
   Dir dir = filesystem->openDir(path);
   path.clear();
 
-  String output = "[";
+  String output;
+  output.reserve(LIST_CHUNK_SIZE + 128);
+  output = "[";
+
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "text/json", "");
+
+  uint32_t index = 0;
+  uint32_t count = 0;
   
-  while (dir.next()) 
+  // Dir gives name, size and time without opening each file
+  while (dir.next() && ( (limit == 0) || (count < limit) ) ) 
   {
-    File entry = dir.openFile("r");
+    if (index++ < offset)
+    {
+      continue;
+    }
     
-    if (output != "[") 
+    if (count++ > 0) 
     {
       output += ',';
     }
     
-    bool isDir = false;
+    String name = dir.fileName();
+    
     output += "{\"type\":\"";
-    output += (isDir) ? "dir" : "file";
+    output += (dir.isDirectory()) ? "dir" : "file";
     output += "\",\"name\":\"";
+    output += (name[0] == '/') ? name.substring(1) : name;
+    output += '"';
     
-    if (entry.name()[0] == '/') 
+    if (withSize)
     {
-      output += &(entry.name()[1]);
-    } 
-    else 
+      output += ",\"size\":" + String((uint32_t) dir.fileSize());
+    }
+    
+    if (withTime)
     {
-      output += entry.name();
+      output += ",\"mtime\":" + String((uint32_t) dir.fileTime());
     }
     
-    output += "\"}";
-    entry.close();
+    output += '}';
+
+    if (output.length() >= LIST_CHUNK_SIZE)
+    {
+      server.sendContent(output);
+      output = "";
+    }
   }
 
   output += "]";
-  server.send(200, "text/json", output);
+  server.sendContent(output);
+  server.sendContent("");
+
+  Serial.println("handleFileList: " + String(count) + " entries");
 }
 
 int calcChecksum(uint8_t* address, uint16_t sizeToCalc)
@@ -989,12 +1048,7 @@ void setup()
     {
       LOGERROR3(F("Current TZ_Name ="), WM_config.TZ_Name, F(", TZ = "), WM_config.TZ);
 
-  #if ESP8266
-      configTime(WM_config.TZ, "pool.ntp.org"); 
-  #else
-      //configTzTime(WM_config.TZ, "pool.ntp.org" );
-      configTzTime(WM_config.TZ, "time.nist.gov", "0.pool.ntp.org", "1.pool.ntp.org");
-  #endif   
+      ESP_WiFiManager::sntp().begin(WM_config.TZ);
     }
     else
     {
@@ -1096,12 +1150,7 @@ void setup()
     {
       LOGERROR3(F("Saving current TZ_Name ="), WM_config.TZ_Name, F(", TZ = "), WM_config.TZ);
       
-  #if ESP8266
-      configTime(WM_config.TZ, "pool.ntp.org"); 
-  #else
-      //configTzTime(WM_config.TZ, "pool.ntp.org" );
-      configTzTime(WM_config.TZ, "time.nist.gov", "0.pool.ntp.org", "1.pool.ntp.org");
-  #endif 
+      ESP_WiFiManager::sntp().begin(WM_config.TZ);
     }
     else
     {
@@ -1202,6 +1251,9 @@ void setup()
     json.clear();
   });
   
+  // Needed by WM_streamFile() for 304 and Range replies
+  WM_collectStreamFileHeaders(server);
+
   server.begin();
   
   Serial.print(F("HTTP server started @ "));
@@ -1222,6 +1274,11 @@ void loop()
   drd->loop();
 
   // this is just for checking if we are alive and connected to WiFi
+#if USE_ESP_WIFIMANAGER_NTP
+  // The manager's SNTP client outlives it : sync started on connect, and the periodic ones
+  ESP_WiFiManager::sntp().loop();
+#endif
+
   check_status();
   
   server.handleClient();
@@ -0,0 +1,51 @@
+#!/usr/bin/env python3
+#
+# Minimal NTP server, to check the manager's SNTP client against a local machine :
+#
+#   python3 ntp_standin.py [port] [offset_seconds]
+#
+# and in the sketch, before autoConnect() :
+#
+#   ESP_wifiManager.sntp().setServer(0, "192.168.2.30", 12300);
+#
+# Replies with this machine's clock plus offset_seconds, stratum 1, to every client request.
+
+import socket
+import struct
+import sys
+import time
+
+NTP_UNIX_OFFSET = 2208988800
+
+
+def timestamp(t):
+  return struct.pack("!II", int(t) + NTP_UNIX_OFFSET, int((t % 1) * 2**32))
+
+
+def main():
+  port    = int(sys.argv[1]) if len(sys.argv) > 1 else 12300
+  offset  = float(sys.argv[2]) if len(sys.argv) > 2 else 0.0
+
+  sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+  sock.bind(("0.0.0.0", port))
+
+  print("NTP stand-in on port {}, offset {} s".format(port, offset))
+
+  while True:
+    request, client = sock.recvfrom(512)
+    received = time.time() + offset
+
+    # Client mode, any version
+    if len(request) < 48 or (request[0] & 0x07) != 3:
+      continue
+
+    # LI 0, version 4, server, stratum 1, poll copied, precision 2^-20
+    reply  = bytes([0x24, 1, request[2], 0xEC]) + bytes(8) + b"LOCL"
+    reply += timestamp(received) + request[40:48] + timestamp(received) + timestamp(time.time() + offset)
+
+    sock.sendto(reply, client)
+    print("{} : {:+.6f}".format(client[0], offset))
+
+
+if __name__ == "__main__":
+  main()
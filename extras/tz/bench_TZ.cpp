@@ -0,0 +1,127 @@
+/****************************************************************************************************************************
+  bench_TZ.cpp
+  Host check and benchmark of the compressed timezone database in src/utils/TZ.h
+
+  Looks up every name of zones.csv, checks it returns the rule of the CSV, then times the lookups against
+  a plain linear scan of fixed-width [][50] name/rule tables, the format TZ.h used to have. Exits with 1 on
+  any mismatch, or when the CSV and TZ.h don't have the same number of zones.
+
+  g++ -O2 -o bench_TZ bench_TZ.cpp && ./bench_TZ zones.csv
+ *****************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+// Flash is plain memory on the host
+#define PROGMEM
+#define pgm_read_byte(p)    (*(const uint8_t *)(p))
+#define pgm_read_word(p)    (*(const uint16_t *)(p))
+#define strncpy_P           strncpy
+
+#include "../../src/utils/TZ.h"
+
+#define ROUNDS      1000
+
+static char names[WM_TZ_COUNT][TIMEZONE_MAX_LEN];
+static char rules[WM_TZ_COUNT][TIMEZONE_MAX_LEN];
+static int  count = 0;
+
+////////////////////////////////////////////////////
+
+static double nowNs()
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+////////////////////////////////////////////////////
+
+static const char * linearTZ(const char * timezoneName)
+{
+  for (int i = 0; i < count; i++)
+  {
+    if (!strcmp(timezoneName, names[i]))
+      return rules[i];
+  }
+
+  return "";
+}
+
+////////////////////////////////////////////////////
+
+int main(int argc, char ** argv)
+{
+  FILE * f = fopen(argc > 1 ? argv[1] : "zones.csv", "r");
+
+  if (!f)
+  {
+    perror("zones.csv");
+    return 1;
+  }
+
+  while ( (count < WM_TZ_COUNT) && (fscanf(f, " \"%49[^\"]\",\"%49[^\"]\"", names[count], rules[count]) == 2) )
+    count++;
+
+  fclose(f);
+
+  char rule[WM_TZ_RULE_MAX_LEN + 1];
+  int  errors = 0;
+
+  for (int i = 0; i < count; i++)
+  {
+    if (!WM_findTZRule(names[i], rule, sizeof(rule)) || strcmp(rule, rules[i]))
+    {
+      printf("Mismatch for %s\n", names[i]);
+      errors++;
+    }
+  }
+
+  if (WM_findTZRule("America/New_Yor", rule, sizeof(rule)) || WM_findTZRule("Zulu/Nowhere", rule, sizeof(rule)) ||
+      WM_findTZRule("", rule, sizeof(rule)))
+  {
+    printf("Unknown name found\n");
+    errors++;
+  }
+
+  // Every zone of the database, none left out of the CSV
+  if (count != WM_TZ_COUNT)
+  {
+    printf("%d zones in zones.csv, %d in TZ.h\n", count, WM_TZ_COUNT);
+    errors++;
+  }
+
+  printf("%d zones checked, %d errors\n\n", count, errors);
+
+  printf("Flash : names %u + restarts %u + rules %u + rule index %u = %u bytes, fixed-width tables %u bytes\n",
+         (unsigned) sizeof(WM_TZ_NAMES), (unsigned) sizeof(WM_TZ_RESTARTS), (unsigned) sizeof(WM_TZ_RULES),
+         (unsigned) sizeof(WM_TZ_RULE_INDEX),
+         (unsigned) (sizeof(WM_TZ_NAMES) + sizeof(WM_TZ_RESTARTS) + sizeof(WM_TZ_RULES) + sizeof(WM_TZ_RULE_INDEX)),
+         (unsigned) (sizeof(names) + sizeof(rules)));
+
+  volatile size_t sink = 0;
+  double start = nowNs();
+
+  for (int r = 0; r < ROUNDS; r++)
+    for (int i = 0; i < count; i++)
+      sink += WM_findTZRule(names[i], rule, sizeof(rule));
+
+  double compressed = (nowNs() - start) / (ROUNDS * count);
+
+  start = nowNs();
+
+  for (int r = 0; r < ROUNDS; r++)
+    for (int i = 0; i < count; i++)
+      sink += strlen(linearTZ(names[i]));
+
+  double linear = (nowNs() - start) / (ROUNDS * count);
+
+  printf("Lookup : compressed %.0f ns, linear fixed-width %.0f ns (average over all names)\n", compressed, linear);
+
+  return errors ? 1 : 0;
+}
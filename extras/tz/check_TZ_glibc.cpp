@@ -0,0 +1,181 @@
+/****************************************************************************************************************************
+  check_TZ_glibc.cpp
+  Host check of the compiled POSIX timezone of src/utils/WM_TimeZone.h against glibc
+
+  For every rule of zones.csv, compares ESP_WMTimeZone with glibc's localtime_r() under TZ set to the same
+  rule, from 2000 to 2100 : every step seconds (default 2 days 1 h 7 min, so each hour of the day comes round),
+  and 1 s either side of each transition glibc makes. Checks isDST(), offset(), abbreviation() and every
+  field of localTime(), and that toUTC() gives back an instant of the same local time. Prints the number of
+  comparisons and mismatches, exits with 1 on any mismatch.
+
+  TZDIR points nowhere, so glibc parses each rule instead of loading a zoneinfo file of the same name.
+
+  g++ -O2 -o check_TZ_glibc check_TZ_glibc.cpp && ./check_TZ_glibc zones.csv [step_seconds]
+ *****************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../../src/utils/WM_TimeZone.h"
+
+#define FIRST_YEAR_UTC        946684800LL       // 2000-01-01 00:00:00 UTC
+#define END_YEAR_UTC          4133980800LL      // 2101-01-01 00:00:00 UTC
+
+#define DEFAULT_STEP          (2 * 86400 + 3600 + 7 * 60)
+
+#define MAX_REPORTED          20
+
+static unsigned long long comparisons = 0;
+static unsigned long long mismatches  = 0;
+
+////////////////////////////////////////////////////
+
+static void mismatch(const char * rule, const time_t& t, const char * what)
+{
+  if (mismatches++ < MAX_REPORTED)
+    printf("Mismatch for %s at %lld : %s\n", rule, (long long) t, what);
+}
+
+// One instant, ESP_WMTimeZone against glibc
+static void compare(const char * rule, const ESP_WMTimeZone& zone, const time_t& t)
+{
+  struct tm expected;
+  struct tm actual;
+
+  localtime_r(&t, &expected);
+  memset(&actual, 0, sizeof(actual));
+  zone.localTime(t, actual);
+
+  comparisons++;
+
+  if ( (actual.tm_sec != expected.tm_sec) || (actual.tm_min != expected.tm_min) || (actual.tm_hour != expected.tm_hour) ||
+       (actual.tm_mday != expected.tm_mday) || (actual.tm_mon != expected.tm_mon) || (actual.tm_year != expected.tm_year) ||
+       (actual.tm_wday != expected.tm_wday) || (actual.tm_yday != expected.tm_yday) )
+    mismatch(rule, t, "struct tm");
+
+  if ( (actual.tm_isdst != expected.tm_isdst) || (zone.isDST(t) != (expected.tm_isdst > 0)) )
+    mismatch(rule, t, "isdst");
+
+  if (zone.offset(t) != expected.tm_gmtoff)
+    mismatch(rule, t, "offset");
+
+  // Abbreviations are truncated to WM_TZ_ABBR_MAX_LEN
+  if (strncmp(zone.abbreviation(t), expected.tm_zone, WM_TZ_ABBR_MAX_LEN))
+    mismatch(rule, t, "abbreviation");
+
+  time_t local = zone.toLocal(t);
+
+  if (local != t + expected.tm_gmtoff)
+    mismatch(rule, t, "toLocal");
+
+  // Repeated local times have two instants, either is right
+  if (zone.toLocal(zone.toUTC(local)) != local)
+    mismatch(rule, t, "toUTC");
+}
+
+// Last instant before the offset or DST flag changes, glibc's, in (from, to]
+static time_t transition(time_t from, time_t to)
+{
+  struct tm before;
+
+  localtime_r(&from, &before);
+
+  while (to - from > 1)
+  {
+    time_t    mid = from + (to - from) / 2;
+    struct tm tm;
+
+    localtime_r(&mid, &tm);
+
+    if ( (tm.tm_gmtoff == before.tm_gmtoff) && (tm.tm_isdst == before.tm_isdst) )
+      from = mid;
+    else
+      to = mid;
+  }
+
+  return to;
+}
+
+////////////////////////////////////////////////////
+
+int main(int argc, char ** argv)
+{
+  FILE * f    = fopen(argc > 1 ? argv[1] : "zones.csv", "r");
+  long   step = (argc > 2) ? atol(argv[2]) : DEFAULT_STEP;
+
+  if (!f)
+  {
+    perror("zones.csv");
+    return 1;
+  }
+
+  if (step < 1)
+  {
+    printf("step_seconds : at least 1\n");
+    return 1;
+  }
+
+  setenv("TZDIR", "/nonexistent", 1);
+
+  char name[64];
+  char rule[64];
+  int  zones   = 0;
+  int  invalid = 0;
+
+  while (fscanf(f, " \"%63[^\"]\",\"%63[^\"]\"", name, rule) == 2)
+  {
+    ESP_WMTimeZone zone;
+
+    zones++;
+
+    if (!zone.begin(rule))
+    {
+      printf("Rule of %s not parsed : %s\n", name, rule);
+      invalid++;
+
+      continue;
+    }
+
+    setenv("TZ", rule, 1);
+    tzset();
+
+    time_t    previous = FIRST_YEAR_UTC;
+    struct tm last;
+
+    localtime_r(&previous, &last);
+
+    for (time_t t = FIRST_YEAR_UTC; t < END_YEAR_UTC; t += step)
+    {
+      struct tm tm;
+
+      localtime_r(&t, &tm);
+
+      // Around each transition since the previous sample
+      while ( (tm.tm_gmtoff != last.tm_gmtoff) || (tm.tm_isdst != last.tm_isdst) )
+      {
+        time_t change = transition(previous, t);
+
+        compare(rule, zone, change - 1);
+        compare(rule, zone, change);
+        compare(rule, zone, change + 1);
+
+        previous = change;
+        localtime_r(&previous, &last);
+      }
+
+      compare(rule, zone, t);
+
+      previous = t;
+      last     = tm;
+    }
+  }
+
+  fclose(f);
+
+  printf("%d zones, %llu comparisons, %llu mismatches, %d rules not parsed\n", zones, comparisons, mismatches, invalid);
+
+  return (mismatches || invalid || !zones) ? 1 : 0;
+}
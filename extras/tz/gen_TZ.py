@@ -0,0 +1,244 @@
+#!/usr/bin/env python3
+#
+# Generates src/utils/TZ.h from zones.csv ("name","POSIX rule" per line, from
+# https://raw.githubusercontent.com/nayarsystems/posix_tz_db/master/zones.csv, with '-' and '+' in
+# the names written as 'm' and 'p').
+#
+# All zones are always available, in three PROGMEM tables :
+#   WM_TZ_NAMES     front-coded names, sorted. Each entry is the length of the prefix shared with the
+#                   previous name, the rest of the name, then 0x80 | rule number. Every
+#                   WM_TZ_RESTART_INTERVAL-th entry shares nothing, so lookups can start there.
+#   WM_TZ_RESTARTS  offset of each restart entry in WM_TZ_NAMES
+#   WM_TZ_RULES     deduplicated "rule\0" strings, WM_TZ_RULE_INDEX gives the offset of each
+#
+# Usage : python3 gen_TZ.py [zones.csv] [TZ.h]
+
+import csv
+import os
+import sys
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+RESTART_INTERVAL = 16
+
+HEADER = """\
+// autogenerated by extras/tz/gen_TZ.py from extras/tz/zones.csv
+// {date}
+//
+// This database is autogenerated from IANA timezone database
+//    https://raw.githubusercontent.com/nayarsystems/posix_tz_db/master/zones.csv
+//    (using https://www.iana.org/time-zones)
+// Update zones.csv and run the script instead of editing this file
+//
+// All zones are always built in, compressed. USING_AFRICA, USING_AMERICA, ... are no longer needed.
+
+#ifndef TZDB_H
+#define TZDB_H
+
+//See: https://www.gnu.org/software/libc/manual/html_node/TZ-Variable.html
+// EST5EDT,M3.2.0,M11.1.0 (for America/New_York)
+// EST5EDT is the name of the time zone
+// EST is the abbreviation used when DST is off
+// 6 hours is the time difference from GMT
+// EDT is the abbreviation used when DST is on
+// ,M3 is the third month
+// .2 is the second occurrence of the day in the month
+// .0 is Sunday
+// ,M11 is the eleventh month
+// .1 is the first occurrence of the day in the month
+// .0 is Sunday
+
+"""
+
+LOOKUP = """\
+////////////////////////////////////////////////////////////
+
+// Compares timezoneName with the name of the restart entry at offset. Returns <0, 0 or >0 like strcmp().
+inline int WM_compareTZRestart(const char * timezoneName, const uint16_t& offset)
+{
+  // Restart entries share no prefix : the name starts right after the zero length
+  const uint8_t* entry = &WM_TZ_NAMES[offset + 1];
+
+  for (uint8_t i = 0; ; i++)
+  {
+    uint8_t c = pgm_read_byte(&entry[i]);
+
+    // End of name : equal if the query ends too
+    if (c & 0x80)
+      return (uint8_t) timezoneName[i];
+
+    if ((uint8_t) timezoneName[i] != c)
+      return (int) (uint8_t) timezoneName[i] - (int) c;
+  }
+}
+
+////////////////////////////////////////////////////////////
+
+// Copies the POSIX rule of the exact timezoneName into rule. Returns false if the name is unknown.
+inline bool WM_findTZRule(const char * timezoneName, char * rule, const size_t& ruleLen)
+{
+  if (!timezoneName || !rule || (ruleLen == 0) || (strlen(timezoneName) > WM_TZ_NAME_MAX_LEN))
+    return false;
+
+  // Last restart entry not after the name
+  uint16_t low  = 0;
+  uint16_t high = WM_TZ_RESTART_COUNT;
+
+  while (low < high)
+  {
+    uint16_t mid = (low + high) / 2;
+
+    if (WM_compareTZRestart(timezoneName, pgm_read_word(&WM_TZ_RESTARTS[mid])) < 0)
+      high = mid;
+    else
+      low = mid + 1;
+  }
+
+  if (low == 0)
+    return false;
+
+  // Rebuild the names of that block one by one
+  char     name[WM_TZ_NAME_MAX_LEN + 1];
+  uint16_t offset = pgm_read_word(&WM_TZ_RESTARTS[low - 1]);
+
+  for (uint8_t entry = 0; (entry < WM_TZ_RESTART_INTERVAL) && (offset < sizeof(WM_TZ_NAMES)); entry++)
+  {
+    uint8_t len = pgm_read_byte(&WM_TZ_NAMES[offset++]);
+    uint8_t c;
+
+    while ( !((c = pgm_read_byte(&WM_TZ_NAMES[offset++])) & 0x80) )
+    {
+      name[len++] = c;
+    }
+
+    name[len] = 0;
+
+    int cmp = strcmp(timezoneName, name);
+
+    if (cmp == 0)
+    {
+      strncpy_P(rule, WM_TZ_RULES + pgm_read_word(&WM_TZ_RULE_INDEX[c & 0x7F]), ruleLen - 1);
+      rule[ruleLen - 1] = 0;
+
+      return true;
+    }
+
+    // Names are sorted, it can't be further
+    if (cmp < 0)
+      break;
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////
+
+#endif // TZDB_H
+"""
+
+
+def macro_name(name):
+  return "TZ_" + name.replace("/", "_").replace("-", "m").replace("+", "p")
+
+
+def c_bytes(data, indent="  ", width=16):
+  return "".join(indent + ", ".join("0x%02X" % b for b in data[i:i + width]) + ",\n" for i in range(0, len(data), width))
+
+
+def c_words(data, indent="  ", width=12):
+  return "".join(indent + ", ".join(str(w) for w in data[i:i + width]) + ",\n" for i in range(0, len(data), width))
+
+
+def main():
+  src = sys.argv[1] if len(sys.argv) > 1 else os.path.join(HERE, "zones.csv")
+  dst = sys.argv[2] if len(sys.argv) > 2 else os.path.join(HERE, "..", "..", "src", "utils", "TZ.h")
+
+  with open(src, newline="") as f:
+    zones = [(row[0], row[1]) for row in csv.reader(f) if row]
+
+  names = [name for name, _ in zones]
+
+  if len(set(names)) != len(names):
+    sys.exit("Duplicate timezone names in " + src)
+
+  if any(ord(c) >= 0x80 for name in names for c in name):
+    sys.exit("Timezone names must be ASCII")
+
+  out = [HEADER.format(date=time.strftime("%a %b %d %H:%M:%S UTC %Y", time.gmtime()))]
+
+  out.append("////////////////////////////////////////////////////\n\n")
+
+  for name, rule in zones:
+    out.append("#define {}\t(\"{}\")\n".format(macro_name(name), rule))
+
+  out.append("\n////////////////////////////////////////////////////////////\n\n")
+
+  rules = sorted(set(rule for _, rule in zones), key=lambda r: r.encode())
+
+  if len(rules) > 0x80:
+    sys.exit("Too many distinct rules for a 7-bit rule number")
+
+  ruleNumber  = dict((rule, i) for i, rule in enumerate(rules))
+  ruleIndex   = []
+  rulePool    = ""
+
+  for rule in rules:
+    ruleIndex.append(len(rulePool))
+    rulePool += rule + "\0"
+
+  # Front-coded names
+  blob      = bytearray()
+  restarts  = []
+  previous  = ""
+
+  for i, (name, rule) in enumerate(sorted(zones, key=lambda z: z[0].encode())):
+    shared = 0
+
+    if i % RESTART_INTERVAL == 0:
+      restarts.append(len(blob))
+    else:
+      while (shared < min(len(name), len(previous))) and (name[shared] == previous[shared]):
+        shared += 1
+
+    blob.append(shared)
+    blob += name[shared:].encode()
+    blob.append(0x80 | ruleNumber[rule])
+    previous = name
+
+  if len(blob) > 0xFFFF or len(rulePool) > 0xFFFF:
+    sys.exit("Database too large for 16-bit offsets")
+
+  out.append("#define TIMEZONE_MAX_LEN          50\n\n")
+  out.append("#define WM_TZ_COUNT               {}\n".format(len(zones)))
+  out.append("#define WM_TZ_NAME_MAX_LEN        {}\n".format(max(len(name) for name in names)))
+  out.append("#define WM_TZ_RULE_MAX_LEN        {}\n".format(max(len(rule) for rule in rules)))
+  out.append("#define WM_TZ_RESTART_INTERVAL    {}\n".format(RESTART_INTERVAL))
+  out.append("#define WM_TZ_RESTART_COUNT       {}\n\n".format(len(restarts)))
+
+  out.append("static const uint8_t WM_TZ_NAMES[] PROGMEM =\n{\n" + c_bytes(blob) + "};\n\n")
+  out.append("static const uint16_t WM_TZ_RESTARTS[] PROGMEM =\n{\n" + c_words(restarts) + "};\n\n")
+
+  out.append("static const char WM_TZ_RULES[] PROGMEM =\n")
+
+  for rule in rules:
+    out.append("  \"{}\\0\"\n".format(rule))
+
+  out.append("  ;\n\n")
+  out.append("static const uint16_t WM_TZ_RULE_INDEX[] PROGMEM =\n{\n" + c_words(ruleIndex) + "};\n\n")
+
+  out.append(LOOKUP)
+
+  total = len(blob) + 2 * len(restarts) + len(rulePool) + 1 + 2 * len(ruleIndex)
+  fixed = len(zones) * 2 * 50
+
+  print("{} zones, {} distinct rules".format(len(zones), len(rules)))
+  print("names {} + restarts {} + rules {} + rule index {} = {} bytes (fixed-width [][50] tables : {} bytes)"
+        .format(len(blob), 2 * len(restarts), len(rulePool) + 1, 2 * len(ruleIndex), total, fixed))
+
+  with open(dst, "w") as f:
+    f.write("".join(out))
+
+
+if __name__ == "__main__":
+  main()
@@ -0,0 +1,510 @@
+/****************************************************************************************************************************
+  connect_bench.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  ESP_WiFiManager is a library for the ESP8266/Arduino platform
+  (https://github.com/esp8266/Arduino) to enable easy
+  configuration and reconfiguration of WiFi credentials using a Captive Portal
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Connection strategies against a scenario of simulated access points, on the virtual clock. Every run
+  replays the scenario from power on, seeded with its run number : the same command line gives the same
+  numbers, and any run can be replayed alone. Writes per strategy, as JSON, the share of runs connected,
+  the time to connected (from the radio) and the radio-on time : scanning, or trying to connect.
+
+    connect_bench -s scenario -c ssid:password[,ssid:password] [-n runs] [-f first_run] [-S strategies]
+                  [-b backoff] [-D deadline_s] [-T connect_timeout_s] [-P portal_timeout_s] [-o file] [-R file]
+
+    -c  known credentials, in stored order
+    -n  runs per strategy, default 1000
+    -f  first run, i.e. seed, default 1
+    -S  comma separated, default connect,reconnect,scan,directed
+          connect    connectWifi() with the first credentials
+          reconnect  reconnectWifi() : the first, then the second credentials
+          auto       autoConnect() with the first credentials stored. When it fails, the Config Portal runs
+                     for -P s (default 1), on the HTTP and DNS ports of the build
+          scan       scanWifiNetworks(), then connectWifi() to the known networks seen, strongest first
+          directed   WiFi.begin() with the channel and BSSID of the last network connected to (kept across
+                     runs, as in RTC memory) first, then the others in stored order
+    -b  when a pass fails, until connected or the deadline : none (one pass, default), fixed:<ms>, or
+        exp:<ms>[:<max_ms>], doubling. The station is off in between.
+    -D  deadline of a run, s, default 120. No pass starts after it, a pass started may end later
+    -T  setConnectTimeout(), s. 0 (default) : the core's WiFi.waitForConnectResult()
+    -o  output file, default stdout
+    -R  also one CSV line per run : strategy,run,connected,connect_ms,radio_on_ms,attempts,scans,passes
+ *****************************************************************************************************************************/
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <ESP_WiFiManager.h>
+
+#include "WM_Host.h"
+
+namespace
+{
+  struct Credentials
+  {
+    String  ssid;
+    String  password;
+  };
+
+  struct Options
+  {
+    const char*               scenario        = nullptr;
+    std::vector<Credentials>  credentials;
+    long                      runs            = 1000;
+    long                      firstRun        = 1;
+    std::vector<std::string>  strategies      = { "connect", "reconnect", "scan", "directed" };
+    std::string               backoff         = "none";
+    uint32_t                  backoffMs       = 0;
+    uint32_t                  backoffMaxMs    = 0;
+    bool                      exponential     = false;
+    uint32_t                  deadlineMs      = 120000;
+    unsigned long             connectTimeout  = 0;
+    unsigned long             portalTimeout   = 1;
+    const char*               output          = nullptr;
+    const char*               raw             = nullptr;
+  };
+
+  struct Run
+  {
+    bool      connected;
+    uint64_t  connectMs;
+    uint64_t  radioOnMs;
+    uint32_t  attempts;
+    uint32_t  scans;
+    uint32_t  passes;
+  };
+
+  Options options;
+
+  ////////////////////////////////////////////////////
+
+  std::vector<std::string> split(const std::string& list)
+  {
+    std::vector<std::string> items;
+    size_t                   start = 0;
+
+    while (start <= list.size())
+    {
+      size_t end = list.find(',', start);
+
+      if (end == std::string::npos)
+        end = list.size();
+
+      if (end > start)
+        items.push_back(list.substr(start, end - start));
+
+      start = end + 1;
+    }
+
+    return items;
+  }
+
+  bool parseBackoff(const std::string& backoff)
+  {
+    unsigned long ms = 0, maxMs = 0;
+
+    options.backoff = backoff;
+
+    if (backoff == "none")
+      return true;
+
+    if (sscanf(backoff.c_str(), "fixed:%lu", &ms) == 1)
+    {
+      options.backoffMs     = ms;
+      options.backoffMaxMs  = ms;
+
+      return true;
+    }
+
+    int fields = sscanf(backoff.c_str(), "exp:%lu:%lu", &ms, &maxMs);
+
+    if (fields >= 1)
+    {
+      options.backoffMs     = ms;
+      options.backoffMaxMs  = (fields == 2) ? maxMs : 60000;
+      options.exponential   = true;
+
+      return true;
+    }
+
+    return false;
+  }
+
+  // Nearest rank
+  double percentile(const std::vector<double>& sorted, const double& p)
+  {
+    if (sorted.empty())
+      return 0;
+
+    size_t rank = (size_t) ( (p / 100) * sorted.size() + 0.999999 );
+
+    return sorted[std::min(std::max(rank, (size_t) 1), sorted.size()) - 1];
+  }
+
+  void printDistribution(FILE* out, const char* name, std::vector<double> values)
+  {
+    double sum = 0;
+
+    std::sort(values.begin(), values.end());
+
+    for (double value : values)
+      sum += value;
+
+    fprintf(out, "\"%s\": {\"mean\": %.1f, \"p50\": %.0f, \"p90\": %.0f, \"p99\": %.0f, \"max\": %.0f}", name,
+            values.empty() ? 0 : sum / values.size(), percentile(values, 50), percentile(values, 90),
+            percentile(values, 99), values.empty() ? 0 : values.back());
+  }
+}
+
+////////////////////////////////////////////////////
+
+// The strategies, friend of ESP_WiFiManager for connectWifi() and reconnectWifi()
+class WM_HostConnectBench
+{
+  public:
+
+    // One pass of the strategy. The radio keeps its state between passes of a run.
+    static void pass(ESP_WiFiManager& wm, const std::string& strategy)
+    {
+      const std::vector<Credentials>& known = options.credentials;
+
+      if (strategy == "connect")
+      {
+        wm.connectWifi(known[0].ssid, known[0].password);
+      }
+      else if (strategy == "reconnect")
+      {
+        const Credentials& second = (known.size() > 1) ? known[1] : known[0];
+
+        wm.setCredentials(known[0].ssid.c_str(), known[0].password.c_str(), second.ssid.c_str(),
+                          second.password.c_str());
+        wm.reconnectWifi();
+      }
+      else if (strategy == "auto")
+      {
+        WM_HostRadio::get().storedSSID      = known[0].ssid.c_str();
+        WM_HostRadio::get().storedPassword  = known[0].password.c_str();
+
+        wm.setConfigPortalTimeout(options.portalTimeout);
+        wm.autoConnect("ESP_Bench", nullptr);
+      }
+      else if (strategy == "scan")
+      {
+        int*  indices = nullptr;
+        int   n       = wm.scanWifiNetworks(&indices);
+
+        // Strongest first, dropped ones are -1
+        for (int i = 0; (i < n) && (WiFi.status() != WL_CONNECTED); i++)
+        {
+          if (indices[i] < 0)
+            continue;
+
+          for (const auto& credentials : known)
+          {
+            if (credentials.ssid == WiFi.SSID(indices[i]))
+            {
+              wm.connectWifi(credentials.ssid, credentials.password);
+              break;
+            }
+          }
+        }
+
+        free(indices);
+      }
+      else if (strategy == "directed")
+      {
+        directed(wm);
+      }
+    }
+
+    // RTC memory of the directed strategy
+    static String   lastSSID;
+    static int32_t  lastChannel;
+    static uint8_t  lastBSSID[6];
+
+  private:
+
+    static void directed(ESP_WiFiManager& wm)
+    {
+      std::vector<const Credentials*> order;
+
+      for (const auto& credentials : options.credentials)
+      {
+        if (credentials.ssid == lastSSID)
+          order.insert(order.begin(), &credentials);
+        else
+          order.push_back(&credentials);
+      }
+
+      WiFi.mode(WIFI_STA);
+
+      for (const Credentials* credentials : order)
+      {
+        bool known = (credentials->ssid == lastSSID) && lastChannel;
+
+        if (known)
+          WiFi.begin(credentials->ssid.c_str(), credentials->password.c_str(), lastChannel, lastBSSID);
+        else
+          WiFi.begin(credentials->ssid.c_str(), credentials->password.c_str());
+
+        if (wm.waitForConnectResult() == WL_CONNECTED)
+          break;
+
+        // Moved, or gone : look for it everywhere next time
+        if (known)
+          lastChannel = 0;
+      }
+    }
+};
+
+String   WM_HostConnectBench::lastSSID;
+int32_t  WM_HostConnectBench::lastChannel = 0;
+uint8_t  WM_HostConnectBench::lastBSSID[6];
+
+////////////////////////////////////////////////////
+
+namespace
+{
+  Run runOnce(const std::string& strategy, const long& seed)
+  {
+    WM_HostRadio& radio = WM_HostRadio::get();
+    Run           run;
+
+    WiFi.mode(WIFI_OFF);
+    WM_Host::powerOn();
+    radio.replay(seed);
+
+    ESP_WiFiManager wm("HostBench");
+
+    if (options.connectTimeout)
+      wm.setConnectTimeout(options.connectTimeout);
+
+    uint32_t backoff = options.backoffMs;
+
+    run.passes = 0;
+
+    while (true)
+    {
+      run.passes++;
+
+      WM_HostConnectBench::pass(wm, strategy);
+
+      if ( (WiFi.status() == WL_CONNECTED) || (options.backoff == "none") || (millis() >= options.deadlineMs) )
+        break;
+
+      WiFi.disconnect();
+      delay(std::min(backoff, (uint32_t) (options.deadlineMs - millis())));
+
+      if (options.exponential)
+        backoff = std::min(backoff * 2, options.backoffMaxMs);
+    }
+
+    WM_HostRadioStats stats = radio.stats();
+
+    run.connected = (stats.connectedMs != 0);
+    run.connectMs = stats.connectedMs;
+    run.radioOnMs = stats.radioOnMs;
+    run.attempts  = stats.attempts;
+    run.scans     = stats.scans;
+
+    if (strategy == "directed")
+    {
+      if (WiFi.status() == WL_CONNECTED)
+      {
+        WM_HostConnectBench::lastSSID     = WiFi.SSID();
+        WM_HostConnectBench::lastChannel  = WiFi.channel();
+        WiFi.BSSID(WM_HostConnectBench::lastBSSID);
+      }
+    }
+
+    return run;
+  }
+}
+
+////////////////////////////////////////////////////
+
+int main(int argc, char* argv[])
+{
+  int opt;
+
+  while ( (opt = getopt(argc, argv, "s:c:n:f:S:b:D:T:P:o:R:")) != -1 )
+  {
+    switch (opt)
+    {
+      case 's':
+        options.scenario = optarg;
+        break;
+
+      case 'c':
+        for (const auto& item : split(optarg))
+        {
+          size_t colon = item.find(':');
+
+          options.credentials.push_back({ String(item.substr(0, colon).c_str()),
+                                          String( (colon == std::string::npos) ? "" : item.substr(colon + 1).c_str()) });
+        }
+
+        break;
+
+      case 'n':
+        options.runs = std::max(1L, atol(optarg));
+        break;
+
+      case 'f':
+        options.firstRun = atol(optarg);
+        break;
+
+      case 'S':
+        options.strategies = split(optarg);
+        break;
+
+      case 'b':
+        if (!parseBackoff(optarg))
+        {
+          fprintf(stderr, "bad backoff %s\n", optarg);
+          return 2;
+        }
+
+        break;
+
+      case 'D':
+        options.deadlineMs = strtoul(optarg, nullptr, 10) * 1000;
+        break;
+
+      case 'T':
+        options.connectTimeout = strtoul(optarg, nullptr, 10);
+        break;
+
+      case 'P':
+        options.portalTimeout = std::max(1UL, strtoul(optarg, nullptr, 10));
+        break;
+
+      case 'o':
+        options.output = optarg;
+        break;
+
+      case 'R':
+        options.raw = optarg;
+        break;
+
+      default:
+        options.scenario = nullptr;
+        break;
+    }
+  }
+
+  if (!options.scenario || options.credentials.empty())
+  {
+    fprintf(stderr, "usage: %s -s scenario -c ssid:password[,ssid:password] [-n runs] [-f first_run] [-S strategies] "
+            "[-b none|fixed:ms|exp:ms[:max_ms]] [-D deadline_s] [-T connect_timeout_s] [-P portal_timeout_s] "
+            "[-o file] [-R file]\n", argv[0]);
+    return 2;
+  }
+
+  for (const auto& strategy : options.strategies)
+  {
+    static const char* known[] = { "connect", "reconnect", "auto", "scan", "directed" };
+
+    if (std::find_if(std::begin(known), std::end(known), [&](const char* name)
+    {
+      return strategy == name;
+    }) == std::end(known))
+    {
+      fprintf(stderr, "unknown strategy %s\n", strategy.c_str());
+      return 2;
+    }
+  }
+
+  WM_Host::setVirtualClock(true);
+
+  WM_HostRadio& radio = WM_HostRadio::get();
+
+  if (!radio.loadScenario(options.scenario))
+  {
+    fprintf(stderr, "%s\n", radio.error().c_str());
+    return 2;
+  }
+
+  // The library's logs would be most of the time
+  WM_setLogLevel(WM_LOG_MODULES, 0);
+
+  FILE* out = options.output ? fopen(options.output, "w") : stdout;
+  FILE* raw = options.raw ? fopen(options.raw, "w") : nullptr;
+
+  if (!out || (options.raw && !raw))
+  {
+    perror(out ? options.raw : options.output);
+    return 2;
+  }
+
+  if (raw)
+    fprintf(raw, "strategy,run,connected,connect_ms,radio_on_ms,attempts,scans,passes\n");
+
+  fprintf(out, "{\n  \"scenario\": \"%s\",\n  \"runs\": %ld,\n  \"first_run\": %ld,\n  \"backoff\": \"%s\",\n"
+          "  \"deadline_s\": %u,\n  \"connect_timeout_s\": %lu,\n  \"credentials\": [", options.scenario, options.runs,
+          options.firstRun, options.backoff.c_str(), options.deadlineMs / 1000, options.connectTimeout);
+
+  for (size_t i = 0; i < options.credentials.size(); i++)
+    fprintf(out, "%s\"%s\"", i ? ", " : "", options.credentials[i].ssid.c_str());
+
+  fprintf(out, "],\n  \"strategies\": [\n");
+
+  for (size_t s = 0; s < options.strategies.size(); s++)
+  {
+    const std::string&  strategy  = options.strategies[s];
+    std::vector<double> connectMs, radioOnMs;
+    double              attempts  = 0, scans = 0, passes = 0;
+    auto                start     = std::chrono::steady_clock::now();
+
+    WM_HostConnectBench::lastSSID     = "";
+    WM_HostConnectBench::lastChannel  = 0;
+
+    for (long i = 0; i < options.runs; i++)
+    {
+      Run run = runOnce(strategy, options.firstRun + i);
+
+      if (run.connected)
+        connectMs.push_back(run.connectMs);
+
+      radioOnMs.push_back(run.radioOnMs);
+      attempts  += run.attempts;
+      scans     += run.scans;
+      passes    += run.passes;
+
+      if (raw)
+        fprintf(raw, "%s,%ld,%d,%llu,%llu,%u,%u,%u\n", strategy.c_str(), options.firstRun + i, run.connected,
+                (unsigned long long) run.connectMs, (unsigned long long) run.radioOnMs, run.attempts, run.scans,
+                run.passes);
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    fprintf(out, "    {\"strategy\": \"%s\", \"connected\": %zu, \"connected_pct\": %.1f,\n     ", strategy.c_str(),
+            connectMs.size(), 100.0 * connectMs.size() / options.runs);
+    printDistribution(out, "connect_ms", connectMs);
+    fprintf(out, ",\n     ");
+    printDistribution(out, "radio_on_ms", radioOnMs);
+    fprintf(out, ",\n     \"attempts\": %.2f, \"scans\": %.2f, \"passes\": %.2f, \"runs_per_s\": %.0f}%s\n",
+            attempts / options.runs, scans / options.runs, passes / options.runs, options.runs / seconds,
+            (s + 1 < options.strategies.size()) ? "," : "");
+  }
+
+  fprintf(out, "  ]\n}\n");
+
+  if (out != stdout)
+    fclose(out);
+
+  if (raw)
+    fclose(raw);
+
+  return 0;
+}
@@ -0,0 +1,555 @@
+/****************************************************************************************************************************
+  portal_bench.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  ESP_WiFiManager is a library for the ESP8266/Arduino platform
+  (https://github.com/esp8266/Arduino) to enable easy
+  configuration and reconfiguration of WiFi credentials using a Captive Portal
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Load generator for the Config Portal, against host_portal or a board on the LAN. Each route is driven in
+  turn by N concurrent clients, one request per connection as browsers do with the portal, and the results
+  are written as JSON : throughput, latency percentiles, bytes per response and status codes per route, and
+  the route's lowest free heap when the portal has USE_WM_METRICS.
+
+    portal_bench [-t host[:port]] [-c clients] [-d seconds] [-n requests] [-r routes] [-B route]
+                 [-w wifisave_body] [-o file]
+
+    -t  portal, default 127.0.0.1:8080. A board : 192.168.4.1
+    -c  concurrent clients, default 4
+    -d  seconds per route, default 5
+    -n  requests per route, instead of -d
+    -r  comma separated paths, default /,/wifi,/scan,/state,/i,probes
+        probes : the OS connectivity probes in turn. /wifisave POSTs -w, which makes the portal
+        erase its credentials and try to connect : only add it on purpose.
+    -B  route requested in a loop by one more client during each run, e.g. /scan to measure
+        latency while the device scans. Not in the results.
+    -w  /wifisave form, default s=wm-bench&p=wm-bench-pass (an SSID that isn't there)
+    -o  output file, default stdout
+
+  The portal is built without rate limiting by default. Built with it (-DWM_HOST_RATE_LIMIT=ON, USE_WM_RATE_LIMIT
+  on a board), most requests get 429 : the results are written anyway, but the exit code is 1 when most responses
+  of a route aren't 2xx / 3xx, so a run that measured 429s isn't taken for a benchmark.
+ *****************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define BENCH_TIMEOUT_MS      30000
+
+namespace
+{
+  const char* PROBES[] =
+  {
+    "/generate_204", "/gen_204", "/hotspot-detect.html", "/library/test/success.html",
+    "/connecttest.txt", "/ncsi.txt", "/redirect", "/fwlink", "/success.txt", "/canonical.html"
+  };
+
+  // Route names of the portal's /metrics
+  const struct
+  {
+    const char* path;
+    const char* metric;
+  } METRIC_ROUTES[] =
+  {
+    { "/",          "root" },
+    { "/wifi",      "wifi" },
+    { "/wifisave",  "wifisave" },
+    { "/close",     "close" },
+    { "/i",         "info" },
+    { "/r",         "reset" },
+    { "/state",     "state" },
+    { "/scan",      "scan" },
+    { "/loglevel",  "loglevel" },
+    { "/metrics",   "metrics" },
+    { "probes",     "probe" },
+  };
+
+  struct Options
+  {
+    std::string               host          = "127.0.0.1";
+    std::string               port          = "8080";
+    int                       clients       = 4;
+    double                    seconds       = 5;
+    long                      requests      = 0;
+    std::vector<std::string>  routes        = { "/", "/wifi", "/scan", "/state", "/i", "probes" };
+    std::string               background;
+    std::string               wifisaveBody  = "s=wm-bench&p=wm-bench-pass";
+    const char*               output        = nullptr;
+  };
+
+  struct Response
+  {
+    int     status  = 0;        // 0 : connection or protocol error
+    size_t  bytes   = 0;        // body, as received
+    double  ms      = 0;
+    std::string body;
+  };
+
+  struct RouteResult
+  {
+    std::string         route;
+    std::vector<double> latencies;
+    std::map<int, long> statuses;
+    long                errors  = 0;
+    size_t              bytes   = 0;
+    double              elapsed = 0;
+    long                backgroundRequests = 0;
+  };
+
+  Options         options;
+  struct addrinfo* target = nullptr;
+
+  ////////////////////////////////////////////////////
+
+  double nowMs()
+  {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  // One request on its own connection, read until the server closes it
+  Response request(const std::string& path, bool keepBody = false)
+  {
+    Response    response;
+    double      start = nowMs();
+    std::string req;
+    bool        post  = (path == "/wifisave");
+
+    req  = std::string(post ? "POST " : "GET ") + path + " HTTP/1.1\r\n";
+    req += "Host: " + options.host + "\r\nUser-Agent: portal_bench\r\nConnection: close\r\n";
+
+    if (post)
+    {
+      req += "Content-Type: application/x-www-form-urlencoded\r\nContent-Length: ";
+      req += std::to_string(options.wifisaveBody.size()) + "\r\n\r\n" + options.wifisaveBody;
+    }
+    else
+    {
+      req += "\r\n";
+    }
+
+    int fd = socket(target->ai_family, SOCK_STREAM, 0);
+
+    if (fd < 0)
+      return response;
+
+    struct timeval tv = { BENCH_TIMEOUT_MS / 1000, 0 };
+    int            one = 1;
+
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    if ( (connect(fd, target->ai_addr, target->ai_addrlen) < 0) ||
+         (send(fd, req.data(), req.size(), MSG_NOSIGNAL) != (ssize_t) req.size()) )
+    {
+      close(fd);
+
+      return response;
+    }
+
+    std::string data;
+    char        buf[4096];
+    ssize_t     len;
+
+    while ( (len = recv(fd, buf, sizeof(buf), 0)) > 0 )
+      data.append(buf, len);
+
+    close(fd);
+
+    size_t headEnd = data.find("\r\n\r\n");
+
+    // Timed out, or not HTTP
+    if ( (len < 0) || (headEnd == std::string::npos) || (data.compare(0, 5, "HTTP/") != 0) )
+      return response;
+
+    response.status = atoi(data.c_str() + data.find(' ') + 1);
+    response.bytes  = data.size() - headEnd - 4;
+    response.ms     = nowMs() - start;
+
+    if (keepBody)
+      response.body = data.substr(headEnd + 4);
+
+    return response;
+  }
+
+  ////////////////////////////////////////////////////
+
+  RouteResult run(const std::string& route)
+  {
+    RouteResult       result;
+    std::mutex        lock;
+    std::atomic<long> issued(0);
+    std::atomic<bool> done(false);
+    double            start     = nowMs();
+    double            deadline  = start + options.seconds * 1000;
+
+    result.route = route;
+
+    auto client = [&](int index)
+    {
+      std::vector<double> latencies;
+      std::map<int, long> statuses;
+      long                errors  = 0;
+      size_t              bytes   = 0;
+      long                probe   = index;
+
+      while (true)
+      {
+        if (options.requests ? (issued++ >= options.requests) : (nowMs() >= deadline))
+          break;
+
+        std::string path = (route == "probes") ? PROBES[probe++ % (sizeof(PROBES) / sizeof(PROBES[0]))] : route;
+        Response    response = request(path);
+
+        if (response.status == 0)
+        {
+          errors++;
+          continue;
+        }
+
+        latencies.push_back(response.ms);
+        statuses[response.status]++;
+        bytes += response.bytes;
+      }
+
+      std::lock_guard<std::mutex> guard(lock);
+
+      result.latencies.insert(result.latencies.end(), latencies.begin(), latencies.end());
+      result.errors += errors;
+      result.bytes  += bytes;
+
+      for (const auto& status : statuses)
+        result.statuses[status.first] += status.second;
+    };
+
+    std::thread background;
+
+    if (!options.background.empty())
+    {
+      background = std::thread([&]()
+      {
+        while (!done)
+        {
+          request(options.background);
+          result.backgroundRequests++;
+        }
+      });
+    }
+
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < options.clients; i++)
+      threads.emplace_back(client, i);
+
+    for (auto& thread : threads)
+      thread.join();
+
+    result.elapsed = (nowMs() - start) / 1000;
+
+    done = true;
+
+    if (background.joinable())
+      background.join();
+
+    std::sort(result.latencies.begin(), result.latencies.end());
+
+    return result;
+  }
+
+  // Nearest rank
+  double percentile(const std::vector<double>& sorted, const double& p)
+  {
+    if (sorted.empty())
+      return 0;
+
+    size_t rank = (size_t) ( (p / 100) * sorted.size() + 0.999999 );
+
+    return sorted[std::min(std::max(rank, (size_t) 1), sorted.size()) - 1];
+  }
+
+  ////////////////////////////////////////////////////
+
+  // Value of "key": in the object starting at from, or -1
+  long long jsonNumber(const std::string& json, size_t from, const char* key)
+  {
+    std::string pattern = std::string("\"") + key + "\":";
+    size_t      pos     = json.find(pattern, from);
+    size_t      end     = json.find('}', from);
+
+    if ( (pos == std::string::npos) || (pos > end) )
+      return -1;
+
+    return atoll(json.c_str() + pos + pattern.size());
+  }
+
+  const char* metricName(const std::string& route)
+  {
+    for (const auto& metric : METRIC_ROUTES)
+    {
+      if (route == metric.path)
+        return metric.metric;
+    }
+
+    return nullptr;
+  }
+
+  void printNumberOrNull(FILE* out, const long long& value)
+  {
+    if (value < 0)
+      fprintf(out, "null");
+    else
+      fprintf(out, "%lld", value);
+  }
+
+  void report(FILE* out, const std::vector<RouteResult>& results, const std::string& metrics)
+  {
+    fprintf(out, "{\n  \"target\": \"%s:%s\",\n  \"clients\": %d,\n", options.host.c_str(), options.port.c_str(),
+            options.clients);
+
+    if (options.requests)
+      fprintf(out, "  \"requests_per_route\": %ld,\n", options.requests);
+    else
+      fprintf(out, "  \"seconds_per_route\": %g,\n", options.seconds);
+
+    if (options.background.empty())
+      fprintf(out, "  \"background\": null,\n");
+    else
+      fprintf(out, "  \"background\": \"%s\",\n", options.background.c_str());
+
+    fprintf(out, "  \"routes\": [\n");
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+      const RouteResult& result = results[i];
+      const auto&        l      = result.latencies;
+      size_t             n      = l.size();
+      double             sum    = 0;
+
+      for (double ms : l)
+        sum += ms;
+
+      fprintf(out, "    {\"route\": \"%s\", \"requests\": %zu, \"errors\": %ld, \"rps\": %.1f,\n", result.route.c_str(), n,
+              result.errors, result.elapsed > 0 ? n / result.elapsed : 0);
+      fprintf(out, "     \"latency_ms\": {\"mean\": %.3f, \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f},\n",
+              n ? sum / n : 0, percentile(l, 50), percentile(l, 95), percentile(l, 99), n ? l.back() : 0);
+      fprintf(out, "     \"bytes_per_response\": %.0f, \"status\": {", n ? (double) result.bytes / n : 0);
+
+      bool first = true;
+
+      for (const auto& status : result.statuses)
+      {
+        fprintf(out, "%s\"%d\": %ld", first ? "" : ", ", status.first, status.second);
+        first = false;
+      }
+
+      fprintf(out, "},\n     \"min_free_heap\": ");
+
+      // From the portal's own metrics, per route
+      const char* name  = metricName(result.route);
+      size_t      pos   = std::string::npos;
+
+      if (name && !metrics.empty())
+        pos = metrics.find(std::string("\"") + name + "\":{", metrics.find("\"routes\":"));
+
+      printNumberOrNull(out, (pos == std::string::npos) ? -1 : jsonNumber(metrics, pos + 1, "minFree"));
+
+      if (!options.background.empty())
+        fprintf(out, ", \"background_requests\": %ld", result.backgroundRequests);
+
+      fprintf(out, "}%s\n", (i + 1 < results.size()) ? "," : "");
+    }
+
+    fprintf(out, "  ],\n  \"heap\": ");
+
+    size_t heap = metrics.empty() ? std::string::npos : metrics.find("\"heap\":{");
+
+    if (heap == std::string::npos)
+    {
+      fprintf(out, "null\n");
+    }
+    else
+    {
+      fprintf(out, "{\"free\": ");
+      printNumberOrNull(out, jsonNumber(metrics, heap + 1, "free"));
+      fprintf(out, ", \"max_block\": ");
+      printNumberOrNull(out, jsonNumber(metrics, heap + 1, "maxBlock"));
+      fprintf(out, ", \"min_free\": ");
+      printNumberOrNull(out, jsonNumber(metrics, heap + 1, "minFree"));
+      fprintf(out, "}\n");
+    }
+
+    fprintf(out, "}\n");
+  }
+
+  // Responses that aren't 2xx / 3xx, connection errors included
+  long rejected(const RouteResult& result)
+  {
+    long count = result.errors;
+
+    for (const auto& status : result.statuses)
+    {
+      if ( (status.first < 200) || (status.first >= 400) )
+        count += status.second;
+    }
+
+    return count;
+  }
+
+  std::vector<std::string> split(const std::string& list)
+  {
+    std::vector<std::string> items;
+    size_t                   start = 0;
+
+    while (start <= list.size())
+    {
+      size_t end = list.find(',', start);
+
+      if (end == std::string::npos)
+        end = list.size();
+
+      if (end > start)
+        items.push_back(list.substr(start, end - start));
+
+      start = end + 1;
+    }
+
+    return items;
+  }
+}
+
+////////////////////////////////////////////////////
+
+int main(int argc, char* argv[])
+{
+  int opt;
+
+  while ( (opt = getopt(argc, argv, "t:c:d:n:r:B:w:o:")) != -1 )
+  {
+    switch (opt)
+    {
+      case 't':
+      {
+        std::string t = optarg;
+        size_t      colon = t.rfind(':');
+
+        options.host = t.substr(0, colon);
+        options.port = (colon == std::string::npos) ? "80" : t.substr(colon + 1);
+
+        break;
+      }
+
+      case 'c':
+        options.clients = std::max(1, atoi(optarg));
+        break;
+
+      case 'd':
+        options.seconds = atof(optarg);
+        break;
+
+      case 'n':
+        options.requests = atol(optarg);
+        break;
+
+      case 'r':
+        options.routes = split(optarg);
+        break;
+
+      case 'B':
+        options.background = optarg;
+        break;
+
+      case 'w':
+        options.wifisaveBody = optarg;
+        break;
+
+      case 'o':
+        options.output = optarg;
+        break;
+
+      default:
+        fprintf(stderr, "usage: %s [-t host[:port]] [-c clients] [-d seconds] [-n requests] [-r routes] [-B route] "
+                "[-w wifisave_body] [-o file]\n", argv[0]);
+        return 2;
+    }
+  }
+
+  struct addrinfo hints;
+
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family   = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+
+  if (getaddrinfo(options.host.c_str(), options.port.c_str(), &hints, &target) != 0)
+  {
+    fprintf(stderr, "can't resolve %s\n", options.host.c_str());
+    return 2;
+  }
+
+  if (request("/state").status == 0)
+  {
+    fprintf(stderr, "no portal at %s:%s\n", options.host.c_str(), options.port.c_str());
+    return 1;
+  }
+
+  std::vector<RouteResult> results;
+
+  for (const auto& route : options.routes)
+  {
+    fprintf(stderr, "%s ...\n", route.c_str());
+    results.push_back(run(route));
+  }
+
+  Response    metrics = request("/metrics?format=json", true);
+  FILE*       out     = options.output ? fopen(options.output, "w") : stdout;
+
+  if (!out)
+  {
+    perror(options.output);
+    return 2;
+  }
+
+  report(out, results, (metrics.status == 200) ? metrics.body : std::string());
+
+  if (out != stdout)
+    fclose(out);
+
+  freeaddrinfo(target);
+
+  bool measured = true;
+
+  for (const auto& result : results)
+  {
+    long total = (long) result.latencies.size() + result.errors;
+    long bad   = rejected(result);
+
+    if (2 * bad > total)
+    {
+      long limited = result.statuses.count(429) ? result.statuses.at(429) : 0;
+
+      fprintf(stderr, "%s : %ld of %ld responses not 2xx / 3xx, %ld of them 429%s\n", result.route.c_str(), bad, total,
+              limited, limited ? " : build the portal without USE_WM_RATE_LIMIT, -DWM_HOST_RATE_LIMIT=OFF" : "");
+      measured = false;
+    }
+  }
+
+  return measured ? 0 : 1;
+}
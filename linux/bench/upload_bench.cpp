@@ -0,0 +1,281 @@
+/****************************************************************************************************************************
+  upload_bench.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Upload throughput of the patched ESP32 WebServer of esp32s2_WebServer_Patch. As the fuzz_multipart target
+  does, a multipart/form-data POST to /upload goes over a loopback socket, its head is peeked until complete,
+  then the multipart parser hands the file to the upload handler in HTTP_UPLOAD_BUFLEN blocks. The handler
+  only hashes them, so what is measured is the network read and the parser, as a flash write would follow.
+  Writes as JSON the throughput per run (mean / p50 / min / max), the blocks per upload and how many were
+  whole blocks, and whether every upload arrived byte-identical.
+
+    upload_bench [-s size] [-n runs] [-o file]
+
+    -s  file size, bytes, default 1048576 (1 MB)
+    -n  uploads, default 20
+    -o  output file, default stdout
+
+  Exits with 1 when an upload didn't arrive whole.
+ *****************************************************************************************************************************/
+
+#include <unistd.h>
+
+#include <WebServer.h>
+#include <lwip/sockets.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define UPLOAD_BOUNDARY       "----WMUploadBench7MA4YWxkTrZu0gW"
+
+namespace
+{
+  // FNV-1a, over the bytes in order
+  uint64_t fnv1a(uint64_t hash, const uint8_t* data, const size_t& len)
+  {
+    for (size_t i = 0; i < len; i++)
+      hash = (hash ^ data[i]) * 0x100000001b3ULL;
+
+    return hash;
+  }
+
+  const uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+
+  double nowMs()
+  {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+}
+
+class BenchWebServer : public WebServer
+{
+  public:
+
+    uint64_t  hash        = FNV_OFFSET;
+    size_t    uploaded    = 0;
+    size_t    blocks      = 0;
+    size_t    wholeBlocks = 0;
+    bool      ended       = false;
+
+    BenchWebServer() : WebServer(IPAddress(127, 0, 0, 1), 0)
+    {
+      on("/upload", HTTP_POST, [this]()
+      {
+        send(200, "text/plain", String((unsigned long) uploaded));
+      }, [this]()
+      {
+        HTTPUpload& upload = WebServer::upload();
+
+        switch (upload.status)
+        {
+          case UPLOAD_FILE_START:
+            hash        = FNV_OFFSET;
+            uploaded    = 0;
+            blocks      = 0;
+            wholeBlocks = 0;
+            ended       = false;
+            break;
+
+          case UPLOAD_FILE_WRITE:
+            hash      = fnv1a(hash, upload.buf, upload.currentSize);
+            uploaded += upload.currentSize;
+            blocks++;
+
+            if (upload.currentSize == HTTP_UPLOAD_BUFLEN)
+              wholeBlocks++;
+
+            break;
+
+          case UPLOAD_FILE_END:
+            ended = true;
+            break;
+
+          default:
+            break;
+        }
+      });
+    }
+
+    uint16_t port()
+    {
+      struct sockaddr_in addr;
+      socklen_t          len = sizeof(addr);
+
+      getsockname(_server.fd(), (struct sockaddr*) &addr, &len);
+
+      return ntohs(addr.sin_port);
+    }
+};
+
+////////////////////////////////////////////////////
+
+// Sends the whole request, then reads the response until the server closes
+static std::string upload(const uint16_t& port, const std::string& request)
+{
+  int                fd = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in addr;
+  std::string        response;
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family      = AF_INET;
+  addr.sin_port        = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  if (::connect(fd, (struct sockaddr*) &addr, sizeof(addr)) == 0)
+  {
+    size_t sent = 0;
+
+    while (sent < request.size())
+    {
+      ssize_t len = ::send(fd, request.data() + sent, request.size() - sent, MSG_NOSIGNAL);
+
+      if (len <= 0)
+        break;
+
+      sent += len;
+    }
+
+    char    buf[1024];
+    ssize_t len;
+
+    while ( (len = recv(fd, buf, sizeof(buf), 0)) > 0 )
+      response.append(buf, len);
+  }
+
+  ::close(fd);
+
+  return response;
+}
+
+int main(int argc, char* argv[])
+{
+  size_t      size    = 1024 * 1024;
+  int         runs    = 20;
+  const char* outFile = nullptr;
+  int         opt;
+
+  while ( (opt = getopt(argc, argv, "s:n:o:")) != -1 )
+  {
+    switch (opt)
+    {
+      case 's':
+        size = strtoul(optarg, nullptr, 10);
+        break;
+
+      case 'n':
+        runs = atoi(optarg);
+        break;
+
+      case 'o':
+        outFile = optarg;
+        break;
+
+      default:
+        fprintf(stderr, "usage: %s [-s size] [-n runs] [-o file]\n", argv[0]);
+        return 2;
+    }
+  }
+
+  if (runs < 1)
+  {
+    fprintf(stderr, "-n : at least 1 run\n");
+    return 2;
+  }
+
+  // Any byte value, boundary-like runs of '-' and CRLFs included
+  std::string file(size, '\0');
+  uint32_t    seed = 1;
+
+  for (size_t i = 0; i < size; i++)
+  {
+    seed    = seed * 1103515245 + 12345;
+    file[i] = (char) (seed >> 16);
+  }
+
+  uint64_t    fileHash = fnv1a(FNV_OFFSET, (const uint8_t*) file.data(), file.size());
+  std::string body     = "--" UPLOAD_BOUNDARY "\r\nContent-Disposition: form-data; name=\"file\"; filename=\"bench.bin\"\r\n"
+                         "Content-Type: application/octet-stream\r\n\r\n" + file + "\r\n--" UPLOAD_BOUNDARY "--\r\n";
+  std::string request  = "POST /upload HTTP/1.1\r\nHost: 192.168.4.1\r\nContent-Type: multipart/form-data; boundary="
+                         UPLOAD_BOUNDARY "\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+
+  BenchWebServer server;
+
+  server.begin();
+
+  std::vector<double> mbPerSec;
+  size_t              blocks      = 0;
+  size_t              wholeBlocks = 0;
+  bool                identical   = true;
+
+  for (int run = 0; run < runs; run++)
+  {
+    std::string       response;
+    std::atomic<bool> done(false);
+    double            start = nowMs();
+
+    std::thread client([&]()
+    {
+      response = upload(server.port(), request);
+      done     = true;
+    });
+
+    while (!done)
+    {
+      server.waitForActivity(10);
+      server.handleClient();
+    }
+
+    client.join();
+
+    double elapsed = nowMs() - start;
+
+    mbPerSec.push_back( (size / (1024.0 * 1024.0)) / (elapsed / 1000.0) );
+
+    blocks      = server.blocks;
+    wholeBlocks = server.wholeBlocks;
+
+    if ( !server.ended || (server.uploaded != size) || (server.hash != fileHash)
+         || (response.compare(0, 15, "HTTP/1.1 200 OK") != 0) )
+    {
+      fprintf(stderr, "run %d : %zu of %zu bytes, %s, %.15s\n", run, server.uploaded, size,
+              (server.hash == fileHash) ? "same hash" : "different hash", response.c_str());
+      identical = false;
+    }
+  }
+
+  server.stop();
+
+  std::vector<double> sorted = mbPerSec;
+  double              sum    = 0;
+
+  std::sort(sorted.begin(), sorted.end());
+
+  for (double value : sorted)
+    sum += value;
+
+  FILE* out = outFile ? fopen(outFile, "w") : stdout;
+
+  if (out == nullptr)
+  {
+    perror(outFile);
+    return 2;
+  }
+
+  fprintf(out, "{\n  \"file_bytes\": %zu,\n  \"runs\": %d,\n  \"upload_buflen\": %d,\n", size, runs, HTTP_UPLOAD_BUFLEN);
+  fprintf(out, "  \"mb_per_s\": {\"mean\": %.1f, \"p50\": %.1f, \"min\": %.1f, \"max\": %.1f},\n", sum / runs,
+          sorted[runs / 2], sorted.front(), sorted.back());
+  fprintf(out, "  \"blocks_per_upload\": %zu,\n  \"whole_blocks\": %zu,\n  \"identical\": %s\n}\n", blocks, wholeBlocks,
+          identical ? "true" : "false");
+
+  if (outFile)
+    fclose(out);
+
+  return identical ? 0 : 1;
+}
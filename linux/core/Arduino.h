@@ -0,0 +1,196 @@
+/****************************************************************************************************************************
+  Arduino.h
+  For the Linux host build of ESP_WiFiManager
+
+  ESP_WiFiManager is a library for the ESP8266/Arduino platform
+  (https://github.com/esp8266/Arduino) to enable easy
+  configuration and reconfiguration of WiFi credentials using a Captive Portal
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  The part of the Arduino ESP32 core API used by the library, on POSIX. The host build defines ESP32 and
+  WM_HOST, so the library takes its ESP32 code paths. Time comes from WM_HostClock (real or virtual),
+  the radio from WM_HostRadio, HTTP and DNS use real sockets. See WM_Host.h
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <ctype.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include <algorithm>
+
+#include "pgmspace.h"
+#include "esp_system.h"
+
+// As the ESP32 core
+using std::min;
+using std::max;
+
+typedef bool      boolean;
+typedef uint8_t   byte;
+
+#define HEX       16
+#define DEC       10
+#define OCT       8
+#define BIN       2
+
+#define ARDUINO                     10819
+#define ARDUINO_BOARD               "HOST"
+
+#define ESP_ARDUINO_VERSION_MAJOR   2
+#define ESP_ARDUINO_VERSION_MINOR   0
+#define ESP_ARDUINO_VERSION_PATCH   17
+
+////////////////////////////////////////////////////
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+// The device wall clock, see WM_Host::wallClock(). Never the host system clock.
+int    WM_Host_gettimeofday(struct timeval* tv, void* tz);
+int    WM_Host_settimeofday(const struct timeval* tv, const void* tz);
+time_t WM_Host_time(time_t* t);
+
+#define gettimeofday(tv, tz)        WM_Host_gettimeofday(tv, tz)
+#define settimeofday(tv, tz)        WM_Host_settimeofday(tv, tz)
+#define time(t)                     WM_Host_time(t)
+
+////////////////////////////////////////////////////
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "IPAddress.h"
+
+////////////////////////////////////////////////////
+
+// stdin / stdout
+class HardwareSerial : public Stream
+{
+  public:
+
+    void begin(unsigned long baud)
+    {
+      (void) baud;
+    }
+
+    void end() {}
+
+    operator bool() const
+    {
+      return true;
+    }
+
+    int available() override;
+    int read() override;
+    int peek() override;
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+
+    using Print::write;
+
+    void flush() override;
+
+  private:
+
+    int _peeked = -1;
+};
+
+extern HardwareSerial Serial;
+
+////////////////////////////////////////////////////
+
+class EspClass
+{
+  public:
+
+    // Heap figures are those of the host allocator, against a device-like heap of WM_HOST_HEAP_SIZE bytes
+    uint32_t getHeapSize();
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+
+    // Emulated PSRAM, see esp_heap_caps.h
+    uint32_t getPsramSize();
+    uint32_t getFreePsram();
+
+    uint64_t getEfuseMac();
+
+    const char* getChipModel()
+    {
+      return "HOST";
+    }
+
+    uint8_t getChipRevision()
+    {
+      return 0;
+    }
+
+    uint8_t getChipCores()
+    {
+      return 1;
+    }
+
+    uint32_t getCpuFreqMHz()
+    {
+      return 240;
+    }
+
+    uint32_t getFlashChipSize()
+    {
+      return 4 * 1024 * 1024;
+    }
+
+    uint32_t getFlashChipSpeed()
+    {
+      return 40000000;
+    }
+
+    const char* getSdkVersion()
+    {
+      return "host";
+    }
+
+    // Exits the process, through WM_Host::onRestart() if set
+    [[noreturn]] void restart();
+
+    [[noreturn]] void deepSleep(uint64_t us);
+};
+
+extern EspClass ESP;
+
+////////////////////////////////////////////////////
+
+// FreeRTOS, as far as the library uses it : tasks are threads
+typedef void (*TaskFunction_t)(void*);
+typedef void* TaskHandle_t;
+
+#define tskIDLE_PRIORITY            0
+#define portTICK_PERIOD_MS          1
+#define pdPASS                      1
+
+int  xTaskCreate(TaskFunction_t task, const char* name, uint32_t stackDepth, void* param, int priority,
+                 TaskHandle_t* handle);
+void vTaskDelay(uint32_t ticks);
+
+#endif    // Arduino_h
@@ -0,0 +1,56 @@
+/****************************************************************************************************************************
+  DNSServer.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Declarations only : the host build answers DNS with the library's own ESP_WMCaptiveDNS (USE_WM_CAPTIVE_DNS,
+  the default), on a real UDP socket. With USE_WM_CAPTIVE_DNS false the portal runs without DNS.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef DNSServer_h
+#define DNSServer_h
+
+#include "WiFiUdp.h"
+
+enum class DNSReplyCode
+{
+  NoError   = 0,
+  FormError = 1,
+  ServerFailure = 2,
+  NonExistentDomain = 3,
+  NotImplemented = 4,
+  Refused   = 5
+};
+
+class DNSServer
+{
+  public:
+
+    bool start(const uint16_t& port, const String& domainName, const IPAddress& resolvedIP)
+    {
+      (void) port;
+      (void) domainName;
+      (void) resolvedIP;
+
+      return false;
+    }
+
+    void processNextRequest() {}
+    void stop() {}
+
+    void setErrorReplyCode(const DNSReplyCode& replyCode)
+    {
+      (void) replyCode;
+    }
+
+    void setTTL(const uint32_t& ttl)
+    {
+      (void) ttl;
+    }
+};
+
+#endif    // DNSServer_h
@@ -0,0 +1,72 @@
+/****************************************************************************************************************************
+  IPAddress.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+ *****************************************************************************************************************************/
+
+#include <stdio.h>
+
+#include "IPAddress.h"
+
+////////////////////////////////////////////////////
+
+bool IPAddress::fromString(const char* address)
+{
+  uint16_t acc  = 0;
+  uint8_t  dots = 0;
+
+  if (!address)
+    return false;
+
+  for (const char* p = address; *p; p++)
+  {
+    char c = *p;
+
+    if ( (c >= '0') && (c <= '9') )
+    {
+      acc = acc * 10 + (c - '0');
+
+      if (acc > 255)
+        return false;
+    }
+    else if (c == '.')
+    {
+      if (dots == 3)
+        return false;
+
+      _address.bytes[dots++] = acc;
+      acc = 0;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  if (dots != 3)
+    return false;
+
+  _address.bytes[3] = acc;
+
+  return true;
+}
+
+size_t IPAddress::printTo(Print& p) const
+{
+  char buf[16];
+
+  snprintf(buf, sizeof(buf), "%u.%u.%u.%u", _address.bytes[0], _address.bytes[1], _address.bytes[2], _address.bytes[3]);
+
+  return p.print(buf);
+}
+
+String IPAddress::toString() const
+{
+  char buf[16];
+
+  snprintf(buf, sizeof(buf), "%u.%u.%u.%u", _address.bytes[0], _address.bytes[1], _address.bytes[2], _address.bytes[3]);
+
+  return String(buf);
+}
@@ -0,0 +1,99 @@
+/****************************************************************************************************************************
+  IPAddress.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef IPAddress_h
+#define IPAddress_h
+
+#include <stdint.h>
+
+#include "Print.h"
+#include "WString.h"
+
+// IPv4, in network order in memory, as the ESP32 core
+class IPAddress : public Printable
+{
+  public:
+
+    IPAddress()
+    {
+      _address.dword = 0;
+    }
+
+    IPAddress(uint8_t first, uint8_t second, uint8_t third, uint8_t fourth)
+    {
+      _address.bytes[0] = first;
+      _address.bytes[1] = second;
+      _address.bytes[2] = third;
+      _address.bytes[3] = fourth;
+    }
+
+    IPAddress(uint32_t address)
+    {
+      _address.dword = address;
+    }
+
+    IPAddress(const uint8_t* address)
+    {
+      memcpy(_address.bytes, address, sizeof(_address.bytes));
+    }
+
+    bool fromString(const char* address);
+
+    bool fromString(const String& address)
+    {
+      return fromString(address.c_str());
+    }
+
+    operator uint32_t() const
+    {
+      return _address.dword;
+    }
+
+    bool operator==(const IPAddress& addr) const
+    {
+      return _address.dword == addr._address.dword;
+    }
+
+    bool operator!=(const IPAddress& addr) const
+    {
+      return _address.dword != addr._address.dword;
+    }
+
+    uint8_t operator[](int index) const
+    {
+      return _address.bytes[index];
+    }
+
+    uint8_t& operator[](int index)
+    {
+      return _address.bytes[index];
+    }
+
+    IPAddress& operator=(uint32_t address)
+    {
+      _address.dword = address;
+
+      return *this;
+    }
+
+    size_t printTo(Print& p) const override;
+
+    String toString() const;
+
+  private:
+
+    union
+    {
+      uint8_t   bytes[4];
+      uint32_t  dword;
+    } _address;
+};
+
+#endif    // IPAddress_h
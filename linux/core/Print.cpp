@@ -0,0 +1,212 @@
+/****************************************************************************************************************************
+  Print.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+ *****************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "Print.h"
+
+////////////////////////////////////////////////////
+
+size_t Print::write(const uint8_t* buffer, size_t size)
+{
+  size_t n = 0;
+
+  while (size--)
+  {
+    if (!write(*buffer++))
+      break;
+
+    n++;
+  }
+
+  return n;
+}
+
+size_t Print::printf(const char* format, ...)
+{
+  char    buf[64];
+  char*   str = buf;
+  va_list args;
+
+  va_start(args, format);
+  int len = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+
+  if (len < 0)
+    return 0;
+
+  if ( (size_t) len >= sizeof(buf) )
+  {
+    str = (char*) malloc(len + 1);
+
+    if (!str)
+      return 0;
+
+    va_start(args, format);
+    vsnprintf(str, len + 1, format, args);
+    va_end(args);
+  }
+
+  size_t n = write((const uint8_t*) str, len);
+
+  if (str != buf)
+    free(str);
+
+  return n;
+}
+
+////////////////////////////////////////////////////
+
+size_t Print::printNumber(unsigned long long value, bool negative, int base)
+{
+  char  buf[66];
+  char* p = &buf[sizeof(buf) - 1];
+
+  if (base < 2)
+    base = 10;
+
+  *p = 0;
+
+  do
+  {
+    unsigned digit = value % base;
+
+    *--p = (digit < 10) ? ('0' + digit) : ('A' + digit - 10);
+    value /= base;
+  } while (value);
+
+  if (negative)
+    *--p = '-';
+
+  return write(p);
+}
+
+size_t Print::print(const __FlashStringHelper* str)
+{
+  return write((const char*) str);
+}
+
+size_t Print::print(const String& str)
+{
+  return write(str.c_str(), str.length());
+}
+
+size_t Print::print(const char str[])
+{
+  return write(str);
+}
+
+size_t Print::print(char c)
+{
+  return write((uint8_t) c);
+}
+
+size_t Print::print(unsigned char value, int base)
+{
+  return print((unsigned long long) value, base);
+}
+
+size_t Print::print(int value, int base)
+{
+  return print((long long) value, base);
+}
+
+size_t Print::print(unsigned int value, int base)
+{
+  return print((unsigned long long) value, base);
+}
+
+size_t Print::print(long value, int base)
+{
+  return print((long long) value, base);
+}
+
+size_t Print::print(unsigned long value, int base)
+{
+  return print((unsigned long long) value, base);
+}
+
+size_t Print::print(long long value, int base)
+{
+  if (base == 0)
+    return write((uint8_t) value);
+
+  // As the Arduino core : negative numbers only in base 10
+  if ( (value < 0) && (base == 10) )
+    return printNumber(0ULL - (unsigned long long) value, true, base);
+
+  return printNumber((unsigned long long) value, false, base);
+}
+
+size_t Print::print(unsigned long long value, int base)
+{
+  if (base == 0)
+    return write((uint8_t) value);
+
+  return printNumber(value, false, base);
+}
+
+size_t Print::print(double value, int digits)
+{
+  char buf[64];
+
+  if (isnan(value))
+    return print("nan");
+
+  if (isinf(value))
+    return print("inf");
+
+  snprintf(buf, sizeof(buf), "%.*f", digits, value);
+
+  return print(buf);
+}
+
+size_t Print::print(const Printable& p)
+{
+  return p.printTo(*this);
+}
+
+////////////////////////////////////////////////////
+
+size_t Print::println()
+{
+  return write("\r\n");
+}
+
+#define HOST_PRINTLN(type)                  \
+  size_t Print::println(type value)       \
+  {                                       \
+    size_t n = print(value);              \
+                                          \
+    return n + println();                 \
+  }
+
+#define HOST_PRINTLN_BASE(type)             \
+  size_t Print::println(type value, int base) \
+  {                                       \
+    size_t n = print(value, base);        \
+                                          \
+    return n + println();                 \
+  }
+
+HOST_PRINTLN(const __FlashStringHelper*)
+HOST_PRINTLN(const String&)
+HOST_PRINTLN(const char*)
+HOST_PRINTLN(char)
+HOST_PRINTLN(const Printable&)
+HOST_PRINTLN_BASE(unsigned char)
+HOST_PRINTLN_BASE(int)
+HOST_PRINTLN_BASE(unsigned int)
+HOST_PRINTLN_BASE(long)
+HOST_PRINTLN_BASE(unsigned long)
+HOST_PRINTLN_BASE(long long)
+HOST_PRINTLN_BASE(unsigned long long)
+HOST_PRINTLN_BASE(double)
@@ -0,0 +1,101 @@
+/****************************************************************************************************************************
+  Print.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef Print_h
+#define Print_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "WString.h"
+
+#define DEC   10
+#define HEX   16
+#define OCT   8
+#define BIN   2
+
+class Print;
+
+class Printable
+{
+  public:
+
+    virtual ~Printable() {}
+
+    virtual size_t printTo(Print& p) const = 0;
+};
+
+////////////////////////////////////////////////////
+
+class Print
+{
+  public:
+
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+
+    size_t write(const char* str)
+    {
+      return str ? write((const uint8_t*) str, strlen(str)) : 0;
+    }
+
+    size_t write(const char* buffer, size_t size)
+    {
+      return write((const uint8_t*) buffer, size);
+    }
+
+    // 0 : can't tell
+    virtual int availableForWrite()
+    {
+      return 0;
+    }
+
+    virtual void flush() {}
+
+    size_t printf(const char* format, ...) __attribute__ ((format (printf, 2, 3)));
+
+    size_t print(const __FlashStringHelper* str);
+    size_t print(const String& str);
+    size_t print(const char str[]);
+    size_t print(char c);
+    size_t print(unsigned char value, int base = DEC);
+    size_t print(int value, int base = DEC);
+    size_t print(unsigned int value, int base = DEC);
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(long long value, int base = DEC);
+    size_t print(unsigned long long value, int base = DEC);
+    size_t print(double value, int digits = 2);
+    size_t print(const Printable& p);
+
+    size_t println(const __FlashStringHelper* str);
+    size_t println(const String& str);
+    size_t println(const char str[]);
+    size_t println(char c);
+    size_t println(unsigned char value, int base = DEC);
+    size_t println(int value, int base = DEC);
+    size_t println(unsigned int value, int base = DEC);
+    size_t println(long value, int base = DEC);
+    size_t println(unsigned long value, int base = DEC);
+    size_t println(long long value, int base = DEC);
+    size_t println(unsigned long long value, int base = DEC);
+    size_t println(double value, int digits = 2);
+    size_t println(const Printable& p);
+    size_t println();
+
+  private:
+
+    size_t printNumber(unsigned long long value, bool negative, int base);
+};
+
+#endif    // Print_h
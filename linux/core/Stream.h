@@ -0,0 +1,109 @@
+/****************************************************************************************************************************
+  Stream.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef Stream_h
+#define Stream_h
+
+#include "Print.h"
+#include "WM_Host.h"
+
+unsigned long millis();
+void yield();
+
+class Stream : public Print
+{
+  public:
+
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long timeout)
+    {
+      _timeout = timeout;
+    }
+
+    unsigned long getTimeout() const
+    {
+      return _timeout;
+    }
+
+    virtual size_t readBytes(char* buffer, size_t length)
+    {
+      size_t count = 0;
+
+      while (count < length)
+      {
+        int c = timedRead();
+
+        if (c < 0)
+          break;
+
+        *buffer++ = (char) c;
+        count++;
+      }
+
+      return count;
+    }
+
+    size_t readBytes(uint8_t* buffer, size_t length)
+    {
+      return readBytes((char*) buffer, length);
+    }
+
+    String readString()
+    {
+      String ret;
+      int    c;
+
+      while ( (c = timedRead()) >= 0 )
+        ret += (char) c;
+
+      return ret;
+    }
+
+    String readStringUntil(char terminator)
+    {
+      String ret;
+      int    c;
+
+      while ( ( (c = timedRead()) >= 0 ) && (c != terminator) )
+        ret += (char) c;
+
+      return ret;
+    }
+
+  protected:
+
+    unsigned long _timeout = 1000;
+
+    int timedRead()
+    {
+      unsigned long start = millis();
+
+      do
+      {
+        int c = read();
+
+        if (c >= 0)
+          return c;
+
+        yield();
+
+        // Virtual clock : waiting for the next byte is what moves it
+        if (WM_Host::isVirtualClock())
+          WM_Host::advance(1000);
+      } while (millis() - start < _timeout);
+
+      return -1;
+    }
+};
+
+#endif    // Stream_h
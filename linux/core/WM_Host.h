@@ -0,0 +1,75 @@
+/****************************************************************************************************************************
+  WM_Host.h
+  For the Linux host build of ESP_WiFiManager
+
+  ESP_WiFiManager is a library for the ESP8266/Arduino platform
+  (https://github.com/esp8266/Arduino) to enable easy
+  configuration and reconfiguration of WiFi credentials using a Captive Portal
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Controls of the host platform, for host programs only : the clock behind millis() / delay(), the device
+  wall clock, the restart hook, the allocator hook. The simulated radio is in WM_HostRadio.h.
+
+  With the virtual clock, time only moves when the program waits : delay(), a scan or a connection
+  attempt, an idle WebServer::waitForActivity() return at once and advance the clock instead, so a
+  sequence that takes minutes on a device runs in microseconds, with the same timings, every run.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WM_Host_h
+#define WM_Host_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace WM_Host
+{
+  // Real monotonic clock (default), or virtual. Switch before anything reads the clock.
+  void      setVirtualClock(const bool& enable);
+  bool      isVirtualClock();
+
+  // us since start
+  uint64_t  micros64();
+
+  // Moves the virtual clock forward, real clock : sleeps
+  void      advance(const uint64_t& us);
+
+  // Virtual clock back to 0, and the wall clock to 1970, as at power on : runs replayed one after the other
+  // all start at the same time. No effect on the real clock.
+  void      powerOn();
+
+  // Device UTC, in us. Starts at 0 (1970) as on a device, until SNTP or the program sets it.
+  int64_t   wallClock();
+  void      setWallClock(const int64_t& us);
+
+  // Called by ESP.restart() / ESP.deepSleep() before the process exits with exitCode
+  typedef void (*RestartCallback)(bool deepSleep);
+
+  void      onRestart(RestartCallback callback, const int& exitCode = 0);
+
+  // Called from delay() and yield(), for programs running the library from a single thread
+  typedef void (*IdleCallback)();
+
+  void      onIdle(IdleCallback callback);
+
+  // Called after each malloc() / calloc() / realloc() / free() of the program, from the allocating thread.
+  // size : requested, 0 for free(). The callback must not allocate.
+  typedef enum
+  {
+    ALLOC_MALLOC = 0,
+    ALLOC_REALLOC,
+    ALLOC_FREE
+  } AllocEvent;
+
+  typedef void (*AllocCallback)(AllocEvent event, size_t size);
+
+  void      onAlloc(AllocCallback callback);
+
+  // Returns of the host WebServer::waitForActivity() since start : wake-ups of a loop sleeping on its sockets
+  uint64_t  activityWakeups();
+}
+
+#endif    // WM_Host_h
@@ -0,0 +1,276 @@
+/****************************************************************************************************************************
+  WM_HostRadio.h
+  For the Linux host build of ESP_WiFiManager
+
+  ESP_WiFiManager is a library for the ESP8266/Arduino platform
+  (https://github.com/esp8266/Arduino) to enable easy
+  configuration and reconfiguration of WiFi credentials using a Captive Portal
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Simulated radio behind WiFi : a set of access points and a station state machine driven by the clock.
+  A connection attempt first finds the AP, then goes through association, authentication and DHCP, each
+  taking the AP's delay, and ends as the ESP32 core reports it (WL_CONNECTED, WL_CONNECT_FAILED,
+  WL_NO_SSID_AVAIL, or stays WL_DISCONNECTED when DHCP never answers). Finding the AP takes channelMs per
+  channel up to the AP's (the core's fast scan), one channel when WiFi.begin() is given it, and a full sweep
+  when the AP isn't there or is below min_rssi. Scans take channels * channelMs.
+
+  Scenario files, one command per line, '#' starts a comment :
+
+    set   channel_ms=120 channels=13 min_rssi=-90 seed=1
+    ap    <ssid> [password=] [rssi=-60] [channel=1] [auth=open|wep|wpa|wpa2|wpa3] [hidden=0]
+               [assoc=50] [auth_ms=100] [dhcp=300] [jitter=0] [fail=none|assoc|auth|dhcp] [fail_pct=100]
+               [ip=192.168.1.100] [bssid=aa:bb:cc:dd:ee:ff]
+    down  <ssid>                AP stops beaconing (and drops its station)
+    up    <ssid>
+    rssi  <ssid> <dBm>
+    trace <ssid> <period_ms> <dBm> [<dBm> ...]
+                                RSSI follows the values, one per period, over and over
+    remove <ssid>
+    host  <name> <ip>           Answer of WiFi.hostByName(), nothing else resolves
+    at    <ms> <command>        Runs command when millis() reaches ms, from the start of the scenario
+
+  SSIDs with spaces are written with double quotes. jitter adds 0 to jitter ms to each phase of an attempt,
+  and fail_pct is the share of attempts the failure happens to, both drawn from the seeded generator :
+  replay() runs the scenario again from the start, with the same draws for the same seed.
+
+  stats() tells how long the radio was on to scan or to connect : from WiFi.begin() until connected, failed,
+  or abandoned by WiFi.disconnect() / another WiFi.begin().
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WM_HostRadio_h
+#define WM_HostRadio_h
+
+#include <stdint.h>
+#include <string.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "esp_wifi.h"
+#include "IPAddress.h"
+
+typedef enum
+{
+  WL_NO_SHIELD        = 255,
+  WL_IDLE_STATUS      = 0,
+  WL_NO_SSID_AVAIL    = 1,
+  WL_SCAN_COMPLETED   = 2,
+  WL_CONNECTED        = 3,
+  WL_CONNECT_FAILED   = 4,
+  WL_CONNECTION_LOST  = 5,
+  WL_DISCONNECTED     = 6
+} wl_status_t;
+
+typedef enum
+{
+  WM_HOST_FAIL_NONE = 0,
+  WM_HOST_FAIL_ASSOC,
+  WM_HOST_FAIL_AUTH,
+  WM_HOST_FAIL_DHCP
+} WM_HostFailure;
+
+typedef struct
+{
+  std::string       ssid;
+  std::string       password;
+  uint8_t           bssid[6];
+  uint8_t           channel;
+  int32_t           rssi;
+  wifi_auth_mode_t  auth;
+  bool              hidden;
+  bool              up;
+
+  // ms
+  uint32_t          assocMs;
+  uint32_t          authMs;
+  uint32_t          dhcpMs;
+
+  uint32_t          jitterMs;
+
+  WM_HostFailure    failure;
+  uint8_t           failPct;      // Share of the attempts failing, %
+  IPAddress         ip;           // Given by DHCP
+
+  // RSSI trace, from traceStart
+  std::vector<int32_t>  trace;
+  uint32_t              tracePeriodMs;
+  uint64_t              traceStart;
+} WM_HostAP;
+
+typedef struct
+{
+  uint64_t          radioOnMs;    // Scanning or connecting
+  uint32_t          scans;
+  uint32_t          attempts;     // WiFi.begin()
+  uint64_t          connectedMs;  // First WL_CONNECTED, from the start of the scenario. 0 : never
+} WM_HostRadioStats;
+
+////////////////////////////////////////////////////
+
+class WM_HostRadio
+{
+  public:
+
+    static WM_HostRadio& get();
+
+    // No AP, no event, station idle and no stored credentials
+    void reset();
+
+    // Runs the file, and keeps it for replay()
+    bool loadScenario(const char* path);
+
+    // reset(), then the scenario again, with its times from now and the generator seeded with seed
+    void replay(const uint32_t& seed);
+
+    // One scenario line. false, and error() set, when it doesn't parse.
+    bool command(const char* line);
+
+    const std::string& error() const
+    {
+      return _error;
+    }
+
+    WM_HostAP&  addAP(const char* ssid, const char* password = "");
+    WM_HostAP*  findAP(const char* ssid);
+    bool        removeAP(const char* ssid);
+
+    const std::vector<WM_HostAP>& aps() const
+    {
+      return _aps;
+    }
+
+    // Runs the scenario events due by now, and moves the station along
+    void update();
+
+    ////////////////////////////////////////////////////
+    // Station
+
+    // Station interface started / stopped by WiFi.mode() : WL_DISCONNECTED / WL_NO_SHIELD, as the core
+    void        staStart();
+    void        staStop();
+
+    // channel / bssid : 0 / nullptr when not known
+    void        staBegin(const char* ssid, const char* password, const int32_t& channel = 0,
+                         const uint8_t* bssid = nullptr);
+    void        staDisconnect();
+
+    wl_status_t staStatus();
+
+    // The AP the station is connected to, or nullptr
+    WM_HostAP*  staAP();
+
+    IPAddress   staIP() const
+    {
+      return _staIP;
+    }
+
+    void        setStaticIP(const IPAddress& ip)
+    {
+      _staticIP = ip;
+    }
+
+    // Credentials kept as in NVS
+    std::string storedSSID;
+    std::string storedPassword;
+
+    ////////////////////////////////////////////////////
+    // Scan : blocks for channels * channelMs, then takes the APs up at that time
+
+    int16_t     scan(const bool& showHidden);
+
+    const std::vector<WM_HostAP>& scanResults() const
+    {
+      return _scanResults;
+    }
+
+    void        scanDelete()
+    {
+      _scanResults.clear();
+    }
+
+    bool        hostByName(const char* name, IPAddress& ip);
+
+    // Since reset() / replay(), an attempt in progress counted until now
+    WM_HostRadioStats stats();
+
+    uint32_t    channelMs = 120;
+    uint8_t     channels  = 13;
+    int32_t     minRSSI   = -90;    // Weaker APs can't be found nor joined
+
+  private:
+
+    typedef enum
+    {
+      STA_IDLE = 0,
+      STA_FIND,
+      STA_ASSOC,
+      STA_AUTH,
+      STA_DHCP,
+      STA_DONE
+    } StaPhase;
+
+    typedef struct
+    {
+      uint64_t    at;               // ms
+      std::string line;
+    } Event;
+
+    WM_HostRadio()
+    {
+      reset();
+    }
+
+    void        runCommand(const std::vector<std::string>& args);
+    void        advanceStation(const uint64_t& now);
+    void        updateRSSI(const uint64_t& now);
+    uint32_t    phaseMs(const WM_HostAP& ap, const uint32_t& ms);
+    void        endAttempt(const uint64_t& now);
+
+    bool        audible(const WM_HostAP& ap) const
+    {
+      return ap.up && (ap.rssi >= minRSSI);
+    }
+
+    // The AP the attempt looks for, where it looks
+    bool        findable(const WM_HostAP* ap) const
+    {
+      return ap && audible(*ap) && ( (_staChannel == 0) || (_staChannel == ap->channel) ) &&
+             (!_staDirected || !memcmp(_staBSSID, ap->bssid, sizeof(_staBSSID)));
+    }
+
+    std::vector<WM_HostAP>  _aps;
+    std::vector<WM_HostAP>  _scanResults;
+    std::vector<Event>      _events;
+    std::vector<std::pair<std::string, IPAddress>> _hosts;
+
+    std::string   _error;
+
+    std::vector<std::string>  _scenario;
+    uint64_t      _epoch      = 0;    // ms, start of the scenario
+    std::minstd_rand  _rng;
+
+    WM_HostRadioStats _stats;
+    bool          _attempting = false;
+    uint64_t      _attemptStart = 0;
+    uint8_t       _attemptDraw  = 0;    // 0..99, the attempt fails when below the AP's fail_pct
+    uint64_t      _eventTime    = 0;
+
+    std::string   _staSSID;
+    std::string   _staPassword;
+    int32_t       _staChannel = 0;
+    uint8_t       _staBSSID[6];
+    bool          _staDirected = false;     // BSSID given
+    StaPhase      _staPhase   = STA_IDLE;
+    uint64_t      _phaseEnd   = 0;
+    wl_status_t   _staStatus  = WL_NO_SHIELD;
+    IPAddress     _staIP;
+    IPAddress     _staticIP;
+    bool          _inUpdate   = false;
+};
+
+#endif    // WM_HostRadio_h
@@ -0,0 +1,701 @@
+/****************************************************************************************************************************
+  WString.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+ *****************************************************************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <ctype.h>
+
+#include <algorithm>
+
+#include "WString.h"
+
+////////////////////////////////////////////////////
+
+String::String(const char* cstr)
+{
+  init();
+
+  if (cstr)
+    copy(cstr, strlen(cstr));
+}
+
+String::String(const char* cstr, unsigned int length)
+{
+  init();
+
+  if (cstr)
+    copy(cstr, length);
+}
+
+String::String(const String& str)
+{
+  init();
+
+  *this = str;
+}
+
+String::String(String&& rval)
+{
+  init();
+
+  move(rval);
+}
+
+String::String(const __FlashStringHelper* str)
+{
+  init();
+
+  if (str)
+    copy((const char*) str, strlen((const char*) str));
+}
+
+String::String(char c)
+{
+  init();
+
+  char buf[2] = { c, 0 };
+
+  *this = buf;
+}
+
+////////////////////////////////////////////////////
+
+static void WM_formatNumber(char* buf, size_t size, unsigned long long value, bool negative, unsigned char base)
+{
+  char  tmp[66];
+  char* p = &tmp[sizeof(tmp) - 1];
+
+  if ( (base < 2) || (base > 36) )
+    base = 10;
+
+  *p = 0;
+
+  do
+  {
+    unsigned digit = value % base;
+
+    *--p = (digit < 10) ? ('0' + digit) : ('a' + digit - 10);
+    value /= base;
+  } while (value);
+
+  if (negative)
+    *--p = '-';
+
+  snprintf(buf, size, "%s", p);
+}
+
+#define WM_STRING_FROM_SIGNED(type)                                                               \
+  String::String(type value, unsigned char base)                                                  \
+  {                                                                                               \
+    char buf[66];                                                                                 \
+                                                                                                  \
+    init();                                                                                       \
+    /* Negative values only in base 10, as the Arduino core */                                    \
+    if ( (value < 0) && (base == 10) )                                                            \
+      WM_formatNumber(buf, sizeof(buf), 0ULL - (unsigned long long) value, true, base);           \
+    else                                                                                          \
+      WM_formatNumber(buf, sizeof(buf), (unsigned long long) (unsigned type) value, false, base); \
+                                                                                                  \
+    *this = buf;                                                                                  \
+  }
+
+#define WM_STRING_FROM_UNSIGNED(type)                                                             \
+  String::String(type value, unsigned char base)                                                  \
+  {                                                                                               \
+    char buf[66];                                                                                 \
+                                                                                                  \
+    init();                                                                                       \
+    WM_formatNumber(buf, sizeof(buf), value, false, base);                                        \
+    *this = buf;                                                                                  \
+  }
+
+WM_STRING_FROM_SIGNED(int)
+WM_STRING_FROM_SIGNED(long)
+WM_STRING_FROM_SIGNED(long long)
+WM_STRING_FROM_UNSIGNED(unsigned char)
+WM_STRING_FROM_UNSIGNED(unsigned int)
+WM_STRING_FROM_UNSIGNED(unsigned long)
+WM_STRING_FROM_UNSIGNED(unsigned long long)
+
+String::String(float value, unsigned int decimalPlaces)
+{
+  char buf[64];
+
+  init();
+  snprintf(buf, sizeof(buf), "%.*f", (int) decimalPlaces, (double) value);
+  *this = buf;
+}
+
+String::String(double value, unsigned int decimalPlaces)
+{
+  char buf[64];
+
+  init();
+  snprintf(buf, sizeof(buf), "%.*f", (int) decimalPlaces, value);
+  *this = buf;
+}
+
+String::~String()
+{
+  invalidate();
+}
+
+////////////////////////////////////////////////////
+
+void String::init()
+{
+  _sso[0] = 0;
+  _cap    = WSTRING_SSO_SIZE - 1;
+  _len    = 0;
+}
+
+void String::invalidate()
+{
+  if (!isSSO())
+    free(_ptr);
+
+  init();
+}
+
+bool String::reserve(unsigned int size)
+{
+  if (size <= _cap)
+    return true;
+
+  return changeBuffer(size);
+}
+
+// Same rounding as the ESP32 core
+bool String::changeBuffer(unsigned int maxStrLen)
+{
+  if (maxStrLen < WSTRING_SSO_SIZE)
+    return true;
+
+  unsigned int newSize = (maxStrLen + 16) & (~0xf);
+  char*        newBuf;
+
+  if (isSSO())
+  {
+    newBuf = (char*) malloc(newSize);
+
+    if (newBuf)
+      memcpy(newBuf, _sso, _len + 1);
+  }
+  else
+  {
+    newBuf = (char*) realloc(_ptr, newSize);
+  }
+
+  if (!newBuf)
+    return false;
+
+  _ptr = newBuf;
+  _cap = newSize - 1;
+
+  return true;
+}
+
+String& String::copy(const char* cstr, unsigned int length)
+{
+  if (!reserve(length))
+  {
+    invalidate();
+
+    return *this;
+  }
+
+  memmove(wbuffer(), cstr, length);
+  _len = length;
+  wbuffer()[_len] = 0;
+
+  return *this;
+}
+
+void String::move(String& rhs)
+{
+  invalidate();
+
+  if (rhs.isSSO())
+  {
+    memcpy(_sso, rhs._sso, sizeof(_sso));
+  }
+  else
+  {
+    _ptr = rhs._ptr;
+  }
+
+  _cap = rhs._cap;
+  _len = rhs._len;
+
+  rhs.init();
+}
+
+////////////////////////////////////////////////////
+
+String& String::operator=(const String& rhs)
+{
+  if (this == &rhs)
+    return *this;
+
+  return copy(rhs.c_str(), rhs._len);
+}
+
+String& String::operator=(String&& rval)
+{
+  if (this != &rval)
+    move(rval);
+
+  return *this;
+}
+
+String& String::operator=(const char* cstr)
+{
+  if (cstr)
+    return copy(cstr, strlen(cstr));
+
+  invalidate();
+
+  return *this;
+}
+
+String& String::operator=(const __FlashStringHelper* str)
+{
+  return *this = (const char*) str;
+}
+
+////////////////////////////////////////////////////
+
+bool String::concat(const char* cstr, unsigned int length)
+{
+  if (!cstr)
+    return false;
+
+  if (length == 0)
+    return true;
+
+  unsigned int newLen = _len + length;
+
+  // cstr may point into this String
+  if ( (cstr >= c_str()) && (cstr < c_str() + _len) )
+  {
+    unsigned int offset = cstr - c_str();
+
+    if (!reserve(newLen))
+      return false;
+
+    memmove(wbuffer() + _len, c_str() + offset, length);
+  }
+  else
+  {
+    if (!reserve(newLen))
+      return false;
+
+    memcpy(wbuffer() + _len, cstr, length);
+  }
+
+  _len = newLen;
+  wbuffer()[_len] = 0;
+
+  return true;
+}
+
+bool String::concat(const String& str)
+{
+  return concat(str.c_str(), str._len);
+}
+
+bool String::concat(const char* cstr)
+{
+  return cstr ? concat(cstr, strlen(cstr)) : false;
+}
+
+bool String::concat(const __FlashStringHelper* str)
+{
+  return concat((const char*) str);
+}
+
+bool String::concat(char c)
+{
+  return concat(&c, 1);
+}
+
+bool String::concat(unsigned char value)
+{
+  return concat(String(value));
+}
+
+bool String::concat(int value)
+{
+  return concat(String(value));
+}
+
+bool String::concat(unsigned int value)
+{
+  return concat(String(value));
+}
+
+bool String::concat(long value)
+{
+  return concat(String(value));
+}
+
+bool String::concat(unsigned long value)
+{
+  return concat(String(value));
+}
+
+bool String::concat(long long value)
+{
+  return concat(String(value));
+}
+
+bool String::concat(unsigned long long value)
+{
+  return concat(String(value));
+}
+
+bool String::concat(float value)
+{
+  return concat(String(value));
+}
+
+bool String::concat(double value)
+{
+  return concat(String(value));
+}
+
+////////////////////////////////////////////////////
+
+int String::compareTo(const String& s) const
+{
+  return strcmp(c_str(), s.c_str());
+}
+
+bool String::equals(const String& s) const
+{
+  return (_len == s._len) && (memcmp(c_str(), s.c_str(), _len) == 0);
+}
+
+bool String::equals(const char* cstr) const
+{
+  return cstr ? (strcmp(c_str(), cstr) == 0) : (_len == 0);
+}
+
+// Time independent of where the strings differ, for secrets
+bool String::equalsConstantTime(const String& s) const
+{
+  unsigned char diff = (_len != s._len);
+
+  for (unsigned int i = 0; (i < _len) && (i < s._len); i++)
+    diff |= (unsigned char) (c_str()[i] ^ s.c_str()[i]);
+
+  return diff == 0;
+}
+
+bool String::equalsIgnoreCase(const String& s) const
+{
+  return (_len == s._len) && (strcasecmp(c_str(), s.c_str()) == 0);
+}
+
+bool String::startsWith(const String& prefix) const
+{
+  return startsWith(prefix, 0);
+}
+
+bool String::startsWith(const String& prefix, unsigned int offset) const
+{
+  if (offset + prefix._len > _len)
+    return false;
+
+  return memcmp(c_str() + offset, prefix.c_str(), prefix._len) == 0;
+}
+
+bool String::endsWith(const String& suffix) const
+{
+  if (suffix._len > _len)
+    return false;
+
+  return memcmp(c_str() + _len - suffix._len, suffix.c_str(), suffix._len) == 0;
+}
+
+////////////////////////////////////////////////////
+
+char String::charAt(unsigned int index) const
+{
+  return (index < _len) ? c_str()[index] : 0;
+}
+
+void String::setCharAt(unsigned int index, char c)
+{
+  if (index < _len)
+    wbuffer()[index] = c;
+}
+
+char String::operator[](unsigned int index) const
+{
+  return charAt(index);
+}
+
+char& String::operator[](unsigned int index)
+{
+  static char dummy;
+
+  if (index >= _len)
+  {
+    dummy = 0;
+
+    return dummy;
+  }
+
+  return wbuffer()[index];
+}
+
+void String::getBytes(unsigned char* buf, unsigned int bufsize, unsigned int index) const
+{
+  if (!bufsize || !buf)
+    return;
+
+  if (index >= _len)
+  {
+    buf[0] = 0;
+
+    return;
+  }
+
+  unsigned int n = std::min(bufsize - 1, _len - index);
+
+  memcpy(buf, c_str() + index, n);
+  buf[n] = 0;
+}
+
+////////////////////////////////////////////////////
+
+int String::indexOf(char ch, unsigned int fromIndex) const
+{
+  if (fromIndex >= _len)
+    return -1;
+
+  const char* found = (const char*) memchr(c_str() + fromIndex, ch, _len - fromIndex);
+
+  return found ? (int) (found - c_str()) : -1;
+}
+
+int String::indexOf(const String& str, unsigned int fromIndex) const
+{
+  if (fromIndex > _len)
+    return -1;
+
+  const char* found = strstr(c_str() + fromIndex, str.c_str());
+
+  return found ? (int) (found - c_str()) : -1;
+}
+
+int String::lastIndexOf(char ch) const
+{
+  return _len ? lastIndexOf(ch, _len - 1) : -1;
+}
+
+int String::lastIndexOf(char ch, unsigned int fromIndex) const
+{
+  if (fromIndex >= _len)
+    return -1;
+
+  for (int i = fromIndex; i >= 0; i--)
+  {
+    if (c_str()[i] == ch)
+      return i;
+  }
+
+  return -1;
+}
+
+int String::lastIndexOf(const String& str) const
+{
+  return (str._len <= _len) ? lastIndexOf(str, _len - str._len) : -1;
+}
+
+int String::lastIndexOf(const String& str, unsigned int fromIndex) const
+{
+  if ( (str._len == 0) || (str._len > _len) )
+    return -1;
+
+  if (fromIndex > _len - str._len)
+    fromIndex = _len - str._len;
+
+  for (int i = fromIndex; i >= 0; i--)
+  {
+    if (memcmp(c_str() + i, str.c_str(), str._len) == 0)
+      return i;
+  }
+
+  return -1;
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const
+{
+  if (beginIndex > endIndex)
+    std::swap(beginIndex, endIndex);
+
+  if (beginIndex >= _len)
+    return String();
+
+  if (endIndex > _len)
+    endIndex = _len;
+
+  return String(c_str() + beginIndex, endIndex - beginIndex);
+}
+
+////////////////////////////////////////////////////
+
+void String::replace(char find, char replace)
+{
+  for (char* p = wbuffer(); *p; p++)
+  {
+    if (*p == find)
+      *p = replace;
+  }
+}
+
+// Same strategy as the core : in place when the result is not longer, else one reserve() then from the end
+void String::replace(const String& find, const String& replace)
+{
+  if ( (_len == 0) || (find._len == 0) )
+    return;
+
+  int diff = replace._len - find._len;
+
+  char* readFrom = wbuffer();
+  char* foundAt;
+
+  if (diff == 0)
+  {
+    while ( (foundAt = strstr(readFrom, find.c_str())) != NULL )
+    {
+      memcpy(foundAt, replace.c_str(), replace._len);
+      readFrom = foundAt + replace._len;
+    }
+  }
+  else if (diff < 0)
+  {
+    char* writeTo = wbuffer();
+
+    while ( (foundAt = strstr(readFrom, find.c_str())) != NULL )
+    {
+      unsigned int n = foundAt - readFrom;
+
+      memmove(writeTo, readFrom, n);
+      writeTo += n;
+      memcpy(writeTo, replace.c_str(), replace._len);
+      writeTo += replace._len;
+      readFrom = foundAt + find._len;
+      _len += diff;
+    }
+
+    memmove(writeTo, readFrom, strlen(readFrom) + 1);
+  }
+  else
+  {
+    unsigned int size = _len;
+
+    while ( (foundAt = strstr(readFrom, find.c_str())) != NULL )
+    {
+      readFrom = foundAt + find._len;
+      size += diff;
+    }
+
+    if (size == _len)
+      return;
+
+    if (!reserve(size))
+      return;
+
+    int index = _len - 1;
+
+    while ( (index >= 0) && ( (index = lastIndexOf(find, index)) >= 0 ) )
+    {
+      readFrom = wbuffer() + index + find._len;
+      memmove(readFrom + diff, readFrom, _len - (readFrom - wbuffer()));
+      _len += diff;
+      wbuffer()[_len] = 0;
+      memcpy(wbuffer() + index, replace.c_str(), replace._len);
+      index--;
+    }
+  }
+}
+
+void String::remove(unsigned int index)
+{
+  remove(index, (unsigned int) -1);
+}
+
+void String::remove(unsigned int index, unsigned int count)
+{
+  if (index >= _len)
+    return;
+
+  if (count > _len - index)
+    count = _len - index;
+
+  char* writeTo = wbuffer() + index;
+
+  _len -= count;
+  memmove(writeTo, writeTo + count, _len - index);
+  wbuffer()[_len] = 0;
+}
+
+void String::toLowerCase()
+{
+  for (char* p = wbuffer(); *p; p++)
+    *p = tolower(*p);
+}
+
+void String::toUpperCase()
+{
+  for (char* p = wbuffer(); *p; p++)
+    *p = toupper(*p);
+}
+
+void String::trim()
+{
+  if (_len == 0)
+    return;
+
+  char* begin = wbuffer();
+
+  while (isspace(*begin))
+    begin++;
+
+  char* end = wbuffer() + _len - 1;
+
+  while (isspace(*end) && (end >= begin))
+    end--;
+
+  _len = end + 1 - begin;
+
+  if (begin > wbuffer())
+    memmove(wbuffer(), begin, _len);
+
+  wbuffer()[_len] = 0;
+}
+
+////////////////////////////////////////////////////
+
+long String::toInt() const
+{
+  return atol(c_str());
+}
+
+float String::toFloat() const
+{
+  return atof(c_str());
+}
+
+double String::toDouble() const
+{
+  return atof(c_str());
+}
@@ -0,0 +1,286 @@
+/****************************************************************************************************************************
+  WString.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Arduino String, with the ESP32 core allocation behaviour : up to WSTRING_SSO_SIZE - 1 characters in the
+  object itself, then a heap buffer grown with realloc() in 16 bytes steps. So the host counts the same
+  allocations as a board does.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WString_h
+#define WString_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <utility>
+
+#include "pgmspace.h"
+
+// Same as the ESP32 core on a 32 bits CPU
+#define WSTRING_SSO_SIZE        11
+
+class String
+{
+  public:
+
+    String(const char* cstr = "");
+    String(const char* cstr, unsigned int length);
+    String(const String& str);
+    String(String&& rval);
+    String(const __FlashStringHelper* str);
+
+    explicit String(char c);
+    explicit String(unsigned char value, unsigned char base = 10);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(long long value, unsigned char base = 10);
+    explicit String(unsigned long long value, unsigned char base = 10);
+    explicit String(float value, unsigned int decimalPlaces = 2);
+    explicit String(double value, unsigned int decimalPlaces = 2);
+
+    ~String();
+
+    ////////////////////////////////////////////////////
+
+    // false, and the String is left unchanged, if the memory can't be allocated
+    bool reserve(unsigned int size);
+
+    inline unsigned int length() const
+    {
+      return _len;
+    }
+
+    inline bool isEmpty() const
+    {
+      return _len == 0;
+    }
+
+    String& operator=(const String& rhs);
+    String& operator=(String&& rval);
+    String& operator=(const char* cstr);
+    String& operator=(const __FlashStringHelper* str);
+
+    ////////////////////////////////////////////////////
+
+    bool concat(const String& str);
+    bool concat(const char* cstr);
+    bool concat(const char* cstr, unsigned int length);
+    bool concat(const __FlashStringHelper* str);
+    bool concat(char c);
+    bool concat(unsigned char value);
+    bool concat(int value);
+    bool concat(unsigned int value);
+    bool concat(long value);
+    bool concat(unsigned long value);
+    bool concat(long long value);
+    bool concat(unsigned long long value);
+    bool concat(float value);
+    bool concat(double value);
+
+    template<typename T>
+    String& operator+=(const T& rhs)
+    {
+      concat(rhs);
+
+      return *this;
+    }
+
+    ////////////////////////////////////////////////////
+
+    int compareTo(const String& s) const;
+    bool equals(const String& s) const;
+    bool equals(const char* cstr) const;
+    bool equalsIgnoreCase(const String& s) const;
+    bool equalsConstantTime(const String& s) const;
+    bool startsWith(const String& prefix) const;
+    bool startsWith(const String& prefix, unsigned int offset) const;
+    bool endsWith(const String& suffix) const;
+
+    bool operator==(const String& rhs) const
+    {
+      return equals(rhs);
+    }
+
+    bool operator==(const char* cstr) const
+    {
+      return equals(cstr);
+    }
+
+    bool operator!=(const String& rhs) const
+    {
+      return !equals(rhs);
+    }
+
+    bool operator!=(const char* cstr) const
+    {
+      return !equals(cstr);
+    }
+
+    bool operator<(const String& rhs) const
+    {
+      return compareTo(rhs) < 0;
+    }
+
+    bool operator>(const String& rhs) const
+    {
+      return compareTo(rhs) > 0;
+    }
+
+    ////////////////////////////////////////////////////
+
+    char charAt(unsigned int index) const;
+    void setCharAt(unsigned int index, char c);
+    char operator[](unsigned int index) const;
+    char& operator[](unsigned int index);
+
+    void getBytes(unsigned char* buf, unsigned int bufsize, unsigned int index = 0) const;
+
+    void toCharArray(char* buf, unsigned int bufsize, unsigned int index = 0) const
+    {
+      getBytes((unsigned char*) buf, bufsize, index);
+    }
+
+    inline const char* c_str() const
+    {
+      return buffer();
+    }
+
+    inline char* begin()
+    {
+      return wbuffer();
+    }
+
+    inline char* end()
+    {
+      return wbuffer() + _len;
+    }
+
+    inline const char* begin() const
+    {
+      return c_str();
+    }
+
+    inline const char* end() const
+    {
+      return c_str() + _len;
+    }
+
+    ////////////////////////////////////////////////////
+
+    int indexOf(char ch, unsigned int fromIndex = 0) const;
+    int indexOf(const String& str, unsigned int fromIndex = 0) const;
+    int lastIndexOf(char ch) const;
+    int lastIndexOf(char ch, unsigned int fromIndex) const;
+    int lastIndexOf(const String& str) const;
+    int lastIndexOf(const String& str, unsigned int fromIndex) const;
+
+    String substring(unsigned int beginIndex) const
+    {
+      return substring(beginIndex, _len);
+    }
+
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+    ////////////////////////////////////////////////////
+
+    void replace(char find, char replace);
+    void replace(const String& find, const String& replace);
+    void remove(unsigned int index);
+    void remove(unsigned int index, unsigned int count);
+    void toLowerCase();
+    void toUpperCase();
+    void trim();
+
+    long toInt() const;
+    float toFloat() const;
+    double toDouble() const;
+
+    ////////////////////////////////////////////////////
+
+  private:
+
+    // Heap buffer when _cap >= WSTRING_SSO_SIZE
+    union
+    {
+      char* _ptr;
+      char  _sso[WSTRING_SSO_SIZE];
+    };
+
+    unsigned int _cap = WSTRING_SSO_SIZE - 1;     // Characters, without the terminating 0
+    unsigned int _len = 0;
+
+    inline bool isSSO() const
+    {
+      return _cap < WSTRING_SSO_SIZE;
+    }
+
+    inline const char* buffer() const
+    {
+      return isSSO() ? _sso : _ptr;
+    }
+
+    inline char* wbuffer()
+    {
+      return isSSO() ? _sso : _ptr;
+    }
+
+    void init();
+    void invalidate();
+    bool changeBuffer(unsigned int maxStrLen);
+    String& copy(const char* cstr, unsigned int length);
+    void move(String& rhs);
+};
+
+////////////////////////////////////////////////////
+
+template<typename T>
+inline String operator+(const String& lhs, const T& rhs)
+{
+  String result(lhs);
+
+  result.concat(rhs);
+
+  return result;
+}
+
+template<typename T>
+inline String operator+(String&& lhs, const T& rhs)
+{
+  lhs.concat(rhs);
+
+  return std::move(lhs);
+}
+
+inline String operator+(const char* lhs, const String& rhs)
+{
+  String result(lhs);
+
+  result.concat(rhs);
+
+  return result;
+}
+
+inline String operator+(const __FlashStringHelper* lhs, const String& rhs)
+{
+  String result(lhs);
+
+  result.concat(rhs);
+
+  return result;
+}
+
+inline bool operator==(const char* lhs, const String& rhs)
+{
+  return rhs.equals(lhs);
+}
+
+#endif    // WString_h
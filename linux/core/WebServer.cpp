@@ -0,0 +1,540 @@
+/****************************************************************************************************************************
+  WebServer.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+ *****************************************************************************************************************************/
+
+#include <poll.h>
+
+#include <atomic>
+
+#include "WebServer.h"
+#include "WM_Host.h"
+
+namespace
+{
+  std::atomic<uint64_t> wakeups(0);
+}
+
+uint64_t WM_Host::activityWakeups()
+{
+  return wakeups;
+}
+
+////////////////////////////////////////////////////
+
+void WebServer::on(const String& uri, HTTPMethod method, THandlerFunction handler)
+{
+  _handlers.push_back( { uri, method, handler } );
+}
+
+void WebServer::close()
+{
+  _server.end();
+  _pendingClients.clear();
+  _currentClient.stop();
+}
+
+////////////////////////////////////////////////////
+
+void WebServer::handleClient()
+{
+  bool active = false;
+
+  while (_pendingClients.size() < HTTP_MAX_PENDING_CLIENTS)
+  {
+    WiFiClient client = _server.accept();
+
+    if (!client)
+      break;
+
+    _pendingClients.push_back( { client, std::string(), millis() } );
+  }
+
+  for (size_t i = 0; i < _pendingClients.size(); )
+  {
+    PendingClient& pending = _pendingClients[i];
+    int            res     = handleRequest(pending);
+
+    if ( (res == 0) && (millis() - pending.accepted >= HTTP_MAX_DATA_WAIT) )
+      res = -1;
+
+    if (res != 0)
+    {
+      active = true;
+      _pendingClients.erase(_pendingClients.begin() + i);
+    }
+    else
+    {
+      i++;
+    }
+  }
+
+  if (!active && _nullDelay)
+    delay(1);
+}
+
+bool WebServer::waitForActivity(unsigned long timeout_ms, int extraFd)
+{
+  std::vector<struct pollfd> fds;
+
+  if (_server.fd() >= 0)
+    fds.push_back( { _server.fd(), POLLIN, 0 } );
+
+  if (extraFd >= 0)
+    fds.push_back( { extraFd, POLLIN, 0 } );
+
+  for (const auto& pending : _pendingClients)
+  {
+    unsigned long waited = millis() - pending.accepted;
+
+    timeout_ms = std::min(timeout_ms, (waited < HTTP_MAX_DATA_WAIT) ? HTTP_MAX_DATA_WAIT - waited : 0UL);
+    fds.push_back( { pending.client.fd(), POLLIN, 0 } );
+  }
+
+  bool virtualClock = WM_Host::isVirtualClock();
+  int  res          = poll(fds.data(), fds.size(), virtualClock ? 0 : (int) timeout_ms);
+
+  wakeups++;
+
+  if (res > 0)
+    return true;
+
+  if (virtualClock)
+    WM_Host::advance((uint64_t) timeout_ms * 1000);
+
+  return false;
+}
+
+////////////////////////////////////////////////////
+
+int WebServer::handleRequest(PendingClient& pending)
+{
+  char buf[1024];
+  int  len;
+
+  while ( (len = pending.client.read((uint8_t*) buf, sizeof(buf))) > 0 )
+  {
+    pending.data.append(buf, len);
+
+    if (pending.data.size() > HTTP_MAX_REQUEST_SIZE)
+      return -1;
+  }
+
+  size_t headEnd = pending.data.find("\r\n\r\n");
+
+  if (headEnd == std::string::npos)
+    return pending.client.connected() ? 0 : -1;
+
+  std::string head = pending.data.substr(0, headEnd);
+  size_t      body = headEnd + 4;
+  size_t      contentLength = 0;
+
+  // Content-Length, before the whole body is there
+  for (size_t pos = 0; (pos = head.find("\r\n", pos)) != std::string::npos; pos += 2)
+  {
+    if (strncasecmp(head.c_str() + pos + 2, "Content-Length:", 15) == 0)
+      contentLength = strtoul(head.c_str() + pos + 17, nullptr, 10);
+  }
+
+  if (contentLength > HTTP_MAX_REQUEST_SIZE)
+    return -1;
+
+  if (pending.data.size() - body < contentLength)
+    return pending.client.connected() ? 0 : -1;
+
+  _currentClient = pending.client;
+
+  if (!parseRequest(head, pending.data.substr(body, contentLength)))
+  {
+    send(400, "text/plain", "Bad Request");
+  }
+  else
+  {
+    bool handled = false;
+
+    for (const auto& handler : _handlers)
+    {
+      if ( (handler.uri == _currentUri) && ( (handler.method == HTTP_ANY) || (handler.method == _currentMethod) ) )
+      {
+        handler.handler();
+        handled = true;
+
+        break;
+      }
+    }
+
+    if (!handled)
+    {
+      if (_notFoundHandler)
+        _notFoundHandler();
+      else
+        send(404, "text/plain", String("Not found: ") + _currentUri);
+    }
+  }
+
+  _currentClient.stop();
+  _currentArgs.clear();
+  _currentHeaders.clear();
+  _responseHeaders  = "";
+  _contentLength    = CONTENT_LENGTH_NOT_SET;
+  _chunked          = false;
+
+  return 1;
+}
+
+bool WebServer::parseRequest(const std::string& head, const std::string& body)
+{
+  size_t      lineEnd = head.find("\r\n");
+  std::string request = head.substr(0, lineEnd);
+
+  size_t      space1  = request.find(' ');
+  size_t      space2  = request.find(' ', space1 + 1);
+
+  if ( (space1 == std::string::npos) || (space2 == std::string::npos) )
+    return false;
+
+  std::string methodStr = request.substr(0, space1);
+  std::string url       = request.substr(space1 + 1, space2 - space1 - 1);
+
+  static const struct
+  {
+    const char* name;
+    HTTPMethod  method;
+  } methods[] =
+  {
+    { "GET",      HTTP_GET },
+    { "HEAD",     HTTP_HEAD },
+    { "POST",     HTTP_POST },
+    { "PUT",      HTTP_PUT },
+    { "PATCH",    HTTP_PATCH },
+    { "DELETE",   HTTP_DELETE },
+    { "OPTIONS",  HTTP_OPTIONS },
+  };
+
+  _currentMethod = HTTP_ANY;
+
+  for (const auto& method : methods)
+  {
+    if (methodStr == method.name)
+      _currentMethod = method.method;
+  }
+
+  if (_currentMethod == HTTP_ANY)
+    return false;
+
+  size_t query  = url.find('?');
+
+  _currentUri   = url.substr(0, query).c_str();
+  _currentArgs.clear();
+  _currentHeaders.clear();
+
+  while (lineEnd != std::string::npos)
+  {
+    size_t      start = lineEnd + 2;
+
+    lineEnd = head.find("\r\n", start);
+
+    std::string line  = head.substr(start, (lineEnd == std::string::npos) ? std::string::npos : lineEnd - start);
+    size_t      colon = line.find(':');
+
+    if (colon == std::string::npos)
+      continue;
+
+    size_t valueStart = line.find_first_not_of(' ', colon + 1);
+
+    _currentHeaders.push_back( { String(line.substr(0, colon).c_str()),
+                                 String( (valueStart == std::string::npos) ? "" : line.substr(valueStart).c_str() ) } );
+  }
+
+  if (query != std::string::npos)
+    parseArguments(String(url.substr(query + 1).c_str()));
+
+  if (!body.empty())
+  {
+    if (header("Content-Type").startsWith("application/x-www-form-urlencoded"))
+      parseArguments(String(body.c_str()));
+    else
+      _currentArgs.push_back( { String("plain"), String(body.c_str(), body.size()) } );
+  }
+
+  return true;
+}
+
+void WebServer::parseArguments(const String& data)
+{
+  int pos = 0;
+
+  while (pos < (int) data.length())
+  {
+    int end = data.indexOf('&', pos);
+
+    if (end < 0)
+      end = data.length();
+
+    String pair = data.substring(pos, end);
+    int    eq   = pair.indexOf('=');
+
+    if (pair.length())
+    {
+      if (eq < 0)
+        _currentArgs.push_back( { urlDecode(pair), String() } );
+      else
+        _currentArgs.push_back( { urlDecode(pair.substring(0, eq)), urlDecode(pair.substring(eq + 1)) } );
+    }
+
+    pos = end + 1;
+  }
+}
+
+String WebServer::urlDecode(const String& text)
+{
+  String       decoded;
+  unsigned int len = text.length();
+
+  decoded.reserve(len);
+
+  for (unsigned int i = 0; i < len; i++)
+  {
+    char c = text[i];
+
+    if (c == '+')
+    {
+      c = ' ';
+    }
+    else if ( (c == '%') && (i + 2 < len) && isxdigit(text[i + 1]) && isxdigit(text[i + 2]) )
+    {
+      char hex[3] = { text[i + 1], text[i + 2], 0 };
+
+      c = (char) strtol(hex, nullptr, 16);
+      i += 2;
+    }
+
+    decoded += c;
+  }
+
+  return decoded;
+}
+
+////////////////////////////////////////////////////
+
+String WebServer::arg(const String& name)
+{
+  for (const auto& arg : _currentArgs)
+  {
+    if (arg.name == name)
+      return arg.value;
+  }
+
+  return String();
+}
+
+String WebServer::arg(int i)
+{
+  return (i >= 0) && (i < (int) _currentArgs.size()) ? _currentArgs[i].value : String();
+}
+
+String WebServer::argName(int i)
+{
+  return (i >= 0) && (i < (int) _currentArgs.size()) ? _currentArgs[i].name : String();
+}
+
+int WebServer::args()
+{
+  return _currentArgs.size();
+}
+
+bool WebServer::hasArg(const String& name)
+{
+  for (const auto& arg : _currentArgs)
+  {
+    if (arg.name == name)
+      return true;
+  }
+
+  return false;
+}
+
+String WebServer::header(const String& name)
+{
+  for (const auto& header : _currentHeaders)
+  {
+    if (header.name.equalsIgnoreCase(name))
+      return header.value;
+  }
+
+  return String();
+}
+
+bool WebServer::hasHeader(const String& name)
+{
+  for (const auto& header : _currentHeaders)
+  {
+    if (header.name.equalsIgnoreCase(name))
+      return true;
+  }
+
+  return false;
+}
+
+String WebServer::hostHeader()
+{
+  return header("Host");
+}
+
+////////////////////////////////////////////////////
+
+void WebServer::sendHeader(const String& name, const String& value, bool first)
+{
+  String headerLine = name + ": " + value + "\r\n";
+
+  if (first)
+    _responseHeaders = headerLine + _responseHeaders;
+  else
+    _responseHeaders += headerLine;
+}
+
+// Same header order as the ESP32 core
+void WebServer::prepareHeader(String& response, int code, const char* content_type, size_t contentLength)
+{
+  response = String("HTTP/1.1 ") + String(code) + " " + responseCodeToString(code) + "\r\n";
+
+  sendHeader("Content-Type", content_type ? content_type : "text/html", true);
+
+  if (_contentLength == CONTENT_LENGTH_NOT_SET)
+  {
+    sendHeader("Content-Length", String((unsigned long) contentLength));
+  }
+  else if (_contentLength != CONTENT_LENGTH_UNKNOWN)
+  {
+    sendHeader("Content-Length", String((unsigned long) _contentLength));
+  }
+  else
+  {
+    _chunked = true;
+    sendHeader("Accept-Ranges", "none");
+    sendHeader("Transfer-Encoding", "chunked");
+  }
+
+  if (_corsEnabled)
+  {
+    sendHeader("Access-Control-Allow-Origin", "*");
+    sendHeader("Access-Control-Allow-Methods", "*");
+    sendHeader("Access-Control-Allow-Headers", "*");
+  }
+
+  sendHeader("Connection", "close");
+
+  response += _responseHeaders;
+  response += "\r\n";
+
+  _responseHeaders = "";
+}
+
+void WebServer::send(int code, const char* content_type, const String& content)
+{
+  String header;
+
+  prepareHeader(header, code, content_type, content.length());
+
+  // One write, as the core does for short responses
+  if (content.length() && (_currentMethod != HTTP_HEAD))
+    header += content;
+
+  _currentClient.write(header.c_str(), header.length());
+}
+
+void WebServer::send(int code, char* content_type, const String& content)
+{
+  send(code, (const char*) content_type, content);
+}
+
+void WebServer::send(int code, const String& content_type, const String& content)
+{
+  send(code, content_type.c_str(), content);
+}
+
+void WebServer::send_P(int code, PGM_P content_type, PGM_P content)
+{
+  send_P(code, content_type, content, content ? strlen(content) : 0);
+}
+
+void WebServer::send_P(int code, PGM_P content_type, PGM_P content, size_t contentLength)
+{
+  String header;
+
+  prepareHeader(header, code, content_type, contentLength);
+  _currentClient.write(header.c_str(), header.length());
+
+  if (contentLength && (_currentMethod != HTTP_HEAD))
+    _currentClient.write(content, contentLength);
+}
+
+void WebServer::sendContent(const String& content)
+{
+  sendContent(content.c_str(), content.length());
+}
+
+void WebServer::sendContent(const char* content, size_t contentLength)
+{
+  if (_currentMethod == HTTP_HEAD)
+    return;
+
+  if (_chunked)
+  {
+    // 16 hex digits of a 64-bit size_t, CRLF, terminating zero
+    char size[19];
+
+    snprintf(size, sizeof(size), "%zx\r\n", contentLength);
+    _currentClient.write(size, strlen(size));
+  }
+
+  if (contentLength)
+    _currentClient.write(content, contentLength);
+
+  if (_chunked)
+  {
+    _currentClient.write("\r\n", 2);
+
+    // Last chunk
+    if (contentLength == 0)
+      _chunked = false;
+  }
+}
+
+void WebServer::sendContent_P(PGM_P content)
+{
+  sendContent(content, strlen(content));
+}
+
+void WebServer::sendContent_P(PGM_P content, size_t size)
+{
+  sendContent(content, size);
+}
+
+const char* WebServer::responseCodeToString(int code)
+{
+  switch (code)
+  {
+    case 200: return "OK";
+    case 204: return "No Content";
+    case 206: return "Partial Content";
+    case 301: return "Moved Permanently";
+    case 302: return "Found";
+    case 304: return "Not Modified";
+    case 307: return "Temporary Redirect";
+    case 400: return "Bad Request";
+    case 401: return "Unauthorized";
+    case 403: return "Forbidden";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 413: return "Payload Too Large";
+    case 416: return "Range Not Satisfiable";
+    case 429: return "Too Many Requests";
+    case 500: return "Internal Server Error";
+    case 503: return "Service Unavailable";
+    default:  return "";
+  }
+}
@@ -0,0 +1,209 @@
+/****************************************************************************************************************************
+  WebServer.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  The ESP32 core WebServer API, as patched in esp32s2_WebServer_Patch (non-blocking request heads, up to
+  HTTP_MAX_PENDING_CLIENTS partial requests, waitForActivity()), over POSIX sockets. One response per
+  connection, with "Connection: close" as the ESP32 core. No uploads, authentication or static files.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WebServer_h
+#define WebServer_h
+
+#include <functional>
+#include <vector>
+
+#include "WiFi.h"
+
+#ifndef HTTP_MAX_DATA_WAIT
+  #define HTTP_MAX_DATA_WAIT          5000    // ms to wait for the whole request
+#endif
+
+#ifndef HTTP_MAX_PENDING_CLIENTS
+  #define HTTP_MAX_PENDING_CLIENTS    8       // connections with a partial request
+#endif
+
+#ifndef HTTP_MAX_REQUEST_SIZE
+  #define HTTP_MAX_REQUEST_SIZE       16384   // head and body
+#endif
+
+#define WEBSERVER_HAS_WAIT_FOR_ACTIVITY   1
+
+#define CONTENT_LENGTH_UNKNOWN      ((size_t) -1)
+#define CONTENT_LENGTH_NOT_SET      ((size_t) -2)
+
+enum HTTPMethod
+{
+  HTTP_ANY,
+  HTTP_GET,
+  HTTP_HEAD,
+  HTTP_POST,
+  HTTP_PUT,
+  HTTP_PATCH,
+  HTTP_DELETE,
+  HTTP_OPTIONS
+};
+
+////////////////////////////////////////////////////
+
+class WebServer
+{
+  public:
+
+    typedef std::function<void(void)> THandlerFunction;
+
+    WebServer(int port = 80) : _server(port) {}
+
+    virtual ~WebServer()
+    {
+      close();
+    }
+
+    void        begin()
+    {
+      _server.begin();
+    }
+
+    void        begin(uint16_t port)
+    {
+      _server.begin(port);
+    }
+
+    // Accepts, reads what arrived, and answers every complete request
+    void        handleClient();
+
+    // Sleep until a connection, request data or extraFd becomes readable, or timeout_ms elapses.
+    // Returns true if there is something to handle. With the virtual clock : doesn't sleep, advances the clock.
+    bool        waitForActivity(unsigned long timeout_ms, int extraFd = -1);
+
+    void        close();
+
+    void        stop()
+    {
+      close();
+    }
+
+    void        on(const String& uri, THandlerFunction handler)
+    {
+      on(uri, HTTP_ANY, handler);
+    }
+
+    void        on(const String& uri, HTTPMethod method, THandlerFunction handler);
+    void        onNotFound(THandlerFunction handler)
+    {
+      _notFoundHandler = handler;
+    }
+
+    String      uri()
+    {
+      return _currentUri;
+    }
+
+    HTTPMethod  method()
+    {
+      return _currentMethod;
+    }
+
+    WiFiClient  client()
+    {
+      return _currentClient;
+    }
+
+    String      arg(const String& name);
+    String      arg(int i);
+    String      argName(int i);
+    int         args();
+    bool        hasArg(const String& name);
+
+    String      header(const String& name);
+    bool        hasHeader(const String& name);
+    String      hostHeader();
+
+    void        send(int code, const char* content_type = NULL, const String& content = String(""));
+    void        send(int code, char* content_type, const String& content);
+    void        send(int code, const String& content_type, const String& content);
+    void        send_P(int code, PGM_P content_type, PGM_P content);
+    void        send_P(int code, PGM_P content_type, PGM_P content, size_t contentLength);
+
+    void        enableDelay(bool value)
+    {
+      _nullDelay = value;
+    }
+
+    void        enableCORS(bool value = true)
+    {
+      _corsEnabled = value;
+    }
+
+    void        enableCrossOrigin(bool value = true)
+    {
+      enableCORS(value);
+    }
+
+    void        setContentLength(const size_t contentLength)
+    {
+      _contentLength = contentLength;
+    }
+
+    void        sendHeader(const String& name, const String& value, bool first = false);
+    void        sendContent(const String& content);
+    void        sendContent(const char* content, size_t contentLength);
+    void        sendContent_P(PGM_P content);
+    void        sendContent_P(PGM_P content, size_t size);
+
+    static String urlDecode(const String& text);
+
+  protected:
+
+    typedef struct
+    {
+      String            uri;
+      HTTPMethod        method;
+      THandlerFunction  handler;
+    } Handler;
+
+    typedef struct
+    {
+      WiFiClient        client;
+      std::string       data;
+      unsigned long     accepted;
+    } PendingClient;
+
+    typedef struct
+    {
+      String            name;
+      String            value;
+    } Pair;
+
+    // 1 : complete request handled, 0 : not complete yet, -1 : bad request or gone
+    int         handleRequest(PendingClient& pending);
+    bool        parseRequest(const std::string& head, const std::string& body);
+    void        parseArguments(const String& data);
+    void        prepareHeader(String& response, int code, const char* content_type, size_t contentLength);
+
+    static const char* responseCodeToString(int code);
+
+    WiFiServer                  _server;
+    std::vector<Handler>        _handlers;
+    THandlerFunction            _notFoundHandler;
+    std::vector<PendingClient>  _pendingClients;
+
+    WiFiClient                  _currentClient;
+    HTTPMethod                  _currentMethod  = HTTP_ANY;
+    String                      _currentUri;
+    std::vector<Pair>           _currentArgs;
+    std::vector<Pair>           _currentHeaders;
+
+    String                      _responseHeaders;
+    size_t                      _contentLength  = CONTENT_LENGTH_NOT_SET;
+    bool                        _chunked        = false;
+    bool                        _nullDelay      = true;
+    bool                        _corsEnabled    = false;
+};
+
+#endif    // WebServer_h
@@ -0,0 +1,1196 @@
+/****************************************************************************************************************************
+  WiFi.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Simulated radio, and the ESP32 WiFi object over it
+ *****************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <fstream>
+
+#include "WiFi.h"
+#include "WM_Host.h"
+
+WiFiClass WiFi;
+
+////////////////////////////////////////////////////
+
+namespace
+{
+  uint64_t nowMs()
+  {
+    return WM_Host::micros64() / 1000;
+  }
+
+  // Splits on blanks, "quoted strings" kept whole. Stops at '#'.
+  std::vector<std::string> tokenize(const char* line)
+  {
+    std::vector<std::string> tokens;
+    const char*              p = line;
+
+    while (*p)
+    {
+      while ( (*p == ' ') || (*p == '\t') || (*p == '\r') || (*p == '\n') )
+        p++;
+
+      if (!*p || (*p == '#'))
+        break;
+
+      std::string token;
+
+      while (*p && (*p != ' ') && (*p != '\t') && (*p != '\r') && (*p != '\n'))
+      {
+        if (*p == '"')
+        {
+          p++;
+
+          while (*p && (*p != '"'))
+            token += *p++;
+
+          if (*p)
+            p++;
+        }
+        else
+        {
+          token += *p++;
+        }
+      }
+
+      tokens.push_back(token);
+    }
+
+    return tokens;
+  }
+
+  bool parseAuth(const std::string& value, wifi_auth_mode_t& auth)
+  {
+    static const struct
+    {
+      const char*       name;
+      wifi_auth_mode_t  auth;
+    } names[] =
+    {
+      { "open",       WIFI_AUTH_OPEN },
+      { "wep",        WIFI_AUTH_WEP },
+      { "wpa",        WIFI_AUTH_WPA_PSK },
+      { "wpa2",       WIFI_AUTH_WPA2_PSK },
+      { "wpa_wpa2",   WIFI_AUTH_WPA_WPA2_PSK },
+      { "wpa3",       WIFI_AUTH_WPA3_PSK },
+      { "wpa2_wpa3",  WIFI_AUTH_WPA2_WPA3_PSK },
+    };
+
+    for (const auto& name : names)
+    {
+      if (value == name.name)
+      {
+        auth = name.auth;
+
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  bool parseFailure(const std::string& value, WM_HostFailure& failure)
+  {
+    static const char* names[] = { "none", "assoc", "auth", "dhcp" };
+
+    for (uint8_t i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+    {
+      if (value == names[i])
+      {
+        failure = (WM_HostFailure) i;
+
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  bool parseBSSID(const std::string& value, uint8_t* bssid)
+  {
+    unsigned b[6];
+
+    if (sscanf(value.c_str(), "%x:%x:%x:%x:%x:%x", &b[0], &b[1], &b[2], &b[3], &b[4], &b[5]) != 6)
+      return false;
+
+    for (uint8_t i = 0; i < 6; i++)
+      bssid[i] = b[i];
+
+    return true;
+  }
+
+  bool parseInt(const std::string& value, long& result)
+  {
+    char* end;
+
+    result = strtol(value.c_str(), &end, 10);
+
+    return !value.empty() && (*end == 0);
+  }
+}
+
+////////////////////////////////////////////////////
+// Radio
+
+WM_HostRadio& WM_HostRadio::get()
+{
+  static WM_HostRadio radio;
+
+  return radio;
+}
+
+void WM_HostRadio::reset()
+{
+  _aps.clear();
+  _scanResults.clear();
+  _events.clear();
+  _hosts.clear();
+  _error.clear();
+
+  storedSSID.clear();
+  storedPassword.clear();
+
+  _staSSID.clear();
+  _staPassword.clear();
+  _staPhase   = STA_IDLE;
+  _staStatus  = WL_NO_SHIELD;
+  _staIP      = IPAddress();
+  _staticIP   = IPAddress();
+
+  channelMs   = 120;
+  channels    = 13;
+  minRSSI     = -90;
+
+  _epoch      = nowMs();
+  _rng.seed(1);
+  _stats      = WM_HostRadioStats();
+  _attempting = false;
+}
+
+void WM_HostRadio::replay(const uint32_t& seed)
+{
+  reset();
+
+  for (const auto& line : _scenario)
+    command(line.c_str());
+
+  _rng.seed(seed);
+}
+
+bool WM_HostRadio::loadScenario(const char* path)
+{
+  std::ifstream file(path);
+  std::string   line;
+  int           lineNumber = 0;
+
+  if (!file)
+  {
+    _error = std::string("can't open ") + path;
+
+    return false;
+  }
+
+  _scenario.clear();
+
+  while (std::getline(file, line))
+  {
+    lineNumber++;
+    _scenario.push_back(line);
+
+    if (!command(line.c_str()))
+    {
+      _error = std::string(path) + ":" + std::to_string(lineNumber) + ": " + _error;
+
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool WM_HostRadio::command(const char* line)
+{
+  std::vector<std::string> args = tokenize(line);
+
+  _error.clear();
+
+  if (args.empty())
+    return true;
+
+  if (args[0] == "at")
+  {
+    long at;
+
+    if ( (args.size() < 3) || !parseInt(args[1], at) || (at < 0) )
+    {
+      _error = "usage: at <ms> <command>";
+
+      return false;
+    }
+
+    // Checked now rather than when it runs
+    std::vector<std::string> rest(args.begin() + 2, args.end());
+    std::string              text;
+
+    for (const auto& arg : rest)
+      text += "\"" + arg + "\" ";
+
+    Event event = { _epoch + at, text };
+
+    auto pos = std::upper_bound(_events.begin(), _events.end(), event, [](const Event & a, const Event & b)
+    {
+      return a.at < b.at;
+    });
+
+    _events.insert(pos, event);
+
+    return true;
+  }
+
+  runCommand(args);
+
+  return _error.empty();
+}
+
+void WM_HostRadio::runCommand(const std::vector<std::string>& args)
+{
+  const std::string& cmd = args[0];
+
+  if (cmd == "set")
+  {
+    for (size_t i = 1; i < args.size(); i++)
+    {
+      size_t      eq    = args[i].find('=');
+      std::string key   = args[i].substr(0, eq);
+      long        value;
+
+      if ( (eq == std::string::npos) || !parseInt(args[i].substr(eq + 1), value) )
+        _error = "bad value " + args[i];
+      else if ( (key == "channel_ms") && (value >= 0) )
+        channelMs = value;
+      else if ( (key == "channels") && (value > 0) && (value <= 14) )
+        channels = value;
+      else if (key == "min_rssi")
+        minRSSI = value;
+      else if ( (key == "seed") && (value >= 0) )
+        _rng.seed(value);
+      else
+        _error = "bad setting " + args[i];
+    }
+  }
+  else if (cmd == "ap")
+  {
+    if (args.size() < 2)
+    {
+      _error = "usage: ap <ssid> [key=value ...]";
+
+      return;
+    }
+
+    WM_HostAP* ap = findAP(args[1].c_str());
+
+    if (!ap)
+      ap = &addAP(args[1].c_str());
+
+    for (size_t i = 2; i < args.size(); i++)
+    {
+      size_t      eq    = args[i].find('=');
+      std::string key   = args[i].substr(0, eq);
+      std::string value = (eq == std::string::npos) ? "" : args[i].substr(eq + 1);
+      long        number;
+      bool        isNumber = parseInt(value, number);
+
+      if (eq == std::string::npos)
+        _error = "expected key=value : " + args[i];
+      else if (key == "password")
+        ap->password = value;
+      else if ( (key == "rssi") && isNumber )
+        ap->rssi = number;
+      else if ( (key == "channel") && isNumber && (number > 0) && (number <= 14) )
+        ap->channel = number;
+      else if ( (key == "hidden") && isNumber )
+        ap->hidden = (number != 0);
+      else if ( (key == "assoc") && isNumber && (number >= 0) )
+        ap->assocMs = number;
+      else if ( (key == "auth_ms") && isNumber && (number >= 0) )
+        ap->authMs = number;
+      else if ( (key == "dhcp") && isNumber && (number >= 0) )
+        ap->dhcpMs = number;
+      else if ( (key == "jitter") && isNumber && (number >= 0) )
+        ap->jitterMs = number;
+      else if ( (key == "fail_pct") && isNumber && (number >= 0) && (number <= 100) )
+        ap->failPct = number;
+      else if ( (key == "auth") && parseAuth(value, ap->auth) )
+        continue;
+      else if ( (key == "fail") && parseFailure(value, ap->failure) )
+        continue;
+      else if ( (key == "bssid") && parseBSSID(value, ap->bssid) )
+        continue;
+      else if ( (key == "ip") && ap->ip.fromString(value.c_str()) )
+        continue;
+      else
+        _error = "bad setting " + args[i];
+    }
+
+    // A password and no auth= : WPA2
+    if ( (ap->auth == WIFI_AUTH_OPEN) && !ap->password.empty() )
+      ap->auth = WIFI_AUTH_WPA2_PSK;
+  }
+  else if ( (cmd == "down") || (cmd == "up") || (cmd == "remove") || (cmd == "rssi") || (cmd == "trace") )
+  {
+    WM_HostAP* ap = (args.size() >= 2) ? findAP(args[1].c_str()) : nullptr;
+
+    if (!ap)
+    {
+      _error = "no AP " + ((args.size() >= 2) ? args[1] : std::string());
+
+      return;
+    }
+
+    if (cmd == "rssi")
+    {
+      long rssi;
+
+      if ( (args.size() < 3) || !parseInt(args[2], rssi) )
+        _error = "usage: rssi <ssid> <dBm>";
+      else
+        ap->rssi = rssi;
+
+      return;
+    }
+
+    if (cmd == "trace")
+    {
+      long period;
+
+      ap->trace.clear();
+
+      if ( (args.size() < 4) || !parseInt(args[2], period) || (period <= 0) )
+      {
+        _error = "usage: trace <ssid> <period_ms> <dBm> [<dBm> ...]";
+
+        return;
+      }
+
+      for (size_t i = 3; i < args.size(); i++)
+      {
+        long rssi;
+
+        if (!parseInt(args[i], rssi))
+        {
+          _error = "bad RSSI " + args[i];
+          ap->trace.clear();
+
+          return;
+        }
+
+        ap->trace.push_back(rssi);
+      }
+
+      ap->tracePeriodMs = period;
+      ap->traceStart    = _inUpdate ? _eventTime : nowMs();
+      ap->rssi          = ap->trace[0];
+
+      return;
+    }
+
+    if ( (cmd != "up") && (_staStatus == WL_CONNECTED) && (_staSSID == ap->ssid) )
+    {
+      _staStatus  = WL_CONNECTION_LOST;
+      _staIP      = IPAddress();
+    }
+
+    if (cmd == "remove")
+      removeAP(args[1].c_str());
+    else
+      ap->up = (cmd == "up");
+  }
+  else if (cmd == "host")
+  {
+    IPAddress ip;
+
+    if ( (args.size() < 3) || !ip.fromString(args[2].c_str()) )
+      _error = "usage: host <name> <ip>";
+    else
+      _hosts.push_back(std::make_pair(args[1], ip));
+  }
+  else
+  {
+    _error = "unknown command " + cmd;
+  }
+}
+
+WM_HostAP& WM_HostRadio::addAP(const char* ssid, const char* password)
+{
+  WM_HostAP ap;
+
+  ap.ssid     = ssid;
+  ap.password = password;
+  ap.bssid[0] = 0x02;
+  ap.bssid[1] = ap.bssid[2] = ap.bssid[3] = ap.bssid[4] = 0;
+  ap.bssid[5] = _aps.size() + 1;
+  ap.channel  = 1;
+  ap.rssi     = -60;
+  ap.auth     = *password ? WIFI_AUTH_WPA2_PSK : WIFI_AUTH_OPEN;
+  ap.hidden   = false;
+  ap.up       = true;
+  ap.assocMs  = 50;
+  ap.authMs   = 100;
+  ap.dhcpMs   = 300;
+  ap.jitterMs = 0;
+  ap.failure  = WM_HOST_FAIL_NONE;
+  ap.failPct  = 100;
+  ap.ip       = IPAddress(192, 168, 1, 100);
+  ap.tracePeriodMs  = 0;
+  ap.traceStart     = 0;
+
+  _aps.push_back(ap);
+
+  return _aps.back();
+}
+
+WM_HostAP* WM_HostRadio::findAP(const char* ssid)
+{
+  for (auto& ap : _aps)
+  {
+    if (ap.ssid == ssid)
+      return &ap;
+  }
+
+  return nullptr;
+}
+
+bool WM_HostRadio::removeAP(const char* ssid)
+{
+  for (auto it = _aps.begin(); it != _aps.end(); ++it)
+  {
+    if (it->ssid == ssid)
+    {
+      _aps.erase(it);
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void WM_HostRadio::update()
+{
+  // Scenario commands don't call back into update(), but stay safe
+  if (_inUpdate)
+    return;
+
+  _inUpdate = true;
+
+  uint64_t now = nowMs();
+
+  while (!_events.empty() && (_events.front().at <= now))
+  {
+    Event event = _events.front();
+
+    _events.erase(_events.begin());
+
+    updateRSSI(event.at);
+    advanceStation(event.at);
+
+    _eventTime = event.at;
+    command(event.line.c_str());
+
+    if (!_error.empty())
+      fprintf(stderr, "WM_HostRadio: at %llu: %s\n", (unsigned long long) event.at, _error.c_str());
+  }
+
+  updateRSSI(now);
+  advanceStation(now);
+
+  _inUpdate = false;
+}
+
+void WM_HostRadio::updateRSSI(const uint64_t& now)
+{
+  for (auto& ap : _aps)
+  {
+    if (!ap.trace.empty() && (now >= ap.traceStart))
+      ap.rssi = ap.trace[( (now - ap.traceStart) / ap.tracePeriodMs) % ap.trace.size()];
+  }
+}
+
+uint32_t WM_HostRadio::phaseMs(const WM_HostAP& ap, const uint32_t& ms)
+{
+  return ms + (ap.jitterMs ? _rng() % (ap.jitterMs + 1) : 0);
+}
+
+void WM_HostRadio::endAttempt(const uint64_t& now)
+{
+  if (_attempting)
+  {
+    _stats.radioOnMs += now - _attemptStart;
+    _attempting = false;
+  }
+}
+
+WM_HostRadioStats WM_HostRadio::stats()
+{
+  update();
+
+  WM_HostRadioStats stats = _stats;
+
+  if (_attempting)
+    stats.radioOnMs += nowMs() - _attemptStart;
+
+  return stats;
+}
+
+void WM_HostRadio::advanceStation(const uint64_t& now)
+{
+  while ( (_staPhase != STA_IDLE) && (_staPhase != STA_DONE) && (_phaseEnd <= now) )
+  {
+    WM_HostAP* ap     = findAP(_staSSID.c_str());
+    uint64_t   at     = _phaseEnd;
+
+    if ( (_staPhase == STA_FIND) ? !findable(ap) : (!ap || !audible(*ap)) )
+    {
+      _staStatus  = WL_NO_SSID_AVAIL;
+      _staPhase   = STA_DONE;
+      endAttempt(at);
+
+      break;
+    }
+
+    bool fails = (_attemptDraw < ap->failPct);
+
+    switch (_staPhase)
+    {
+      case STA_FIND:
+        _staPhase   = STA_ASSOC;
+        _phaseEnd  += phaseMs(*ap, ap->assocMs);
+
+        break;
+
+      case STA_ASSOC:
+        if ( (ap->failure == WM_HOST_FAIL_ASSOC) && fails )
+        {
+          _staStatus  = WL_CONNECT_FAILED;
+          _staPhase   = STA_DONE;
+          endAttempt(at);
+        }
+        else
+        {
+          _staPhase   = STA_AUTH;
+          _phaseEnd  += phaseMs(*ap, ap->authMs);
+        }
+
+        break;
+
+      case STA_AUTH:
+        if ( ( (ap->failure == WM_HOST_FAIL_AUTH) && fails ) ||
+             ( (ap->auth != WIFI_AUTH_OPEN) && (ap->password != _staPassword) ) )
+        {
+          _staStatus  = WL_CONNECT_FAILED;
+          _staPhase   = STA_DONE;
+          endAttempt(at);
+        }
+        else
+        {
+          // No DHCP with a static IP
+          _staPhase   = STA_DHCP;
+          _phaseEnd  += (_staticIP == IPAddress()) ? phaseMs(*ap, ap->dhcpMs) : 0;
+        }
+
+        break;
+
+      case STA_DHCP:
+        _staPhase = STA_DONE;
+
+        // Never gets an address : stays disconnected, radio on, as a real station until the sketch gives up
+        if ( (ap->failure == WM_HOST_FAIL_DHCP) && fails && (_staticIP == IPAddress()) )
+          break;
+
+        _staStatus  = WL_CONNECTED;
+        _staIP      = (_staticIP != IPAddress()) ? _staticIP : ap->ip;
+        endAttempt(at);
+
+        if (_stats.connectedMs == 0)
+          _stats.connectedMs = std::max(at - _epoch, (uint64_t) 1);
+
+        break;
+
+      default:
+        break;
+    }
+  }
+}
+
+void WM_HostRadio::staBegin(const char* ssid, const char* password, const int32_t& channel, const uint8_t* bssid)
+{
+  update();
+  endAttempt(nowMs());
+
+  _staSSID      = ssid ? ssid : "";
+  _staPassword  = password ? password : "";
+  _staChannel   = channel;
+  _staDirected  = (bssid != nullptr);
+  _staStatus    = WL_DISCONNECTED;
+  _staIP        = IPAddress();
+  _staPhase     = STA_FIND;
+
+  if (bssid)
+    memcpy(_staBSSID, bssid, sizeof(_staBSSID));
+
+  _stats.attempts++;
+  _attempting   = true;
+  _attemptStart = nowMs();
+  _attemptDraw  = _rng() % 100;
+
+  WM_HostAP* ap = findAP(_staSSID.c_str());
+  uint32_t   swept;
+
+  // The core's fast scan stops on the AP's channel. Not there : gives up after a full sweep.
+  if (channel)
+    swept = 1;
+  else if (findable(ap))
+    swept = ap->channel;
+  else
+    swept = channels;
+
+  _phaseEnd     = nowMs() + swept * channelMs;
+}
+
+void WM_HostRadio::staStart()
+{
+  update();
+
+  if (_staStatus == WL_NO_SHIELD)
+    _staStatus = WL_DISCONNECTED;
+}
+
+void WM_HostRadio::staStop()
+{
+  staDisconnect();
+
+  _staStatus = WL_NO_SHIELD;
+}
+
+void WM_HostRadio::staDisconnect()
+{
+  update();
+  endAttempt(nowMs());
+
+  _staPhase   = STA_IDLE;
+  _staStatus  = WL_DISCONNECTED;
+  _staIP      = IPAddress();
+}
+
+wl_status_t WM_HostRadio::staStatus()
+{
+  update();
+
+  return _staStatus;
+}
+
+WM_HostAP* WM_HostRadio::staAP()
+{
+  if (staStatus() != WL_CONNECTED)
+    return nullptr;
+
+  return findAP(_staSSID.c_str());
+}
+
+int16_t WM_HostRadio::scan(const bool& showHidden)
+{
+  _stats.scans++;
+  _stats.radioOnMs += (uint32_t) channels * channelMs;
+
+  delay((uint32_t) channels * channelMs);
+
+  update();
+
+  _scanResults.clear();
+
+  for (const auto& ap : _aps)
+  {
+    if (!audible(ap) || (ap.hidden && !showHidden))
+      continue;
+
+    _scanResults.push_back(ap);
+
+    if (ap.hidden)
+      _scanResults.back().ssid.clear();
+  }
+
+  return _scanResults.size();
+}
+
+bool WM_HostRadio::hostByName(const char* name, IPAddress& ip)
+{
+  if (ip.fromString(name))
+    return true;
+
+  for (const auto& host : _hosts)
+  {
+    if (host.first == name)
+    {
+      ip = host.second;
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////
+// ESP-IDF
+
+esp_err_t esp_wifi_sta_get_ap_info(wifi_ap_record_t* ap_info)
+{
+  WM_HostAP* ap = WM_HostRadio::get().staAP();
+
+  if (!ap)
+    return ESP_ERR_WIFI_NOT_CONNECT;
+
+  memset(ap_info, 0, sizeof(*ap_info));
+  memcpy(ap_info->bssid, ap->bssid, sizeof(ap_info->bssid));
+  strncpy((char*) ap_info->ssid, ap->ssid.c_str(), sizeof(ap_info->ssid) - 1);
+  ap_info->primary  = ap->channel;
+  ap_info->rssi     = ap->rssi;
+  ap_info->authmode = ap->auth;
+
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_get_config(wifi_interface_t interface, wifi_config_t* conf)
+{
+  WM_HostRadio& radio = WM_HostRadio::get();
+
+  memset(conf, 0, sizeof(*conf));
+
+  if (interface == WIFI_IF_STA)
+  {
+    // Same sizes, and same missing terminators at full length, as the IDF
+    memcpy(conf->sta.ssid, radio.storedSSID.c_str(), std::min(radio.storedSSID.size(), sizeof(conf->sta.ssid)));
+    memcpy(conf->sta.password, radio.storedPassword.c_str(),
+           std::min(radio.storedPassword.size(), sizeof(conf->sta.password)));
+  }
+  else
+  {
+    String ssid = WiFi.softAPSSID();
+
+    memcpy(conf->ap.ssid, ssid.c_str(), std::min((size_t) ssid.length(), sizeof(conf->ap.ssid)));
+    conf->ap.ssid_len = ssid.length();
+  }
+
+  return ESP_OK;
+}
+
+////////////////////////////////////////////////////
+// WiFi
+
+bool WiFiClass::mode(wifi_mode_t mode)
+{
+  if ( (_mode & WIFI_MODE_STA) && !(mode & WIFI_MODE_STA) )
+    WM_HostRadio::get().staStop();
+  else if ( !(_mode & WIFI_MODE_STA) && (mode & WIFI_MODE_STA) )
+    WM_HostRadio::get().staStart();
+
+  if ( (_mode & WIFI_MODE_AP) && !(mode & WIFI_MODE_AP) )
+    _apStarted = false;
+
+  _mode = mode;
+
+  return true;
+}
+
+wifi_mode_t WiFiClass::getMode()
+{
+  return _mode;
+}
+
+wl_status_t WiFiClass::begin(const char* ssid, const char* passphrase, int32_t channel, const uint8_t* bssid,
+                             bool connect)
+{
+  WM_HostRadio& radio = WM_HostRadio::get();
+
+  if (!ssid || !*ssid || (strlen(ssid) > 32) || (passphrase && (strlen(passphrase) > 64)) )
+    return WL_CONNECT_FAILED;
+
+  mode((wifi_mode_t) (_mode | WIFI_MODE_STA));
+
+  if (_persistent)
+  {
+    radio.storedSSID      = ssid;
+    radio.storedPassword  = passphrase ? passphrase : "";
+  }
+
+  if (connect)
+    radio.staBegin(ssid, passphrase, channel, bssid);
+
+  return radio.staStatus();
+}
+
+wl_status_t WiFiClass::begin()
+{
+  WM_HostRadio& radio = WM_HostRadio::get();
+
+  if (radio.storedSSID.empty())
+    return WL_CONNECT_FAILED;
+
+  mode((wifi_mode_t) (_mode | WIFI_MODE_STA));
+
+  radio.staBegin(radio.storedSSID.c_str(), radio.storedPassword.c_str());
+
+  return radio.staStatus();
+}
+
+bool WiFiClass::config(IPAddress local_ip, IPAddress gateway, IPAddress subnet, IPAddress dns1, IPAddress dns2)
+{
+  _useStaticIP    = (local_ip != IPAddress());
+  _staticIP       = local_ip;
+  _staticGateway  = gateway;
+  _staticSubnet   = subnet;
+  _staticDNS[0]   = dns1;
+  _staticDNS[1]   = dns2;
+
+  WM_HostRadio::get().setStaticIP(_useStaticIP ? local_ip : IPAddress());
+
+  return true;
+}
+
+bool WiFiClass::disconnect(bool wifioff, bool eraseap)
+{
+  WM_HostRadio& radio = WM_HostRadio::get();
+
+  radio.staDisconnect();
+
+  if (eraseap)
+  {
+    radio.storedSSID.clear();
+    radio.storedPassword.clear();
+  }
+
+  if (wifioff)
+    mode((wifi_mode_t) (_mode & ~WIFI_MODE_STA));
+
+  return true;
+}
+
+wl_status_t WiFiClass::status()
+{
+  return WM_HostRadio::get().staStatus();
+}
+
+// As the ESP32 core : polls every 100ms until connected or failed
+uint8_t WiFiClass::waitForConnectResult(unsigned long timeoutLength)
+{
+  if ( (_mode & WIFI_MODE_STA) == 0 )
+    return WL_DISCONNECTED;
+
+  unsigned long start = millis();
+
+  while ( ( !status() || (status() >= WL_DISCONNECTED) ) && ( (millis() - start) < timeoutLength ) )
+  {
+    delay(100);
+  }
+
+  return status();
+}
+
+String WiFiClass::SSID() const
+{
+  WM_HostAP* ap = WM_HostRadio::get().staAP();
+
+  return ap ? String(ap->ssid.c_str()) : String();
+}
+
+String WiFiClass::psk() const
+{
+  if (!WM_HostRadio::get().staAP())
+    return String();
+
+  return String(WM_HostRadio::get().storedPassword.c_str());
+}
+
+int8_t WiFiClass::RSSI()
+{
+  WM_HostAP* ap = WM_HostRadio::get().staAP();
+
+  return ap ? ap->rssi : 0;
+}
+
+int32_t WiFiClass::channel()
+{
+  WM_HostAP* ap = WM_HostRadio::get().staAP();
+
+  return ap ? ap->channel : 0;
+}
+
+uint8_t* WiFiClass::BSSID(uint8_t* bssid)
+{
+  static uint8_t buf[6];
+  WM_HostAP*     ap = WM_HostRadio::get().staAP();
+
+  if (!ap)
+    return nullptr;
+
+  if (!bssid)
+    bssid = buf;
+
+  memcpy(bssid, ap->bssid, sizeof(buf));
+
+  return bssid;
+}
+
+String WiFiClass::BSSIDstr()
+{
+  WM_HostAP* ap = WM_HostRadio::get().staAP();
+  char       buf[18];
+
+  if (!ap)
+    return String();
+
+  snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X", ap->bssid[0], ap->bssid[1], ap->bssid[2],
+           ap->bssid[3], ap->bssid[4], ap->bssid[5]);
+
+  return String(buf);
+}
+
+IPAddress WiFiClass::localIP()
+{
+  return (status() == WL_CONNECTED) ? WM_HostRadio::get().staIP() : IPAddress();
+}
+
+IPAddress WiFiClass::gatewayIP()
+{
+  if (status() != WL_CONNECTED)
+    return IPAddress();
+
+  if (_useStaticIP)
+    return _staticGateway;
+
+  IPAddress ip = WM_HostRadio::get().staIP();
+
+  return IPAddress(ip[0], ip[1], ip[2], 1);
+}
+
+IPAddress WiFiClass::subnetMask()
+{
+  if (status() != WL_CONNECTED)
+    return IPAddress();
+
+  return _useStaticIP ? _staticSubnet : IPAddress(255, 255, 255, 0);
+}
+
+IPAddress WiFiClass::dnsIP(uint8_t dns_no)
+{
+  if ( _useStaticIP && (dns_no < 2) && (_staticDNS[dns_no] != IPAddress()) )
+    return _staticDNS[dns_no];
+
+  return (dns_no == 0) ? gatewayIP() : IPAddress();
+}
+
+uint8_t* WiFiClass::macAddress(uint8_t* mac)
+{
+  uint64_t efuse = ESP.getEfuseMac();
+
+  for (uint8_t i = 0; i < 6; i++)
+    mac[i] = (efuse >> (8 * i)) & 0xFF;
+
+  return mac;
+}
+
+String WiFiClass::macAddress()
+{
+  uint8_t mac[6];
+  char    buf[18];
+
+  macAddress(mac);
+  snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+
+  return String(buf);
+}
+
+bool WiFiClass::setHostname(const char* hostname)
+{
+  _hostname = hostname;
+
+  return true;
+}
+
+const char* WiFiClass::getHostname()
+{
+  if (_hostname.length() == 0)
+  {
+    uint8_t mac[6];
+    char    buf[16];
+
+    macAddress(mac);
+    snprintf(buf, sizeof(buf), "esp32-%02X%02X%02X", mac[3], mac[4], mac[5]);
+    _hostname = buf;
+  }
+
+  return _hostname.c_str();
+}
+
+int16_t WiFiClass::scanNetworks(bool async, bool show_hidden, bool passive, uint32_t max_ms_per_chan,
+                                uint8_t channel)
+{
+  (void) async;
+  (void) passive;
+  (void) max_ms_per_chan;
+  (void) channel;
+
+  // Always synchronous : the scan takes its time on the clock, then scanComplete() has the result
+  mode((wifi_mode_t) (_mode | WIFI_MODE_STA));
+
+  _scanCount = WM_HostRadio::get().scan(show_hidden);
+
+  return _scanCount;
+}
+
+int16_t WiFiClass::scanComplete()
+{
+  return _scanCount;
+}
+
+void WiFiClass::scanDelete()
+{
+  WM_HostRadio::get().scanDelete();
+
+  _scanCount = WIFI_SCAN_FAILED;
+}
+
+String WiFiClass::SSID(uint8_t networkItem)
+{
+  const auto& results = WM_HostRadio::get().scanResults();
+
+  return (networkItem < results.size()) ? String(results[networkItem].ssid.c_str()) : String();
+}
+
+wifi_auth_mode_t WiFiClass::encryptionType(uint8_t networkItem)
+{
+  const auto& results = WM_HostRadio::get().scanResults();
+
+  return (networkItem < results.size()) ? results[networkItem].auth : WIFI_AUTH_OPEN;
+}
+
+int32_t WiFiClass::RSSI(uint8_t networkItem)
+{
+  const auto& results = WM_HostRadio::get().scanResults();
+
+  return (networkItem < results.size()) ? results[networkItem].rssi : 0;
+}
+
+int32_t WiFiClass::channel(uint8_t networkItem)
+{
+  const auto& results = WM_HostRadio::get().scanResults();
+
+  return (networkItem < results.size()) ? results[networkItem].channel : 0;
+}
+
+uint8_t* WiFiClass::BSSID(uint8_t networkItem)
+{
+  const auto& results = WM_HostRadio::get().scanResults();
+
+  return (networkItem < results.size()) ? (uint8_t*) results[networkItem].bssid : nullptr;
+}
+
+String WiFiClass::BSSIDstr(uint8_t networkItem)
+{
+  uint8_t* bssid = BSSID(networkItem);
+  char     buf[18];
+
+  if (!bssid)
+    return String();
+
+  snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X", bssid[0], bssid[1], bssid[2], bssid[3], bssid[4],
+           bssid[5]);
+
+  return String(buf);
+}
+
+bool WiFiClass::softAP(const char* ssid, const char* passphrase, int channel, int ssid_hidden, int max_connection)
+{
+  (void) channel;
+  (void) ssid_hidden;
+  (void) max_connection;
+
+  if (!ssid || !*ssid || (strlen(ssid) > 32))
+    return false;
+
+  // WPA2 needs 8 characters at least, as on the ESP32
+  if (passphrase && *passphrase && (strlen(passphrase) < 8))
+    return false;
+
+  mode((wifi_mode_t) (_mode | WIFI_MODE_AP));
+
+  _apSSID     = ssid;
+  _apStarted  = true;
+
+  return true;
+}
+
+bool WiFiClass::softAPConfig(IPAddress local_ip, IPAddress gateway, IPAddress subnet)
+{
+  (void) gateway;
+  (void) subnet;
+
+  _apIP = local_ip;
+
+  return true;
+}
+
+bool WiFiClass::softAPdisconnect(bool wifioff)
+{
+  _apStarted = false;
+
+  if (wifioff)
+    mode((wifi_mode_t) (_mode & ~WIFI_MODE_AP));
+
+  return true;
+}
+
+IPAddress WiFiClass::softAPIP()
+{
+  return (_mode & WIFI_MODE_AP) ? _apIP : IPAddress();
+}
+
+uint8_t* WiFiClass::softAPmacAddress(uint8_t* mac)
+{
+  // AP MAC is the base MAC + 1
+  macAddress(mac);
+  mac[5]++;
+
+  return mac;
+}
+
+String WiFiClass::softAPmacAddress()
+{
+  uint8_t mac[6];
+  char    buf[18];
+
+  softAPmacAddress(mac);
+  snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+
+  return String(buf);
+}
+
+String WiFiClass::softAPSSID() const
+{
+  return _apStarted ? _apSSID : String();
+}
+
+int WiFiClass::hostByName(const char* aHostname, IPAddress& aResult)
+{
+  return WM_HostRadio::get().hostByName(aHostname, aResult) ? 1 : 0;
+}
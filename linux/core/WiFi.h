@@ -0,0 +1,162 @@
+/****************************************************************************************************************************
+  WiFi.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  The ESP32 core WiFi object, over the simulated radio of WM_HostRadio.h
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WiFi_h
+#define WiFi_h
+
+#include "Arduino.h"
+#include "esp_wifi.h"
+#include "WM_HostRadio.h"
+#include "WiFiClient.h"
+#include "WiFiServer.h"
+#include "WiFiUdp.h"
+
+#define WIFI_OFF            WIFI_MODE_NULL
+#define WIFI_STA            WIFI_MODE_STA
+#define WIFI_AP             WIFI_MODE_AP
+#define WIFI_AP_STA         WIFI_MODE_APSTA
+
+#define WIFI_SCAN_RUNNING   (-1)
+#define WIFI_SCAN_FAILED    (-2)
+
+////////////////////////////////////////////////////
+
+class WiFiClass
+{
+  public:
+
+    bool        mode(wifi_mode_t mode);
+    wifi_mode_t getMode();
+
+    ////////////////////////////////////////////////////
+    // Station
+
+    wl_status_t begin(const char* ssid, const char* passphrase = nullptr, int32_t channel = 0,
+                      const uint8_t* bssid = nullptr, bool connect = true);
+    wl_status_t begin();
+
+    bool        config(IPAddress local_ip, IPAddress gateway, IPAddress subnet,
+                       IPAddress dns1 = (uint32_t) 0, IPAddress dns2 = (uint32_t) 0);
+
+    bool        disconnect(bool wifioff = false, bool eraseap = false);
+
+    wl_status_t status();
+    uint8_t     waitForConnectResult(unsigned long timeoutLength = 60000);
+
+    bool        isConnected()
+    {
+      return status() == WL_CONNECTED;
+    }
+
+    String      SSID() const;
+    String      psk() const;
+    int8_t      RSSI();
+    int32_t     channel();
+    uint8_t*    BSSID(uint8_t* bssid = nullptr);
+    String      BSSIDstr();
+
+    IPAddress   localIP();
+    IPAddress   gatewayIP();
+    IPAddress   subnetMask();
+    IPAddress   dnsIP(uint8_t dns_no = 0);
+
+    uint8_t*    macAddress(uint8_t* mac);
+    String      macAddress();
+
+    bool        setHostname(const char* hostname);
+    const char* getHostname();
+
+    bool        setAutoConnect(bool autoConnect)
+    {
+      _autoConnect = autoConnect;
+
+      return true;
+    }
+
+    bool        getAutoConnect()
+    {
+      return _autoConnect;
+    }
+
+    bool        setAutoReconnect(bool autoReconnect)
+    {
+      (void) autoReconnect;
+
+      return true;
+    }
+
+    // Whether begin() stores the credentials
+    void        persistent(bool persistent)
+    {
+      _persistent = persistent;
+    }
+
+    ////////////////////////////////////////////////////
+    // Scan
+
+    int16_t     scanNetworks(bool async = false, bool show_hidden = false, bool passive = false,
+                             uint32_t max_ms_per_chan = 300, uint8_t channel = 0);
+    int16_t     scanComplete();
+    void        scanDelete();
+
+    String            SSID(uint8_t networkItem);
+    wifi_auth_mode_t  encryptionType(uint8_t networkItem);
+    int32_t           RSSI(uint8_t networkItem);
+    int32_t           channel(uint8_t networkItem);
+    uint8_t*          BSSID(uint8_t networkItem);
+    String            BSSIDstr(uint8_t networkItem);
+
+    ////////////////////////////////////////////////////
+    // Soft AP
+
+    bool        softAP(const char* ssid, const char* passphrase = nullptr, int channel = 1, int ssid_hidden = 0,
+                       int max_connection = 4);
+    bool        softAPConfig(IPAddress local_ip, IPAddress gateway, IPAddress subnet);
+    bool        softAPdisconnect(bool wifioff = false);
+
+    IPAddress   softAPIP();
+    uint8_t*    softAPmacAddress(uint8_t* mac);
+    String      softAPmacAddress();
+    String      softAPSSID() const;
+
+    uint8_t     softAPgetStationNum()
+    {
+      return 0;
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Names given by the scenario ("host" command), and dotted IPs
+    int         hostByName(const char* aHostname, IPAddress& aResult);
+
+  private:
+
+    wifi_mode_t _mode         = WIFI_MODE_NULL;
+    bool        _autoConnect  = true;
+    bool        _persistent   = true;
+    bool        _useStaticIP  = false;
+
+    IPAddress   _staticIP;
+    IPAddress   _staticGateway;
+    IPAddress   _staticSubnet;
+    IPAddress   _staticDNS[2];
+
+    String      _hostname;
+    String      _apSSID;
+    IPAddress   _apIP         = IPAddress(192, 168, 4, 1);
+    bool        _apStarted    = false;
+    int16_t     _scanCount    = WIFI_SCAN_FAILED;
+};
+
+extern WiFiClass WiFi;
+
+#endif    // WiFi_h
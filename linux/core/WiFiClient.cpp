@@ -0,0 +1,259 @@
+/****************************************************************************************************************************
+  WiFiClient.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+ *****************************************************************************************************************************/
+
+#include <errno.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <netinet/tcp.h>
+
+#include "lwip/sockets.h"
+#include "WiFiClient.h"
+
+////////////////////////////////////////////////////
+
+class WiFiClient::Socket
+{
+  public:
+
+    explicit Socket(int fd) : fd(fd) {}
+
+    ~Socket()
+    {
+      if (fd >= 0)
+        ::close(fd);
+    }
+
+    int fd;
+};
+
+namespace
+{
+  IPAddress toIPAddress(const struct sockaddr_in& addr)
+  {
+    return IPAddress((uint32_t) addr.sin_addr.s_addr);
+  }
+}
+
+////////////////////////////////////////////////////
+
+WiFiClient::WiFiClient(int fd)
+{
+  if (fd >= 0)
+    _socket = std::make_shared<Socket>(fd);
+}
+
+int WiFiClient::connect(IPAddress ip, uint16_t port, int32_t timeout_ms)
+{
+  stop();
+
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+
+  if (fd < 0)
+    return 0;
+
+  struct sockaddr_in addr;
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family       = AF_INET;
+  addr.sin_port         = htons(port);
+  addr.sin_addr.s_addr  = (uint32_t) ip;
+
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+  if ( (::connect(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0) && (errno != EINPROGRESS) )
+  {
+    ::close(fd);
+
+    return 0;
+  }
+
+  struct pollfd pfd = { fd, POLLOUT, 0 };
+  int           err = 0;
+  socklen_t     len = sizeof(err);
+
+  if ( (poll(&pfd, 1, timeout_ms) != 1) || (getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len) < 0) || err )
+  {
+    ::close(fd);
+
+    return 0;
+  }
+
+  _socket = std::make_shared<Socket>(fd);
+
+  return 1;
+}
+
+uint8_t WiFiClient::connected()
+{
+  if (!_socket)
+    return 0;
+
+  if (_peeked >= 0)
+    return 1;
+
+  // Data waiting, or an open connection with nothing to read
+  char    c;
+  ssize_t res = recv(_socket->fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+
+  if ( (res > 0) || ( (res < 0) && ( (errno == EAGAIN) || (errno == EWOULDBLOCK) ) ) )
+    return 1;
+
+  stop();
+
+  return 0;
+}
+
+int WiFiClient::available()
+{
+  int count = 0;
+
+  if (!_socket || (ioctl(_socket->fd, FIONREAD, &count) < 0))
+    return (_peeked >= 0) ? 1 : 0;
+
+  return count + ( (_peeked >= 0) ? 1 : 0 );
+}
+
+int WiFiClient::read()
+{
+  uint8_t c;
+
+  return (read(&c, 1) == 1) ? c : -1;
+}
+
+int WiFiClient::read(uint8_t* buf, size_t size)
+{
+  int count = 0;
+
+  if (size == 0)
+    return 0;
+
+  if (_peeked >= 0)
+  {
+    *buf++  = _peeked;
+    _peeked = -1;
+    size--;
+    count++;
+  }
+
+  if (!_socket || (size == 0))
+    return count ? count : -1;
+
+  ssize_t res = recv(_socket->fd, buf, size, MSG_DONTWAIT);
+
+  if (res > 0)
+    count += res;
+
+  return count ? count : -1;
+}
+
+int WiFiClient::peek()
+{
+  if (_peeked < 0)
+    _peeked = read();
+
+  return _peeked;
+}
+
+size_t WiFiClient::write(uint8_t c)
+{
+  return write(&c, 1);
+}
+
+// Blocks until everything is sent, or the peer is gone
+size_t WiFiClient::write(const uint8_t* buf, size_t size)
+{
+  size_t sent = 0;
+
+  if (!_socket)
+    return 0;
+
+  while (sent < size)
+  {
+    ssize_t res = send(_socket->fd, buf + sent, size - sent, MSG_NOSIGNAL);
+
+    if (res > 0)
+    {
+      sent += res;
+    }
+    else if ( (res < 0) && ( (errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR) ) )
+    {
+      struct pollfd pfd = { _socket->fd, POLLOUT, 0 };
+
+      if (poll(&pfd, 1, 5000) != 1)
+        break;
+    }
+    else
+    {
+      break;
+    }
+  }
+
+  return sent;
+}
+
+void WiFiClient::stop()
+{
+  _socket.reset();
+  _peeked = -1;
+}
+
+int WiFiClient::setNoDelay(bool nodelay)
+{
+  int flag = nodelay;
+
+  return _socket ? setsockopt(_socket->fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag)) : -1;
+}
+
+int WiFiClient::fd() const
+{
+  return _socket ? _socket->fd : -1;
+}
+
+IPAddress WiFiClient::remoteIP() const
+{
+  struct sockaddr_in addr;
+  socklen_t          len = sizeof(addr);
+
+  if (!_socket || (getpeername(_socket->fd, (struct sockaddr *) &addr, &len) < 0))
+    return IPAddress();
+
+  return toIPAddress(addr);
+}
+
+uint16_t WiFiClient::remotePort() const
+{
+  struct sockaddr_in addr;
+  socklen_t          len = sizeof(addr);
+
+  if (!_socket || (getpeername(_socket->fd, (struct sockaddr *) &addr, &len) < 0))
+    return 0;
+
+  return ntohs(addr.sin_port);
+}
+
+IPAddress WiFiClient::localIP() const
+{
+  struct sockaddr_in addr;
+  socklen_t          len = sizeof(addr);
+
+  if (!_socket || (getsockname(_socket->fd, (struct sockaddr *) &addr, &len) < 0))
+    return IPAddress();
+
+  return toIPAddress(addr);
+}
+
+uint16_t WiFiClient::localPort() const
+{
+  struct sockaddr_in addr;
+  socklen_t          len = sizeof(addr);
+
+  if (!_socket || (getsockname(_socket->fd, (struct sockaddr *) &addr, &len) < 0))
+    return 0;
+
+  return ntohs(addr.sin_port);
+}
@@ -0,0 +1,73 @@
+/****************************************************************************************************************************
+  WiFiClient.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  TCP client over a POSIX socket. Copies share the socket, closed with the last one, as in the ESP32 core.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WiFiClient_h
+#define WiFiClient_h
+
+#include <memory>
+
+#include "Arduino.h"
+
+class WiFiClient : public Stream
+{
+  public:
+
+    WiFiClient() {}
+
+    // Takes ownership of a connected socket
+    explicit WiFiClient(int fd);
+
+    int       connect(IPAddress ip, uint16_t port, int32_t timeout_ms = 3000);
+
+    uint8_t   connected();
+
+    operator bool()
+    {
+      return connected();
+    }
+
+    int       available() override;
+    int       read() override;
+    int       read(uint8_t* buf, size_t size);
+    int       peek() override;
+
+    size_t    write(uint8_t c) override;
+    size_t    write(const uint8_t* buf, size_t size) override;
+
+    using Print::write;
+
+    size_t    write_P(PGM_P buf, size_t size)
+    {
+      return write((const uint8_t*) buf, size);
+    }
+
+    void      flush() override {}
+    void      stop();
+
+    int       setNoDelay(bool nodelay);
+
+    int       fd() const;
+
+    IPAddress remoteIP() const;
+    uint16_t  remotePort() const;
+    IPAddress localIP() const;
+    uint16_t  localPort() const;
+
+  private:
+
+    class Socket;
+
+    std::shared_ptr<Socket>  _socket;
+    int                      _peeked = -1;
+};
+
+#endif    // WiFiClient_h
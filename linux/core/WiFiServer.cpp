@@ -0,0 +1,77 @@
+/****************************************************************************************************************************
+  WiFiServer.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+ *****************************************************************************************************************************/
+
+#include <errno.h>
+#include <poll.h>
+
+#include "lwip/sockets.h"
+#include "WiFiServer.h"
+
+////////////////////////////////////////////////////
+
+bool WiFiServer::begin(uint16_t port)
+{
+  if (port)
+    _port = port;
+
+  end();
+
+  _fd = socket(AF_INET, SOCK_STREAM, 0);
+
+  if (_fd < 0)
+    return false;
+
+  int                 one = 1;
+  struct sockaddr_in  addr;
+
+  setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family       = AF_INET;
+  addr.sin_port         = htons(_port);
+  addr.sin_addr.s_addr  = htonl(INADDR_ANY);
+
+  if ( (bind(_fd, (struct sockaddr *) &addr, sizeof(addr)) < 0) || (listen(_fd, 16) < 0) )
+  {
+    fprintf(stderr, "WiFiServer: can't listen on port %u : %s\n", _port, strerror(errno));
+
+    end();
+
+    return false;
+  }
+
+  fcntl(_fd, F_SETFL, fcntl(_fd, F_GETFL, 0) | O_NONBLOCK);
+
+  return true;
+}
+
+void WiFiServer::end()
+{
+  if (_fd >= 0)
+  {
+    ::close(_fd);
+    _fd = -1;
+  }
+}
+
+WiFiClient WiFiServer::accept()
+{
+  if (_fd < 0)
+    return WiFiClient();
+
+  int fd = ::accept(_fd, nullptr, nullptr);
+
+  return WiFiClient(fd);
+}
+
+bool WiFiServer::hasClient()
+{
+  struct pollfd pfd = { _fd, POLLIN, 0 };
+
+  return (_fd >= 0) && (poll(&pfd, 1, 0) == 1);
+}
@@ -0,0 +1,67 @@
+/****************************************************************************************************************************
+  WiFiServer.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WiFiServer_h
+#define WiFiServer_h
+
+#include "WiFiClient.h"
+
+class WiFiServer
+{
+  public:
+
+    explicit WiFiServer(uint16_t port = 80) : _port(port) {}
+
+    ~WiFiServer()
+    {
+      end();
+    }
+
+    // false when the port can't be bound
+    bool        begin(uint16_t port = 0);
+    void        end();
+
+    void        close()
+    {
+      end();
+    }
+
+    // Next pending connection, or a client that isn't connected. Never blocks.
+    WiFiClient  accept();
+
+    WiFiClient  available()
+    {
+      return accept();
+    }
+
+    bool        hasClient();
+
+    int         fd() const
+    {
+      return _fd;
+    }
+
+    uint16_t    port() const
+    {
+      return _port;
+    }
+
+    operator bool() const
+    {
+      return _fd >= 0;
+    }
+
+  private:
+
+    uint16_t  _port;
+    int       _fd = -1;
+};
+
+#endif    // WiFiServer_h
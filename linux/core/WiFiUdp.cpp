@@ -0,0 +1,168 @@
+/****************************************************************************************************************************
+  WiFiUdp.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+ *****************************************************************************************************************************/
+
+#include "lwip/sockets.h"
+#include "WiFi.h"
+#include "WiFiUdp.h"
+
+#define WIFI_UDP_MAX_PACKET     1460
+
+////////////////////////////////////////////////////
+
+uint8_t WiFiUDP::begin(uint16_t port)
+{
+  stop();
+
+  _fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+  if (_fd < 0)
+    return 0;
+
+  int                 one = 1;
+  struct sockaddr_in  addr;
+
+  setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family       = AF_INET;
+  addr.sin_port         = htons(port);
+  addr.sin_addr.s_addr  = htonl(INADDR_ANY);
+
+  if (bind(_fd, (struct sockaddr *) &addr, sizeof(addr)) < 0)
+  {
+    stop();
+
+    return 0;
+  }
+
+  fcntl(_fd, F_SETFL, fcntl(_fd, F_GETFL, 0) | O_NONBLOCK);
+
+  return 1;
+}
+
+void WiFiUDP::stop()
+{
+  if (_fd >= 0)
+  {
+    ::close(_fd);
+    _fd = -1;
+  }
+
+  _sendBuffer.clear();
+  _recvBuffer.clear();
+  _recvPos = 0;
+}
+
+int WiFiUDP::beginPacket(IPAddress ip, uint16_t port)
+{
+  if ( (_fd < 0) && !begin(0) )
+    return 0;
+
+  _sendIP   = ip;
+  _sendPort = port;
+  _sendBuffer.clear();
+
+  return 1;
+}
+
+int WiFiUDP::beginPacket(const char* host, uint16_t port)
+{
+  IPAddress ip;
+
+  if (!WiFi.hostByName(host, ip))
+    return 0;
+
+  return beginPacket(ip, port);
+}
+
+int WiFiUDP::endPacket()
+{
+  struct sockaddr_in addr;
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family       = AF_INET;
+  addr.sin_port         = htons(_sendPort);
+  addr.sin_addr.s_addr  = (uint32_t) _sendIP;
+
+  ssize_t res = sendto(_fd, _sendBuffer.data(), _sendBuffer.size(), 0, (struct sockaddr *) &addr, sizeof(addr));
+
+  _sendBuffer.clear();
+
+  return (res >= 0) ? 1 : 0;
+}
+
+size_t WiFiUDP::write(uint8_t c)
+{
+  return write(&c, 1);
+}
+
+size_t WiFiUDP::write(const uint8_t* buffer, size_t size)
+{
+  if (_sendBuffer.size() + size > WIFI_UDP_MAX_PACKET)
+    size = WIFI_UDP_MAX_PACKET - _sendBuffer.size();
+
+  _sendBuffer.insert(_sendBuffer.end(), buffer, buffer + size);
+
+  return size;
+}
+
+int WiFiUDP::parsePacket()
+{
+  struct sockaddr_in  from;
+  socklen_t           fromLen = sizeof(from);
+
+  _recvBuffer.resize(WIFI_UDP_MAX_PACKET);
+  _recvPos = 0;
+
+  ssize_t len = (_fd < 0) ? -1 : recvfrom(_fd, _recvBuffer.data(), _recvBuffer.size(), MSG_DONTWAIT,
+                                          (struct sockaddr *) &from, &fromLen);
+
+  if (len <= 0)
+  {
+    _recvBuffer.clear();
+
+    return 0;
+  }
+
+  _recvBuffer.resize(len);
+  _remoteIP   = IPAddress((uint32_t) from.sin_addr.s_addr);
+  _remotePort = ntohs(from.sin_port);
+
+  return len;
+}
+
+int WiFiUDP::available()
+{
+  return _recvBuffer.size() - _recvPos;
+}
+
+int WiFiUDP::read()
+{
+  return (_recvPos < _recvBuffer.size()) ? _recvBuffer[_recvPos++] : -1;
+}
+
+int WiFiUDP::read(unsigned char* buffer, size_t len)
+{
+  size_t count = std::min(len, _recvBuffer.size() - _recvPos);
+
+  memcpy(buffer, _recvBuffer.data() + _recvPos, count);
+  _recvPos += count;
+
+  return count;
+}
+
+int WiFiUDP::peek()
+{
+  return (_recvPos < _recvBuffer.size()) ? _recvBuffer[_recvPos] : -1;
+}
+
+void WiFiUDP::flush()
+{
+  _recvBuffer.clear();
+  _recvPos = 0;
+}
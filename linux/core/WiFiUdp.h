@@ -0,0 +1,86 @@
+/****************************************************************************************************************************
+  WiFiUdp.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WiFiUdp_h
+#define WiFiUdp_h
+
+#include <vector>
+
+#include "Arduino.h"
+
+class WiFiUDP : public Stream
+{
+  public:
+
+    WiFiUDP() {}
+
+    ~WiFiUDP()
+    {
+      stop();
+    }
+
+    // 1 on success, 0 otherwise. port 0 : any.
+    uint8_t   begin(uint16_t port);
+    void      stop();
+
+    int       beginPacket(IPAddress ip, uint16_t port);
+    int       beginPacket(const char* host, uint16_t port);
+    int       endPacket();
+
+    size_t    write(uint8_t c) override;
+    size_t    write(const uint8_t* buffer, size_t size) override;
+
+    using Print::write;
+
+    // Size of the next datagram, 0 when none is waiting. Never blocks.
+    int       parsePacket();
+
+    int       available() override;
+    int       read() override;
+    int       read(unsigned char* buffer, size_t len);
+
+    int       read(char* buffer, size_t len)
+    {
+      return read((unsigned char*) buffer, len);
+    }
+
+    int       peek() override;
+    void      flush() override;
+
+    IPAddress remoteIP() const
+    {
+      return _remoteIP;
+    }
+
+    uint16_t  remotePort() const
+    {
+      return _remotePort;
+    }
+
+    int       fd() const
+    {
+      return _fd;
+    }
+
+  private:
+
+    int                   _fd = -1;
+
+    IPAddress             _sendIP;
+    uint16_t              _sendPort = 0;
+    std::vector<uint8_t>  _sendBuffer;
+
+    IPAddress             _remoteIP;
+    uint16_t              _remotePort = 0;
+    std::vector<uint8_t>  _recvBuffer;
+    size_t                _recvPos = 0;
+};
+
+#endif    // WiFiUdp_h
@@ -0,0 +1,356 @@
+/****************************************************************************************************************************
+  core.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Clock, Serial, ESP and FreeRTOS task shims of the host build
+ *****************************************************************************************************************************/
+
+#include <unistd.h>
+#include <malloc.h>
+#include <sys/ioctl.h>
+
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <random>
+
+#include "Arduino.h"
+#include "WM_Host.h"
+
+// Heap of the emulated device, getFreeHeap() is that minus what the host program allocated since start
+#ifndef WM_HOST_HEAP_SIZE
+  #define WM_HOST_HEAP_SIZE         (320 * 1024)
+#endif
+
+HardwareSerial  Serial;
+EspClass        ESP;
+
+////////////////////////////////////////////////////
+
+namespace
+{
+  std::atomic<bool>       virtualClock(false);
+  std::atomic<uint64_t>   virtualNow(0);
+
+  std::atomic<int64_t>    wallOffset(0);
+
+  WM_Host::RestartCallback  restartCallback = nullptr;
+  int                       restartExitCode = 0;
+  WM_Host::IdleCallback     idleCallback    = nullptr;
+
+  const auto              startTime = std::chrono::steady_clock::now();
+
+  std::minstd_rand        rng;
+
+  size_t heapInUse()
+  {
+    struct mallinfo2 info = mallinfo2();
+
+    return info.uordblks;
+  }
+
+  // What the process had allocated before setup(), not part of the emulated heap
+  const size_t            heapBaseline = heapInUse();
+  uint32_t                heapMinFree  = WM_HOST_HEAP_SIZE;
+
+  void idle()
+  {
+    if (idleCallback)
+      idleCallback();
+  }
+}
+
+////////////////////////////////////////////////////
+
+void WM_Host::setVirtualClock(const bool& enable)
+{
+  virtualNow    = micros64();
+  virtualClock  = enable;
+}
+
+bool WM_Host::isVirtualClock()
+{
+  return virtualClock;
+}
+
+uint64_t WM_Host::micros64()
+{
+  if (virtualClock)
+    return virtualNow;
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void WM_Host::advance(const uint64_t& us)
+{
+  if (virtualClock)
+    virtualNow += us;
+  else
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void WM_Host::powerOn()
+{
+  if (virtualClock)
+  {
+    virtualNow  = 0;
+    wallOffset  = 0;
+  }
+}
+
+int64_t WM_Host::wallClock()
+{
+  return wallOffset + (int64_t) micros64();
+}
+
+void WM_Host::setWallClock(const int64_t& us)
+{
+  wallOffset = us - (int64_t) micros64();
+}
+
+void WM_Host::onRestart(RestartCallback callback, const int& exitCode)
+{
+  restartCallback = callback;
+  restartExitCode = exitCode;
+}
+
+void WM_Host::onIdle(IdleCallback callback)
+{
+  idleCallback = callback;
+}
+
+////////////////////////////////////////////////////
+
+unsigned long millis()
+{
+  return (unsigned long) (WM_Host::micros64() / 1000);
+}
+
+unsigned long micros()
+{
+  return (unsigned long) WM_Host::micros64();
+}
+
+void delay(unsigned long ms)
+{
+  idle();
+
+  WM_Host::advance((uint64_t) ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  WM_Host::advance(us);
+}
+
+void yield()
+{
+  idle();
+
+  if (!virtualClock)
+    std::this_thread::yield();
+}
+
+long random(long howbig)
+{
+  if (howbig <= 0)
+    return 0;
+
+  return rng() % howbig;
+}
+
+long random(long howsmall, long howbig)
+{
+  if (howsmall >= howbig)
+    return howsmall;
+
+  return howsmall + random(howbig - howsmall);
+}
+
+void randomSeed(unsigned long seed)
+{
+  rng.seed(seed);
+}
+
+// minstd_rand draws 31 bits
+uint32_t esp_random()
+{
+  return ( (uint32_t) rng() << 16) ^ (uint32_t) rng();
+}
+
+////////////////////////////////////////////////////
+
+int WM_Host_gettimeofday(struct timeval* tv, void* tz)
+{
+  (void) tz;
+
+  int64_t now = WM_Host::wallClock();
+
+  tv->tv_sec  = now / 1000000LL;
+  tv->tv_usec = now % 1000000LL;
+
+  return 0;
+}
+
+int WM_Host_settimeofday(const struct timeval* tv, const void* tz)
+{
+  (void) tz;
+
+  WM_Host::setWallClock((int64_t) tv->tv_sec * 1000000LL + tv->tv_usec);
+
+  return 0;
+}
+
+time_t WM_Host_time(time_t* t)
+{
+  time_t now = (time_t) (WM_Host::wallClock() / 1000000LL);
+
+  if (t)
+    *t = now;
+
+  return now;
+}
+
+////////////////////////////////////////////////////
+
+int HardwareSerial::available()
+{
+  int count = 0;
+
+  if (ioctl(STDIN_FILENO, FIONREAD, &count) < 0)
+    count = 0;
+
+  return count + (_peeked >= 0 ? 1 : 0);
+}
+
+int HardwareSerial::read()
+{
+  if (_peeked >= 0)
+  {
+    int c = _peeked;
+
+    _peeked = -1;
+
+    return c;
+  }
+
+  uint8_t c;
+
+  if ( (available() <= 0) || (::read(STDIN_FILENO, &c, 1) != 1) )
+    return -1;
+
+  return c;
+}
+
+int HardwareSerial::peek()
+{
+  if (_peeked < 0)
+    _peeked = read();
+
+  return _peeked;
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+  return fwrite(&c, 1, 1, stdout);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size)
+{
+  return fwrite(buffer, 1, size, stdout);
+}
+
+void HardwareSerial::flush()
+{
+  fflush(stdout);
+}
+
+////////////////////////////////////////////////////
+
+uint32_t EspClass::getHeapSize()
+{
+  return WM_HOST_HEAP_SIZE;
+}
+
+uint32_t EspClass::getFreeHeap()
+{
+  size_t   used = heapInUse();
+  uint32_t free = 0;
+
+  if (used < heapBaseline)
+    free = WM_HOST_HEAP_SIZE;
+  else if (used - heapBaseline < WM_HOST_HEAP_SIZE)
+    free = WM_HOST_HEAP_SIZE - (used - heapBaseline);
+
+  if (free < heapMinFree)
+    heapMinFree = free;
+
+  return free;
+}
+
+uint32_t EspClass::getMinFreeHeap()
+{
+  getFreeHeap();
+
+  return heapMinFree;
+}
+
+// No fragmentation on the host
+uint32_t EspClass::getMaxAllocHeap()
+{
+  return getFreeHeap();
+}
+
+// 24:0A:C4:00:00:01, first byte lowest as read from eFuse
+uint64_t EspClass::getEfuseMac()
+{
+  return 0x010000C40A24ULL;
+}
+
+void EspClass::restart()
+{
+  if (restartCallback)
+    restartCallback(false);
+
+  fflush(stdout);
+  exit(restartExitCode);
+}
+
+void EspClass::deepSleep(uint64_t us)
+{
+  (void) us;
+
+  if (restartCallback)
+    restartCallback(true);
+
+  fflush(stdout);
+  exit(restartExitCode);
+}
+
+////////////////////////////////////////////////////
+
+int xTaskCreate(TaskFunction_t task, const char* name, uint32_t stackDepth, void* param, int priority,
+                TaskHandle_t* handle)
+{
+  (void) name;
+  (void) stackDepth;
+  (void) priority;
+
+  std::thread thread(task, param);
+
+  if (handle)
+    *handle = nullptr;
+
+  thread.detach();
+
+  return pdPASS;
+}
+
+// Always real time : tasks are threads, they don't drive the virtual clock
+void vTaskDelay(uint32_t ticks)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(ticks * portTICK_PERIOD_MS));
+}
@@ -0,0 +1,20 @@
+/****************************************************************************************************************************
+  esp_attr.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef esp_attr_h
+#define esp_attr_h
+
+// No RTC memory on the host : RTC_DATA_ATTR variables are plain statics, lost with the process
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+#define IRAM_ATTR
+#define DRAM_ATTR
+
+#endif    // esp_attr_h
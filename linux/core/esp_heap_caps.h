@@ -0,0 +1,36 @@
+/****************************************************************************************************************************
+  esp_heap_caps.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  PSRAM of the emulated device : WM_HOST_PSRAM_SIZE bytes (host CMake option, default 0 : no PSRAM), apart from
+  the internal heap of ESP.getFreeHeap(). Its allocations are reported to the allocator hook like the others,
+  as the ESP-IDF heap hooks do.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef esp_heap_caps_h
+#define esp_heap_caps_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_8BIT             (1 << 2)
+#define MALLOC_CAP_SPIRAM           (1 << 10)
+#define MALLOC_CAP_INTERNAL         (1 << 11)
+#define MALLOC_CAP_DEFAULT          (1 << 12)
+
+// MALLOC_CAP_SPIRAM : from the PSRAM, nullptr without room. Otherwise malloc().
+void*   heap_caps_malloc(size_t size, uint32_t caps);
+
+// Either kind
+void    heap_caps_free(void* ptr);
+
+// PSRAM only, 0 for other caps
+size_t  heap_caps_get_total_size(uint32_t caps);
+size_t  heap_caps_get_free_size(uint32_t caps);
+
+#endif    // esp_heap_caps_h
@@ -0,0 +1,40 @@
+/****************************************************************************************************************************
+  esp_system.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef esp_system_h
+#define esp_system_h
+
+#include <stdint.h>
+
+typedef enum
+{
+  ESP_RST_UNKNOWN = 0,
+  ESP_RST_POWERON,
+  ESP_RST_EXT,
+  ESP_RST_SW,
+  ESP_RST_PANIC,
+  ESP_RST_INT_WDT,
+  ESP_RST_TASK_WDT,
+  ESP_RST_WDT,
+  ESP_RST_DEEPSLEEP,
+  ESP_RST_BROWNOUT,
+  ESP_RST_SDIO
+} esp_reset_reason_t;
+
+// A host process always starts from power on
+inline esp_reset_reason_t esp_reset_reason()
+{
+  return ESP_RST_POWERON;
+}
+
+// Hardware RNG of the chip, the seeded random() generator of the host
+uint32_t esp_random();
+
+#endif    // esp_system_h
@@ -0,0 +1,88 @@
+/****************************************************************************************************************************
+  esp_wifi.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  The ESP-IDF WiFi types and calls used by the library, answered by WM_HostRadio
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef esp_wifi_h
+#define esp_wifi_h
+
+#include <stdint.h>
+
+typedef int esp_err_t;
+
+#define ESP_OK                        0
+#define ESP_FAIL                      -1
+#define ESP_ERR_WIFI_NOT_CONNECT      0x300F
+
+typedef enum
+{
+  WIFI_MODE_NULL = 0,
+  WIFI_MODE_STA,
+  WIFI_MODE_AP,
+  WIFI_MODE_APSTA,
+  WIFI_MODE_MAX
+} wifi_mode_t;
+
+typedef enum
+{
+  WIFI_IF_STA = 0,
+  WIFI_IF_AP
+} wifi_interface_t;
+
+typedef enum
+{
+  WIFI_AUTH_OPEN = 0,
+  WIFI_AUTH_WEP,
+  WIFI_AUTH_WPA_PSK,
+  WIFI_AUTH_WPA2_PSK,
+  WIFI_AUTH_WPA_WPA2_PSK,
+  WIFI_AUTH_WPA2_ENTERPRISE,
+  WIFI_AUTH_WPA3_PSK,
+  WIFI_AUTH_WPA2_WPA3_PSK,
+  WIFI_AUTH_MAX
+} wifi_auth_mode_t;
+
+typedef struct
+{
+  uint8_t           bssid[6];
+  uint8_t           ssid[33];
+  uint8_t           primary;
+  int8_t            rssi;
+  wifi_auth_mode_t  authmode;
+} wifi_ap_record_t;
+
+typedef struct
+{
+  uint8_t   ssid[32];
+  uint8_t   password[64];
+  uint8_t   bssid_set;
+  uint8_t   bssid[6];
+  uint8_t   channel;
+} wifi_sta_config_t;
+
+typedef struct
+{
+  uint8_t   ssid[32];
+  uint8_t   password[64];
+  uint8_t   ssid_len;
+  uint8_t   channel;
+  uint8_t   max_connection;
+} wifi_ap_config_t;
+
+typedef union
+{
+  wifi_ap_config_t  ap;
+  wifi_sta_config_t sta;
+} wifi_config_t;
+
+esp_err_t esp_wifi_sta_get_ap_info(wifi_ap_record_t* ap_info);
+esp_err_t esp_wifi_get_config(wifi_interface_t interface, wifi_config_t* conf);
+
+#endif    // esp_wifi_h
@@ -0,0 +1,225 @@
+/****************************************************************************************************************************
+  heap.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Allocator of the host build : glibc's, with the WM_Host::onAlloc() callback after each call.
+  operator new / delete go through malloc() / free(), so C++ allocations are seen too.
+  Sanitizer builds (WM_HOST_SANITIZE) keep the sanitizer's allocator, and report no allocation.
+
+  The emulated PSRAM of heap_caps_malloc() is mapped apart from glibc's heap, so it doesn't count in the
+  internal heap figures of ESP.getFreeHeap().
+ *****************************************************************************************************************************/
+
+#include <stdlib.h>
+#include <sys/mman.h>
+
+#include <atomic>
+#include <mutex>
+
+#include "Arduino.h"
+#include "esp_heap_caps.h"
+#include "WM_Host.h"
+
+// PSRAM of the emulated device, 0 : none
+#ifndef WM_HOST_PSRAM_SIZE
+  #define WM_HOST_PSRAM_SIZE        0
+#endif
+
+// Blocks of PSRAM allocated at the same time
+#define WM_HOST_PSRAM_BLOCKS        32
+
+extern "C"
+{
+  void* __libc_malloc(size_t size);
+  void* __libc_calloc(size_t count, size_t size);
+  void* __libc_realloc(void* ptr, size_t size);
+  void  __libc_free(void* ptr);
+}
+
+////////////////////////////////////////////////////
+
+namespace
+{
+  std::atomic<WM_Host::AllocCallback> allocCallback(nullptr);
+
+  inline void notify(const WM_Host::AllocEvent& event, const size_t& size)
+  {
+    WM_Host::AllocCallback callback = allocCallback.load(std::memory_order_relaxed);
+
+    if (callback)
+      callback(event, size);
+  }
+}
+
+void WM_Host::onAlloc(AllocCallback callback)
+{
+  allocCallback = callback;
+}
+
+////////////////////////////////////////////////////
+
+#if !WM_HOST_SANITIZE
+
+extern "C" void* malloc(size_t size)
+{
+  void* ptr = __libc_malloc(size);
+
+  if (ptr)
+    notify(WM_Host::ALLOC_MALLOC, size);
+
+  return ptr;
+}
+
+extern "C" void* calloc(size_t count, size_t size)
+{
+  void* ptr = __libc_calloc(count, size);
+
+  if (ptr)
+    notify(WM_Host::ALLOC_MALLOC, count * size);
+
+  return ptr;
+}
+
+// As umm_malloc counts them : realloc(nullptr) is a malloc, realloc(ptr, 0) a free
+extern "C" void* realloc(void* ptr, size_t size)
+{
+  void* newPtr = __libc_realloc(ptr, size);
+
+  if (!ptr)
+  {
+    if (newPtr)
+      notify(WM_Host::ALLOC_MALLOC, size);
+  }
+  else if (size == 0)
+  {
+    notify(WM_Host::ALLOC_FREE, 0);
+  }
+  else if (newPtr)
+  {
+    notify(WM_Host::ALLOC_REALLOC, size);
+  }
+
+  return newPtr;
+}
+
+extern "C" void free(void* ptr)
+{
+  if (ptr)
+  {
+    __libc_free(ptr);
+    notify(WM_Host::ALLOC_FREE, 0);
+  }
+}
+
+#endif    // WM_HOST_SANITIZE
+
+////////////////////////////////////////////////////
+
+namespace
+{
+  struct PsramBlock
+  {
+    void*   ptr;
+    size_t  size;
+  };
+
+  std::mutex  psramLock;
+  PsramBlock  psramBlocks[WM_HOST_PSRAM_BLOCKS];
+  size_t      psramUsed = 0;
+
+  void* psramAlloc(const size_t& size)
+  {
+    std::lock_guard<std::mutex> lock(psramLock);
+
+    if ( (size == 0) || (size > WM_HOST_PSRAM_SIZE - psramUsed) )
+      return nullptr;
+
+    for (PsramBlock& block : psramBlocks)
+    {
+      if (block.ptr)
+        continue;
+
+      void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+      if (ptr == MAP_FAILED)
+        return nullptr;
+
+      block.ptr   = ptr;
+      block.size  = size;
+      psramUsed  += size;
+
+      return ptr;
+    }
+
+    return nullptr;
+  }
+
+  // false : not a PSRAM block
+  bool psramFree(void* ptr)
+  {
+    std::lock_guard<std::mutex> lock(psramLock);
+
+    for (PsramBlock& block : psramBlocks)
+    {
+      if (block.ptr != ptr)
+        continue;
+
+      munmap(ptr, block.size);
+
+      psramUsed -= block.size;
+      block.ptr  = nullptr;
+
+      return true;
+    }
+
+    return false;
+  }
+}
+
+void* heap_caps_malloc(size_t size, uint32_t caps)
+{
+  if ( (caps & MALLOC_CAP_SPIRAM) == 0 )
+    return malloc(size);
+
+  void* ptr = psramAlloc(size);
+
+  if (ptr)
+    notify(WM_Host::ALLOC_MALLOC, size);
+
+  return ptr;
+}
+
+void heap_caps_free(void* ptr)
+{
+  if (ptr && psramFree(ptr))
+    notify(WM_Host::ALLOC_FREE, 0);
+  else
+    free(ptr);
+}
+
+size_t heap_caps_get_total_size(uint32_t caps)
+{
+  return (caps & MALLOC_CAP_SPIRAM) ? WM_HOST_PSRAM_SIZE : 0;
+}
+
+size_t heap_caps_get_free_size(uint32_t caps)
+{
+  std::lock_guard<std::mutex> lock(psramLock);
+
+  return (caps & MALLOC_CAP_SPIRAM) ? WM_HOST_PSRAM_SIZE - psramUsed : 0;
+}
+
+////////////////////////////////////////////////////
+
+uint32_t EspClass::getPsramSize()
+{
+  return heap_caps_get_total_size(MALLOC_CAP_SPIRAM);
+}
+
+uint32_t EspClass::getFreePsram()
+{
+  return heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+}
@@ -0,0 +1,25 @@
+/****************************************************************************************************************************
+  lwip/sockets.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  lwIP's BSD socket API is the POSIX one
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef lwip_sockets_h
+#define lwip_sockets_h
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#endif    // lwip_sockets_h
@@ -0,0 +1,53 @@
+/****************************************************************************************************************************
+  pgmspace.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Flash is plain memory on the host, as on ESP32
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef pgmspace_h
+#define pgmspace_h
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+#define PROGMEM
+#define PGM_P                     const char *
+#define PGM_VOID_P                const void *
+#define PSTR(s)                   (s)
+
+class __FlashStringHelper;
+
+#define FPSTR(p)                  (reinterpret_cast<const __FlashStringHelper *>(p))
+#define F(s)                      FPSTR(PSTR(s))
+
+#define pgm_read_byte(addr)       (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)       (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr)      (*(const uint32_t *)(addr))
+#define pgm_read_float(addr)      (*(const float *)(addr))
+#define pgm_read_ptr(addr)        (*(void * const *)(addr))
+
+#define memcpy_P                  memcpy
+#define memccpy_P                 memccpy
+#define memcmp_P                  memcmp
+#define strlen_P                  strlen
+#define strnlen_P                 strnlen
+#define strcpy_P                  strcpy
+#define strncpy_P                 strncpy
+#define strcat_P                  strcat
+#define strncat_P                 strncat
+#define strcmp_P                  strcmp
+#define strncmp_P                 strncmp
+#define strcasecmp_P              strcasecmp
+#define strstr_P                  strstr
+#define sprintf_P                 sprintf
+#define snprintf_P                snprintf
+#define vsnprintf_P               vsnprintf
+
+#endif    // pgmspace_h
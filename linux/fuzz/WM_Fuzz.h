@@ -0,0 +1,107 @@
+/****************************************************************************************************************************
+  WM_Fuzz.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Helpers of the fuzzing targets : splitting an input into the values a target needs, and checks that
+  abort, in every build type, when a property of the code under test doesn't hold.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WM_Fuzz_h
+#define WM_Fuzz_h
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+
+#define WM_FUZZ_CHECK(cond)                                                           \
+  do                                                                                  \
+  {                                                                                   \
+    if (!(cond))                                                                      \
+    {                                                                                 \
+      fprintf(stderr, "%s:%d : check failed : %s\n", __FILE__, __LINE__, #cond);      \
+      abort();                                                                        \
+    }                                                                                 \
+  } while (0)
+
+////////////////////////////////////////////////////
+
+// Consumes the input from the front. Past the end : 0 and empty strings.
+class WM_FuzzInput
+{
+  public:
+
+    WM_FuzzInput(const uint8_t* data, const size_t& size) : _data(data), _size(size) {}
+
+    size_t remaining() const
+    {
+      return _size - _pos;
+    }
+
+    uint8_t byte()
+    {
+      return (_pos < _size) ? _data[_pos++] : 0;
+    }
+
+    uint32_t uint32()
+    {
+      uint32_t value = 0;
+
+      for (int i = 0; i < 4; i++)
+        value = (value << 8) | byte();
+
+      return value;
+    }
+
+    int64_t int64()
+    {
+      uint64_t value = 0;
+
+      for (int i = 0; i < 8; i++)
+        value = (value << 8) | byte();
+
+      return (int64_t) value;
+    }
+
+    // Up to the separator (consumed, not returned) or maxLen bytes. May hold 0 bytes.
+    std::string token(const char& separator, const size_t& maxLen = SIZE_MAX)
+    {
+      std::string value;
+
+      while ( (_pos < _size) && (value.size() < maxLen) )
+      {
+        char c = (char) _data[_pos++];
+
+        if (c == separator)
+          break;
+
+        value += c;
+      }
+
+      return value;
+    }
+
+    std::string rest()
+    {
+      std::string value((const char*) _data + _pos, _size - _pos);
+
+      _pos = _size;
+
+      return value;
+    }
+
+  private:
+
+    const uint8_t*  _data;
+    size_t          _size;
+    size_t          _pos = 0;
+};
+
+#endif    // WM_Fuzz_h
@@ -0,0 +1,238 @@
+/****************************************************************************************************************************
+  WM_FuzzWebServer.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  The patched ESP32 WebServer of esp32s2_WebServer_Patch, compiled for the host, answering raw requests.
+  Each request goes the device's way : accepted on a loopback socket, its head peeked until complete, then
+  parsed (request line, headers, query, urlencoded or multipart body) and handed to the handlers below,
+  which check what the parser gives them :
+
+    /           every argument and collected header readable, by index and by name
+    /upload     upload handler : events in order, blocks within HTTP_UPLOAD_BUFLEN
+    /file       Range and If-None-Match of streamFile() against a 1000 bytes file
+    /auth       Basic and Digest authentication
+    /chunked    chunked response of the arguments
+
+  The virtual clock runs the timeouts, so requests whose head or body never completes cost no wait.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WM_FuzzWebServer_h
+#define WM_FuzzWebServer_h
+
+#include <WebServer.h>
+#include <lwip/sockets.h>
+
+#include <string>
+
+#include "WM_Fuzz.h"
+#include "WM_Host.h"
+
+// A request fits the socket buffers, nothing blocks
+#define WM_FUZZ_MAX_REQUEST         (32 * 1024)
+
+#define WM_FUZZ_FILE_SIZE           1000
+
+class WM_FuzzWebServer : public WebServer
+{
+  public:
+
+    WM_FuzzWebServer() : WebServer(IPAddress(127, 0, 0, 1), 0)
+    {
+      static const char* headerKeys[] = { "User-Agent", "Cookie", "Content-Type" };
+
+      collectHeaders(headerKeys, sizeof(headerKeys) / sizeof(headerKeys[0]));
+
+      on("/", [this]()
+      {
+        checkArgs();
+        send(200, "text/plain", String(args()));
+      });
+
+      on("/upload", HTTP_POST, [this]()
+      {
+        checkArgs();
+        send(200, "text/plain", String(_uploaded));
+      }, [this]()
+      {
+        checkUpload();
+      });
+
+      on("/file", [this]()
+      {
+        size_t  first = 0;
+        size_t  last  = 0;
+        int     range = _parseRange(WM_FUZZ_FILE_SIZE, first, last);
+
+        WM_FUZZ_CHECK( (range >= -1) && (range <= 1) );
+        WM_FUZZ_CHECK( (range != 1) || ( (first <= last) && (last < WM_FUZZ_FILE_SIZE) ) );
+
+        if (_etagMatches(_fileETag(WM_FUZZ_FILE_SIZE, 0)))
+          _streamFileNotModified(_fileETag(WM_FUZZ_FILE_SIZE, 0));
+        else if (range < 0)
+          _streamFileRangeNotSatisfiable(WM_FUZZ_FILE_SIZE);
+        else
+          send(range ? 206 : 200, "text/plain", String((unsigned long) (last - first)));
+      });
+
+      on("/auth", [this]()
+      {
+        if (authenticate("admin", "esp32"))
+        {
+          WM_FUZZ_CHECK(hasHeader("Authorization"));
+
+          send(200, "text/plain", "OK");
+        }
+        else
+        {
+          requestAuthentication( (args() > 0) ? DIGEST_AUTH : BASIC_AUTH, "ESP_WiFiManager");
+        }
+      });
+
+      on("/chunked", [this]()
+      {
+        setContentLength(CONTENT_LENGTH_UNKNOWN);
+        send(200, "text/plain", "");
+
+        for (int i = 0; i < args(); i++)
+          sendContent(arg(i));
+
+        sendContent("");
+      });
+
+      onNotFound([this]()
+      {
+        checkArgs();
+        send(404, "text/plain", uri());
+      });
+    }
+
+    void begin()
+    {
+      WebServer::begin();
+
+      struct sockaddr_in addr;
+      socklen_t          len = sizeof(addr);
+
+      WM_FUZZ_CHECK(getsockname(_server.fd(), (struct sockaddr*) &addr, &len) == 0);
+
+      _port = ntohs(addr.sin_port);
+    }
+
+    // Sends one request, returns the response : empty when the server closed without answering
+    std::string request(const std::string& data)
+    {
+      std::string response;
+
+      if (data.size() > WM_FUZZ_MAX_REQUEST)
+        return response;
+
+      int                fd = socket(AF_INET, SOCK_STREAM, 0);
+      struct sockaddr_in addr;
+
+      memset(&addr, 0, sizeof(addr));
+      addr.sin_family       = AF_INET;
+      addr.sin_port         = htons(_port);
+      addr.sin_addr.s_addr  = htonl(INADDR_LOOPBACK);
+
+      WM_FUZZ_CHECK(::connect(fd, (struct sockaddr*) &addr, sizeof(addr)) == 0);
+      WM_FUZZ_CHECK(::send(fd, data.data(), data.size(), MSG_NOSIGNAL) == (ssize_t) data.size());
+
+      // All of the request, as when a client waits for the answer
+      shutdown(fd, SHUT_WR);
+
+      _uploadStatus = -1;
+      _uploaded     = 0;
+
+      handleClient();
+
+      // A head that never completes : past its deadline, dropped
+      WM_Host::advance( (HTTP_MAX_DATA_WAIT + 1) * 1000ULL);
+      handleClient();
+
+      // No upload, or the last one ended or aborted
+      WM_FUZZ_CHECK( (_uploadStatus == -1) || (_uploadStatus == UPLOAD_FILE_END) || (_uploadStatus == UPLOAD_FILE_ABORTED) );
+
+      char    buf[4096];
+      ssize_t len;
+
+      while ( (len = recv(fd, buf, sizeof(buf), MSG_DONTWAIT)) > 0 )
+        response.append(buf, len);
+
+      ::close(fd);
+
+      WM_FUZZ_CHECK(response.empty() || (response.compare(0, 9, "HTTP/1.1 ") == 0) || (response.compare(0, 9, "HTTP/1.0 ") == 0));
+
+      return response;
+    }
+
+  private:
+
+    uint16_t  _port         = 0;
+    int       _uploadStatus = -1;
+    size_t    _uploaded     = 0;
+    size_t    _lastBlock    = 0;
+
+    void checkArgs()
+    {
+      for (int i = 0; i < args(); i++)
+      {
+        WM_FUZZ_CHECK(hasArg(argName(i)));
+
+        arg(argName(i));
+        arg(i);
+      }
+
+      for (int i = 0; i < headers(); i++)
+      {
+        header(headerName(i));
+        header(i);
+      }
+
+      hostHeader();
+      WM_FUZZ_CHECK(arg(args()) == "");
+    }
+
+    void checkUpload()
+    {
+      HTTPUpload& upload = WebServer::upload();
+
+      WM_FUZZ_CHECK(upload.currentSize <= HTTP_UPLOAD_BUFLEN);
+
+      switch (upload.status)
+      {
+        case UPLOAD_FILE_START:
+          WM_FUZZ_CHECK( (upload.currentSize == 0) && (upload.totalSize == 0) );
+
+          _uploaded = 0;
+          break;
+
+        case UPLOAD_FILE_WRITE:
+          // Whole blocks, only the last one before UPLOAD_FILE_END may be shorter
+          WM_FUZZ_CHECK( (_uploadStatus == UPLOAD_FILE_START) || (_uploadStatus == UPLOAD_FILE_WRITE) );
+          WM_FUZZ_CHECK( (_uploadStatus != UPLOAD_FILE_WRITE) || (_lastBlock == HTTP_UPLOAD_BUFLEN) );
+          WM_FUZZ_CHECK(upload.totalSize == _uploaded);
+
+          _uploaded  += upload.currentSize;
+          _lastBlock  = upload.currentSize;
+          break;
+
+        case UPLOAD_FILE_END:
+          WM_FUZZ_CHECK( (_uploadStatus == UPLOAD_FILE_START) || (_uploadStatus == UPLOAD_FILE_WRITE) );
+          WM_FUZZ_CHECK(upload.totalSize == _uploaded);
+          break;
+
+        case UPLOAD_FILE_ABORTED:
+          WM_FUZZ_CHECK(_uploadStatus != -1);
+          break;
+      }
+
+      _uploadStatus = upload.status;
+    }
+};
+
+#endif    // WM_FuzzWebServer_h
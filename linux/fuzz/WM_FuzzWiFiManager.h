@@ -0,0 +1,84 @@
+/****************************************************************************************************************************
+  WM_FuzzWiFiManager.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Access of the fuzzing targets to ESP_WiFiManager internals : WM_HostFuzz is a friend of the class. The
+  portal's web server is replaced by one whose request is set directly, so a handler runs on fuzzed
+  arguments without a socket.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WM_FuzzWiFiManager_h
+#define WM_FuzzWiFiManager_h
+
+#include <ESP_WiFiManager.h>
+
+#include <string>
+
+#include "WM_Fuzz.h"
+#include "WM_Host.h"
+
+class WM_FuzzHostServer : public WebServer
+{
+  public:
+
+    WM_FuzzHostServer() : WebServer(0) {}
+
+    // Request line and headers, to "\r\n\r\n", then the body. false : not a request.
+    bool load(const std::string& head, const std::string& body)
+    {
+      _currentArgs.clear();
+      _currentHeaders.clear();
+
+      return parseRequest(head, body);
+    }
+};
+
+////////////////////////////////////////////////////
+
+class WM_HostFuzz
+{
+  public:
+
+    // The portal's server, to fill with load()
+    static WM_FuzzHostServer& server(ESP_WiFiManager& wm)
+    {
+      if (!_server)
+      {
+        _server = new WM_FuzzHostServer();
+        wm.server.reset(_server);
+      }
+
+      return *_server;
+    }
+
+    static void handleWifiSave(ESP_WiFiManager& wm)
+    {
+      wm.connect = false;
+      wm.handleWifiSave();
+
+      WM_FUZZ_CHECK(wm.connect);
+    }
+
+    static bool isIp(ESP_WiFiManager& wm, const String& str)
+    {
+      return wm.isIp(str);
+    }
+
+    static bool optionalIPFromString(ESP_WiFiManager& wm, IPAddress* ip, const char* str)
+    {
+      return wm.optionalIPFromString(ip, str);
+    }
+
+  private:
+
+    static WM_FuzzHostServer* _server;
+};
+
+WM_FuzzHostServer* WM_HostFuzz::_server = nullptr;
+
+#endif    // WM_FuzzWiFiManager_h
@@ -0,0 +1,38 @@
+/****************************************************************************************************************************
+  fuzz_http.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Fuzzing target : the input is a raw HTTP request, request line, headers and body, to the patched ESP32
+  WebServer. See WM_FuzzWebServer.h for what is checked.
+ *****************************************************************************************************************************/
+
+#include "WM_FuzzWebServer.h"
+
+extern "C" int LLVMFuzzerInitialize(int* argc, char*** argv)
+{
+  (void) argc;
+  (void) argv;
+
+  WM_Host::setVirtualClock(true);
+
+  return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  static WM_FuzzWebServer server;
+  static bool             started = false;
+
+  if (!started)
+  {
+    server.begin();
+    started = true;
+  }
+
+  server.request(std::string((const char*) data, size));
+
+  return 0;
+}
@@ -0,0 +1,55 @@
+/****************************************************************************************************************************
+  fuzz_ip.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Fuzzing target : the IP address strings of the portal, isIp() and the IPAddress::fromString() that
+  handleWifiSave() applies to ip / gw / sn / dns1 / dns2. The input is the string. Checks :
+
+    isIp() is true exactly for strings of digits, '.' and ':'
+    a string fromString() accepts is one isIp() accepts
+    optionalIPFromString() gives what fromString() gives
+    an accepted address converts back to a string that parses to the same address
+ *****************************************************************************************************************************/
+
+#include "WM_FuzzWiFiManager.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  static ESP_WiFiManager wm("FuzzIP");
+
+  // As arguments reach it : C strings
+  String str(std::string((const char*) data, strnlen((const char*) data, size)).c_str());
+
+  bool ipChars = true;
+
+  for (unsigned int i = 0; i < str.length(); i++)
+  {
+    char c = str.charAt(i);
+
+    if ( !( ( (c >= '0') && (c <= '9') ) || (c == '.') || (c == ':') ) )
+      ipChars = false;
+  }
+
+  WM_FUZZ_CHECK(WM_HostFuzz::isIp(wm, str) == ipChars);
+
+  IPAddress ip;
+  IPAddress optional;
+  bool      valid = ip.fromString(str.c_str());
+
+  WM_FUZZ_CHECK(!valid || ipChars);
+  WM_FUZZ_CHECK(WM_HostFuzz::optionalIPFromString(wm, &optional, str.c_str()) == valid);
+
+  if (valid)
+  {
+    IPAddress back;
+
+    WM_FUZZ_CHECK(optional == ip);
+    WM_FUZZ_CHECK(back.fromString(ip.toString()));
+    WM_FUZZ_CHECK(back == ip);
+  }
+
+  return 0;
+}
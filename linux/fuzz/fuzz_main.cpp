@@ -0,0 +1,300 @@
+/****************************************************************************************************************************
+  fuzz_main.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Driver of the fuzzing targets when the compiler has no libFuzzer (gcc) : runs LLVMFuzzerTestOneInput() on
+  inputs, and optionally on random mutations of them. Not coverage guided, for AFL (stdin), reproducing a
+  crash and a quick check in a sanitizer build. With clang, the targets link libFuzzer instead.
+
+    fuzz_<target> [-runs=N] [-seed=N] [-max_len=N] [file | directory ...]
+
+    no file     one input from stdin, as AFL runs it
+    -runs=N     then N mutations (bit flips, byte changes, inserts, deletions, splices) of the inputs
+    -seed=N     of the mutations, default 1
+    -max_len=N  of the mutated inputs, default 4096
+
+  An input that crashes is written to crash-input in the current directory, to replay it.
+ *****************************************************************************************************************************/
+
+#include <dirent.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+extern "C" int LLVMFuzzerInitialize(int* argc, char*** argv) __attribute__((weak));
+
+// Sanitizer runtime, when linked
+extern "C" void __sanitizer_set_death_callback(void (*callback)(void)) __attribute__((weak));
+
+////////////////////////////////////////////////////
+
+namespace
+{
+  typedef std::vector<uint8_t> Input;
+
+  bool readFile(const std::string& path, Input& input)
+  {
+    FILE* file = fopen(path.c_str(), "rb");
+
+    if (!file)
+      return false;
+
+    uint8_t buf[4096];
+    size_t  len;
+
+    input.clear();
+
+    while ( (len = fread(buf, 1, sizeof(buf), file)) > 0 )
+      input.insert(input.end(), buf, buf + len);
+
+    fclose(file);
+
+    return true;
+  }
+
+  // A file, or the files of a directory, sorted so runs are repeatable
+  void collect(const std::string& path, std::vector<std::string>& files)
+  {
+    struct stat st;
+
+    if (stat(path.c_str(), &st) != 0)
+    {
+      fprintf(stderr, "Can't read %s\n", path.c_str());
+      exit(1);
+    }
+
+    if (!S_ISDIR(st.st_mode))
+    {
+      files.push_back(path);
+
+      return;
+    }
+
+    DIR*                      dir = opendir(path.c_str());
+    struct dirent*            entry;
+    std::vector<std::string>  names;
+
+    while ( dir && (entry = readdir(dir)) )
+    {
+      if (entry->d_name[0] != '.')
+        names.push_back(path + "/" + entry->d_name);
+    }
+
+    if (dir)
+      closedir(dir);
+
+    std::sort(names.begin(), names.end());
+
+    for (const auto& name : names)
+      collect(name, files);
+  }
+
+  const Input* current = nullptr;
+
+  void saveCurrent()
+  {
+    FILE* file = current ? fopen("crash-input", "wb") : nullptr;
+
+    if (file)
+    {
+      fwrite(current->data(), 1, current->size(), file);
+      fclose(file);
+      fprintf(stderr, "Input written to crash-input\n");
+    }
+
+    current = nullptr;
+  }
+
+  void onAbort(int sig)
+  {
+    saveCurrent();
+    signal(sig, SIG_DFL);
+    raise(sig);
+  }
+
+  void run(const Input& input)
+  {
+    current = &input;
+
+    // Exact size, so ASan sees reads past the end
+    uint8_t* copy = (uint8_t*) malloc(input.size() ? input.size() : 1);
+
+    if (input.size())
+      memcpy(copy, input.data(), input.size());
+    LLVMFuzzerTestOneInput(copy, input.size());
+    free(copy);
+
+    current = nullptr;
+  }
+
+  void mutate(Input& input, const std::vector<Input>& corpus, std::minstd_rand& rng, const size_t& maxLen)
+  {
+    int changes = 1 + rng() % 4;
+
+    while (changes--)
+    {
+      size_t size = input.size();
+
+      switch (rng() % 6)
+      {
+        case 0:
+          if (size)
+            input[rng() % size] ^= 1 << (rng() % 8);
+
+          break;
+
+        case 1:
+          if (size)
+            input[rng() % size] = rng();
+
+          break;
+
+        case 2:
+        {
+          // Interesting bytes of text protocols, or random
+          static const char special[] = "\r\n\0%&=+:;,.-/<>\"?";
+          uint8_t c = (rng() % 2) ? special[rng() % (sizeof(special) - 1)] : (uint8_t) rng();
+
+          input.insert(input.begin() + (size ? rng() % (size + 1) : 0), 1 + rng() % 8, c);
+          break;
+        }
+
+        case 3:
+          if (size)
+          {
+            size_t pos = rng() % size;
+
+            input.erase(input.begin() + pos, input.begin() + std::min(size, pos + 1 + rng() % 16));
+          }
+
+          break;
+
+        case 4:
+          if (size)
+          {
+            // Repeats a block, grows counts and lengths
+            size_t pos = rng() % size;
+            size_t len = 1 + rng() % std::min(size - pos, (size_t) 64);
+            Input  block(input.begin() + pos, input.begin() + pos + len);
+
+            input.insert(input.begin() + rng() % (size + 1), block.begin(), block.end());
+          }
+
+          break;
+
+        default:
+        {
+          // Part of another input
+          const Input& other = corpus[rng() % corpus.size()];
+
+          if (!other.empty())
+          {
+            size_t pos = rng() % other.size();
+            size_t len = 1 + rng() % (other.size() - pos);
+
+            input.insert(input.begin() + (size ? rng() % (size + 1) : 0), other.begin() + pos, other.begin() + pos + len);
+          }
+
+          break;
+        }
+      }
+    }
+
+    if (input.size() > maxLen)
+      input.resize(maxLen);
+  }
+}
+
+////////////////////////////////////////////////////
+
+int main(int argc, char** argv)
+{
+  unsigned long             runs    = 0;
+  unsigned long             seed    = 1;
+  size_t                    maxLen  = 4096;
+  std::vector<std::string>  files;
+
+  if (LLVMFuzzerInitialize)
+    LLVMFuzzerInitialize(&argc, &argv);
+
+  if (__sanitizer_set_death_callback)
+    __sanitizer_set_death_callback(saveCurrent);
+
+  signal(SIGABRT, onAbort);
+  signal(SIGSEGV, onAbort);
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strncmp(argv[i], "-runs=", 6) == 0)
+      runs = strtoul(argv[i] + 6, nullptr, 10);
+    else if (strncmp(argv[i], "-seed=", 6) == 0)
+      seed = strtoul(argv[i] + 6, nullptr, 10);
+    else if (strncmp(argv[i], "-max_len=", 9) == 0)
+      maxLen = strtoul(argv[i] + 9, nullptr, 10);
+    else if (argv[i][0] == '-')
+      fprintf(stderr, "Ignoring %s, only -runs= -seed= -max_len= without libFuzzer\n", argv[i]);
+    else
+      collect(argv[i], files);
+  }
+
+  std::vector<Input> corpus;
+
+  if (files.empty())
+  {
+    Input input;
+
+    readFile("/dev/stdin", input);
+    corpus.push_back(input);
+  }
+
+  for (const auto& file : files)
+  {
+    Input input;
+
+    if (!readFile(file, input))
+    {
+      fprintf(stderr, "Can't read %s\n", file.c_str());
+
+      return 1;
+    }
+
+    corpus.push_back(input);
+  }
+
+  for (const auto& input : corpus)
+    run(input);
+
+  fprintf(stderr, "%s : %zu inputs\n", argv[0], corpus.size());
+
+  if (runs == 0)
+    return 0;
+
+  std::minstd_rand rng(seed);
+
+  for (unsigned long i = 0; i < runs; i++)
+  {
+    Input input = corpus[rng() % corpus.size()];
+
+    mutate(input, corpus, rng, maxLen);
+    run(input);
+
+    // Grow the pool a little, so mutations stack
+    if ( (i % 16) == 0 )
+      corpus.push_back(input);
+  }
+
+  fprintf(stderr, "%s : %lu mutations, seed %lu\n", argv[0], runs, seed);
+
+  return 0;
+}
@@ -0,0 +1,62 @@
+/****************************************************************************************************************************
+  fuzz_multipart.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Fuzzing target : multipart/form-data uploads to the patched ESP32 WebServer. The target writes a valid
+  head, so every input reaches the multipart parser :
+
+    byte 0        bit 0 : quoted boundary, bit 1 : Content-Length one byte short, bit 2 : one byte long
+    up to '\n'    the boundary, at most 70 bytes
+    the rest      the body
+
+  See WM_FuzzWebServer.h for what is checked of the parts and upload events.
+ *****************************************************************************************************************************/
+
+#include "WM_FuzzWebServer.h"
+
+extern "C" int LLVMFuzzerInitialize(int* argc, char*** argv)
+{
+  (void) argc;
+  (void) argv;
+
+  WM_Host::setVirtualClock(true);
+
+  return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  static WM_FuzzWebServer server;
+  static bool             started = false;
+
+  if (!started)
+  {
+    server.begin();
+    started = true;
+  }
+
+  WM_FuzzInput input(data, size);
+
+  uint8_t     flags     = input.byte();
+  std::string boundary  = input.token('\n', 70);
+  std::string body      = input.rest();
+  size_t      length    = body.size();
+
+  if ( (flags & 0x02) && length )
+    length--;
+  else if (flags & 0x04)
+    length++;
+
+  std::string request = "POST /upload HTTP/1.1\r\nHost: 192.168.4.1\r\nContent-Type: multipart/form-data; boundary=";
+
+  request += (flags & 0x01) ? "\"" + boundary + "\"" : boundary;
+  request += "\r\nContent-Length: " + std::to_string(length) + "\r\n\r\n";
+  request += body;
+
+  server.request(request);
+
+  return 0;
+}
@@ -0,0 +1,109 @@
+/****************************************************************************************************************************
+  fuzz_tz.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Fuzzing target : the time zone names of the portal's form, getTZ() and the time zone database, and the
+  POSIX TZ rules ESP_WMTimeZone compiles. The input is :
+
+    up to '\n'    a time zone name, looked up with getTZ() and, into a short buffer, WM_findTZRule()
+    up to '\n'    a POSIX TZ rule
+    the rest      UTC times, 8 bytes each, within about 35000 years of 1970
+
+  Checks :
+
+    every rule of the database compiles
+    a truncated lookup is 0 terminated within its buffer
+    for each time of a rule that compiles : at most two offsets, one without DST, localTime() as gmtime_r()
+    of the local time, and local to UTC back to the same time but in an hour a DST end repeats
+ *****************************************************************************************************************************/
+
+#include <set>
+
+#include "WM_FuzzWiFiManager.h"
+
+// About 35000 years, broken down times keep in range of every field
+#define WM_FUZZ_MAX_TIME      (1LL << 40)
+
+namespace
+{
+  void checkTime(const ESP_WMTimeZone& zone, const time_t& utc, std::set<int32_t>& offsets)
+  {
+    int32_t offset = zone.offset(utc);
+    time_t  local  = zone.toLocal(utc);
+
+    offsets.insert(offset);
+
+    WM_FUZZ_CHECK(local == utc + offset);
+    WM_FUZZ_CHECK(zone.hasDST() || !zone.isDST(utc));
+    WM_FUZZ_CHECK(strlen(zone.abbreviation(utc)) <= WM_TZ_ABBR_MAX_LEN);
+
+    struct tm tm;
+    struct tm expected;
+
+    zone.localTime(utc, tm);
+    WM_FUZZ_CHECK(gmtime_r(&local, &expected));
+
+    WM_FUZZ_CHECK( (tm.tm_year == expected.tm_year) && (tm.tm_mon == expected.tm_mon) && (tm.tm_mday == expected.tm_mday) );
+    WM_FUZZ_CHECK( (tm.tm_hour == expected.tm_hour) && (tm.tm_min == expected.tm_min) && (tm.tm_sec == expected.tm_sec) );
+    WM_FUZZ_CHECK( (tm.tm_wday == expected.tm_wday) && (tm.tm_yday == expected.tm_yday) );
+    WM_FUZZ_CHECK(tm.tm_isdst == (zone.isDST(utc) ? 1 : 0));
+
+    // Back to the same time, but for local times a DST end repeats : those are taken as DST
+    time_t back = zone.toUTC(local);
+
+    if (back != utc)
+    {
+      WM_FUZZ_CHECK(!zone.isDST(utc) && zone.isDST(back));
+      WM_FUZZ_CHECK(zone.toLocal(back) == local);
+    }
+  }
+}
+
+////////////////////////////////////////////////////
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  static ESP_WiFiManager wm("FuzzTZ");
+
+  WM_FuzzInput  input(data, size);
+  std::string   name  = input.token('\n', 64);
+  std::string   rule  = input.token('\n', 128);
+
+  const char* found = wm.getTZ(name.c_str());
+
+  if (found && found[0])
+  {
+    ESP_WMTimeZone zone;
+
+    WM_FUZZ_CHECK(zone.begin(found));
+  }
+
+  char    shortRule[16];
+  size_t  shortLen = 1 + name.size() % sizeof(shortRule);
+
+  memset(shortRule, 'x', sizeof(shortRule));
+
+  if (WM_findTZRule(name.c_str(), shortRule, shortLen))
+    WM_FUZZ_CHECK(strnlen(shortRule, shortLen) < shortLen);
+
+  ESP_WMTimeZone zone;
+
+  if (!zone.begin(rule.c_str()))
+    return 0;
+
+  std::set<int32_t> offsets;
+
+  while (input.remaining())
+  {
+    time_t utc = (time_t) (input.int64() % WM_FUZZ_MAX_TIME);
+
+    checkTime(zone, utc, offsets);
+  }
+
+  WM_FUZZ_CHECK(offsets.size() <= (zone.hasDST() ? 2U : 1U));
+
+  return 0;
+}
@@ -0,0 +1,84 @@
+/****************************************************************************************************************************
+  fuzz_urldecode.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Fuzzing target : WebServer::urlDecode() of the patched ESP32 WebServer, which decodes every argument name
+  and value. The input is the encoded text. Checks :
+
+    the decoded text is never longer than the encoded one
+    when every '%' starts a valid escape, the text decodes as RFC 3986 and HTML forms say ('+' is a space)
+ *****************************************************************************************************************************/
+
+#include <WebServer.h>
+
+#include "WM_Fuzz.h"
+
+namespace
+{
+  int hexValue(const char& c)
+  {
+    if ( (c >= '0') && (c <= '9') )
+      return c - '0';
+
+    if ( (c >= 'a') && (c <= 'f') )
+      return c - 'a' + 10;
+
+    if ( (c >= 'A') && (c <= 'F') )
+      return c - 'A' + 10;
+
+    return -1;
+  }
+
+  // false when an escape isn't valid, the device's decoding of those is its own
+  bool reference(const std::string& text, std::string& decoded)
+  {
+    decoded.clear();
+
+    for (size_t i = 0; i < text.size(); i++)
+    {
+      if (text[i] == '+')
+      {
+        decoded += ' ';
+      }
+      else if (text[i] == '%')
+      {
+        if ( (i + 2 >= text.size()) || (hexValue(text[i + 1]) < 0) || (hexValue(text[i + 2]) < 0) )
+          return false;
+
+        decoded += (char) (hexValue(text[i + 1]) * 16 + hexValue(text[i + 2]));
+        i += 2;
+      }
+      else
+      {
+        decoded += text[i];
+      }
+    }
+
+    return true;
+  }
+}
+
+////////////////////////////////////////////////////
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  // As arguments reach it : C strings
+  std::string text((const char*) data, strnlen((const char*) data, size));
+  String      decoded = WebServer::urlDecode(String(text.c_str()));
+  std::string expected;
+
+  WM_FUZZ_CHECK(decoded.length() <= text.size());
+
+  if (reference(text, expected))
+  {
+    // A decoded 0 ends the C string
+    expected.resize(strnlen(expected.c_str(), expected.size()));
+
+    WM_FUZZ_CHECK(expected == decoded.c_str());
+  }
+
+  return 0;
+}
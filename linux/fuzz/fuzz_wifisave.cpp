@@ -0,0 +1,88 @@
+/****************************************************************************************************************************
+  fuzz_wifisave.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Fuzzing target : handleWifiSave(), the form of the Config Portal that stores credentials, custom parameters
+  and the static IP configuration. The input is the query string, up to '\n', then the urlencoded body
+  of a POST /wifisave. Custom parameters of 1, 6 and 40 bytes take their fields. Checks :
+
+    the request is handled, connect is set
+    every parameter value is 0 terminated within its length
+    ip / gw / sn / dns1 / dns2 that parse are the static IP configuration
+ *****************************************************************************************************************************/
+
+#include "WM_FuzzWiFiManager.h"
+
+namespace
+{
+  ESP_WMParameter flag("flag", "Flag", "", 1);
+  ESP_WMParameter port("port", "Port", "1883", 6);
+  ESP_WMParameter host("host", "Host", "", 40);
+
+  void checkIP(WM_FuzzHostServer& server, const char* name, const IPAddress& stored)
+  {
+    IPAddress ip;
+
+    if (ip.fromString(server.arg(name)))
+      WM_FUZZ_CHECK(stored == ip);
+  }
+}
+
+extern "C" int LLVMFuzzerInitialize(int* argc, char*** argv)
+{
+  (void) argc;
+  (void) argv;
+
+  WM_Host::setVirtualClock(true);
+
+  return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  static ESP_WiFiManager wm("FuzzSave");
+  static bool            started = false;
+
+  if (!started)
+  {
+    wm.addParameter(&flag);
+    wm.addParameter(&port);
+    wm.addParameter(&host);
+    started = true;
+  }
+
+  WM_FuzzInput        input(data, size);
+  std::string         query   = input.token('\n');
+  std::string         body    = input.rest();
+  WM_FuzzHostServer&  server  = WM_HostFuzz::server(wm);
+
+  std::string head = "POST /wifisave" + (query.empty() ? "" : "?" + query) + " HTTP/1.1\r\n"
+                     "Host: 192.168.4.1\r\nContent-Type: application/x-www-form-urlencoded\r\n"
+                     "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n";
+
+  if (!server.load(head, body))
+    return 0;
+
+  WM_HostFuzz::handleWifiSave(wm);
+
+  for (ESP_WMParameter* param : { &flag, &port, &host })
+    WM_FUZZ_CHECK(strnlen(param->getValue(), param->getValueLength() + 1) <= (size_t) param->getValueLength());
+
+  WiFi_STA_IPConfig config;
+
+  wm.getSTAStaticIPConfig(config);
+
+  checkIP(server, "ip",   config._sta_static_ip);
+  checkIP(server, "gw",   config._sta_static_gw);
+  checkIP(server, "sn",   config._sta_static_sn);
+
+#if USE_CONFIGURABLE_DNS
+  checkIP(server, "dns1", config._sta_static_dns1);
+  checkIP(server, "dns2", config._sta_static_dns2);
+#endif
+
+  return 0;
+}
@@ -0,0 +1,25 @@
+/****************************************************************************************************************************
+  FS.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  File system type of the ESP32 core, only so serveStatic() compiles : the host has no file system to serve
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef FS_h
+#define FS_h
+
+namespace fs
+{
+  class FS
+  {
+  };
+}
+
+using fs::FS;
+
+#endif    // FS_h
@@ -0,0 +1,52 @@
+/****************************************************************************************************************************
+  Uri.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Exact match URI of the ESP32 WebServer
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef Uri_h
+#define Uri_h
+
+#include <vector>
+
+#include "Arduino.h"
+
+class Uri
+{
+  protected:
+
+    const String _uri;
+
+  public:
+
+    Uri(const char* uri) : _uri(uri) {}
+    Uri(const String& uri) : _uri(uri) {}
+    Uri(const __FlashStringHelper* uri) : _uri(String(uri)) {}
+
+    virtual ~Uri() {}
+
+    virtual Uri* clone() const
+    {
+      return new Uri(_uri);
+    }
+
+    virtual void initPathArgs(std::vector<String>& pathArgs)
+    {
+      (void) pathArgs;
+    }
+
+    virtual bool canHandle(const String& requestUri, std::vector<String>& pathArgs)
+    {
+      (void) pathArgs;
+
+      return _uri == requestUri;
+    }
+};
+
+#endif    // Uri_h
@@ -0,0 +1,83 @@
+/****************************************************************************************************************************
+  detail/RequestHandler.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Request handler base of the ESP32 WebServer
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef RequestHandler_h
+#define RequestHandler_h
+
+#include <assert.h>
+
+#include <vector>
+
+class RequestHandler
+{
+  public:
+
+    virtual ~RequestHandler() {}
+
+    virtual bool canHandle(HTTPMethod method, String uri)
+    {
+      (void) method;
+      (void) uri;
+
+      return false;
+    }
+
+    virtual bool canUpload(String uri)
+    {
+      (void) uri;
+
+      return false;
+    }
+
+    virtual bool handle(WebServer& server, HTTPMethod requestMethod, String requestUri)
+    {
+      (void) server;
+      (void) requestMethod;
+      (void) requestUri;
+
+      return false;
+    }
+
+    virtual void upload(WebServer& server, String requestUri, HTTPUpload& upload)
+    {
+      (void) server;
+      (void) requestUri;
+      (void) upload;
+    }
+
+    RequestHandler* next()
+    {
+      return _next;
+    }
+
+    void next(RequestHandler* r)
+    {
+      _next = r;
+    }
+
+    const String& pathArg(unsigned int i)
+    {
+      assert(i < pathArgs.size());
+
+      return pathArgs[i];
+    }
+
+  private:
+
+    RequestHandler*     _next = nullptr;
+
+  protected:
+
+    std::vector<String> pathArgs;
+};
+
+#endif    // RequestHandler_h
@@ -0,0 +1,91 @@
+/****************************************************************************************************************************
+  detail/RequestHandlersImpl.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Function handler of the ESP32 WebServer. No file system on the host : static handlers never match.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef RequestHandlersImpl_h
+#define RequestHandlersImpl_h
+
+#include "RequestHandler.h"
+#include "mimetable.h"
+#include "FS.h"
+
+class FunctionRequestHandler : public RequestHandler
+{
+  public:
+
+    FunctionRequestHandler(WebServer::THandlerFunction fn, WebServer::THandlerFunction ufn, const Uri& uri,
+                           HTTPMethod method)
+      : _fn(fn), _ufn(ufn), _uri(uri.clone()), _method(method)
+    {
+      _uri->initPathArgs(pathArgs);
+    }
+
+    ~FunctionRequestHandler()
+    {
+      delete _uri;
+    }
+
+    bool canHandle(HTTPMethod requestMethod, String requestUri) override
+    {
+      if ( (_method != HTTP_ANY) && (_method != requestMethod) )
+        return false;
+
+      return _uri->canHandle(requestUri, pathArgs);
+    }
+
+    bool canUpload(String requestUri) override
+    {
+      return _ufn && canHandle(HTTP_POST, requestUri);
+    }
+
+    bool handle(WebServer& server, HTTPMethod requestMethod, String requestUri) override
+    {
+      (void) server;
+
+      if (!canHandle(requestMethod, requestUri))
+        return false;
+
+      _fn();
+
+      return true;
+    }
+
+    void upload(WebServer& server, String requestUri, HTTPUpload& upload) override
+    {
+      (void) server;
+      (void) upload;
+
+      if (canUpload(requestUri))
+        _ufn();
+    }
+
+  protected:
+
+    WebServer::THandlerFunction _fn;
+    WebServer::THandlerFunction _ufn;
+    Uri*                        _uri;
+    HTTPMethod                  _method;
+};
+
+class StaticRequestHandler : public RequestHandler
+{
+  public:
+
+    StaticRequestHandler(FS& fs, const char* path, const char* uri, const char* cache_header)
+    {
+      (void) fs;
+      (void) path;
+      (void) uri;
+      (void) cache_header;
+    }
+};
+
+#endif    // RequestHandlersImpl_h
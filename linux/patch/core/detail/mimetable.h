@@ -0,0 +1,80 @@
+/****************************************************************************************************************************
+  detail/mimetable.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  MIME types of the ESP32 WebServer
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef mimetable_h
+#define mimetable_h
+
+namespace mime
+{
+  enum type
+  {
+    html,
+    htm,
+    css,
+    txt,
+    js,
+    json,
+    png,
+    gif,
+    jpg,
+    ico,
+    svg,
+    ttf,
+    otf,
+    woff,
+    woff2,
+    eot,
+    sfnt,
+    xml,
+    pdf,
+    zip,
+    gz,
+    appcache,
+    none,
+    maxType
+  };
+
+  struct Entry
+  {
+    const char endsWith[16];
+    const char mimeType[32];
+  };
+
+  inline const Entry mimeTable[maxType] =
+  {
+    { ".html",      "text/html" },
+    { ".htm",       "text/html" },
+    { ".css",       "text/css" },
+    { ".txt",       "text/plain" },
+    { ".js",        "application/javascript" },
+    { ".json",      "application/json" },
+    { ".png",       "image/png" },
+    { ".gif",       "image/gif" },
+    { ".jpg",       "image/jpeg" },
+    { ".ico",       "image/x-icon" },
+    { ".svg",       "image/svg+xml" },
+    { ".ttf",       "application/x-font-ttf" },
+    { ".otf",       "application/x-font-opentype" },
+    { ".woff",      "application/font-woff" },
+    { ".woff2",     "application/font-woff2" },
+    { ".eot",       "application/vnd.ms-fontobject" },
+    { ".sfnt",      "application/font-sfnt" },
+    { ".xml",       "text/xml" },
+    { ".pdf",       "application/pdf" },
+    { ".zip",       "application/zip" },
+    { ".gz",        "application/x-gzip" },
+    { ".appcache",  "text/cache-manifest" },
+    { "",           "application/octet-stream" }
+  };
+}
+
+#endif    // mimetable_h
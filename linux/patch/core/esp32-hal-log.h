@@ -0,0 +1,27 @@
+/****************************************************************************************************************************
+  esp32-hal-log.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Core log macros of the ESP32 WebServer, silent as in a release build : fuzzing inputs are mostly invalid
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef esp32_hal_log_h
+#define esp32_hal_log_h
+
+#include <stdio.h>
+
+// Arguments still evaluated and checked against the format, as on the device
+#define WM_FUZZ_LOG(format, ...)    do { if (0) printf(format, ##__VA_ARGS__); } while (0)
+
+#define log_e(format, ...)          WM_FUZZ_LOG(format, ##__VA_ARGS__)
+#define log_w(format, ...)          WM_FUZZ_LOG(format, ##__VA_ARGS__)
+#define log_i(format, ...)          WM_FUZZ_LOG(format, ##__VA_ARGS__)
+#define log_d(format, ...)          WM_FUZZ_LOG(format, ##__VA_ARGS__)
+#define log_v(format, ...)          WM_FUZZ_LOG(format, ##__VA_ARGS__)
+
+#endif    // esp32_hal_log_h
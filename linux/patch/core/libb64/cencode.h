@@ -0,0 +1,51 @@
+/****************************************************************************************************************************
+  libb64/cencode.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Base64 encoder of the ESP32 core, for Basic authentication. No line breaks.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef cencode_h
+#define cencode_h
+
+inline int base64_encode_expected_len(int plaintext_len)
+{
+  return ( (plaintext_len + 2) / 3) * 4;
+}
+
+// Returns the length written, code_out is 0 terminated
+inline int base64_encode_chars(const char* plaintext_in, int length_in, char* code_out)
+{
+  static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  const unsigned char*  in  = (const unsigned char*) plaintext_in;
+  char*                 out = code_out;
+
+  for (int i = 0; i < length_in; i += 3)
+  {
+    unsigned int  n     = in[i] << 16;
+    int           left  = length_in - i;
+
+    if (left > 1)
+      n |= in[i + 1] << 8;
+
+    if (left > 2)
+      n |= in[i + 2];
+
+    *out++ = alphabet[(n >> 18) & 0x3F];
+    *out++ = alphabet[(n >> 12) & 0x3F];
+    *out++ = (left > 1) ? alphabet[(n >> 6) & 0x3F] : '=';
+    *out++ = (left > 2) ? alphabet[n & 0x3F] : '=';
+  }
+
+  *out = 0;
+
+  return out - code_out;
+}
+
+#endif    // cencode_h
@@ -0,0 +1,160 @@
+/****************************************************************************************************************************
+  mbedtls/md5.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  mbedTLS MD5 API of ESP-IDF, for Digest authentication, over a plain RFC 1321 implementation
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef mbedtls_md5_h
+#define mbedtls_md5_h
+
+#include <stdint.h>
+#include <string.h>
+
+typedef struct
+{
+  uint32_t  state[4];
+  uint64_t  length;       // bytes
+  uint8_t   buffer[64];
+} mbedtls_md5_context;
+
+inline void mbedtls_md5_process(mbedtls_md5_context* ctx, const uint8_t block[64])
+{
+  static const uint32_t K[64] =
+  {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+  };
+
+  static const uint8_t S[16] = { 7, 12, 17, 22, 5, 9, 14, 20, 4, 11, 16, 23, 6, 10, 15, 21 };
+
+  uint32_t M[16];
+
+  for (int i = 0; i < 16; i++)
+    M[i] = block[i * 4] | (block[i * 4 + 1] << 8) | (block[i * 4 + 2] << 16) | ((uint32_t) block[i * 4 + 3] << 24);
+
+  uint32_t a = ctx->state[0];
+  uint32_t b = ctx->state[1];
+  uint32_t c = ctx->state[2];
+  uint32_t d = ctx->state[3];
+
+  for (int i = 0; i < 64; i++)
+  {
+    uint32_t f;
+    int      g;
+
+    if (i < 16)
+    {
+      f = (b & c) | (~b & d);
+      g = i;
+    }
+    else if (i < 32)
+    {
+      f = (d & b) | (~d & c);
+      g = (5 * i + 1) % 16;
+    }
+    else if (i < 48)
+    {
+      f = b ^ c ^ d;
+      g = (3 * i + 5) % 16;
+    }
+    else
+    {
+      f = c ^ (b | ~d);
+      g = (7 * i) % 16;
+    }
+
+    uint32_t s = S[(i / 16) * 4 + (i % 4)];
+
+    f = f + a + K[i] + M[g];
+    a = d;
+    d = c;
+    c = b;
+    b = b + ( (f << s) | (f >> (32 - s)) );
+  }
+
+  ctx->state[0] += a;
+  ctx->state[1] += b;
+  ctx->state[2] += c;
+  ctx->state[3] += d;
+}
+
+inline void mbedtls_md5_init(mbedtls_md5_context* ctx)
+{
+  memset(ctx, 0, sizeof(*ctx));
+}
+
+inline void mbedtls_md5_free(mbedtls_md5_context* ctx)
+{
+  memset(ctx, 0, sizeof(*ctx));
+}
+
+inline int mbedtls_md5_starts(mbedtls_md5_context* ctx)
+{
+  ctx->state[0] = 0x67452301;
+  ctx->state[1] = 0xefcdab89;
+  ctx->state[2] = 0x98badcfe;
+  ctx->state[3] = 0x10325476;
+  ctx->length   = 0;
+
+  return 0;
+}
+
+inline int mbedtls_md5_update(mbedtls_md5_context* ctx, const unsigned char* input, size_t ilen)
+{
+  size_t used = ctx->length % 64;
+
+  ctx->length += ilen;
+
+  while (ilen > 0)
+  {
+    size_t n = (ilen < 64 - used) ? ilen : 64 - used;
+
+    memcpy(ctx->buffer + used, input, n);
+    used  += n;
+    input += n;
+    ilen  -= n;
+
+    if (used == 64)
+    {
+      mbedtls_md5_process(ctx, ctx->buffer);
+      used = 0;
+    }
+  }
+
+  return 0;
+}
+
+inline int mbedtls_md5_finish(mbedtls_md5_context* ctx, unsigned char output[16])
+{
+  static const unsigned char padding[64] = { 0x80 };
+
+  uint64_t      bits = ctx->length * 8;
+  unsigned char size[8];
+
+  for (int i = 0; i < 8; i++)
+    size[i] = (unsigned char) (bits >> (8 * i));
+
+  size_t used = ctx->length % 64;
+
+  mbedtls_md5_update(ctx, padding, (used < 56) ? 56 - used : 120 - used);
+  mbedtls_md5_update(ctx, size, 8);
+
+  for (int i = 0; i < 16; i++)
+    output[i] = (unsigned char) (ctx->state[i / 4] >> (8 * (i % 4)));
+
+  return 0;
+}
+
+#endif    // mbedtls_md5_h
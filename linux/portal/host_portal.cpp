@@ -0,0 +1,137 @@
+/****************************************************************************************************************************
+  host_portal.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  ESP_WiFiManager is a library for the ESP8266/Arduino platform
+  (https://github.com/esp8266/Arduino) to enable easy
+  configuration and reconfiguration of WiFi credentials using a Captive Portal
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Runs the Config Portal on the host, against a scenario of simulated access points :
+
+    host_portal [-s scenario] [-v] [-t timeout_s] [-a] [-n ap_name] [-p ap_password]
+
+    -s  scenario file, see WM_HostRadio.h (default : one open AP "HostAP")
+    -v  virtual clock
+    -t  portal timeout, 0 (default) : none
+    -a  autoConnect() with the credentials given in the portal, instead of startConfigPortal()
+
+  The portal listens on HTTP_PORT (8080) and the captive DNS on WM_DNS_PORT (5353) :
+    curl http://127.0.0.1:8080/        dig @127.0.0.1 -p 5353 example.com
+
+  Built with -DWM_HOST_ALLOC_TRACKING=ON, prints the allocations of each request, and their totals at the end.
+
+  Exits with 0 once connected to an AP, 1 otherwise.
+ *****************************************************************************************************************************/
+
+#include <unistd.h>
+
+#include <ESP_WiFiManager.h>
+
+#include "WM_Host.h"
+
+int main(int argc, char* argv[])
+{
+  const char*   scenario    = nullptr;
+  const char*   apName      = "ESP_HostPortal";
+  const char*   apPassword  = nullptr;
+  unsigned long timeout     = 0;
+  bool          autoConnect = false;
+  int           opt;
+
+  while ( (opt = getopt(argc, argv, "s:vt:an:p:")) != -1 )
+  {
+    switch (opt)
+    {
+      case 's':
+        scenario = optarg;
+        break;
+
+      case 'v':
+        WM_Host::setVirtualClock(true);
+        break;
+
+      case 't':
+        timeout = strtoul(optarg, nullptr, 10);
+        break;
+
+      case 'a':
+        autoConnect = true;
+        break;
+
+      case 'n':
+        apName = optarg;
+        break;
+
+      case 'p':
+        apPassword = optarg;
+        break;
+
+      default:
+        fprintf(stderr, "usage: %s [-s scenario] [-v] [-t timeout_s] [-a] [-n ap_name] [-p ap_password]\n", argv[0]);
+        return 2;
+    }
+  }
+
+  WM_HostRadio& radio = WM_HostRadio::get();
+
+  if (scenario)
+  {
+    if (!radio.loadScenario(scenario))
+    {
+      fprintf(stderr, "%s\n", radio.error().c_str());
+      return 2;
+    }
+  }
+  else
+  {
+    radio.addAP("HostAP");
+  }
+
+  // Line buffered, for logs read through a pipe
+  setvbuf(stdout, nullptr, _IOLBF, 0);
+
+  Serial.begin(115200);
+  Serial.print(F("\nStarting host_portal on "));
+  Serial.println(ARDUINO_BOARD);
+  Serial.println(ESP_WIFIMANAGER_VERSION);
+
+  ESP_WiFiManager ESP_wifiManager("HostPortal");
+
+  ESP_wifiManager.setConfigPortalTimeout(timeout);
+
+  bool connected;
+
+  if (autoConnect)
+  {
+    connected = ESP_wifiManager.autoConnect(apName, apPassword);
+  }
+  else
+  {
+    // Station off : startConfigPortal() would otherwise first wait 60s in WiFi.waitForConnectResult(),
+    // as on an ESP32 with nothing to connect to
+    WiFi.mode(WIFI_AP);
+
+    connected = ESP_wifiManager.startConfigPortal(apName, apPassword);
+  }
+
+#if USE_WM_ALLOC_TRACKING
+  ESP_wifiManager.allocTracker().printTable(Serial);
+#endif
+
+  if (connected && (WiFi.status() == WL_CONNECTED))
+  {
+    Serial.print(F("Connected to "));
+    Serial.print(WiFi.SSID());
+    Serial.print(F(", IP = "));
+    Serial.println(WiFi.localIP());
+
+    return 0;
+  }
+
+  Serial.println(F("Not connected"));
+
+  return 1;
+}
@@ -0,0 +1,27 @@
+/****************************************************************************************************************************
+  sketch_main.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  main() of an Arduino sketch built on the host (WM_HOST_SKETCH) : setup() once, then loop(), as the
+  ESP32 core's loopTask. Sketches are compiled as C++ with Arduino.h included first, the way the Arduino
+  builder does, but without its generated prototypes : functions are declared before use.
+ *****************************************************************************************************************************/
+
+#include <Arduino.h>
+
+void setup();
+void loop();
+
+int main()
+{
+  setup();
+
+  while (true)
+  {
+    loop();
+    yield();
+  }
+}
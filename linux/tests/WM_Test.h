@@ -0,0 +1,139 @@
+/****************************************************************************************************************************
+  WM_Test.h
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Helpers of the host tests : checks that report every failure and make the test exit 1, and loopback TCP
+  clients with a deadline. A test is a program, run by ctest.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WM_Test_h
+#define WM_Test_h
+
+#include <poll.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <chrono>
+#include <string>
+
+namespace WM_Test
+{
+  inline int& failures()
+  {
+    static int count = 0;
+
+    return count;
+  }
+
+  // Exit code of the test
+  inline int result(const char* name)
+  {
+    if (failures())
+      fprintf(stderr, "%s : %d check(s) failed\n", name, failures());
+    else
+      printf("%s : OK\n", name);
+
+    return failures() ? 1 : 0;
+  }
+
+  // ms of a steady clock, for latencies
+  inline double nowMs()
+  {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  ////////////////////////////////////////////////////
+
+  // Connected to 127.0.0.1:port, -1 on failure
+  inline int connectTcp(const uint16_t& port)
+  {
+    int                fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if ( (fd >= 0) && (::connect(fd, (struct sockaddr*) &addr, sizeof(addr)) != 0) )
+    {
+      ::close(fd);
+      fd = -1;
+    }
+
+    return fd;
+  }
+
+  inline bool sendAll(const int& fd, const std::string& data)
+  {
+    return ::send(fd, data.data(), data.size(), MSG_NOSIGNAL) == (ssize_t) data.size();
+  }
+
+  // What the peer sends until it closes or timeoutMs passes
+  inline std::string receiveAll(const int& fd, const int& timeoutMs)
+  {
+    std::string   response;
+    double        deadline = nowMs() + timeoutMs;
+    char          buf[4096];
+
+    for (;;)
+    {
+      int left = (int) (deadline - nowMs());
+
+      if (left <= 0)
+        break;
+
+      struct pollfd pfd = { fd, POLLIN, 0 };
+
+      if (poll(&pfd, 1, left) <= 0)
+        break;
+
+      ssize_t len = recv(fd, buf, sizeof(buf), 0);
+
+      if (len <= 0)
+        break;
+
+      response.append(buf, len);
+    }
+
+    return response;
+  }
+
+  // One request on its own connection, the response once the server closes
+  inline std::string request(const uint16_t& port, const std::string& data, const int& timeoutMs = 2000)
+  {
+    int fd = connectTcp(port);
+
+    if (fd < 0)
+      return std::string();
+
+    std::string response = sendAll(fd, data) ? receiveAll(fd, timeoutMs) : std::string();
+
+    ::close(fd);
+
+    return response;
+  }
+}
+
+#define WM_TEST_CHECK(cond)                                                           \
+  do                                                                                  \
+  {                                                                                   \
+    if (!(cond))                                                                      \
+    {                                                                                 \
+      fprintf(stderr, "%s:%d : check failed : %s\n", __FILE__, __LINE__, #cond);      \
+      WM_Test::failures()++;                                                          \
+    }                                                                                 \
+  } while (0)
+
+#endif    // WM_Test_h
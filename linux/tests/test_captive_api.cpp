@@ -0,0 +1,59 @@
+/****************************************************************************************************************************
+  test_captive_api.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  The captive-portal identification of WM_CaptivePortalAPI.h : the DHCP option 114 URI, up to the 255 bytes its
+  one-byte length allows, and the RFC 8908 JSON document, both refused rather than truncated.
+ *****************************************************************************************************************************/
+
+#include <utils/WM_CaptivePortalAPI.h>
+
+#include <string>
+
+#include "WM_Test.h"
+
+int main()
+{
+  char buf[WM_CAPTIVE_URI_MAXLEN + 64];
+
+  // The URI of the portal's API endpoint
+  WM_TEST_CHECK(WM_buildCaptiveURI(buf, sizeof(buf), "192.168.4.1") == strlen("http://192.168.4.1/api/captive"));
+  WM_TEST_CHECK(strcmp(buf, "http://192.168.4.1/api/captive") == 0);
+
+  // Up to WM_CAPTIVE_URI_MAXLEN bytes, no more
+  size_t      fixedLen = strlen("http://") + strlen(WM_CAPTIVE_API_PATH);
+  std::string host(WM_CAPTIVE_URI_MAXLEN - fixedLen, 'h');
+
+  WM_TEST_CHECK(WM_buildCaptiveURI(buf, sizeof(buf), host.c_str()) == WM_CAPTIVE_URI_MAXLEN);
+  WM_TEST_CHECK(strlen(buf) == WM_CAPTIVE_URI_MAXLEN);
+
+  host += 'h';
+
+  WM_TEST_CHECK(WM_buildCaptiveURI(buf, sizeof(buf), host.c_str()) == 0);
+
+  // Nor past the buffer, terminating zero included
+  char small[20];
+
+  WM_TEST_CHECK(WM_buildCaptiveURI(small, sizeof(small), "192.168.4.1") == 0);
+  WM_TEST_CHECK(WM_buildCaptiveURI(buf, strlen("http://192.168.4.1/api/captive"), "192.168.4.1") == 0);
+  WM_TEST_CHECK(WM_buildCaptiveURI(buf, strlen("http://192.168.4.1/api/captive") + 1, "192.168.4.1") > 0);
+
+  // The RFC 8908 document
+  const char* json = "{\"captive\":true,\"user-portal-url\":\"http://192.168.4.1/\"}";
+
+  WM_TEST_CHECK(WM_buildCaptiveJSON(buf, sizeof(buf), "http://192.168.4.1/") == strlen(json));
+  WM_TEST_CHECK(strcmp(buf, json) == 0);
+
+  WM_TEST_CHECK(WM_buildCaptiveJSON(buf, strlen(json), "http://192.168.4.1/") == 0);
+  WM_TEST_CHECK(WM_buildCaptiveJSON(buf, strlen(json) + 1, "http://192.168.4.1/") == strlen(json));
+
+  // The longest portal URL fits the buffer the manager builds it in
+  host.assign(WM_CAPTIVE_URI_MAXLEN, 'h');
+
+  WM_TEST_CHECK(WM_buildCaptiveJSON(buf, sizeof(buf), host.c_str()) > 0);
+
+  return WM_Test::result("captive_api");
+}
@@ -0,0 +1,228 @@
+/****************************************************************************************************************************
+  test_captive_dns.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  ESP_WMCaptiveDNS on a UDP socket, as a phone joining the portal uses it : a burst of A, AAAA and HTTPS
+  queries for a dozen domains at once. Checks each reply (A : the portal IP with the set TTL, anything else :
+  empty NOERROR), the budget of one processNextRequest() call, and the time until the whole burst is
+  answered by a portal loop waiting on the socket, against one query per 10 ms tick as the core DNSServer
+  is served.
+ *****************************************************************************************************************************/
+
+#include <ESP_WiFiManager.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "WM_Test.h"
+
+#define TEST_TTL            300
+
+// Loop tick of the core DNSServer's portal : one query answered per tick
+#define TICK_MS             10
+
+#define MAX_BURST_MS        50
+
+#define QTYPE_AAAA          28
+#define QTYPE_HTTPS         65
+
+namespace
+{
+  const char* domains[] =
+  {
+    "connectivitycheck.gstatic.com", "www.google.com", "captive.apple.com", "www.apple.com",
+    "clients3.google.com", "www.msftconnecttest.com", "detectportal.firefox.com", "play.googleapis.com",
+    "mtalk.google.com", "graph.facebook.com", "api.twitter.com", "time.android.com"
+  };
+
+  const int DOMAINS = sizeof(domains) / sizeof(domains[0]);
+
+  std::string query(const uint16_t& id, const char* name, const uint16_t& qtype)
+  {
+    std::string packet = { (char) (id >> 8), (char) id, 0x01, 0x00, 0x00, 0x01, 0, 0, 0, 0, 0, 0 };
+
+    for (const char* label = name; *label; )
+    {
+      const char* dot = strchr(label, '.');
+      size_t      len = dot ? (size_t) (dot - label) : strlen(label);
+
+      packet += (char) len;
+      packet.append(label, len);
+      label += len + (dot ? 1 : 0);
+    }
+
+    packet += '\0';
+    packet += { (char) (qtype >> 8), (char) qtype, 0x00, 0x01 };
+
+    return packet;
+  }
+
+  uint16_t qtypeOf(const int& i)
+  {
+    static const uint16_t qtypes[] = { WM_DNS_QTYPE_A, QTYPE_AAAA, QTYPE_HTTPS };
+
+    return qtypes[i % 3];
+  }
+
+  uint16_t boundPort(const int& fd)
+  {
+    struct sockaddr_in addr;
+    socklen_t          len = sizeof(addr);
+
+    getsockname(fd, (struct sockaddr*) &addr, &len);
+
+    return ntohs(addr.sin_port);
+  }
+
+  // Sends the burst, returns the ms until every query is answered, -1 if some never are
+  double burst(const uint16_t& port, const bool& checkReplies)
+  {
+    int                fd = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr;
+    std::vector<bool>  answered(DOMAINS * 3, false);
+    int                left = DOMAINS * 3;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    double start = WM_Test::nowMs();
+
+    for (int i = 0; i < DOMAINS * 3; i++)
+    {
+      std::string packet = query(i, domains[i / 3], qtypeOf(i));
+
+      sendto(fd, packet.data(), packet.size(), 0, (struct sockaddr*) &addr, sizeof(addr));
+    }
+
+    while ( (left > 0) && (WM_Test::nowMs() - start < 2000) )
+    {
+      struct pollfd pfd = { fd, POLLIN, 0 };
+      uint8_t       reply[WM_DNS_MAX_PACKET_SIZE];
+
+      if (poll(&pfd, 1, 100) <= 0)
+        continue;
+
+      ssize_t len = recv(fd, reply, sizeof(reply), 0);
+
+      if (len < WM_DNS_HEADER_SIZE)
+        continue;
+
+      int id = (reply[0] << 8) | reply[1];
+
+      if ( (id >= DOMAINS * 3) || answered[id] )
+        continue;
+
+      answered[id] = true;
+      left--;
+
+      if (!checkReplies)
+        continue;
+
+      std::string sent = query(id, domains[id / 3], qtypeOf(id));
+
+      // Response, authoritative, RD kept, NOERROR, the question echoed
+      WM_TEST_CHECK( (reply[2] == 0x85) && (reply[3] == 0) );
+      WM_TEST_CHECK( (reply[4] == 0) && (reply[5] == 1) );
+      WM_TEST_CHECK(memcmp(reply + WM_DNS_HEADER_SIZE, sent.data() + WM_DNS_HEADER_SIZE, sent.size() - WM_DNS_HEADER_SIZE) == 0);
+
+      if (qtypeOf(id) == WM_DNS_QTYPE_A)
+      {
+        const uint8_t* answer = reply + sent.size();
+
+        WM_TEST_CHECK( (reply[7] == 1) && (len == (ssize_t) sent.size() + WM_DNS_ANSWER_SIZE) );
+        WM_TEST_CHECK( ( (answer[6] << 24) | (answer[7] << 16) | (answer[8] << 8) | answer[9]) == TEST_TTL );
+        WM_TEST_CHECK( (answer[12] == 192) && (answer[13] == 168) && (answer[14] == 4) && (answer[15] == 1) );
+      }
+      else
+      {
+        // No AAAA / HTTPS record, no wait for a retry
+        WM_TEST_CHECK( (reply[7] == 0) && (len == (ssize_t) sent.size()) );
+      }
+    }
+
+    ::close(fd);
+
+    return left ? -1 : WM_Test::nowMs() - start;
+  }
+}
+
+int main()
+{
+  ESP_WMCaptiveDNS dns;
+
+  WM_TEST_CHECK(dns.start(0, "*", IPAddress(192, 168, 4, 1)));
+  dns.setTTL(TEST_TTL);
+
+  uint16_t port = boundPort(dns.fd());
+
+  // Budget : one call answers at most WM_DNS_MAX_PACKETS_PER_TICK of the waiting queries
+  int                fd = socket(AF_INET, SOCK_DGRAM, 0);
+  struct sockaddr_in addr;
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family      = AF_INET;
+  addr.sin_port        = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  for (int i = 0; i < WM_DNS_MAX_PACKETS_PER_TICK + 4; i++)
+  {
+    std::string packet = query(i, "example.com", WM_DNS_QTYPE_A);
+
+    sendto(fd, packet.data(), packet.size(), 0, (struct sockaddr*) &addr, sizeof(addr));
+  }
+
+  usleep(20 * 1000);
+
+  WM_TEST_CHECK(dns.processNextRequest() == WM_DNS_MAX_PACKETS_PER_TICK);
+  WM_TEST_CHECK(dns.processNextRequest() == 4);
+  WM_TEST_CHECK(dns.processNextRequest() == 0);
+
+  ::close(fd);
+
+  // The portal loop, waiting on the DNS socket
+  std::atomic<bool> running(true);
+  std::atomic<bool> onePerTick(false);
+
+  std::thread loop([&]()
+  {
+    while (running)
+    {
+      if (onePerTick)
+      {
+        usleep(TICK_MS * 1000);
+        dns.processNextRequest(1);
+      }
+      else
+      {
+        struct pollfd pfd = { dns.fd(), POLLIN, 0 };
+
+        poll(&pfd, 1, TICK_MS);
+        dns.processNextRequest();
+      }
+    }
+  });
+
+  double batched = burst(port, true);
+
+  onePerTick = true;
+
+  double perTick = burst(port, false);
+
+  running = false;
+  loop.join();
+
+  dns.stop();
+
+  printf("Burst of %d queries : %.1f ms, %.1f ms at one per %d ms tick\n", DOMAINS * 3, batched, perTick, TICK_MS);
+
+  WM_TEST_CHECK( (batched >= 0) && (batched <= MAX_BURST_MS) );
+  WM_TEST_CHECK(perTick >= 0);
+
+  return WM_Test::result("captive_dns");
+}
@@ -0,0 +1,161 @@
+/****************************************************************************************************************************
+  test_portal_wakeups.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  The Config Portal loop sleeping on its sockets : counts the wake-ups of the loop while the portal sits idle,
+  the CPU time it takes meanwhile, how fast it answers a DNS query and an HTTP request, and that it still ends
+  at its timeout. Spinning on delay(1) wakes it about 1000 times a second, polling DNS every 10 ms 100 times.
+ *****************************************************************************************************************************/
+
+#include <sys/resource.h>
+
+#include <ESP_WiFiManager.h>
+
+#include <thread>
+
+#include "WM_Host.h"
+#include "WM_Test.h"
+
+#define PORTAL_TIMEOUT_S      3
+#define IDLE_MS               1000
+
+// Wake-ups allowed while idle for IDLE_MS
+#define MAX_IDLE_WAKEUPS      3
+
+#define MAX_IDLE_CPU_MS       20
+#define MAX_LATENCY_MS        50
+
+namespace
+{
+  // CPU time of the process, every thread, in ms
+  double cpuMs()
+  {
+    struct rusage usage;
+
+    getrusage(RUSAGE_SELF, &usage);
+
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000.0
+           + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000.0;
+  }
+
+  // Latency of an A query for example.com to the portal's DNS, -1 without a reply
+  double dnsLatency()
+  {
+    static const uint8_t query[] =
+    {
+      0x12, 0x34, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      7, 'e', 'x', 'a', 'm', 'p', 'l', 'e', 3, 'c', 'o', 'm', 0,
+      0x00, 0x01, 0x00, 0x01
+    };
+
+    int                fd = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr;
+    uint8_t            reply[512];
+    double             latency = -1;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(WM_DNS_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    double start = WM_Test::nowMs();
+
+    sendto(fd, query, sizeof(query), 0, (struct sockaddr*) &addr, sizeof(addr));
+
+    struct pollfd pfd = { fd, POLLIN, 0 };
+
+    if ( (poll(&pfd, 1, 1000) > 0) && (recv(fd, reply, sizeof(reply), 0) > (ssize_t) sizeof(query))
+         && (reply[0] == query[0]) && (reply[1] == query[1]) )
+    {
+      latency = WM_Test::nowMs() - start;
+    }
+
+    ::close(fd);
+
+    return latency;
+  }
+}
+
+int main()
+{
+  WM_HostRadio::get().addAP("HostAP");
+
+  ESP_WiFiManager ESP_wifiManager("WakeupTest");
+
+  ESP_wifiManager.setConfigPortalTimeout(PORTAL_TIMEOUT_S);
+
+  // Timed out, the portal then tries the saved AP : not for long
+  ESP_wifiManager.setConnectTimeout(1);
+
+  // Station off, as host_portal does : no wait for a connection before the portal
+  WiFi.mode(WIFI_AP);
+
+  std::thread portal([&]()
+  {
+    ESP_wifiManager.startConfigPortal("ESP_WakeupTest");
+  });
+
+  // Up once its web server accepts
+  double portalStart = WM_Test::nowMs();
+  int    fd          = -1;
+
+  while ( (fd < 0) && (WM_Test::nowMs() - portalStart < 1000) )
+  {
+    if ( (fd = WM_Test::connectTcp(HTTP_PORT)) < 0)
+      usleep(10 * 1000);
+  }
+
+  WM_TEST_CHECK(fd >= 0);
+  ::close(fd);
+
+  // Idle : no traffic, so no reason to wake up before the portal times out
+  usleep(100 * 1000);
+
+  uint64_t wakeups = WM_Host::activityWakeups();
+  double   cpu     = cpuMs();
+
+  usleep(IDLE_MS * 1000);
+
+  wakeups = WM_Host::activityWakeups() - wakeups;
+  cpu     = cpuMs() - cpu;
+
+  printf("Idle %d ms : %llu wake-up(s), %.1f ms CPU\n", IDLE_MS, (unsigned long long) wakeups, cpu);
+
+  WM_TEST_CHECK(wakeups <= MAX_IDLE_WAKEUPS);
+  WM_TEST_CHECK(cpu <= MAX_IDLE_CPU_MS);
+
+  // Traffic wakes it up at once
+  double latency = dnsLatency();
+
+  printf("DNS : %.2f ms\n", latency);
+
+  WM_TEST_CHECK( (latency >= 0) && (latency <= MAX_LATENCY_MS) );
+
+  // /state : the pages a user browses cancel the portal's timeout
+  double      start    = WM_Test::nowMs();
+  std::string response = WM_Test::request(HTTP_PORT, "GET /state HTTP/1.1\r\nHost: 192.168.4.1\r\n\r\n");
+
+  latency = WM_Test::nowMs() - start;
+
+  printf("HTTP : %.2f ms\n", latency);
+
+  WM_TEST_CHECK(response.compare(0, 15, "HTTP/1.1 200 OK") == 0);
+  WM_TEST_CHECK(latency <= MAX_LATENCY_MS);
+
+  // And the sleep still ends at the portal's timeout, when its loop turns the AP off
+  while ( (WiFi.getMode() != WIFI_STA) && (WM_Test::nowMs() - portalStart < 2 * PORTAL_TIMEOUT_S * 1000) )
+    usleep(1000);
+
+  double duration = WM_Test::nowMs() - portalStart;
+
+  printf("Portal : %.0f ms\n", duration);
+
+  WM_TEST_CHECK(duration <= PORTAL_TIMEOUT_S * 1000 + MAX_LATENCY_MS);
+
+  portal.join();
+
+  return WM_Test::result("portal_wakeups");
+}
@@ -0,0 +1,110 @@
+/****************************************************************************************************************************
+  test_rate_limiter.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  ESP_WMRateLimiter against its own clock : bursts, refill at the configured rate however often a client asks,
+  Retry-After, separate buckets per route class and per client, and the client seen least recently replaced
+  when the table is full.
+ *****************************************************************************************************************************/
+
+#include <utils/WM_RateLimiter.h>
+
+#include "WM_Test.h"
+
+#define CLIENT_IP           0x0104A8C0UL      // 192.168.4.1, as IPAddress converts
+
+// ms per token
+#define EXPENSIVE_MS        (60000UL / WM_RATE_EXPENSIVE_PER_MIN)
+#define CHEAP_MS            (60000UL / WM_RATE_CHEAP_PER_MIN)
+
+namespace
+{
+  // Requests allowed out of count, one every stepMs from now on
+  int allowed(ESP_WMRateLimiter& limiter, const uint32_t& ip, const bool& expensive, unsigned long& now,
+              const int& count, const unsigned long& stepMs)
+  {
+    int ok = 0;
+
+    for (int i = 0; i < count; i++, now += stepMs)
+    {
+      if (limiter.check(ip, expensive, now) == 0)
+        ok++;
+    }
+
+    return ok;
+  }
+}
+
+int main()
+{
+  ESP_WMRateLimiter limiter;
+  unsigned long     now = 1000;
+
+  // A burst, then nothing until a token is refilled
+  WM_TEST_CHECK(allowed(limiter, CLIENT_IP, true, now, WM_RATE_EXPENSIVE_BURST, 0) == WM_RATE_EXPENSIVE_BURST);
+
+  uint32_t retryAfter = limiter.check(CLIENT_IP, true, now);
+
+  WM_TEST_CHECK( (retryAfter > 0) && (retryAfter <= (EXPENSIVE_MS + 999) / 1000) );
+
+  // The cheap bucket is separate
+  WM_TEST_CHECK(limiter.check(CLIENT_IP, false, now) == 0);
+
+  // Asked every ms, the bucket still refills at WM_RATE_EXPENSIVE_PER_MIN : one token per EXPENSIVE_MS,
+  // not lost to rounding on each request
+  unsigned long drained = now;
+
+  WM_TEST_CHECK(allowed(limiter, CLIENT_IP, true, now, EXPENSIVE_MS - 1, 1) == 0);
+  WM_TEST_CHECK( (now == drained + EXPENSIVE_MS - 1) && (limiter.check(CLIENT_IP, true, now) != 0) );
+
+  now = drained + EXPENSIVE_MS;
+
+  WM_TEST_CHECK(limiter.check(CLIENT_IP, true, now) == 0);
+
+  // Requests every 7 ms for a minute, from an empty bucket : exactly the minute's tokens
+  int ok = allowed(limiter, CLIENT_IP, true, now, 60000 / 7 + 2, 7);
+
+  WM_TEST_CHECK(ok == WM_RATE_EXPENSIVE_PER_MIN);
+
+  // Same for the cheap routes, asked every 3 ms
+  allowed(limiter, CLIENT_IP, false, now, WM_RATE_CHEAP_BURST * 2, 0);
+
+  ok = allowed(limiter, CLIENT_IP, false, now, 60000 / 3 + 1, 3);
+
+  WM_TEST_CHECK(ok == WM_RATE_CHEAP_PER_MIN);
+
+  // Idle long enough, full again, never more than the burst
+  now += 10 * 60000UL;
+
+  WM_TEST_CHECK(allowed(limiter, CLIENT_IP, true, now, WM_RATE_EXPENSIVE_BURST + 1, 0) == WM_RATE_EXPENSIVE_BURST);
+
+  // Other clients have their own buckets
+  WM_TEST_CHECK(allowed(limiter, CLIENT_IP + 1, true, now, WM_RATE_EXPENSIVE_BURST, 0) == WM_RATE_EXPENSIVE_BURST);
+
+  // Table full : the client seen least recently starts over with full buckets, the others keep theirs
+  for (uint32_t i = 2; i < WM_RATE_LIMIT_CLIENTS; i++)
+    limiter.check(CLIENT_IP + i, true, ++now);
+
+  limiter.check(CLIENT_IP + 1, true, ++now);
+  limiter.check(CLIENT_IP + WM_RATE_LIMIT_CLIENTS, true, ++now);
+
+  WM_TEST_CHECK(limiter.check(CLIENT_IP + 1, true, now) != 0);
+  WM_TEST_CHECK(allowed(limiter, CLIENT_IP, true, now, WM_RATE_EXPENSIVE_BURST + 1, 0) == WM_RATE_EXPENSIVE_BURST);
+
+  // millis() wrapping around
+  ESP_WMRateLimiter wrapped;
+
+  now = (unsigned long) -10;
+
+  WM_TEST_CHECK(allowed(wrapped, CLIENT_IP, true, now, WM_RATE_EXPENSIVE_BURST, 0) == WM_RATE_EXPENSIVE_BURST);
+
+  now += EXPENSIVE_MS;
+
+  WM_TEST_CHECK(wrapped.check(CLIENT_IP, true, now) == 0);
+  WM_TEST_CHECK(wrapped.check(CLIENT_IP, true, now) != 0);
+
+  return WM_Test::result("rate_limiter");
+}
@@ -0,0 +1,161 @@
+/****************************************************************************************************************************
+  test_slowloris.cpp
+  For the Linux host build of ESP_WiFiManager
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  The patched ESP32 WebServer under slow clients : connections that send part of their request head, a head
+  past the peek buffer, or only part of a form's body, then trickle or stall. Other clients must still be
+  served at once, slow ones evicted when the pending slots run out, and an oversized head answered 431.
+ *****************************************************************************************************************************/
+
+#include <WebServer.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "WM_Test.h"
+
+// A served request takes a few ms on loopback. Blocked behind a slow client, it takes the client's timeout.
+#define MAX_LATENCY_MS      250
+
+class TestWebServer : public WebServer
+{
+  public:
+
+    TestWebServer() : WebServer(IPAddress(127, 0, 0, 1), 0)
+    {
+      on("/", [this]()
+      {
+        send(200, "text/plain", "OK");
+      });
+
+      on("/form", HTTP_POST, [this]()
+      {
+        send(200, "text/plain", arg("a"));
+      });
+    }
+
+    uint16_t port()
+    {
+      struct sockaddr_in addr;
+      socklen_t          len = sizeof(addr);
+
+      getsockname(_server.fd(), (struct sockaddr*) &addr, &len);
+
+      return ntohs(addr.sin_port);
+    }
+};
+
+namespace
+{
+  // Partial heads, without the blank line that ends them
+  std::string partialHead(const size_t& size)
+  {
+    std::string head = "GET / HTTP/1.1\r\nHost: 192.168.4.1\r\n";
+
+    while (head.size() < size)
+      head += "X-Padding: 0123456789012345678901234567890123456789\r\n";
+
+    return head;
+  }
+
+  // A GET of another client, its latency checked
+  void checkServed(const uint16_t& port, const char* what)
+  {
+    double      start     = WM_Test::nowMs();
+    std::string response  = WM_Test::request(port, "GET / HTTP/1.1\r\nHost: 192.168.4.1\r\n\r\n");
+    double      latency   = WM_Test::nowMs() - start;
+
+    if ( (response.compare(0, 15, "HTTP/1.1 200 OK") != 0) || (latency > MAX_LATENCY_MS) )
+      fprintf(stderr, "%s : %.1f ms, %.15s\n", what, latency, response.c_str());
+
+    WM_TEST_CHECK(response.compare(0, 15, "HTTP/1.1 200 OK") == 0);
+    WM_TEST_CHECK(latency <= MAX_LATENCY_MS);
+  }
+}
+
+int main()
+{
+  TestWebServer     server;
+  std::atomic<bool> running(true);
+
+  server.begin();
+
+  uint16_t port = server.port();
+
+  std::thread loop([&]()
+  {
+    while (running)
+    {
+      server.waitForActivity(50);
+      server.handleClient();
+    }
+  });
+
+  std::vector<int> slow;
+
+  // Longer than the 512 bytes peeked before : the head is still incomplete
+  slow.push_back(WM_Test::connectTcp(port));
+  WM_Test::sendAll(slow.back(), partialHead(600));
+
+  // Request line only
+  slow.push_back(WM_Test::connectTcp(port));
+  WM_Test::sendAll(slow.back(), "GET / HTTP/1.1\r\n");
+
+  // Complete head, 10 of the 100 bytes of its form
+  slow.push_back(WM_Test::connectTcp(port));
+  WM_Test::sendAll(slow.back(), "POST /form HTTP/1.1\r\nContent-Type: application/x-www-form-urlencoded\r\n"
+                                "Content-Length: 100\r\n\r\na=01234567");
+
+  checkServed(port, "with slow clients");
+
+  // Trickling a header line byte by byte, as slowloris does
+  for (const char& c : std::string("X-Slow: 1\r\n"))
+  {
+    for (int fd : slow)
+      WM_Test::sendAll(fd, std::string(1, c));
+
+    checkServed(port, "while slow clients trickle");
+  }
+
+  // More slow clients than pending slots : the oldest idle ones are evicted, new clients still get in
+  for (int i = 0; i < HTTP_MAX_PENDING_CLIENTS; i++)
+  {
+    slow.push_back(WM_Test::connectTcp(port));
+    WM_Test::sendAll(slow.back(), partialHead(100));
+  }
+
+  checkServed(port, "with every pending slot taken");
+
+  // A head that doesn't fit the peek buffer
+  std::string response = WM_Test::request(port, partialHead(HTTP_PEEK_BUFLEN + 100));
+
+  WM_TEST_CHECK(response.compare(0, 12, "HTTP/1.1 431") == 0);
+
+  // A form sent in pieces is served once complete, its body read without waiting
+  int fd = WM_Test::connectTcp(port);
+
+  WM_Test::sendAll(fd, "POST /form HTTP/1.1\r\nContent-Type: application/x-www-form-urlencoded\r\nContent-Length: 9\r\n\r\n");
+  usleep(100 * 1000);
+  checkServed(port, "while a form body is missing");
+  WM_Test::sendAll(fd, "a=partial");
+
+  response = WM_Test::receiveAll(fd, 2000);
+  ::close(fd);
+
+  WM_TEST_CHECK(response.compare(0, 15, "HTTP/1.1 200 OK") == 0);
+  WM_TEST_CHECK( (response.size() >= 7) && (response.compare(response.size() - 7, 7, "partial") == 0) );
+
+  for (int slowFd : slow)
+    ::close(slowFd);
+
+  running = false;
+  loop.join();
+
+  server.stop();
+
+  return WM_Test::result("slowloris");
+}
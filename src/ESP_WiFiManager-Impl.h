@@ -38,6 +38,44 @@
 
 //////////////////////////////////////////
 
+#if USE_WM_ALLOC_TRACKING
+
+WM_AllocCounts WM_allocCounts;
+
+// ESP-IDF heap hooks : run inside the allocator, from any task and with the flash cache possibly off
+#if ( defined(ESP32) && !defined(WM_HOST) && defined(CONFIG_HEAP_USE_HOOKS) )
+
+extern "C" IRAM_ATTR void esp_heap_trace_alloc_hook(void* ptr, size_t size, uint32_t caps)
+{
+  (void) ptr;
+  (void) caps;
+
+  WM_allocCounts.mallocs++;
+  WM_allocCounts.bytes += size;
+}
+
+extern "C" IRAM_ATTR void esp_heap_trace_free_hook(void* ptr)
+{
+  (void) ptr;
+
+  WM_allocCounts.frees++;
+}
+
+#endif
+
+#endif    // USE_WM_ALLOC_TRACKING
+
+//////////////////////////////////////////
+
+#if USE_WM_STATIC_MEMORY
+
+char   WM_paramPool[WM_STATIC_PARAM_POOL];
+size_t WM_paramPoolUsed = 0;
+
+#endif
+
+//////////////////////////////////////////
+
 ESP_WMParameter::ESP_WMParameter(const char *custom)
 {
   _WMParam_data._id = NULL;
@@ -74,7 +112,16 @@ void ESP_WMParameter::init(const char *id, const char *placeholder, const char *
   _WMParam_data._length = length;
   _WMParam_data._labelPlacement = labelPlacement;
 
-  _WMParam_data._value = new char[_WMParam_data._length + 1];
+#if USE_WM_STATIC_MEMORY
+  _WMParam_data._value = WM_paramPoolAlloc(_WMParam_data._length + 1);
+
+  if (_WMParam_data._value == NULL)
+  {
+    LOGERROR3(F("No room for parameter"), id, F(", WM_STATIC_PARAM_POOL used ="), WM_paramPoolUsed);
+  }
+#else
+  _WMParam_data._value = (char*) WM_memAlloc(WM_MEM_PARAM, _WMParam_data._length + 1);
+#endif
 
   if (_WMParam_data._value != NULL)
   {
@@ -85,6 +132,11 @@ void ESP_WMParameter::init(const char *id, const char *placeholder, const char *
       strncpy(_WMParam_data._value, defaultValue, _WMParam_data._length);
     }
   }
+  else
+  {
+    // No room : an empty value, shown and saved as such, instead of writes through NULL
+    _WMParam_data._length = 0;
+  }
   
   _customHTML = custom;
 }
@@ -95,7 +147,14 @@ ESP_WMParameter::~ESP_WMParameter()
 {
   if (_WMParam_data._value != NULL)
   {
-    delete[] _WMParam_data._value;
+#if USE_WM_STATIC_MEMORY
+    if (!WM_paramPoolFree(_WMParam_data._value, _WMParam_data._length + 1))
+    {
+      LOGWARN1(F("Parameter freed out of order, its pool space is lost :"), _WMParam_data._id);
+    }
+#else
+    WM_memFree(_WMParam_data._value);
+#endif
   }
 }
 
@@ -120,9 +179,10 @@ void ESP_WMParameter::getWMParam_Data(WMParam_Data &WMParam_data)
 
 //////////////////////////////////////////
 
+// Never NULL : "" for a custom HTML parameter, or one that got no room for its value
 const char* ESP_WMParameter::getValue()
 {
-  return _WMParam_data._value;
+  return (_WMParam_data._value != NULL) ? _WMParam_data._value : "";
 }
 
 //////////////////////////////////////////
@@ -215,7 +275,9 @@ ESP_WiFiManager::ESP_WiFiManager(const char *iHostname)
 {
 #if USE_DYNAMIC_PARAMS
   _max_params = WIFI_MANAGER_MAX_PARAMS;
-  _params = (ESP_WMParameter**)malloc(_max_params * sizeof(ESP_WMParameter*));
+  _params = (ESP_WMParameter**)calloc(_max_params, sizeof(ESP_WMParameter*));
+#else
+  memset(_params, 0, sizeof(_params));
 #endif
 
   //WiFi not yet started here, must call WiFi.mode(WIFI_STA) and modify function WiFiGenericClass::mode(wifi_mode_t m) !!!
@@ -247,6 +309,14 @@ ESP_WiFiManager::ESP_WiFiManager(const char *iHostname)
   setHostname();
 
   networkIndices = NULL;
+
+#if USE_WM_SNTP
+  // After a deep sleep, time is valid right away
+  if (sntp().restore())
+  {
+    LOGWARN(F("Time restored from RTC memory"));
+  }
+#endif
 }
 
 //////////////////////////////////////////
@@ -262,20 +332,16 @@ ESP_WiFiManager::~ESP_WiFiManager()
   }
 #endif
 
-  if (networkIndices)
-  {
-    free(networkIndices); //indices array no longer required so free memory
-  }
+  freeIndices(networkIndices);
+  WM_memFree(_pageBuf);
 }
 
 //////////////////////////////////////////
 
-#if USE_DYNAMIC_PARAMS
 bool ESP_WiFiManager::addParameter(ESP_WMParameter *p)
-#else
-void ESP_WiFiManager::addParameter(ESP_WMParameter *p)
-#endif
 {
+  WM_LOG_MODULE(WM_LOG_PARAMS);
+
 #if USE_DYNAMIC_PARAMS
 
   if (_paramsCount == _max_params)
@@ -315,11 +381,13 @@ void ESP_WiFiManager::addParameter(ESP_WMParameter *p)
     _paramsCount++;
      
     LOGINFO1(F("Adding parameter"), p->getID());
+
+    return true;
   }
-  else
-  {
-    LOGINFO("Can't add parameter. Full");
-  }
+
+  LOGERROR1(F("Can't add parameter, WIFI_MANAGER_MAX_PARAMS reached :"), p->getID());
+
+  return false;
 
 #endif
 }
@@ -336,12 +404,23 @@ void ESP_WiFiManager::setupConfigPortal()
   if (WiFi.getAutoConnect() == 0)
     WiFi.setAutoConnect(1);
 
-  dnsServer.reset(new DNSServer());
+#if USE_WM_STATIC_MEMORY
+  dnsServer.emplace();
+  server.emplace(HTTP_PORT_TO_USE);
+#else
+  dnsServer.reset(new WM_DNSServer());
 
-#ifdef ESP8266
+  #ifdef ESP8266
   server.reset(new ESP8266WebServer(HTTP_PORT_TO_USE));
-#else		//ESP32
+  #else		//ESP32
   server.reset(new WebServer(HTTP_PORT_TO_USE));
+  #endif
+
+  if (WM_memPlacement(WM_MEM_PAGE) == WM_MEM_PSRAM)
+  {
+    WM_memFree(_pageBuf);
+    _pageBuf = (char*) WM_psramAlloc(WM_PSRAM_CHUNK_SIZE);
+  }
 #endif
 
   // optional soft ip config
@@ -357,7 +436,11 @@ void ESP_WiFiManager::setupConfigPortal()
   /* Setup the DNS server redirecting all the domains to the apIP */
   if (dnsServer)
   {
+    WM_LOG_MODULE(WM_LOG_DNS);
+
+#if !USE_WM_CAPTIVE_DNS
     dnsServer->setErrorReplyCode(DNSReplyCode::NoError);
+#endif
     
     // DNSServer started with "*" domain name, all DNS requests will be passsed to WiFi.softAPIP()
     if (! dnsServer->start(DNS_PORT, "*", WiFi.softAPIP()))
@@ -414,16 +497,74 @@ void ESP_WiFiManager::setupConfigPortal()
   
   LOGWARN1(F("AP IP address ="), WiFi.softAPIP());
 
+  // Probe responses only depend on the AP IP, so format them once here
+  WM_StaticString<15>                   apIP;
+  WM_StaticString<WM_PORTAL_URL_MAXLEN> portalURL;
+
+  apIP      += WiFi.softAPIP();
+  portalURL += F("http://");
+  portalURL += apIP;
+  portalURL += '/';
+
+#if USE_WM_STATIC_MEMORY
+  WM_StaticString<sizeof(WM_PROBE_READY_BODY) + 2 * WM_PORTAL_URL_MAXLEN> body;
+
+  _probeRedirect.clear();
+  WM_printTemplate(_probeRedirect, WM_PROBE_REDIRECT_RESP, "{u}", portalURL);
+
+  WM_printTemplate(body, WM_PROBE_READY_BODY, "{u}", portalURL);
+
+  _probeReady.clear();
+  WM_printTemplate(_probeReady, WM_PROBE_READY_HEAD, "{l}", WM_StaticString<5>(body.length()));
+  _probeReady += body.c_str();
+#else
+  _probeRedirect = FPSTR(WM_PROBE_REDIRECT_RESP);
+  _probeRedirect.replace("{u}", portalURL.c_str());
+
+  String body = FPSTR(WM_PROBE_READY_BODY);
+  body.replace("{u}", portalURL.c_str());
+  
+  _probeReady = FPSTR(WM_PROBE_READY_HEAD);
+  _probeReady.replace("{l}", String(body.length()));
+  _probeReady += body;
+#endif
+
+  // Clients that understand DHCP option 114 go straight to the RFC 8908 API, without probing
+  char captiveJSON[WM_CAPTIVE_URI_MAXLEN + 64];
+  
+  if (WM_buildCaptiveJSON(captiveJSON, sizeof(captiveJSON), portalURL))
+  {
+#if USE_WM_STATIC_MEMORY
+    _captiveJSON.clear();
+    _captiveJSON += captiveJSON;
+#else
+    _captiveJSON = captiveJSON;
+#endif
+    
+    setCaptivePortalOption(apIP);
+  }
+
   /* Setup web pages: root, wifi config pages, SO captive portal detectors and not found. */
-  server->on("/", std::bind(&ESP_WiFiManager::handleRoot, this));
-  server->on("/wifi", std::bind(&ESP_WiFiManager::handleWifi, this));
-  server->on("/wifisave", std::bind(&ESP_WiFiManager::handleWifiSave, this));
-  server->on("/close", std::bind(&ESP_WiFiManager::handleServerClose, this));
-  server->on("/i", std::bind(&ESP_WiFiManager::handleInfo, this));
-  server->on("/r", std::bind(&ESP_WiFiManager::handleReset, this));
-  server->on("/state", std::bind(&ESP_WiFiManager::handleState, this));
-  server->on("/scan", std::bind(&ESP_WiFiManager::handleScan, this));
-  server->onNotFound(std::bind(&ESP_WiFiManager::handleNotFound, this));
+  server->on("/", std::bind(&ESP_WiFiManager::handleRoute, this, WM_ROUTE_ROOT, &ESP_WiFiManager::handleRoot));
+  server->on("/wifi", std::bind(&ESP_WiFiManager::handleRoute, this, WM_ROUTE_WIFI, &ESP_WiFiManager::handleWifi));
+  server->on("/wifisave", std::bind(&ESP_WiFiManager::handleRoute, this, WM_ROUTE_WIFISAVE, &ESP_WiFiManager::handleWifiSave));
+  server->on("/close", std::bind(&ESP_WiFiManager::handleRoute, this, WM_ROUTE_CLOSE, &ESP_WiFiManager::handleServerClose));
+  server->on("/i", std::bind(&ESP_WiFiManager::handleRoute, this, WM_ROUTE_INFO, &ESP_WiFiManager::handleInfo));
+  server->on("/r", std::bind(&ESP_WiFiManager::handleRoute, this, WM_ROUTE_RESET, &ESP_WiFiManager::handleReset));
+  server->on("/state", std::bind(&ESP_WiFiManager::handleRoute, this, WM_ROUTE_STATE, &ESP_WiFiManager::handleState));
+  server->on("/scan", std::bind(&ESP_WiFiManager::handleRoute, this, WM_ROUTE_SCAN, &ESP_WiFiManager::handleScan));
+
+#if (WIFIMGR_LOGLEVEL_MAX > 0)
+  server->on("/loglevel", std::bind(&ESP_WiFiManager::handleRoute, this, WM_ROUTE_LOGLEVEL, &ESP_WiFiManager::handleLogLevel));
+#endif
+
+  server->on(WM_CAPTIVE_API_PATH, std::bind(&ESP_WiFiManager::handleRoute, this, WM_ROUTE_CAPTIVE_API, &ESP_WiFiManager::handleCaptiveAPI));
+
+#if USE_WM_METRICS
+  server->on("/metrics", std::bind(&ESP_WiFiManager::handleRoute, this, WM_ROUTE_METRICS, &ESP_WiFiManager::handleMetrics));
+#endif
+
+  server->onNotFound(std::bind(&ESP_WiFiManager::handleRoute, this, WM_ROUTE_NOT_FOUND, &ESP_WiFiManager::handleNotFound));
   server->begin(); // Web server start
   
   LOGWARN(F("HTTP server started"));
@@ -461,6 +602,8 @@ bool ESP_WiFiManager::autoConnect()
 
 bool ESP_WiFiManager::autoConnect(char const *apName, char const *apPassword)
 {
+  WM_LOG_MODULE(WM_LOG_CONNECT);
+
 #if AUTOCONNECT_NO_INVALIDATE
   LOGINFO(F("\nAutoConnect using previously saved SSID/PW, but keep previous settings"));
   // Connect to previously saved SSID/PW, but keep previous settings
@@ -484,6 +627,8 @@ bool ESP_WiFiManager::autoConnect(char const *apName, char const *apPassword)
        
       LOGWARN1(F("Connected after waiting (s) :"), waited / 1000);
       LOGWARN1(F("Local ip ="), WiFi.localIP());
+
+      syncTime();
       
       return true;
     }
@@ -554,15 +699,14 @@ bool  ESP_WiFiManager::startConfigPortal(char const *apName, char const *apPassw
 
   while (_configPortalTimeout == 0 || millis() < _configPortalStart + _configPortalTimeout)
   {
-    //DNS
+    //DNS, drains all pending queries when USE_WM_CAPTIVE_DNS
+#if USE_WM_CAPTIVE_DNS
+    _metrics.addDNSQueries(dnsServer->processNextRequest());
+#else
     dnsServer->processNextRequest();
+#endif
     //HTTP
     server->handleClient();
-  
-#if ( USING_ESP32_S2 || USING_ESP32_C3 ) 
-    // Fix ESP32-S2 issue with WebServer (https://github.com/espressif/arduino-esp32/issues/4348)
-    delay(1);
-#endif
 
     if (connect)
     {
@@ -584,6 +728,8 @@ bool  ESP_WiFiManager::startConfigPortal(char const *apName, char const *apPassw
         if (_savecallback != NULL)
         {
           //todo: check if any custom parameters actually exist, and check if they really changed maybe
+          ESP_WMAllocScope allocScope(_allocs, WM_ALLOC_SAVE);
+
           _savecallback();
         }
         break;
@@ -596,6 +742,8 @@ bool  ESP_WiFiManager::startConfigPortal(char const *apName, char const *apPassw
         if (_savecallback != NULL)
         {
           //todo: check if any custom parameters actually exist, and check if they really changed maybe
+          ESP_WMAllocScope allocScope(_allocs, WM_ALLOC_SAVE);
+
           _savecallback();
         }
         
@@ -611,7 +759,7 @@ bool  ESP_WiFiManager::startConfigPortal(char const *apName, char const *apPassw
       break;
     }
     
-    yield();
+    waitForPortalActivity();
   }
 
   WiFi.mode(WIFI_STA);
@@ -634,13 +782,54 @@ bool  ESP_WiFiManager::startConfigPortal(char const *apName, char const *apPassw
   dnsServer->stop();
   dnsServer.reset();
 
+  WM_memFree(_pageBuf);
+  _pageBuf = nullptr;
+
   return  WiFi.status() == WL_CONNECTED;
 }
 
 //////////////////////////////////////////
 
+// Sleep until the portal has something to do instead of spinning on handleClient()
+void ESP_WiFiManager::waitForPortalActivity()
+{
+#if defined(WEBSERVER_HAS_WAIT_FOR_ACTIVITY)
+#if USE_WM_CAPTIVE_DNS
+  // Also wake up on DNS queries
+  int dnsFd = dnsServer->fd();
+#else
+  int dnsFd = -1;
+#endif
+
+  // Until the portal times out. Without a DNS socket, DNS is polled between shorter sleeps.
+  unsigned long timeout = (dnsFd >= 0) ? WM_PORTAL_IDLE_SLEEP_MS : WM_PORTAL_MAX_SLEEP_MS;
+
+  if (_configPortalTimeout != 0)
+  {
+    unsigned long elapsed = millis() - _configPortalStart;
+    
+    timeout = (elapsed < _configPortalTimeout) ? std::min(timeout, _configPortalTimeout - elapsed) : 0;
+  }
+  
+  server->enableDelay(false);
+  server->waitForActivity(timeout, dnsFd);
+#else
+
+  #if ( USING_ESP32_S2 || USING_ESP32_C3 ) 
+  // Fix ESP32-S2 issue with WebServer (https://github.com/espressif/arduino-esp32/issues/4348)
+  delay(1);
+  #endif
+  
+  yield();
+#endif
+}
+
+//////////////////////////////////////////
+
 void ESP_WiFiManager::setWifiStaticIP()
 { 
+  WM_LOG_MODULE(WM_LOG_CONNECT);
+
 #if USE_CONFIGURABLE_DNS
   if (_WiFi_STA_IPconfig._sta_static_ip)
   {
@@ -688,6 +877,8 @@ void ESP_WiFiManager::setWifiStaticIP()
 
 int ESP_WiFiManager::reconnectWifi()
 {
+  WM_LOG_MODULE(WM_LOG_CONNECT);
+
   int connectResult;
   
   // using user-provided _ssid, _pass instead of system-stored
@@ -713,6 +904,10 @@ int ESP_WiFiManager::reconnectWifi()
 
 int ESP_WiFiManager::connectWifi(const String& ssid, const String& pass)
 {
+  WM_LOG_MODULE(WM_LOG_CONNECT);
+
+  ESP_WMAllocScope allocScope(_allocs, WM_ALLOC_CONNECT);
+
   // Add option if didn't input/update SSID/PW => Use the previous saved Credentials.
   // But update the Static/DHCP options if changed.
   if ( (ssid != "") || ( (ssid == "") && (WiFi_SSID() != "") ) )
@@ -764,12 +959,21 @@ int ESP_WiFiManager::connectWifi(const String& ssid, const String& pass)
   
   LOGWARN1("Connection result: ", getStatus(connRes));
 
+  _metrics.connectDone(connRes);
+
   //not connected, WPS enabled, no pass - first attempt
   if (_tryWPS && connRes != WL_CONNECTED && pass == "")
   {
     startWPS();
     //should be connected at the end of WPS
     connRes = waitForConnectResult();
+
+    _metrics.connectDone(connRes);
+  }
+
+  if (connRes == WL_CONNECTED)
+  {
+    syncTime();
   }
 
   return connRes;
@@ -777,8 +981,37 @@ int ESP_WiFiManager::connectWifi(const String& ssid, const String& pass)
 
 //////////////////////////////////////////
 
+// First SNTP sync once connected. Only started, sntp().loop() sends the burst, unless WM_SNTP_SYNC_ON_CONNECT
+// waits here for it, at most about a second
+void ESP_WiFiManager::syncTime()
+{
+#if USE_WM_SNTP
+  if (!sntp().isSynced())
+  {
+  #if WM_SNTP_SYNC_ON_CONNECT
+    WM_LOG_MODULE(WM_LOG_CONNECT);
+
+    if (sntp().sync())
+    {
+      LOGWARN1(F("Time synced, drift (ppb) ="), sntp().driftPPB());
+    }
+    else
+    {
+      LOGWARN(F("Time not synced, will retry in sntp().loop()"));
+    }
+  #else
+    sntp().start();
+  #endif
+  }
+#endif
+}
+
+//////////////////////////////////////////
+
 uint8_t ESP_WiFiManager::waitForConnectResult()
 {
+  WM_LOG_MODULE(WM_LOG_CONNECT);
+
   if (_connectTimeout == 0)
   {
     unsigned long startedAt = millis();
@@ -832,6 +1065,8 @@ uint8_t ESP_WiFiManager::waitForConnectResult()
 
 void ESP_WiFiManager::startWPS()
 {
+  WM_LOG_MODULE(WM_LOG_CONNECT);
+
 #ifdef ESP8266
   LOGINFO("START WPS");
   WiFi.beginWPSConfig();
@@ -883,6 +1118,8 @@ String ESP_WiFiManager::getConfigPortalPW()
 
 void ESP_WiFiManager::resetSettings()
 {
+  WM_LOG_MODULE(WM_LOG_STORAGE);
+
   LOGINFO(F("Previous settings invalidated"));
   
 #ifdef ESP8266  
@@ -1032,41 +1269,132 @@ void ESP_WiFiManager::setBreakAfterConfig(bool shouldBreak)
 
 //////////////////////////////////////////
 
-void ESP_WiFiManager::reportStatus(String &page)
+void ESP_WiFiManager::reportStatus(Print& page)
 {
-  page += FPSTR(WM_HTTP_SCRIPT_NTP_MSG);
+  char ssid[33];
+
+  WiFi_SSID(ssid, sizeof(ssid));
 
-  if (WiFi_SSID() != "")
+  page.print(FPSTR(WM_HTTP_SCRIPT_NTP_MSG));
+
+  if (ssid[0] != 0)
   {
-    page += F("Configured to connect to access point <b>");
-    page += WiFi_SSID();
+    page.print(F("Configured to connect to access point <b>"));
+    page.print(ssid);
 
     if (WiFi.status() == WL_CONNECTED)
     {
-      page += F(" and currently connected</b> on IP <a href=\"http://");
-      page += WiFi.localIP().toString();
-      page += F("/\">");
-      page += WiFi.localIP().toString();
-      page += F("</a>");
+      page.print(F(" and currently connected</b> on IP <a href=\"http://"));
+      page.print(WiFi.localIP());
+      page.print(F("/\">"));
+      page.print(WiFi.localIP());
+      page.print(F("</a>"));
     }
     else
     {
-      page += F(" but not currently connected</b> to network.");
+      page.print(F(" but not currently connected</b> to network."));
     }
   }
   else
   {
-    page += F("No network currently configured.");
+    page.print(F("No network currently configured."));
+  }
+}
+
+//////////////////////////////////////////
+
+WM_ChunkedPrint::Sender ESP_WiFiManager::pageSender()
+{
+  // The manager outlives the pages, the sender only refers to it
+  return WM_ChunkedPrint::Sender([](void* manager, const char* data, size_t len)
+  {
+    ESP_WiFiManager* self = (ESP_WiFiManager*) manager;
+
+    self->_metrics.addBytesOut(len);
+    self->server->sendContent(data, len);
+  }, this);
+}
+
+//////////////////////////////////////////
+
+/** Sends the status line and headers of a page of unknown length. Its body follows through a WM_ChunkedPrint
+    of pageSender(), then endPage() */
+void ESP_WiFiManager::beginPage(const int& code, const char* contentType)
+{
+  server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server->send(code, contentType, "");
+}
+
+//////////////////////////////////////////
+
+void ESP_WiFiManager::printPageHead(Print& page, const char* title, const bool& ntpScript)
+{
+  WM_printTemplate(page, WM_HTTP_HEAD_START, "{v}", title);
+  page.print(FPSTR(WM_HTTP_SCRIPT));
+
+  if (ntpScript)
+  {
+    page.print(FPSTR(WM_HTTP_SCRIPT_NTP));
+  }
+
+  page.print(FPSTR(WM_HTTP_STYLE));
+  page.print(_customHeadElement);
+  page.print(FPSTR(WM_HTTP_HEAD_END));
+}
+
+//////////////////////////////////////////
+
+void ESP_WiFiManager::endPage(WM_ChunkedPrint& page)
+{
+  page.flush();
+
+  // Ends the chunked reply
+  server->sendContent("");
+}
+
+//////////////////////////////////////////
+
+/** Prints a page body with body, then ends the page : in the PSRAM page buffer when there is one, else in a
+    chunk on the stack of printStackPage(), not of the handlers */
+void ESP_WiFiManager::printPage(const PageBody& body)
+{
+  if (_pageBuf)
+  {
+    WM_ChunkedPrint page(pageSender(), _pageBuf, WM_PSRAM_CHUNK_SIZE);
+
+    body(page);
+    endPage(page);
+  }
+  else
+  {
+    printStackPage(body);
   }
 }
 
 //////////////////////////////////////////
 
+void ESP_WiFiManager::printStackPage(const PageBody& body)
+{
+  WM_StackChunkedPrint page(pageSender());
+
+  body(page);
+  endPage(page);
+}
+
+//////////////////////////////////////////
+
 /** Handle root or redirect to captive portal */
 void ESP_WiFiManager::handleRoot()
 {
+  WM_LOG_MODULE(WM_LOG_HTTP);
+
   LOGDEBUG(F("Handle root"));
 
+  if (!allowRequest(false))
+  {
+    return;
+  }
+
   // Disable _configPortalTimeout when someone accessing Portal to give some time to config
   _configPortalTimeout = 0;		//KH
 
@@ -1086,42 +1414,30 @@ void ESP_WiFiManager::handleRoot()
   server->sendHeader(FPSTR(WM_HTTP_PRAGMA), FPSTR(WM_HTTP_NO_CACHE));
   server->sendHeader(FPSTR(WM_HTTP_EXPIRES), "-1");
 
-  String page = FPSTR(WM_HTTP_HEAD_START);
-  
-  page.replace("{v}", "VIVOsmart Options");
-  page += FPSTR(WM_HTTP_SCRIPT);
-  page += FPSTR(WM_HTTP_SCRIPT_NTP);
-  page += FPSTR(WM_HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(WM_HTTP_HEAD_END);
-  byte mac[6];  
-  WiFi.macAddress(mac);  
-  String ret = "";
-  page += "<div style='margin: 0px 20px 20px 20px;'>Dispositivo numero: <b>0000" + String(mac[5]) + String(mac[4])+ String(mac[3]) + String(mac[2])+ String(mac[1]) + String(mac[0]) + "</b></div>";
-  /*if (WiFi_SSID() != "")
+  beginPage(200, "text/html");
+
+  printPage([&](WM_ChunkedPrint& page)
   {
-    if (WiFi.status() == WL_CONNECTED)
-    {
-      page += " on ";
-      page += WiFi_SSID();
-    }
-    else
-    {
-      page += " <s>on ";
-      page += WiFi_SSID();
-      page += "</s>";
-    }
-  }*/
+    printPageHead(page, "VIVOsmart Options", true);
+
+    byte mac[6];
+
+    WiFi.macAddress(mac);
 
-  //page += "</h2>";
-  page += FPSTR(WM_HTTP_PORTAL_OPTIONS);
-  page += F("<div class=\"msg\">");
-  reportStatus(page);
-  page += F("</div>");
-  page += FPSTR(WM_HTTP_END);
+    page.print(F("<div style='margin: 0px 20px 20px 20px;'>Dispositivo numero: <b>0000"));
 
-  server->send(200, "text/html", page);
+    for (int i = 5; i >= 0; i--)
+    {
+      page.print(mac[i]);
+    }
 
+    page.print(F("</b></div>"));
+    page.print(FPSTR(WM_HTTP_PORTAL_OPTIONS));
+    page.print(F("<div class=\"msg\">"));
+    reportStatus(page);
+    page.print(F("</div>"));
+    page.print(FPSTR(WM_HTTP_END));
+  });
 }
 
 //////////////////////////////////////////
@@ -1129,8 +1445,15 @@ void ESP_WiFiManager::handleRoot()
 /** Wifi config page handler */
 void ESP_WiFiManager::handleWifi()
 {
+  WM_LOG_MODULE(WM_LOG_HTTP);
+
   LOGDEBUG(F("Handle WiFi"));
 
+  if (!allowRequest(true))
+  {
+    return;
+  }
+
   // Disable _configPortalTimeout when someone accessing Portal to give some time to config
   _configPortalTimeout = 0;		//KH
   
@@ -1144,225 +1467,182 @@ void ESP_WiFiManager::handleWifi()
   server->sendHeader(FPSTR(WM_HTTP_PRAGMA), FPSTR(WM_HTTP_NO_CACHE));
   server->sendHeader(FPSTR(WM_HTTP_EXPIRES), "-1");
   
-  String page = FPSTR(WM_HTTP_HEAD_START);
-  
-  page.replace("{v}", "Config ESP");
-  page += FPSTR(WM_HTTP_SCRIPT);
-  page += FPSTR(WM_HTTP_SCRIPT_NTP);
-  page += FPSTR(WM_HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(WM_HTTP_HEAD_END);
-  page += F("<h2>WiFi Configuration</h2>");
+  beginPage(200, "text/html");
 
-  //  KH, New
-  numberOfNetworks = scanWifiNetworks(&networkIndices);
-
-  //Print list of WiFi networks that were found in earlier scan
-  if (numberOfNetworks == 0)
-  {
-    page += F("No network found. Refresh to scan again.");
-  }
-  else
+  printPage([&](WM_ChunkedPrint& page)
   {
-    page += FPSTR(WM_FLDSET_START);
-    
-    //display networks in page
-    for (int i = 0; i < numberOfNetworks; i++)
+    printPageHead(page, "Config ESP", true);
+    page.print(F("<h2>WiFi Configuration</h2>"));
+
+    //  KH, New
+    numberOfNetworks = scanWifiNetworks(&networkIndices);
+
+    //Print list of WiFi networks that were found in earlier scan
+    if (numberOfNetworks == 0)
     {
-      if (networkIndices[i] == -1)
-        continue; // skip dups and those that are below the required quality
-      
-      LOGDEBUG1(F("Index ="), i);
-      LOGDEBUG1(F("SSID ="), WiFi.SSID(networkIndices[i]));
-      LOGDEBUG1(F("RSSI ="), WiFi.RSSI(networkIndices[i]));
+      page.print(F("No network found. Refresh to scan again."));
+    }
+    else
+    {
+      page.print(FPSTR(WM_FLDSET_START));
+
+      //display networks in page
+      for (int i = 0; i < numberOfNetworks; i++)
+      {
+        if (networkIndices[i] == -1)
+          continue; // skip dups and those that are below the required quality
 
-      int quality = getRSSIasQuality(WiFi.RSSI(networkIndices[i]));
+        LOGDEBUG1(F("Index ="), i);
+        LOGDEBUG1(F("SSID ="), WiFi.SSID(networkIndices[i]));
+        LOGDEBUG1(F("RSSI ="), WiFi.RSSI(networkIndices[i]));
 
-      String item = FPSTR(WM_HTTP_ITEM);
-      String rssiQ;
-      rssiQ += quality;
-      item.replace("{v}", WiFi.SSID(networkIndices[i]));
-      item.replace("{pollo}", "polpetta3");
-      item.replace("{r}", rssiQ);
+        WM_StaticString<4>  quality(getRSSIasQuality(WiFi.RSSI(networkIndices[i])));
+        String              ssid = WiFi.SSID(networkIndices[i]);
 
 #ifdef ESP8266
-      if (WiFi.encryptionType(networkIndices[i]) != ENC_TYPE_NONE)
+        bool encrypted = (WiFi.encryptionType(networkIndices[i]) != ENC_TYPE_NONE);
 #else		//ESP32
-      if (WiFi.encryptionType(networkIndices[i]) != WIFI_AUTH_OPEN)
+        bool encrypted = (WiFi.encryptionType(networkIndices[i]) != WIFI_AUTH_OPEN);
 #endif
-      {
-        item.replace("{i}", "l");
-      }
-      else
-      {
-        item.replace("{i}", "");
+
+        const WM_TemplateVar item[] = { { "{v}", ssid.c_str() }, { "{r}", quality }, { "{i}", encrypted ? "l" : "" } };
+
+        WM_printTemplate(page, WM_HTTP_ITEM, item, sizeof(item) / sizeof(item[0]));
+        delay(0);
       }
 
-      //LOGDEBUG(item);
-      
-      page += item;
-      delay(0);
+      // Next request scans again
+      freeIndices(networkIndices);
+
+      page.print(FPSTR(WM_FLDSET_END));
+
+      page.print(F("<br/>"));
     }
-    
-    page += FPSTR(WM_FLDSET_END);
 
-    page += "<br/>";
-  }
-  //page +=getUID();
-  page += "<small>*Hint: To reuse the saved WiFi credentials, leave SSID and PWD fields empty</small>";
+    page.print(F("<small>*Hint: To reuse the saved WiFi credentials, leave SSID and PWD fields empty</small>"));
 
-  page += FPSTR(WM_HTTP_FORM_START);
-  
 #if DISPLAY_STORED_CREDENTIALS_IN_CP
-  // Populate SSIDs and PWDs if valid
-  page.replace("[[ssid]]",  _ssid );
-  page.replace("[[pwd]]",   _pass );
-  page.replace("[[ssid1]]", _ssid1 );
-  page.replace("[[pwd1]]",  _pass1 );
-#endif
-  
-  char parLength[2];
-  
-  page += FPSTR(WM_FLDSET_START);
-  
-  // add the extra parameters to the form
-  for (int i = 0; i < _paramsCount; i++)
-  {
-    if (_params[i] == NULL)
+    // Populate SSIDs and PWDs if valid
+    const WM_TemplateVar credentials[] =
     {
-      break;
-    }
-    
-    String pitem;
-    switch (_params[i]->getLabelPlacement())
+      { "[[ssid]]",   _ssid.c_str()   },
+      { "[[pwd]]",    _pass.c_str()   },
+      { "[[ssid1]]",  _ssid1.c_str()  },
+      { "[[pwd1]]",   _pass1.c_str()  }
+    };
+
+    WM_printTemplate(page, WM_HTTP_FORM_START, credentials, sizeof(credentials) / sizeof(credentials[0]));
+#else
+    page.print(FPSTR(WM_HTTP_FORM_START));
+#endif
+
+    page.print(FPSTR(WM_FLDSET_START));
+
+    // add the extra parameters to the form
+    for (int i = 0; i < _paramsCount; i++)
     {
-      case WFM_LABEL_BEFORE:
-        pitem = FPSTR(WM_HTTP_FORM_LABEL_BEFORE);
-        break;
-      case WFM_LABEL_AFTER:
-        pitem = FPSTR(WM_HTTP_FORM_LABEL_AFTER);
-        break;
-      default:
-        // WFM_NO_LABEL
-        pitem = FPSTR(WM_HTTP_FORM_PARAM);
+      if (_params[i] == NULL)
+      {
         break;
-    }
+      }
 
-    if (_params[i]->getID() != NULL)
-    {
-      pitem.replace("{i}", _params[i]->getID());
-      pitem.replace("{n}", _params[i]->getID());
-      pitem.replace("{p}", _params[i]->getPlaceholder());
-      snprintf(parLength, 2, "%d", _params[i]->getValueLength());
-      pitem.replace("{l}", parLength);
-      pitem.replace("{v}", _params[i]->getValue());
-      pitem.replace("{pollo}", "polpetta4");
-      pitem.replace("{c}", _params[i]->getCustomHTML());
+      if (_params[i]->getID() == NULL)
+      {
+        page.print(_params[i]->getCustomHTML());
+
+        continue;
+      }
+
+      PGM_P pitem;
+
+      switch (_params[i]->getLabelPlacement())
+      {
+        case WFM_LABEL_BEFORE:
+          pitem = WM_HTTP_FORM_LABEL_BEFORE;
+          break;
+        case WFM_LABEL_AFTER:
+          pitem = WM_HTTP_FORM_LABEL_AFTER;
+          break;
+        default:
+          // WFM_NO_LABEL
+          pitem = WM_HTTP_FORM_PARAM;
+          break;
+      }
+
+      WM_StaticString<11> parLength(_params[i]->getValueLength());
+
+      const WM_TemplateVar param[] =
+      {
+        { "{i}", _params[i]->getID()          },
+        { "{n}", _params[i]->getID()          },
+        { "{p}", _params[i]->getPlaceholder() },
+        { "{l}", parLength                    },
+        { "{v}", _params[i]->getValue()       },
+        { "{c}", _params[i]->getCustomHTML()  }
+      };
+
+      WM_printTemplate(page, pitem, param, sizeof(param) / sizeof(param[0]));
     }
-    else
+
+    if (_paramsCount > 0)
     {
-      pitem = _params[i]->getCustomHTML();
+      page.print(FPSTR(WM_FLDSET_END));
     }
 
-    page += pitem;
-  }
-  
-  if (_paramsCount > 0)
-  {
-    page += FPSTR(WM_FLDSET_END);
-  }
-
-  if (_params[0] != NULL)
-  {
-    page += "<br/>";
-  }
+    if (_params[0] != NULL)
+    {
+      page.print(F("<br/>"));
+    }
 
-  LOGDEBUG1(F("Static IP ="), _WiFi_STA_IPconfig._sta_static_ip.toString());
+    LOGDEBUG1(F("Static IP ="), _WiFi_STA_IPconfig._sta_static_ip.toString());
   
-  // KH, Comment out in v1.0.9 to permit changing from DHCP to static IP, or vice versa
-  // and add staticIP label in CP
+    // KH, Comment out in v1.0.9 to permit changing from DHCP to static IP, or vice versa
+    // and add staticIP label in CP
   
-  // From v1.0.10 to permit disable/enable StaticIP configuration in Config Portal from sketch. Valid only if DHCP is used.
-  // You'll loose the feature of dynamically changing from DHCP to static IP, or vice versa
-  // You have to explicitly specify false to disable the feature.
+    // From v1.0.10 to permit disable/enable StaticIP configuration in Config Portal from sketch. Valid only if DHCP is used.
+    // You'll loose the feature of dynamically changing from DHCP to static IP, or vice versa
+    // You have to explicitly specify false to disable the feature.
 
 #if !USE_STATIC_IP_CONFIG_IN_CP
-  if (_WiFi_STA_IPconfig._sta_static_ip)
+    if (_WiFi_STA_IPconfig._sta_static_ip)
 #endif  
-  {
-    page += FPSTR(WM_FLDSET_START);
-    
-    String item = FPSTR(WM_HTTP_FORM_LABEL);
-    item += FPSTR(WM_HTTP_FORM_PARAM);
-    item.replace("{i}", "ip");
-    item.replace("{n}", "ip");
-    item.replace("{p}", "Static IP");
-    item.replace("{l}", "15");
-    item.replace("{v}", _WiFi_STA_IPconfig._sta_static_ip.toString());
-    item.replace("{pollo}", "polpetta5");
-
-    page += item;
-
-    item = FPSTR(WM_HTTP_FORM_LABEL);
-    item += FPSTR(WM_HTTP_FORM_PARAM);
-    item.replace("{i}", "gw");
-    item.replace("{n}", "gw");
-    item.replace("{p}", "Gateway IP");
-    item.replace("{l}", "15");
-    item.replace("{v}", _WiFi_STA_IPconfig._sta_static_gw.toString());
-    item.replace("{pollo}", "polpetta6");
-
-    page += item;
-
-    item = FPSTR(WM_HTTP_FORM_LABEL);
-    item += FPSTR(WM_HTTP_FORM_PARAM);
-    item.replace("{i}", "sn");
-    item.replace("{n}", "sn");
-    item.replace("{p}", "Subnet");
-    item.replace("{l}", "15");
-    item.replace("{v}", _WiFi_STA_IPconfig._sta_static_sn.toString());
-    item.replace("{pollo}", "polpetta7");
-
-  #if USE_CONFIGURABLE_DNS
-    //***** Added for DNS address options *****
-    page += item;
-
-    item = FPSTR(WM_HTTP_FORM_LABEL);
-    item += FPSTR(WM_HTTP_FORM_PARAM);
-    item.replace("{i}", "dns1");
-    item.replace("{n}", "dns1");
-    item.replace("{p}", "DNS1 IP");
-    item.replace("{l}", "15");
-    item.replace("{v}", _WiFi_STA_IPconfig._sta_static_dns1.toString());
-    item.replace("{pollo}", "polpetta8");
-    
-    page += item;
-
-    item = FPSTR(WM_HTTP_FORM_LABEL);
-    item += FPSTR(WM_HTTP_FORM_PARAM);
-    item.replace("{i}", "dns2");
-    item.replace("{n}", "dns2");
-    item.replace("{p}", "DNS2 IP");
-    item.replace("{l}", "15");
-    item.replace("{v}", _WiFi_STA_IPconfig._sta_static_dns2.toString());
-    item.replace("{pollo}", "polpetta9");
-    //***** End added for DNS address options *****
-  #endif
+    {
+      // Label and input of a static IP setting
+      auto printIPItem = [&page](const char* id, const char* label, const IPAddress& ip)
+      {
+        WM_StaticString<39> value(ip);
 
-    page += item;
-    
-    page += FPSTR(WM_FLDSET_END);
+        const WM_TemplateVar item[] =
+          { { "{i}", id }, { "{n}", id }, { "{p}", label }, { "{l}", "15" }, { "{v}", value }, { "{c}", "" } };
 
-    page += "<br/>";
-  }
-  
-  page += FPSTR(WM_HTTP_SCRIPT_NTP_HIDDEN);
+        WM_printTemplate(page, WM_HTTP_FORM_LABEL, item, sizeof(item) / sizeof(item[0]));
+        WM_printTemplate(page, WM_HTTP_FORM_PARAM, item, sizeof(item) / sizeof(item[0]));
+      };
+
+      page.print(FPSTR(WM_FLDSET_START));
 
-  page += FPSTR(WM_HTTP_FORM_END);
+      printIPItem("ip", "Static IP",  _WiFi_STA_IPconfig._sta_static_ip);
+      printIPItem("gw", "Gateway IP", _WiFi_STA_IPconfig._sta_static_gw);
+      printIPItem("sn", "Subnet",     _WiFi_STA_IPconfig._sta_static_sn);
 
-  page += FPSTR(WM_HTTP_END);
+    #if USE_CONFIGURABLE_DNS
+      //***** Added for DNS address options *****
+      printIPItem("dns1", "DNS1 IP", _WiFi_STA_IPconfig._sta_static_dns1);
+      printIPItem("dns2", "DNS2 IP", _WiFi_STA_IPconfig._sta_static_dns2);
+      //***** End added for DNS address options *****
+    #endif
+
+      page.print(FPSTR(WM_FLDSET_END));
+
+      page.print(F("<br/>"));
+    }
 
-  server->send(200, "text/html", page);
+    page.print(FPSTR(WM_HTTP_SCRIPT_NTP_HIDDEN));
+
+    page.print(FPSTR(WM_HTTP_FORM_END));
+
+    page.print(FPSTR(WM_HTTP_END));
+  });
 
   LOGDEBUG(F("Sent config page"));
 }
@@ -1372,8 +1652,15 @@ void ESP_WiFiManager::handleWifi()
 /** Handle the WLAN save form and redirect to WLAN config page again */
 void ESP_WiFiManager::handleWifiSave()
 {
+  WM_LOG_MODULE(WM_LOG_PARAMS);
+
   LOGDEBUG(F("WiFi save"));
 
+  if (!allowRequest(true))
+  {
+    return;
+  }
+
   //SAVE/connect here
   _ssid = server->arg("s").c_str();
   _pass = server->arg("p").c_str();
@@ -1414,8 +1701,11 @@ void ESP_WiFiManager::handleWifiSave()
     //read parameter
     String value = server->arg(_params[i]->getID()).c_str();
     
-    //store it in array
-    value.toCharArray(_params[i]->_WMParam_data._value, _params[i]->_WMParam_data._length);
+    //store it in array, if the parameter got room for one
+    if (_params[i]->_WMParam_data._value != NULL)
+    {
+      value.toCharArray(_params[i]->_WMParam_data._value, _params[i]->_WMParam_data._length);
+    }
     
     LOGDEBUG2(F("Parameter and value :"), _params[i]->getID(), value);
   }
@@ -1464,22 +1754,17 @@ void ESP_WiFiManager::handleWifiSave()
   //*****  End added for DNS Options *****
 #endif
 
-  String page = FPSTR(WM_HTTP_HEAD_START);
-  
-  page.replace("{v}", "Credentials Saved");
-  page += FPSTR(WM_HTTP_SCRIPT);
-  page += FPSTR(WM_HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(WM_HTTP_HEAD_END);
-  page += FPSTR(WM_HTTP_SAVED);
-  page.replace("{v}", _apName);
-  page.replace("{pollo}", "polpetta");
-  page.replace("{x}", _ssid);
-  page.replace("{x1}", _ssid1);
-  
-  page += FPSTR(WM_HTTP_END);
+  beginPage(200, "text/html");
 
-  server->send(200, "text/html", page);
+  printPage([&](WM_ChunkedPrint& page)
+  {
+    printPageHead(page, "Credentials Saved");
+
+    const WM_TemplateVar saved[] = { { "{v}", _apName }, { "{x}", _ssid.c_str() }, { "{x1}", _ssid1.c_str() } };
+
+    WM_printTemplate(page, WM_HTTP_SAVED, saved, sizeof(saved) / sizeof(saved[0]));
+    page.print(FPSTR(WM_HTTP_END));
+  });
 
   LOGDEBUG(F("Sent wifi save page"));
 
@@ -1494,7 +1779,14 @@ void ESP_WiFiManager::handleWifiSave()
 /** Handle shut down the server page */
 void ESP_WiFiManager::handleServerClose()
 {
+  WM_LOG_MODULE(WM_LOG_HTTP);
+
   LOGDEBUG(F("Server Close"));
+
+  if (!allowRequest(false))
+  {
+    return;
+  }
   
   server->sendHeader(FPSTR(WM_HTTP_CACHE_CONTROL), FPSTR(WM_HTTP_NO_STORE));
 
@@ -1506,29 +1798,29 @@ void ESP_WiFiManager::handleServerClose()
   server->sendHeader(FPSTR(WM_HTTP_PRAGMA), FPSTR(WM_HTTP_NO_CACHE));
   server->sendHeader(FPSTR(WM_HTTP_EXPIRES), "-1");
   
-  String page = FPSTR(WM_HTTP_HEAD_START);
-  
-  page.replace("{v}", "Close Server");
-  page.replace("{pollo}", "polpettissima2");
-  page += FPSTR(WM_HTTP_SCRIPT);
-  page += FPSTR(WM_HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(WM_HTTP_HEAD_END);
-  page += F("<div class=\"msg\">");
-  page += F("My network is <b>");
-  page += WiFi_SSID();
-  page += F("</b><br>");
-  page += F("IP address is <b>");
-  page += WiFi.localIP().toString();
-  page += F("</b><br><br>");
-  page += F("Portal closed...<br><br>");
-  
-  //page += F("Push button on device to restart configuration server!");
-  
-  page += FPSTR(WM_HTTP_END);
-  
-  server->send(200, "text/html", page);
-  
+  char ssid[33];
+
+  WiFi_SSID(ssid, sizeof(ssid));
+
+  beginPage(200, "text/html");
+
+  printPage([&](WM_ChunkedPrint& page)
+  {
+    printPageHead(page, "Close Server");
+    page.print(F("<div class=\"msg\">"));
+    page.print(F("My network is <b>"));
+    page.print(ssid);
+    page.print(F("</b><br>"));
+    page.print(F("IP address is <b>"));
+    page.print(WiFi.localIP());
+    page.print(F("</b><br><br>"));
+    page.print(F("Portal closed...<br><br>"));
+
+    //page.print(F("Push button on device to restart configuration server!"));
+
+    page.print(FPSTR(WM_HTTP_END));
+  });
+
   stopConfigPortal = true; //signal ready to shutdown config portal
   
   LOGDEBUG(F("Sent server close page"));
@@ -1542,8 +1834,15 @@ void ESP_WiFiManager::handleServerClose()
 /** Handle the info page */
 void ESP_WiFiManager::handleInfo()
 {
+  WM_LOG_MODULE(WM_LOG_HTTP);
+
   LOGDEBUG(F("Info"));
 
+  if (!allowRequest(false))
+  {
+    return;
+  }
+
   // Disable _configPortalTimeout when someone accessing Portal to give some time to config
   _configPortalTimeout = 0;		//KH
 
@@ -1557,104 +1856,109 @@ void ESP_WiFiManager::handleInfo()
   server->sendHeader(FPSTR(WM_HTTP_PRAGMA), FPSTR(WM_HTTP_NO_CACHE));
   server->sendHeader(FPSTR(WM_HTTP_EXPIRES), "-1");
   
-  String page = FPSTR(WM_HTTP_HEAD_START);
-  
-  page.replace("{v}", "Info");
-  page.replace("{pollo}", "polpettissima2");
-  page += FPSTR(WM_HTTP_SCRIPT);
-  page += FPSTR(WM_HTTP_SCRIPT_NTP);
-  page += FPSTR(WM_HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(WM_HTTP_HEAD_END);
-  
-  page += F("<h2>WiFi Information</h2>");
-  
-  reportStatus(page);
-  
-  page += FPSTR(WM_FLDSET_START);
-  
-  page += F("<h3>Device Data</h3>");
-  page += F("<table class=\"table\">");
-  page += F("<thead><tr><th>Name</th><th>Value</th></tr></thead><tbody><tr><td>Chip ID</td><td>");
+  char    ssid[33];
+  char    hex[17];
+  uint8_t mac[6];
+
+  WiFi_SSID(ssid, sizeof(ssid));
+
+  beginPage(200, "text/html");
+
+  printPage([&](WM_ChunkedPrint& page)
+  {
+    printPageHead(page, "Info", true);
+
+    page.print(F("<h2>WiFi Information</h2>"));
 
-  page += F("0x");
+    reportStatus(page);
+
+    page.print(FPSTR(WM_FLDSET_START));
+
+    page.print(F("<h3>Device Data</h3>"));
+    page.print(F("<table class=\"table\">"));
+    page.print(F("<thead><tr><th>Name</th><th>Value</th></tr></thead><tbody><tr><td>Chip ID</td><td>"));
+
+    page.print(F("0x"));
 #ifdef ESP8266
-  page += String(ESP.getChipId(), HEX);		//ESP.getChipId();
+    snprintf(hex, sizeof(hex), "%lx", (unsigned long) ESP.getChipId());
+    page.print(hex);
 #else		//ESP32
 
-  page += String(ESP_getChipId(), HEX);		//ESP.getChipId();
-  
-  page += F("</td></tr>");
-  page += F("<tr><td>Chip OUI</td><td>");
-  page += F("0x");
-  page += String(getChipOUI(), HEX);		//ESP.getChipId();
-  
-  page += F("</td></tr>");
-  page += F("<tr><td>Chip Model</td><td>");
-  page += ESP.getChipModel();
-  page += F(" Rev");
-  page += ESP.getChipRevision();
+    snprintf(hex, sizeof(hex), "%lx", (unsigned long) ESP_getChipId());
+    page.print(hex);
+
+    page.print(F("</td></tr>"));
+    page.print(F("<tr><td>Chip OUI</td><td>"));
+    page.print(F("0x"));
+    snprintf(hex, sizeof(hex), "%lx", (unsigned long) getChipOUI());
+    page.print(hex);
+
+    page.print(F("</td></tr>"));
+    page.print(F("<tr><td>Chip Model</td><td>"));
+    page.print(ESP.getChipModel());
+    page.print(F(" Rev"));
+    page.print(ESP.getChipRevision());
 #endif
 
-  page += F("</td></tr>");
-  page += F("<tr><td>Flash Chip ID</td><td>");
+    page.print(F("</td></tr>"));
+    page.print(F("<tr><td>Flash Chip ID</td><td>"));
 
 #ifdef ESP8266
-  page += String(ESP.getFlashChipId(), HEX);		//ESP.getFlashChipId();
+    snprintf(hex, sizeof(hex), "%lx", (unsigned long) ESP.getFlashChipId());
+    page.print(hex);
 #else		//ESP32
-  // TODO
-  page += F("TODO");
+    // TODO
+    page.print(F("TODO"));
 #endif
 
-  page += F("</td></tr>");
-  page += F("<tr><td>IDE Flash Size</td><td>");
-  page += ESP.getFlashChipSize();
-  page += F(" bytes</td></tr>");
-  page += F("<tr><td>Real Flash Size</td><td>");
+    page.print(F("</td></tr>"));
+    page.print(F("<tr><td>IDE Flash Size</td><td>"));
+    page.print(ESP.getFlashChipSize());
+    page.print(F(" bytes</td></tr>"));
+    page.print(F("<tr><td>Real Flash Size</td><td>"));
 
 #ifdef ESP8266
-  page += ESP.getFlashChipRealSize();
+    page.print(ESP.getFlashChipRealSize());
 #else		//ESP32
-  // TODO
-  page += F("TODO");
+    // TODO
+    page.print(F("TODO"));
 #endif
 
-  page += F(" bytes</td></tr>");
-  page += F("<tr><td>Access Point IP</td><td>");
-  page += WiFi.softAPIP().toString();
-  page += F("</td></tr>");
-  page += F("<tr><td>Access Point MAC</td><td>");
-  page += WiFi.softAPmacAddress();
-  page += F("</td></tr>");
+    page.print(F(" bytes</td></tr>"));
+    page.print(F("<tr><td>Access Point IP</td><td>"));
+    page.print(WiFi.softAPIP());
+    page.print(F("</td></tr>"));
+    page.print(F("<tr><td>Access Point MAC</td><td>"));
+    page.print(WM_MACAddress(WiFi.softAPmacAddress(mac)));
+    page.print(F("</td></tr>"));
 
-  page += F("<tr><td>SSID</td><td>");
-  page += WiFi_SSID();
-  page += F("</td></tr>");
+    page.print(F("<tr><td>SSID</td><td>"));
+    page.print(ssid);
+    page.print(F("</td></tr>"));
 
-  page += F("<tr><td>Station IP</td><td>");
-  page += WiFi.localIP().toString();
-  page += F("</td></tr>");
+    page.print(F("<tr><td>Station IP</td><td>"));
+    page.print(WiFi.localIP());
+    page.print(F("</td></tr>"));
 
-  page += F("<tr><td>Station MAC</td><td>");
-  page += WiFi.macAddress();
-  page += F("</td></tr>");
-  page += F("</tbody></table>");
+    page.print(F("<tr><td>Station MAC</td><td>"));
+    page.print(WM_MACAddress(WiFi.macAddress(mac)));
+    page.print(F("</td></tr>"));
+    page.print(F("</tbody></table>"));
 
-  page += FPSTR(WM_FLDSET_END);
-  
-#if USE_AVAILABLE_PAGES  
-  page += FPSTR(WM_FLDSET_START);
-  
-  page += FPSTR(WM_HTTP_AVAILABLE_PAGES);
-  
-  page += FPSTR(WM_FLDSET_END);
-#endif
+    page.print(FPSTR(WM_FLDSET_END));
+
+#if USE_AVAILABLE_PAGES
+    page.print(FPSTR(WM_FLDSET_START));
 
-  page += F("<p/>More information about ESP_WiFiManager at");
-  page += F("<p/><a href=\"https://github.com/khoih-prog/ESP_WiFiManager\">https://github.com/khoih-prog/ESP_WiFiManager</a>");
-  page += FPSTR(WM_HTTP_END);
+    page.print(FPSTR(WM_HTTP_AVAILABLE_PAGES));
 
-  server->send(200, "text/html", page);
+    page.print(FPSTR(WM_FLDSET_END));
+#endif
+
+    page.print(F("<p/>More information about ESP_WiFiManager at"));
+    page.print(F("<p/><a href=\"https://github.com/khoih-prog/ESP_WiFiManager\">https://github.com/khoih-prog/ESP_WiFiManager</a>"));
+    page.print(FPSTR(WM_HTTP_END));
+  });
 
   LOGDEBUG(F("Sent info page"));
 }
@@ -1664,7 +1968,14 @@ void ESP_WiFiManager::handleInfo()
 /** Handle the state page */
 void ESP_WiFiManager::handleState()
 {
+  WM_LOG_MODULE(WM_LOG_HTTP);
+
   LOGDEBUG(F("State - json"));
+
+  if (!allowRequest(false))
+  {
+    return;
+  }
   
   server->sendHeader(FPSTR(WM_HTTP_CACHE_CONTROL), FPSTR(WM_HTTP_NO_STORE));
 
@@ -1676,42 +1987,148 @@ void ESP_WiFiManager::handleState()
   server->sendHeader(FPSTR(WM_HTTP_PRAGMA), FPSTR(WM_HTTP_NO_CACHE));
   server->sendHeader(FPSTR(WM_HTTP_EXPIRES), "-1");
   
-  String page = F("{\"Soft_AP_IP\":\"");
-  
-  page += WiFi.softAPIP().toString();
-  page += F("\",\"Soft_AP_MAC\":\"");
-  page += WiFi.softAPmacAddress();
-  page += F("\",\"Station_IP\":\"");
-  page += WiFi.localIP().toString();
-  page += F("\",\"Station_MAC\":\"");
-  page += WiFi.macAddress();
-  page += F("\",");
+  char    ssid[33];
+  char    pass[65];
+  uint8_t mac[6];
+
+  WiFi_SSID(ssid, sizeof(ssid));
+  WiFi_Pass(pass, sizeof(pass));
 
-  if (WiFi.psk() != "")
+  beginPage(200, "application/json");
+
+  printPage([&](WM_ChunkedPrint& page)
   {
-    page += F("\"Password\":true,");
+    page.print(F("{\"Soft_AP_IP\":\""));
+    page.print(WiFi.softAPIP());
+    page.print(F("\",\"Soft_AP_MAC\":\""));
+    page.print(WM_MACAddress(WiFi.softAPmacAddress(mac)));
+    page.print(F("\",\"Station_IP\":\""));
+    page.print(WiFi.localIP());
+    page.print(F("\",\"Station_MAC\":\""));
+    page.print(WM_MACAddress(WiFi.macAddress(mac)));
+    page.print(F("\","));
+
+    if (pass[0] != 0)
+    {
+      page.print(F("\"Password\":true,"));
+    }
+    else
+    {
+      page.print(F("\"Password\":false,"));
+    }
+
+    page.print(F("\"SSID\":\""));
+    page.print(ssid);
+    page.print(F("\"}"));
+  });
+
+  LOGDEBUG(F("Sent state page in json format"));
+}
+
+//////////////////////////////////////////
+
+/** Handle the log level page. Sets the levels given as arguments, /loglevel?scan=4&http=0 or /loglevel?all=2,
+    then lists the levels of all modules, one "module=level" per line */
+void ESP_WiFiManager::handleLogLevel()
+{
+  WM_LOG_MODULE(WM_LOG_HTTP);
+
+  if (!allowRequest(false))
+  {
+    return;
   }
-  else
+
+  for (int i = 0; i < server->args(); i++)
   {
-    page += F("\"Password\":false,");
+    int module = WM_logModuleByName(server->argName(i).c_str());
+    int level  = server->arg(i).toInt();
+
+    if ( (module >= 0) && (level >= 0) )
+    {
+      WM_setLogLevel(module, level);
+
+      LOGINFO2(F("Log level"), server->argName(i), level);
+    }
   }
 
-  page += F("\"SSID\":\"");
-  page += WiFi_SSID();
-  page += F("\"}");
-  
-  server->send(200, "application/json", page);
-  
-  LOGDEBUG(F("Sent state page in json format"));
+  server->sendHeader(FPSTR(WM_HTTP_CACHE_CONTROL), FPSTR(WM_HTTP_NO_STORE));
+  beginPage(200, "text/plain");
+
+  printPage([&](WM_ChunkedPrint& page)
+  {
+    for (uint8_t i = 0; i < WM_LOG_MODULES; i++)
+    {
+      page.print(FPSTR(WM_logModuleName(i)));
+      page.print('=');
+      page.print(WM_getLogLevel(i));
+      page.print('\n');
+    }
+
+    page.print(F("max="));
+    page.print(WIFIMGR_LOGLEVEL_MAX);
+    page.print('\n');
+  });
 }
 
 //////////////////////////////////////////
 
+void ESP_WiFiManager::handleRoute(const uint8_t& route, void (ESP_WiFiManager::*handler)())
+{
+  _allocs.beginRequest(route);
+  _metrics.beginRequest(route);
+
+  (this->*handler)();
+
+  _metrics.endRequest();
+  _allocs.endRequest();
+}
+
+//////////////////////////////////////////
+
+#if USE_WM_METRICS
+
+/** Handle the metrics page. Prometheus text format, or compact JSON with ?format=json */
+void ESP_WiFiManager::handleMetrics()
+{
+  WM_LOG_MODULE(WM_LOG_HTTP);
+
+  if (!allowRequest(false))
+  {
+    return;
+  }
+
+  bool json = (server->arg("format") == "json");
+
+  LOGDEBUG1(F("Metrics, json ="), json);
+
+  server->sendHeader(FPSTR(WM_HTTP_CACHE_CONTROL), FPSTR(WM_HTTP_NO_STORE));
+  beginPage(200, json ? "application/json" : "text/plain; version=0.0.4");
+
+  printPage([&](WM_ChunkedPrint& out)
+  {
+    if (json)
+      _metrics.printJSON(out);
+    else
+      _metrics.printPrometheus(out);
+  });
+}
+
+#endif
+
+//////////////////////////////////////////
+
 /** Handle the scan page */
 void ESP_WiFiManager::handleScan()
 {
+  WM_LOG_MODULE(WM_LOG_SCAN);
+
   LOGDEBUG(F("Scan"));
 
+  if (!allowRequest(true))
+  {
+    return;
+  }
+
   // Disable _configPortalTimeout when someone accessing Portal to give some time to config
   _configPortalTimeout = 0;		//KH
 
@@ -1728,7 +2145,7 @@ void ESP_WiFiManager::handleScan()
   server->sendHeader(FPSTR(WM_HTTP_EXPIRES), "-1");
 
   int n;
-  int *indices;
+  int *indices = NULL;
 
   //Space for indices array allocated on heap in scanWifiNetworks
   //and should be freed when indices no longer required.
@@ -1737,58 +2154,49 @@ void ESP_WiFiManager::handleScan()
   
   LOGDEBUG(F("In handleScan, scanWifiNetworks done"));
   
-  String page = F("{\"Access_Points\":[");
+  beginPage(200, "application/json");
 
-  //display networks in page
-  for (int i = 0; i < n; i++)
+  printPage([&](WM_ChunkedPrint& page)
   {
-    if (indices[i] == -1)
-      continue; // skip duplicates and those that are below the required quality
+    page.print(F("{\"Access_Points\":["));
 
-    if (i != 0)
-      page += F(", ");
+    bool first = true;
 
-    LOGDEBUG1(F("Index ="), i);
-    LOGDEBUG1(F("SSID ="), WiFi.SSID(indices[i]));
-    LOGDEBUG1(F("RSSI ="), WiFi.RSSI(indices[i]));
+    //display networks in page
+    for (int i = 0; i < n; i++)
+    {
+      if (indices[i] == -1)
+        continue; // skip duplicates and those that are below the required quality
 
-    int quality = getRSSIasQuality(WiFi.RSSI(indices[i]));
-    String item = FPSTR(JSON_ITEM);
-    String rssiQ;
-    
-    rssiQ += quality;
-    item.replace("{v}", WiFi.SSID(indices[i]));
-    item.replace("{pollo}", "polpetta2");
-    item.replace("{r}", rssiQ);
+      if (!first)
+        page.print(F(", "));
+
+      first = false;
+
+      LOGDEBUG1(F("Index ="), i);
+      LOGDEBUG1(F("SSID ="), WiFi.SSID(indices[i]));
+      LOGDEBUG1(F("RSSI ="), WiFi.RSSI(indices[i]));
+
+      WM_StaticString<4>  quality(getRSSIasQuality(WiFi.RSSI(indices[i])));
+      String              ssid = WiFi.SSID(indices[i]);
 
 #ifdef ESP8266
-    if (WiFi.encryptionType(indices[i]) != ENC_TYPE_NONE)
+      bool encrypted = (WiFi.encryptionType(indices[i]) != ENC_TYPE_NONE);
 #else		//ESP32
-    if (WiFi.encryptionType(indices[i]) != WIFI_AUTH_OPEN)
+      bool encrypted = (WiFi.encryptionType(indices[i]) != WIFI_AUTH_OPEN);
 #endif
-    {
-      item.replace("{i}", "true");
-    }
-    else
-    {
-      item.replace("{i}", "false");
+
+      const WM_TemplateVar item[] = { { "{v}", ssid.c_str() }, { "{r}", quality }, { "{i}", encrypted ? "true" : "false" } };
+
+      WM_printTemplate(page, JSON_ITEM, item, sizeof(item) / sizeof(item[0]));
+      delay(0);
     }
-    
-    //LOGDEBUG(item);
-    
-    page += item;
-    delay(0);
-  }
 
-  if (indices)
-  {
-    free(indices); //indices array no longer required so free memory
-  }
+    freeIndices(indices);
+
+    page.print(F("]}"));
+  });
 
-  page += F("]}");
-  
-  server->send(200, "application/json", page);
-  
   LOGDEBUG(F("Sent WiFiScan Data in Json format"));
 }
 
@@ -1797,24 +2205,27 @@ void ESP_WiFiManager::handleScan()
 /** Handle the reset page */
 void ESP_WiFiManager::handleReset()
 {
+  WM_LOG_MODULE(WM_LOG_HTTP);
+
   LOGDEBUG(F("Reset"));
+
+  if (!allowRequest(false))
+  {
+    return;
+  }
   
   server->sendHeader("Cache-Control", "no-cache, no-store, must-revalidate");
   server->sendHeader("Pragma", "no-cache");
   server->sendHeader("Expires", "-1");
   
-  String page = FPSTR(WM_HTTP_HEAD_START);
-  
-  page.replace("{v}", "WiFi Information");
-  page.replace("{pollo}", "polpettissima4");
-  page += FPSTR(WM_HTTP_SCRIPT);
-  page += FPSTR(WM_HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(WM_HTTP_HEAD_END);
-  page += F("Resetting");
-  page += FPSTR(WM_HTTP_END);
-  
-  server->send(200, "text/html", page);
+  beginPage(200, "text/html");
+
+  printPage([&](WM_ChunkedPrint& page)
+  {
+    printPageHead(page, "WiFi Information");
+    page.print(F("Resetting"));
+    page.print(FPSTR(WM_HTTP_END));
+  });
 
   LOGDEBUG(F("Sent reset page"));
   delay(5000);
@@ -1839,32 +2250,169 @@ void ESP_WiFiManager::handleReset()
 
 void ESP_WiFiManager::handleNotFound()
 {
-  if (captivePortal())
+  if (handleProbe())
   {
-    // If caprive portal redirect instead of displaying the error page.
     return;
   }
 
-  String message = "File Not Found\n\n";
+  if (!allowRequest(false))
+  {
+    return;
+  }
   
-  message += "URI: ";
-  message += server->uri();
-  message += "\nMethod: ";
-  message += (server->method() == HTTP_GET) ? "GET" : "POST";
-  message += "\nArguments: ";
-  message += server->args();
-  message += "\n";
-
-  for (uint8_t i = 0; i < server->args(); i++)
+  if (captivePortal())
   {
-    message += " " + server->argName(i) + ": " + server->arg(i) + "\n";
+    // If caprive portal redirect instead of displaying the error page.
+    return;
   }
 
   server->sendHeader("Cache-Control", "no-cache, no-store, must-revalidate");
   server->sendHeader("Pragma", "no-cache");
   server->sendHeader("Expires", "-1");
+
+  beginPage(404, "text/plain");
+
+  printPage([&](WM_ChunkedPrint& message)
+  {
+    message.print(F("File Not Found\n\n"));
+    message.print(F("URI: "));
+    message.print(server->uri());
+    message.print(F("\nMethod: "));
+    message.print((server->method() == HTTP_GET) ? F("GET") : F("POST"));
+    message.print(F("\nArguments: "));
+    message.print(server->args());
+    message.print('\n');
+
+    for (uint8_t i = 0; i < server->args(); i++)
+    {
+      message.print(' ');
+      message.print(server->argName(i));
+      message.print(F(": "));
+      message.print(server->arg(i));
+      message.print('\n');
+    }
+  });
+}
+
+//////////////////////////////////////////
+
+/**
+   Per-client rate limit
+   Return false, after sending 429 with Retry-After, if the client is over its budget.
+   Scans and saves use the expensive budget, the other pages the cheap one.
+*/
+bool ESP_WiFiManager::allowRequest(const bool& expensive)
+{
+#if USE_WM_RATE_LIMIT
+  WM_LOG_MODULE(WM_LOG_HTTP);
+
+  uint32_t retryAfter = _rateLimiter.check((uint32_t) server->client().remoteIP(), expensive, millis());
+
+  if (retryAfter == 0)
+  {
+    return true;
+  }
+
+  LOGWARN3(F("Rate limited :"), server->client().remoteIP(), F(", retry after"), retryAfter);
+
+  _metrics.rateLimited();
+
+  server->sendHeader(F("Retry-After"), String(retryAfter));
+  server->send(429, FPSTR(WM_HTTP_HEAD_CT2), F("Too Many Requests"));
+
+  return false;
+#else
+  (void) expensive;
   
-  server->send(404, "text/plain", message);
+  return true;
+#endif
+}
+
+//////////////////////////////////////////
+
+/**
+   RFC 8908 captive-portal API, advertised by DHCP option 114
+*/
+void ESP_WiFiManager::handleCaptiveAPI()
+{
+  WM_LOG_MODULE(WM_LOG_HTTP);
+
+  LOGDEBUG(F("handleCaptiveAPI"));
+  
+  server->sendHeader(FPSTR(WM_HTTP_CACHE_CONTROL), F("private"));
+  _metrics.addBytesOut(_captiveJSON.length());
+  server->setContentLength(_captiveJSON.length());
+  server->send(200, WM_CAPTIVE_API_CONTENT_TYPE, "");
+  server->sendContent(_captiveJSON.c_str(), _captiveJSON.length());
+}
+
+//////////////////////////////////////////
+
+void ESP_WiFiManager::setCaptivePortalOption(const char* apIP)
+{
+  // The DHCP server keeps the pointer, so the URI must outlive the portal
+  static char apiURI[WM_CAPTIVE_URI_MAXLEN + 1];
+
+  if (WM_buildCaptiveURI(apiURI, sizeof(apiURI), apIP) == 0)
+  {
+    LOGERROR1(F("Captive portal URI too long, IP ="), apIP);
+    
+    return;
+  }
+
+#if WM_HAS_DHCP_CAPTIVE_OPTION
+  esp_netif_t* netif = esp_netif_get_handle_from_ifkey("WIFI_AP_DEF");
+
+  if (netif)
+  {
+    // Options can only be changed while the DHCP server is stopped
+    esp_netif_dhcps_stop(netif);
+    esp_netif_dhcps_option(netif, ESP_NETIF_OP_SET, ESP_NETIF_CAPTIVEPORTAL_URI, apiURI, strlen(apiURI));
+    esp_netif_dhcps_start(netif);
+    
+    LOGWARN1(F("DHCP option 114 ="), apiURI);
+  }
+#else
+  LOGINFO1(F("DHCP option 114 not supported. API ="), apiURI);
+#endif
+}
+
+//////////////////////////////////////////
+
+/**
+   OS connectivity probes
+   Answer with the preformatted response if the URI is in WM_PROBES. Return true if it was a probe.
+*/
+bool ESP_WiFiManager::handleProbe()
+{
+  WM_LOG_MODULE(WM_LOG_HTTP);
+
+  // uri() returns by value on ESP32, keep the temporary alive
+  const String& uri = server->uri();
+
+  for (uint8_t i = 0; i < WM_NUM_PROBES; i++)
+  {
+    if (strcmp_P(uri.c_str(), (PGM_P) pgm_read_ptr(&WM_PROBES[i].path)) == 0)
+    {
+      WM_ProbeReply reply = (WM_ProbeReply) pgm_read_byte(&WM_PROBES[i].reply);
+      
+      LOGDEBUG1(F("handleProbe: "), uri);
+      
+      const char* content = (reply == WM_PROBE_READY) ? _probeReady.c_str() : _probeRedirect.c_str();
+      size_t      length  = (reply == WM_PROBE_READY) ? _probeReady.length() : _probeRedirect.length();
+
+      _metrics.setRoute(WM_ROUTE_PROBE);
+      _allocs.setRoute(WM_ROUTE_PROBE);
+      _metrics.addBytesOut(length);
+
+      server->sendContent(content, length);
+      server->client().stop();
+      
+      return true;
+    }
+  }
+
+  return false;
 }
 
 //////////////////////////////////////////
@@ -1876,13 +2424,22 @@ void ESP_WiFiManager::handleNotFound()
 */
 bool ESP_WiFiManager::captivePortal()
 {
+  WM_LOG_MODULE(WM_LOG_HTTP);
+
   LOGDEBUG1(F("captivePortal: hostHeader = "), server->hostHeader());
   
   if (!isIp(server->hostHeader()))
   {
     LOGINFO1(F("Request redirected to captive portal : "), server->client().localIP());
+
+    _metrics.setRoute(WM_ROUTE_REDIRECT);
+    _allocs.setRoute(WM_ROUTE_REDIRECT);
     
-    server->sendHeader(F("Location"), (String)F("http://") + toStringIp(server->client().localIP()), true);
+    WM_StaticString<22> location;
+
+    location += F("http://");
+    location += server->client().localIP();
+    server->sendHeader(F("Location"), location.c_str(), true);
     server->send(302, FPSTR(WM_HTTP_HEAD_CT2), ""); // Empty content inhibits Content-length header so we have to close the socket ourselves.
     server->client().stop(); // Stop is needed because we sent no content length
     
@@ -1925,13 +2482,22 @@ void ESP_WiFiManager::setRemoveDuplicateAPs(bool removeDuplicates)
 //////////////////////////////////////////
 
 //Scan for WiFiNetworks in range and sort by signal strength
-//space for indices array allocated on the heap and should be freed when no longer required
+//space for indices array allocated on the heap and should be freed when no longer required, by freeIndices()
+//With USE_WM_STATIC_MEMORY, the array is _scanIndices and only the strongest WM_STATIC_MAX_NETWORKS are kept
 int ESP_WiFiManager::scanWifiNetworks(int **indicesptr)
 {
+  WM_LOG_MODULE(WM_LOG_SCAN);
+
+  ESP_WMAllocScope allocScope(_allocs, WM_ALLOC_SCAN);
+
   LOGDEBUG(F("Scanning Network"));
 
+  unsigned long scanStart = millis();
+
   int n = WiFi.scanNetworks(false, true);
 
+  _metrics.scanDone(millis() - scanStart, n);
+
   LOGDEBUG1(F("scanWifiNetworks: Done, Scanned Networks n ="), n); 
 
   //KH, Terrible bug here. WiFi.scanNetworks() returns n < 0 => malloc( negative == very big ) => crash!!!
@@ -1947,9 +2513,14 @@ int ESP_WiFiManager::scanWifiNetworks(int **indicesptr)
   }
   else
   {
+#if USE_WM_STATIC_MEMORY
+    int* indices  = _scanIndices;
+    int  capacity = WM_STATIC_MAX_NETWORKS;
+#else
     // Allocate space off the heap for indices array.
     // This space should be freed when no longer required.
-    int* indices = (int *)malloc(n * sizeof(int));
+    int* indices  = (int *) WM_memAlloc(WM_MEM_SCAN, n * sizeof(int));
+    int  capacity = n;
 
     if (indices == NULL)
     {
@@ -1958,30 +2529,43 @@ int ESP_WiFiManager::scanWifiNetworks(int **indicesptr)
       
       return (0);
     }
+#endif
 
     *indicesptr = indices;
-   
-    //sort networks
-    for (int i = 0; i < n; i++)
-    {
-      indices[i] = i;
-    }
 
     LOGDEBUG(F("Sorting"));
 
-    // RSSI SORT
-    // old sort
+    // RSSI SORT : insertion, strongest first. When the array is full, weaker networks drop off its end
+    int count = 0;
+
     for (int i = 0; i < n; i++)
     {
-      for (int j = i + 1; j < n; j++)
+      int rssi = WiFi.RSSI(i);
+      int j    = count;
+
+      if ( (count == capacity) && (rssi <= WiFi.RSSI(indices[count - 1])) )
+        continue;
+
+      if (count < capacity)
+        count++;
+      else
+        j--;
+
+      for ( ; (j > 0) && (WiFi.RSSI(indices[j - 1]) < rssi); j--)
       {
-        if (WiFi.RSSI(indices[j]) > WiFi.RSSI(indices[i]))
-        {
-          std::swap(indices[i], indices[j]);
-        }
+        indices[j] = indices[j - 1];
       }
+
+      indices[j] = i;
+    }
+
+    if (count < n)
+    {
+      LOGWARN3(F("Scan found"), n, F("networks, kept the strongest"), count);
     }
 
+    n = count;
+
     LOGDEBUG(F("Removing Dup"));
 
     // remove duplicates ( must be RSSI sorted )
@@ -2037,6 +2621,18 @@ int ESP_WiFiManager::scanWifiNetworks(int **indicesptr)
 
 //////////////////////////////////////////
 
+void ESP_WiFiManager::freeIndices(int*& indices)
+{
+#if !USE_WM_STATIC_MEMORY
+  //indices array no longer required so free memory
+  WM_memFree(indices);
+#endif
+
+  indices = NULL;
+}
+
+//////////////////////////////////////////
+
 int ESP_WiFiManager::getRSSIasQuality(const int& RSSI)
 {
   int quality = 0;
@@ -2080,64 +2676,106 @@ bool ESP_WiFiManager::isIp(const String& str)
 /** IP to String? */
 String ESP_WiFiManager::toStringIp(const IPAddress& ip)
 {
-  String res = "";
-  
-  for (int i = 0; i < 3; i++)
+  WM_StaticString<15> res;
+
+  for (int i = 0; i < 4; i++)
   {
-    res += String((ip >> (8 * i)) & 0xFF) + ".";
-  }
+    if (i)
+      res += '.';
 
-  res += String(((ip >> 8 * 3)) & 0xFF);
+    res += ip[i];
+  }
 
-  return res;
+  return String(res.c_str());
 }
 
 //////////////////////////////////////////
 
-#ifdef ESP32
-// We can't use WiFi.SSID() in ESP32 as it's only valid after connected.
-// SSID and Password stored in ESP32 wifi_ap_record_t and wifi_config_t are also cleared in reboot
-// Have to create a new function to store in EEPROM/SPIFFS for this purpose
-
-String ESP_WiFiManager::getStoredWiFiSSID()
+void ESP_WiFiManager::WiFi_SSID(char* ssid, const size_t& size)
 {
+  ssid[0] = 0;
+
+#ifdef ESP8266
+  struct station_config conf;
+
+  wifi_station_get_config(&conf);
+
+  // 32 characters, not terminated when all are used
+  snprintf(ssid, size, "%.*s", (int) sizeof(conf.ssid), reinterpret_cast<char*>(conf.ssid));
+#else		//ESP32
   if (WiFi.getMode() == WIFI_MODE_NULL)
   {
-    return String();
+    return;
   }
 
   wifi_ap_record_t info;
 
   if (!esp_wifi_sta_get_ap_info(&info))
   {
-    return String(reinterpret_cast<char*>(info.ssid));
+    snprintf(ssid, size, "%.*s", (int) sizeof(info.ssid), reinterpret_cast<char*>(info.ssid));
   }
   else
   {
     wifi_config_t conf;
-    
+
     esp_wifi_get_config(WIFI_IF_STA, &conf);
-    
-    return String(reinterpret_cast<char*>(conf.sta.ssid));
-  }
 
-  return String();
+    snprintf(ssid, size, "%.*s", (int) sizeof(conf.sta.ssid), reinterpret_cast<char*>(conf.sta.ssid));
+  }
+#endif
 }
 
 //////////////////////////////////////////
 
-String ESP_WiFiManager::getStoredWiFiPass()
+void ESP_WiFiManager::WiFi_Pass(char* pass, const size_t& size)
 {
+  pass[0] = 0;
+
+#ifdef ESP8266
+  struct station_config conf;
+
+  wifi_station_get_config(&conf);
+
+  snprintf(pass, size, "%.*s", (int) sizeof(conf.password), reinterpret_cast<char*>(conf.password));
+#else		//ESP32
   if (WiFi.getMode() == WIFI_MODE_NULL)
   {
-    return String();
+    return;
   }
 
   wifi_config_t conf;
-  
+
   esp_wifi_get_config(WIFI_IF_STA, &conf);
-  
-  return String(reinterpret_cast<char*>(conf.sta.password));
+
+  snprintf(pass, size, "%.*s", (int) sizeof(conf.sta.password), reinterpret_cast<char*>(conf.sta.password));
+#endif
+}
+
+//////////////////////////////////////////
+
+#ifdef ESP32
+// We can't use WiFi.SSID() in ESP32 as it's only valid after connected.
+// SSID and Password stored in ESP32 wifi_ap_record_t and wifi_config_t are also cleared in reboot
+// Have to create a new function to store in EEPROM/SPIFFS for this purpose
+
+String ESP_WiFiManager::getStoredWiFiSSID()
+{
+  char ssid[33];
+
+  WiFi_SSID(ssid, sizeof(ssid));
+
+  return String(ssid);
+}
+
+//////////////////////////////////////////
+
+String ESP_WiFiManager::getStoredWiFiPass()
+{
+  char pass[65];
+
+  WiFi_Pass(pass, sizeof(pass));
+
+  return String(pass);
 }
 
 //////////////////////////////////////////
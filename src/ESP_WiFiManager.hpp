@@ -166,6 +166,99 @@ typedef struct
 
 ////////////////////////////////////////////////////
 
+// Use the library's captive DNS responder instead of the core DNSServer in the Config Portal
+#if !defined(USE_WM_CAPTIVE_DNS)
+  #define USE_WM_CAPTIVE_DNS          true
+#endif
+
+#if USE_WM_CAPTIVE_DNS
+  #include "utils/WM_CaptiveDNS.h"
+  
+  typedef ESP_WMCaptiveDNS    WM_DNSServer;
+#else
+  #if (_WIFIMGR_LOGLEVEL_ > 3)
+    #warning Using core DNSServer in Config Portal
+  #endif
+  
+  typedef DNSServer           WM_DNSServer;
+#endif
+
+////////////////////////////////////////////////////
+
+#include "utils/WM_CaptivePortalAPI.h"
+
+////////////////////////////////////////////////////
+
+// Per-client rate limiting of the Config Portal pages, opt-in. Excess requests get 429 with Retry-After
+#if !defined(USE_WM_RATE_LIMIT)
+  #define USE_WM_RATE_LIMIT           false
+#endif
+
+#if USE_WM_RATE_LIMIT
+  #include "utils/WM_RateLimiter.h"
+#endif
+
+////////////////////////////////////////////////////
+
+// Config Portal metrics (per route latency, bytes, DNS, scans, connections, heap) at /metrics
+#if !defined(USE_WM_METRICS)
+  #define USE_WM_METRICS              false
+#endif
+
+#include "utils/WM_StaticString.h"
+#include "utils/WM_Metrics.h"
+
+// Heap operations per Config Portal request and per scan / connect / save, printed on Serial
+#if !defined(USE_WM_ALLOC_TRACKING)
+  #define USE_WM_ALLOC_TRACKING       false
+#endif
+
+#include "utils/WM_AllocTracker.h"
+
+// No heap for the manager's own storage : web and DNS servers, parameter values, scan results and probe
+// replies are reserved at build time, sized by WIFI_MANAGER_MAX_PARAMS, WM_STATIC_PARAM_POOL and
+// WM_STATIC_MAX_NETWORKS. Declare the manager as a global : it then holds them.
+#if !defined(USE_WM_STATIC_MEMORY)
+  #define USE_WM_STATIC_MEMORY        false
+#endif
+
+#if USE_WM_STATIC_MEMORY
+  #include "utils/WM_StaticMemory.h"
+
+  #if !USE_WM_CAPTIVE_DNS
+    #warning USE_WM_STATIC_MEMORY : the core DNSServer allocates each packet, use USE_WM_CAPTIVE_DNS
+  #endif
+#endif
+
+// PSRAM or internal RAM for the page chunk, scan results and parameter values, see WM_MEM_*_PLACEMENT.
+// Not used by USE_WM_STATIC_MEMORY.
+#include "utils/WM_Memory.h"
+
+// ETag, 304 and Range for the files a sketch serves from its own web server : WM_streamFile()
+#include "utils/WM_StreamFile.h"
+
+// DHCP option 114 can only be set through esp_netif from ESP-IDF v5.1 (core v3.0.0+)
+#if ( defined(ESP32) && defined(__has_include) )
+  #if __has_include(<esp_idf_version.h>)
+    #include <esp_idf_version.h>
+  #endif
+#endif
+
+#if ( defined(ESP32) && defined(ESP_IDF_VERSION_MAJOR) && \
+      ( (ESP_IDF_VERSION_MAJOR > 5) || ( (ESP_IDF_VERSION_MAJOR == 5) && (ESP_IDF_VERSION_MINOR >= 1) ) ) )
+  #include <esp_netif.h>
+  
+  #define WM_HAS_DHCP_CAPTIVE_OPTION      true
+#else
+  #if (_WIFIMGR_LOGLEVEL_ > 3)
+    #warning DHCP option 114 not supported by this core. Captive portal relies on DNS and probe redirects
+  #endif
+  
+  #define WM_HAS_DHCP_CAPTIVE_OPTION      false
+#endif
+
+////////////////////////////////////////////////////
+
 typedef struct
 {
   IPAddress _sta_static_ip;
@@ -224,6 +317,7 @@ const char WM_HTTP_SCRIPT[] PROGMEM = "<script>function c(l){document.getElement
 #if USE_ESP_WIFIMANAGER_NTP
 
 #include "utils/TZ.h"
+#include "utils/WM_TimeZone.h"
 
 const char WM_HTTP_SCRIPT_NTP_MSG[] PROGMEM = "<p style='display: none;'>Your Timezone is : <b><label id='timezone' name='timezone'></b><script>document.getElementById('timezone').innerHTML=timezone.name();document.getElementById('timezone').value=timezone.name();</script></p>";
 const char WM_HTTP_SCRIPT_NTP_HIDDEN[] PROGMEM = "<p><input type='hidden' id='timezone' name='timezone'><script>document.getElementById('timezone').innerHTML=timezone.name();document.getElementById('timezone').value=timezone.name();</script></p>";
@@ -256,6 +350,23 @@ const char WM_HTTP_SCRIPT_NTP[] PROGMEM = "<script>(function(e){var t=function()
   const char WM_HTTP_SCRIPT_NTP[]         PROGMEM   = "";
 #endif
 
+////////////////////////////////////////////////////
+
+// SNTP sync as soon as the manager gets connected, and clock restored from RTC memory after deep sleep
+#if !defined(USE_WM_SNTP)
+  #define USE_WM_SNTP                 USE_ESP_WIFIMANAGER_NTP
+#endif
+
+// By default the sync is only started on connect, and done by sntp().loop(). true waits for it there, up to
+// about a second, for sketches that don't call sntp().loop()
+#if !defined(WM_SNTP_SYNC_ON_CONNECT)
+  #define WM_SNTP_SYNC_ON_CONNECT     false
+#endif
+
+#if USE_WM_SNTP
+  #include "utils/WM_SNTP.h"
+#endif
+
 ////////////////////////////////////////////////////
 ////////////////////////////////////////////////////
 
@@ -333,8 +444,61 @@ const char WM_HTTP_AVAILABLE_PAGES[] PROGMEM = "<h3>Available Pages</h3><table c
 const char WM_HTTP_AVAILABLE_PAGES[] PROGMEM = "";
 #endif
 
+////////////////////////////////////////////////////
+
+// Connectivity probes the OSes send while associated. They are matched by exact path in handleNotFound()
+// and answered with a response preformatted once per portal, so probe storms cost no String building.
+typedef enum
+{
+  WM_PROBE_REDIRECT = 0,      // 302 to the portal
+  WM_PROBE_READY              // 200 page pointing to the portal, for clients that show the page itself
+} WM_ProbeReply;
+
+typedef struct
+{
+  const char*   path;
+  WM_ProbeReply reply;
+} WM_Probe;
+
+const char WM_PROBE_ANDROID[]       PROGMEM = "/generate_204";
+const char WM_PROBE_ANDROID2[]      PROGMEM = "/gen_204";
+const char WM_PROBE_APPLE[]         PROGMEM = "/hotspot-detect.html";
+const char WM_PROBE_APPLE2[]        PROGMEM = "/library/test/success.html";
+const char WM_PROBE_WINDOWS[]       PROGMEM = "/connecttest.txt";
+const char WM_PROBE_WINDOWS2[]      PROGMEM = "/ncsi.txt";
+const char WM_PROBE_WINDOWS3[]      PROGMEM = "/redirect";
+const char WM_PROBE_WINDOWS4[]      PROGMEM = "/fwlink";
+const char WM_PROBE_FIREFOX[]       PROGMEM = "/success.txt";
+const char WM_PROBE_FIREFOX2[]      PROGMEM = "/canonical.html";
+
+const WM_Probe WM_PROBES[] PROGMEM =
+{
+  { WM_PROBE_ANDROID,   WM_PROBE_REDIRECT },
+  { WM_PROBE_ANDROID2,  WM_PROBE_REDIRECT },
+  { WM_PROBE_APPLE,     WM_PROBE_READY    },
+  { WM_PROBE_APPLE2,    WM_PROBE_READY    },
+  { WM_PROBE_WINDOWS,   WM_PROBE_REDIRECT },
+  { WM_PROBE_WINDOWS2,  WM_PROBE_REDIRECT },
+  { WM_PROBE_WINDOWS3,  WM_PROBE_REDIRECT },
+  { WM_PROBE_WINDOWS4,  WM_PROBE_REDIRECT },
+  { WM_PROBE_FIREFOX,   WM_PROBE_REDIRECT },
+  { WM_PROBE_FIREFOX2,  WM_PROBE_REDIRECT },
+};
+
+#define WM_NUM_PROBES     ( sizeof(WM_PROBES) / sizeof(WM_PROBES[0]) )
+
+// {u} is replaced by the portal URL, {l} by the body length
+const char WM_PROBE_REDIRECT_RESP[] PROGMEM = "HTTP/1.1 302 Found\r\nLocation: {u}\r\nCache-Control: no-cache, no-store, must-revalidate\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+const char WM_PROBE_READY_HEAD[]    PROGMEM = "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\nCache-Control: no-cache, no-store, must-revalidate\r\nContent-Length: {l}\r\nConnection: close\r\n\r\n";
+const char WM_PROBE_READY_BODY[]    PROGMEM = "<html><head><meta http-equiv='refresh' content='0;url={u}'></head><body><a href='{u}'>Portal ready</a></body></html>";
+
+// {u} : "http://" + the AP IP + "/"
+#define WM_PORTAL_URL_MAXLEN      23
+
 //KH
-#define WIFI_MANAGER_MAX_PARAMS 20
+#ifndef WIFI_MANAGER_MAX_PARAMS
+  #define WIFI_MANAGER_MAX_PARAMS 20
+#endif
 
 ////////////////////////////////////////////////////
 
@@ -386,9 +550,32 @@ class ESP_WMParameter
 
 ////////////////////////////////////////////////////
 
-#define USE_DYNAMIC_PARAMS				true
+// The parameter list grows by WIFI_MANAGER_MAX_PARAMS on the heap, or holds WIFI_MANAGER_MAX_PARAMS at most
+#if USE_WM_STATIC_MEMORY
+  #define USE_DYNAMIC_PARAMS      false
+#else
+  #define USE_DYNAMIC_PARAMS      true
+#endif
+
 #define DEFAULT_PORTAL_TIMEOUT  	60000L
 
+// Port of the portal's DNS server. Only worth changing for tests, clients always ask port 53.
+#ifndef WM_DNS_PORT
+  #define WM_DNS_PORT               53
+#endif
+
+// Longest the portal loop sleeps waiting for socket activity (WebServer with waitForActivity() only), when the
+// portal has no timeout. HTTP traffic, DNS queries and client deadlines end the sleep sooner.
+#ifndef WM_PORTAL_IDLE_SLEEP_MS
+  #define WM_PORTAL_IDLE_SLEEP_MS   60000
+#endif
+
+// Same, when the DNS server has no socket to wait on (ESP8266, the core DNSServer) : it is polled between
+// sleeps, so this bounds DNS latency.
+#ifndef WM_PORTAL_MAX_SLEEP_MS
+  #define WM_PORTAL_MAX_SLEEP_MS    10
+#endif
+
 // From v1.0.10 to permit disable/enable StaticIP configuration in Config Portal from sketch. Valid only if DHCP is used.
 // You have to explicitly specify false to disable the feature.
 #ifndef USE_STATIC_IP_CONFIG_IN_CP
@@ -463,13 +650,8 @@ class ESP_WiFiManager
     //called when settings have been changed and connection was successful
     void          setSaveConfigCallback(void(*func)());
 
-#if USE_DYNAMIC_PARAMS
-    //adds a custom parameter
+    //adds a custom parameter, false if there's no room
     bool 				  addParameter(ESP_WMParameter *p);
-#else
-    //adds a custom parameter
-    void 				  addParameter(ESP_WMParameter *p);
-#endif
 
     //if this is set, it will exit after config, even if connection is unsucessful.
     void          setBreakAfterConfig(bool shouldBreak);
@@ -484,6 +666,7 @@ class ESP_WiFiManager
     
     //Scan for WiFiNetworks in range and sort by signal strength
     //space for indices array allocated on the heap and should be freed when no longer required
+    //With USE_WM_STATIC_MEMORY, the array belongs to the manager : not to be freed, and valid until the next scan
     int           scanWifiNetworks(int **indicesptr);
 
 ////////////////////////////////////////////////////
@@ -603,6 +786,10 @@ class ESP_WiFiManager
 #endif
     }
 
+    // Same, into a buffer of size bytes (33 and 65 hold any), without the heap
+    void          WiFi_SSID(char* ssid, const size_t& size);
+    void          WiFi_Pass(char* pass, const size_t& size);
+
     void setHostname()
     {
       if (RFC952_hostname[0] != 0)
@@ -655,16 +842,13 @@ class ESP_WiFiManager
     // .1 is the first occurrence of the day in the month
     // .0 is Sunday   
     
+    // Exact name match, binary search in the PROGMEM database of utils/TZ.h.
+    // The rule is copied to RAM, valid until the next call.
     const char * getTZ(const char * timezoneName)
     {               
-      //const char TZ_NAME[][TIMEZONE_MAX_LEN]
-      for (uint16_t index = 0; index < sizeof(TZ_NAME) / TIMEZONE_MAX_LEN; index++)
+      if (WM_findTZRule(timezoneName, _TZ_rule, sizeof(_TZ_rule)))
       {
-        if ( !strncmp(timezoneName, (TZ_NAME[index]), strlen((TZ_NAME[index])) ) )
-        {
-          yield();
-          return (ESP_TZ_NAME[index]);            
-        }    
+        return _TZ_rule;
       }
       
       return "";      
@@ -675,26 +859,111 @@ class ESP_WiFiManager
     {
       return getTZ(timezoneName.c_str());      
     }
+
+    // Compiled form of getTZ(timezoneName), for fast UTC <-> local time conversions without setenv() / tzset()
+    bool getTimeZone(const char * timezoneName, ESP_WMTimeZone& timeZone)
+    {
+      return timeZone.begin(getTZ(timezoneName));
+    }
 #endif    
 
+////////////////////////////////////////////////////
+
+    // Run time log level of a module (WM_LOG_SCAN, ...), or of all of them with WM_LOG_MODULES.
+    // Capped to WIFIMGR_LOGLEVEL_MAX. Also settable from the Config Portal : /loglevel?scan=4&http=0
+    inline void setLogLevel(const uint8_t& module, const uint8_t& level)
+    {
+      WM_setLogLevel(module, level);
+    }
+
+    inline uint8_t getLogLevel(const uint8_t& module)
+    {
+      return WM_getLogLevel(module);
+    }
+
+////////////////////////////////////////////////////
+
+#if USE_WM_METRICS
+    // Counters served at /metrics. Sketches can also feed them, e.g. addBytesOut() from their own routes
+    inline ESP_WMMetrics& metrics()
+    {
+      return _metrics;
+    }
+#endif
+
+#if USE_WM_ALLOC_TRACKING
+    // Allocations per route and operation : allocTracker().printTable(Serial), setOutput(nullptr) for no rows
+    inline ESP_WMAllocTracker& allocTracker()
+    {
+      return _allocs;
+    }
+#endif
+
+////////////////////////////////////////////////////
+
+#if USE_WM_SNTP
+    // SNTP client started by connectWifi() / autoConnect(). One for the program, shared by all managers and
+    // outliving them : call ESP_WiFiManager::sntp().loop() in loop() for the sync and the periodic ones,
+    // or sntp().setServer() to use other servers.
+    static ESP_WMSNTP& sntp()
+    {
+      static ESP_WMSNTP client;
+
+      return client;
+    }
+
+    // Called once time is valid, from a sync or restored after deep sleep
+    inline void setTimeValidCallback(WM_TimeValidCallback func)
+    {
+      sntp().setTimeValidCallback(func);
+    }
+
+    inline bool timeValid()
+    {
+      return sntp().isValid();
+    }
+#endif
+
 ////////////////////////////////////////////////////
 
   private:
-    std::unique_ptr<DNSServer>        dnsServer;
+
+#if defined(WM_HOST)
+    // Host build : drives connectWifi() / reconnectWifi() against the simulated radio, see linux/bench,
+    // and feeds handleWifiSave() / isIp() fuzzed input, see linux/fuzz
+    friend class WM_HostConnectBench;
+    friend class WM_HostFuzz;
+#endif
+
+#if USE_WM_STATIC_MEMORY
+    WM_InPlace<WM_DNSServer>          dnsServer;
+
+  #ifdef ESP8266
+    WM_InPlace<ESP8266WebServer>      server;
+  #else		//ESP32
+    WM_InPlace<WebServer>             server;
+  #endif
+#else
+    std::unique_ptr<WM_DNSServer>     dnsServer;
 
     //KH, for ESP32
-#ifdef ESP8266
+  #ifdef ESP8266
     std::unique_ptr<ESP8266WebServer> server;
-#else		//ESP32
+  #else		//ESP32
     std::unique_ptr<WebServer>        server;
+  #endif
 #endif
 
+    // WM_PSRAM_CHUNK_SIZE bytes of PSRAM while the portal runs, else nullptr : pages use their own chunk
+    char*         _pageBuf = nullptr;
+
 #define RFC952_HOSTNAME_MAXLEN      24
     char RFC952_hostname[RFC952_HOSTNAME_MAXLEN + 1];
 
     char* getRFC952_hostname(const char* iHostname);
 
     void          setupConfigPortal();
+    void          waitForPortalActivity();
     void          startWPS();
     //const char*   getStatus(const int& status);
 
@@ -712,6 +981,7 @@ class ESP_WiFiManager
 #if USE_ESP_WIFIMANAGER_NTP
     // Timezone info
     String        _timezoneName         = "";
+    char          _TZ_rule[WM_TZ_RULE_MAX_LEN + 1];
 #endif
 
     ////////////////////////////////////////////////////
@@ -723,6 +993,12 @@ class ESP_WiFiManager
 
     int           numberOfNetworks;
     int           *networkIndices;
+
+#if USE_WM_STATIC_MEMORY
+    int           _scanIndices[WM_STATIC_MAX_NETWORKS];
+#endif
+
+    void          freeIndices(int*& indices);
     
     // KH, To enable dynamic/random channel
     // default to channel 1
@@ -765,15 +1041,64 @@ class ESP_WiFiManager
     void          handleServerClose();
     void          handleInfo();
     void          handleState();
+    void          handleLogLevel();
+    void          handleMetrics();
     void          handleScan();
     void          handleReset();
     void          handleNotFound();
+    bool          handleProbe();
     bool          captivePortal();
+
+    // Runs the handler of a route, measured by _metrics and _allocs
+    void          handleRoute(const uint8_t& route, void (ESP_WiFiManager::*handler)());
+
+    // Preformatted probe responses, built in setupConfigPortal()
+#if USE_WM_STATIC_MEMORY
+    WM_StaticString<sizeof(WM_PROBE_REDIRECT_RESP) + WM_PORTAL_URL_MAXLEN>                            _probeRedirect;
+    WM_StaticString<sizeof(WM_PROBE_READY_HEAD) + 5 + sizeof(WM_PROBE_READY_BODY) + 2 * WM_PORTAL_URL_MAXLEN> _probeReady;
+#else
+    String        _probeRedirect;
+    String        _probeReady;
+#endif
+
+    // Per route counters and heap use, see metrics() and /metrics
+    ESP_WMMetrics       _metrics;
+    ESP_WMAllocTracker  _allocs;
+
+#if USE_WM_RATE_LIMIT
+    ESP_WMRateLimiter   _rateLimiter;
+#endif
+
+    bool          allowRequest(const bool& expensive);
+
+    // RFC 8908 API response, built in setupConfigPortal()
+#if USE_WM_STATIC_MEMORY
+    WM_StaticString<WM_CAPTIVE_URI_MAXLEN + 64> _captiveJSON;
+#else
+    String        _captiveJSON;
+#endif
+
+    void          handleCaptiveAPI();
+    void          setCaptivePortalOption(const char* apIP);
+
+    void          syncTime();
     
-    void          reportStatus(String& page);
+    void          reportStatus(Print& page);
+
+    // Streamed pages : the body goes out in WM_CHUNK_SIZE chunks as it is printed, not built in a String
+    WM_ChunkedPrint::Sender pageSender();
+    void          beginPage(const int& code, const char* contentType);
+    void          printPageHead(Print& page, const char* title, const bool& ntpScript = false);
+    void          endPage(WM_ChunkedPrint& page);
+
+    // The handlers' [&] lambdas, referenced, not copied to the heap as std::function would
+    typedef WM_FunctionRef<void(WM_ChunkedPrint& page)> PageBody;
+
+    void          printPage(const PageBody& body);
+    void          printStackPage(const PageBody& body) __attribute__((noinline));
 
     // DNS server
-    const byte    DNS_PORT = 53;
+    const uint16_t DNS_PORT = WM_DNS_PORT;
 
     //helpers
     int           getRSSIasQuality(const int& RSSI);
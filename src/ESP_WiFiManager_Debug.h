@@ -57,6 +57,94 @@
   #define _WIFIMGR_LOGLEVEL_       0
 #endif
 
+// _WIFIMGR_LOGLEVEL_ is the level every module starts with. It can be changed at run time, per module, with
+// WM_setLogLevel() or the Config Portal /loglevel page, up to WIFIMGR_LOGLEVEL_MAX : the levels compiled in.
+// Set WIFIMGR_LOGLEVEL_MAX to 4 to be able to trace in the field a firmware built silent.
+#ifndef WIFIMGR_LOGLEVEL_MAX
+  #define WIFIMGR_LOGLEVEL_MAX     _WIFIMGR_LOGLEVEL_
+#endif
+
+//////////////////////////////////////////
+
+#include <Arduino.h>
+
+#include "utils/WM_NameList.h"
+
+// Modules, with their own log level
+enum WM_LogModule : uint8_t
+{
+  WM_LOG_CORE = 0,
+  WM_LOG_SCAN,
+  WM_LOG_CONNECT,
+  WM_LOG_HTTP,
+  WM_LOG_DNS,
+  WM_LOG_PARAMS,
+  WM_LOG_STORAGE,
+  WM_LOG_MODULES
+};
+
+// Names of the modules, in enum order, for the /loglevel page
+const char WM_LOG_MODULE_NAMES[] PROGMEM = "core\0scan\0connect\0http\0dns\0params\0storage\0";
+
+// Module of the LOGxxx calls in a function (or block) : WM_LOG_MODULE(WM_LOG_SCAN);
+// Everywhere else, WM_LOG_CORE.
+#define WM_LOG_MODULE(module)     const uint8_t WM_logModule = module
+
+static const uint8_t WM_logModule = WM_LOG_CORE;
+
+// Current level of each module, shared by every translation unit
+inline uint8_t* WM_logLevels()
+{
+  static uint8_t levels[WM_LOG_MODULES] =
+  {
+    _WIFIMGR_LOGLEVEL_, _WIFIMGR_LOGLEVEL_, _WIFIMGR_LOGLEVEL_, _WIFIMGR_LOGLEVEL_,
+    _WIFIMGR_LOGLEVEL_, _WIFIMGR_LOGLEVEL_, _WIFIMGR_LOGLEVEL_
+  };
+
+  return levels;
+}
+
+// Level n messages of the current module are on. Folds to false when n isn't compiled in.
+#define WM_LOG_ON(n)      ( (WIFIMGR_LOGLEVEL_MAX > n) && (WM_logLevels()[WM_logModule] > n) )
+
+// WM_LOG_MODULES : all modules. Level is capped to WIFIMGR_LOGLEVEL_MAX.
+inline void WM_setLogLevel(const uint8_t& module, uint8_t level)
+{
+  if (level > WIFIMGR_LOGLEVEL_MAX)
+    level = WIFIMGR_LOGLEVEL_MAX;
+
+  for (uint8_t i = 0; i < WM_LOG_MODULES; i++)
+  {
+    if ( (module == i) || (module == WM_LOG_MODULES) )
+      WM_logLevels()[i] = level;
+  }
+}
+
+inline uint8_t WM_getLogLevel(const uint8_t& module)
+{
+  return (module < WM_LOG_MODULES) ? WM_logLevels()[module] : 0;
+}
+
+inline const char* WM_logModuleName(const uint8_t& module)
+{
+  return WM_listName(WM_LOG_MODULE_NAMES, module);
+}
+
+// Module by name, "all" for WM_LOG_MODULES, -1 if unknown
+inline int WM_logModuleByName(const char* name)
+{
+  if (!strcmp(name, "all"))
+    return WM_LOG_MODULES;
+
+  for (uint8_t i = 0; i < WM_LOG_MODULES; i++)
+  {
+    if (!strcmp_P(name, WM_logModuleName(i)))
+      return i;
+  }
+
+  return -1;
+}
+
 //////////////////////////////////////////
 
 const char WM_MARK[] = "[WM] ";
@@ -68,37 +156,81 @@ const char WM_SP[]   = " ";
 #define WM_PRINT_MARK   WM_PRINT(WM_MARK)
 #define WM_PRINT_SP     WM_PRINT(WM_SP)
 
+// Set WIFIMGR_DEFERRED_LOG to true to keep Serial off the hot path : LOGxxx calls are queued as compact
+// binary records and written to WM_DBG_PORT in the background. See utils/WM_DeferredLog.h
+#ifndef WIFIMGR_DEFERRED_LOG
+  #define WIFIMGR_DEFERRED_LOG     false
+#endif
+
+////////////////////////////////////////////////////
+
+#if WIFIMGR_DEFERRED_LOG
+
+#include "utils/WM_DeferredLog.h"
+
+#define WM_LOG_LINE_FLAGS   (WM_LOG_MARK | WM_LOG_NEWLINE)
+
+#define LOGERROR(x)         if(WM_LOG_ON(0)) WM_LOG_DEFER(1, WM_LOG_LINE_FLAGS, x)
+#define LOGERROR0(x)        if(WM_LOG_ON(0)) WM_LOG_DEFER(1, 0, x)
+#define LOGERROR1(x,y)      if(WM_LOG_ON(0)) WM_LOG_DEFER(1, WM_LOG_LINE_FLAGS, x, y)
+#define LOGERROR2(x,y,z)    if(WM_LOG_ON(0)) WM_LOG_DEFER(1, WM_LOG_LINE_FLAGS, x, y, z)
+#define LOGERROR3(x,y,z,w)  if(WM_LOG_ON(0)) WM_LOG_DEFER(1, WM_LOG_LINE_FLAGS, x, y, z, w)
+
+#define LOGWARN(x)          if(WM_LOG_ON(1)) WM_LOG_DEFER(2, WM_LOG_LINE_FLAGS, x)
+#define LOGWARN0(x)         if(WM_LOG_ON(1)) WM_LOG_DEFER(2, 0, x)
+#define LOGWARN1(x,y)       if(WM_LOG_ON(1)) WM_LOG_DEFER(2, WM_LOG_LINE_FLAGS, x, y)
+#define LOGWARN2(x,y,z)     if(WM_LOG_ON(1)) WM_LOG_DEFER(2, WM_LOG_LINE_FLAGS, x, y, z)
+#define LOGWARN3(x,y,z,w)   if(WM_LOG_ON(1)) WM_LOG_DEFER(2, WM_LOG_LINE_FLAGS, x, y, z, w)
+
+#define LOGINFO(x)          if(WM_LOG_ON(2)) WM_LOG_DEFER(3, WM_LOG_LINE_FLAGS, x)
+#define LOGINFO0(x)         if(WM_LOG_ON(2)) WM_LOG_DEFER(3, 0, x)
+#define LOGINFO1(x,y)       if(WM_LOG_ON(2)) WM_LOG_DEFER(3, WM_LOG_LINE_FLAGS, x, y)
+#define LOGINFO2(x,y,z)     if(WM_LOG_ON(2)) WM_LOG_DEFER(3, WM_LOG_LINE_FLAGS, x, y, z)
+#define LOGINFO3(x,y,z,w)   if(WM_LOG_ON(2)) WM_LOG_DEFER(3, WM_LOG_LINE_FLAGS, x, y, z, w)
+
+#define LOGDEBUG(x)         if(WM_LOG_ON(3)) WM_LOG_DEFER(4, WM_LOG_LINE_FLAGS, x)
+#define LOGDEBUG0(x)        if(WM_LOG_ON(3)) WM_LOG_DEFER(4, 0, x)
+#define LOGDEBUG1(x,y)      if(WM_LOG_ON(3)) WM_LOG_DEFER(4, WM_LOG_LINE_FLAGS, x, y)
+#define LOGDEBUG2(x,y,z)    if(WM_LOG_ON(3)) WM_LOG_DEFER(4, WM_LOG_LINE_FLAGS, x, y, z)
+#define LOGDEBUG3(x,y,z,w)  if(WM_LOG_ON(3)) WM_LOG_DEFER(4, WM_LOG_LINE_FLAGS, x, y, z, w)
+
+#else   // WIFIMGR_DEFERRED_LOG
+
+////////////////////////////////////////////////////
+
+#define LOGERROR(x)         if(WM_LOG_ON(0)) { WM_PRINT_MARK; WM_PRINTLN(x); }
+#define LOGERROR0(x)        if(WM_LOG_ON(0)) { WM_PRINT(x); }
+#define LOGERROR1(x,y)      if(WM_LOG_ON(0)) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINTLN(y); }
+#define LOGERROR2(x,y,z)    if(WM_LOG_ON(0)) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINT(y); WM_PRINT_SP; WM_PRINTLN(z); }
+#define LOGERROR3(x,y,z,w)  if(WM_LOG_ON(0)) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINT(y); WM_PRINT_SP; WM_PRINT(z); WM_PRINT_SP; WM_PRINTLN(w); }
+
 ////////////////////////////////////////////////////
 
-#define LOGERROR(x)         if(_WIFIMGR_LOGLEVEL_>0) { WM_PRINT_MARK; WM_PRINTLN(x); }
-#define LOGERROR0(x)        if(_WIFIMGR_LOGLEVEL_>0) { WM_PRINT(x); }
-#define LOGERROR1(x,y)      if(_WIFIMGR_LOGLEVEL_>0) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINTLN(y); }
-#define LOGERROR2(x,y,z)    if(_WIFIMGR_LOGLEVEL_>0) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINT(y); WM_PRINT_SP; WM_PRINTLN(z); }
-#define LOGERROR3(x,y,z,w)  if(_WIFIMGR_LOGLEVEL_>0) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINT(y); WM_PRINT_SP; WM_PRINT(z); WM_PRINT_SP; WM_PRINTLN(w); }
+#define LOGWARN(x)          if(WM_LOG_ON(1)) { WM_PRINT_MARK; WM_PRINTLN(x); }
+#define LOGWARN0(x)         if(WM_LOG_ON(1)) { WM_PRINT(x); }
+#define LOGWARN1(x,y)       if(WM_LOG_ON(1)) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINTLN(y); }
+#define LOGWARN2(x,y,z)     if(WM_LOG_ON(1)) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINT(y); WM_PRINT_SP; WM_PRINTLN(z); }
+#define LOGWARN3(x,y,z,w)   if(WM_LOG_ON(1)) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINT(y); WM_PRINT_SP; WM_PRINT(z); WM_PRINT_SP; WM_PRINTLN(w); }
 
 ////////////////////////////////////////////////////
 
-#define LOGWARN(x)          if(_WIFIMGR_LOGLEVEL_>1) { WM_PRINT_MARK; WM_PRINTLN(x); }
-#define LOGWARN0(x)         if(_WIFIMGR_LOGLEVEL_>1) { WM_PRINT(x); }
-#define LOGWARN1(x,y)       if(_WIFIMGR_LOGLEVEL_>1) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINTLN(y); }
-#define LOGWARN2(x,y,z)     if(_WIFIMGR_LOGLEVEL_>1) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINT(y); WM_PRINT_SP; WM_PRINTLN(z); }
-#define LOGWARN3(x,y,z,w)   if(_WIFIMGR_LOGLEVEL_>1) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINT(y); WM_PRINT_SP; WM_PRINT(z); WM_PRINT_SP; WM_PRINTLN(w); }
+#define LOGINFO(x)          if(WM_LOG_ON(2)) { WM_PRINT_MARK; WM_PRINTLN(x); }
+#define LOGINFO0(x)         if(WM_LOG_ON(2)) { WM_PRINT(x); }
+#define LOGINFO1(x,y)       if(WM_LOG_ON(2)) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINTLN(y); }
+#define LOGINFO2(x,y,z)     if(WM_LOG_ON(2)) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINT(y); WM_PRINT_SP; WM_PRINTLN(z); }
+#define LOGINFO3(x,y,z,w)   if(WM_LOG_ON(2)) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINT(y); WM_PRINT_SP; WM_PRINT(z); WM_PRINT_SP; WM_PRINTLN(w); }
 
 ////////////////////////////////////////////////////
 
-#define LOGINFO(x)          if(_WIFIMGR_LOGLEVEL_>2) { WM_PRINT_MARK; WM_PRINTLN(x); }
-#define LOGINFO0(x)         if(_WIFIMGR_LOGLEVEL_>2) { WM_PRINT(x); }
-#define LOGINFO1(x,y)       if(_WIFIMGR_LOGLEVEL_>2) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINTLN(y); }
-#define LOGINFO2(x,y,z)     if(_WIFIMGR_LOGLEVEL_>2) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINT(y); WM_PRINT_SP; WM_PRINTLN(z); }
-#define LOGINFO3(x,y,z,w)   if(_WIFIMGR_LOGLEVEL_>2) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINT(y); WM_PRINT_SP; WM_PRINT(z); WM_PRINT_SP; WM_PRINTLN(w); }
+#define LOGDEBUG(x)         if(WM_LOG_ON(3)) { WM_PRINT_MARK; WM_PRINTLN(x); }
+#define LOGDEBUG0(x)        if(WM_LOG_ON(3)) { WM_PRINT(x); }
+#define LOGDEBUG1(x,y)      if(WM_LOG_ON(3)) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINTLN(y); }
+#define LOGDEBUG2(x,y,z)    if(WM_LOG_ON(3)) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINT(y); WM_PRINT_SP; WM_PRINTLN(z); }
+#define LOGDEBUG3(x,y,z,w)  if(WM_LOG_ON(3)) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINT(y); WM_PRINT_SP; WM_PRINT(z); WM_PRINT_SP; WM_PRINTLN(w); }
 
 ////////////////////////////////////////////////////
 
-#define LOGDEBUG(x)         if(_WIFIMGR_LOGLEVEL_>3) { WM_PRINT_MARK; WM_PRINTLN(x); }
-#define LOGDEBUG0(x)        if(_WIFIMGR_LOGLEVEL_>3) { WM_PRINT(x); }
-#define LOGDEBUG1(x,y)      if(_WIFIMGR_LOGLEVEL_>3) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINTLN(y); }
-#define LOGDEBUG2(x,y,z)    if(_WIFIMGR_LOGLEVEL_>3) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINT(y); WM_PRINT_SP; WM_PRINTLN(z); }
-#define LOGDEBUG3(x,y,z,w)  if(_WIFIMGR_LOGLEVEL_>3) { WM_PRINT_MARK; WM_PRINT(x); WM_PRINT_SP; WM_PRINT(y); WM_PRINT_SP; WM_PRINT(z); WM_PRINT_SP; WM_PRINTLN(w); }
+#endif    // WIFIMGR_DEFERRED_LOG
 
 ////////////////////////////////////////////////////
 
@@ -1,13 +1,12 @@
-
-// autogenerated from https://raw.githubusercontent.com/nayarsystems/posix_tz_db/master/zones.csv
-// by script <esp8266 arduino core>/tools/TZupdate.sh
-// Thu Nov 12 04:07:03 UTC 2020
+// autogenerated by extras/tz/gen_TZ.py from extras/tz/zones.csv
+// Sun Oct 18 15:32:39 UTC 2026
 //
 // This database is autogenerated from IANA timezone database
 //    https://raw.githubusercontent.com/nayarsystems/posix_tz_db/master/zones.csv
 //    (using https://www.iana.org/time-zones)
-// and can be updated on demand in this repository
-// or by yourself using the above script
+// Update zones.csv and run the script instead of editing this file
+//
+// All zones are always built in, compressed. USING_AFRICA, USING_AMERICA, ... are no longer needed.
 
 #ifndef TZDB_H
 #define TZDB_H
@@ -25,50 +24,6 @@
 // .1 is the first occurrence of the day in the month
 // .0 is Sunday
 
-
-#if !defined(USING_AFRICA)
-  #define USING_AFRICA      false
-#endif
-
-#if !defined(USING_AMERICA)
-  #define USING_AMERICA      true
-#endif
-
-#if !defined(USING_ANTARCTICA)
-  #define USING_ANTARCTICA      false
-#endif
-
-#if !defined(USING_ASIA)
-  #define USING_ASIA      false
-#endif
-
-#if !defined(USING_ATLANTIC)
-  #define USING_ATLANTIC      false
-#endif
-
-#if !defined(USING_AUSTRALIA)
-  #define USING_AUSTRALIA      true
-#endif
-
-#if !defined(USING_EUROPE)
-  #define USING_EUROPE      false
-#endif
-
-#if !defined(USING_INDIAN)
-  #define USING_INDIAN      false
-#endif
-
-#if !defined(USING_PACIFIC)
-  #define USING_PACIFIC      false
-#endif
-
-#if !defined(USING_ETC_GMT)
-  #define USING_ETC_GMT      false
-#endif
-
-
-
-
 ////////////////////////////////////////////////////
 
 #define TZ_Africa_Abidjan	("GMT0")
@@ -534,999 +489,477 @@
 
 ////////////////////////////////////////////////////////////
 
-#define TIMEZONE_MAX_LEN      50
-
-static const char TZ_NAME[][TIMEZONE_MAX_LEN] /*PROGMEM*/ =
-{
-#if USING_AFRICA
-  "Africa/Abidjan",             //PSTR("GMT0")
-  "Africa/Accra",               //PSTR("GMT0")
-  "Africa/Addis_Ababa",         //PSTR("EAT-3")
-  "Africa/Algiers",             //PSTR("CET-1")
-  "Africa/Asmara",              //PSTR("EAT-3")
-  "Africa/Bamako",              //PSTR("GMT0")
-  "Africa/Bangui",              //PSTR("WAT-1")
-  "Africa/Banjul",              //PSTR("GMT0")
-  "Africa/Bissau",              //PSTR("GMT0")
-  "Africa/Blantyre",            //PSTR("CAT-2")
-  "Africa/Brazzaville",         //PSTR("WAT-1")
-  "Africa/Bujumbura",           //PSTR("CAT-2")
-  "Africa/Cairo",               //PSTR("EET-2")
-  "Africa/Casablanca",          //PSTR("<+01>-1")
-  "Africa/Ceuta",               //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Africa/Conakry",             //PSTR("GMT0")
-  "Africa/Dakar",               //PSTR("GMT0")
-  "Africa/Dar_es_Salaam",       //PSTR("EAT-3")
-  "Africa/Djibouti",            //PSTR("EAT-3")
-  "Africa/Douala",              //PSTR("WAT-1")
-  "Africa/El_Aaiun",            //PSTR("<+01>-1")
-  "Africa/Freetown",            //PSTR("GMT0")
-  "Africa/Gaborone",            //PSTR("CAT-2")
-  "Africa/Harare",              //PSTR("CAT-2")
-  "Africa/Johannesburg",        //PSTR("SAST-2")
-  "Africa/Juba",                //PSTR("EAT-3")
-  "Africa/Kampala",             //PSTR("EAT-3")
-  "Africa/Khartoum",            //PSTR("CAT-2")
-  "Africa/Kigali",              //PSTR("CAT-2")
-  "Africa/Kinshasa",            //PSTR("WAT-1")
-  "Africa/Lagos",               //PSTR("WAT-1")
-  "Africa/Libreville",          //PSTR("WAT-1")
-  "Africa/Lome",                //PSTR("GMT0")
-  "Africa/Luanda",              //PSTR("WAT-1")
-  "Africa/Lubumbashi",          //PSTR("CAT-2")
-  "Africa/Lusaka",              //PSTR("CAT-2")
-  "Africa/Malabo",              //PSTR("WAT-1")
-  "Africa/Maputo",              //PSTR("CAT-2")
-  "Africa/Maseru",              //PSTR("SAST-2")
-  "Africa/Mbabane",             //PSTR("SAST-2")
-  "Africa/Mogadishu",           //PSTR("EAT-3")
-  "Africa/Monrovia",            //PSTR("GMT0")
-  "Africa/Nairobi",             //PSTR("EAT-3")
-  "Africa/Ndjamena",            //PSTR("WAT-1")
-  "Africa/Niamey",              //PSTR("WAT-1")
-  "Africa/Nouakchott",          //PSTR("GMT0")
-  "Africa/Ouagadougou",         //PSTR("GMT0")
-  "Africa/PortomNovo",          //PSTR("WAT-1")
-  "Africa/Sao_Tome",            //PSTR("GMT0")
-  "Africa/Tripoli",             //PSTR("EET-2")
-  "Africa/Tunis",               //PSTR("CET-1")
-  "Africa/Windhoek",            //PSTR("CAT-2")
-#endif
+#define TIMEZONE_MAX_LEN          50
 
-  
-#if USING_AMERICA   
-  "America/Adak",               //PSTR("HST10HDT",M3.2.0",M11.1.0")
-  "America/Anchorage",          //PSTR("AKST9AKDT",M3.2.0",M11.1.0")
-  "America/Anguilla",           //PSTR("AST4")
-  "America/Antigua",            //PSTR("AST4")
-  "America/Araguaina",          //PSTR("<-03>3")
-  "America/Argentina/Buenos_Aires",   //PSTR("<-03>3")
-  "America/Argentina/Catamarca",      //PSTR("<-03>3")
-  "America/Argentina/Cordoba",        //PSTR("<-03>3")
-  "America/Argentina/Jujuy",          //PSTR("<-03>3")
-  "America/Argentina/La_Rioja",       //PSTR("<-03>3")
-  "America/Argentina/Mendoza",        //PSTR("<-03>3")
-  "America/Argentina/Rio_Gallegos",   //PSTR("<-03>3")
-  "America/Argentina/Salta",          //PSTR("<-03>3")
-  "America/Argentina/San_Juan",       //PSTR("<-03>3")
-  "America/Argentina/San_Luis",       //PSTR("<-03>3")
-  "America/Argentina/Tucuman",        //PSTR("<-03>3")
-  "America/Argentina/Ushuaia",        //PSTR("<-03>3")
-  "America/Aruba",              //PSTR("AST4")
-  "America/Asuncion",           //PSTR("<-04>4<-03>",M10.1.0/0",M3.4.0/0")
-  "America/Atikokan",           //PSTR("EST5")
-  "America/Bahia",              //PSTR("<-03>3")
-  "America/Bahia_Banderas",     //PSTR("CST6CDT",M4.1.0",M10.5.0")
-  "America/Barbados",           //PSTR("AST4")
-  "America/Belem",              //PSTR("<-03>3")
-  "America/Belize",             //PSTR("CST6")
-  "America/BlancmSablon",       //PSTR("AST4")
-  "America/Boa_Vista",          //PSTR("<-04>4")
-  "America/Bogota",             //PSTR("<-05>5")
-  "America/Boise",              //PSTR("MST7MDT",M3.2.0",M11.1.0")
-  "America/Cambridge_Bay",      //PSTR("MST7MDT",M3.2.0",M11.1.0")
-  "America/Campo_Grande",       //PSTR("<-04>4")
-  "America/Cancun",             //PSTR("EST5")
-  "America/Caracas",            //PSTR("<-04>4")
-  "America/Cayenne",            //PSTR("<-03>3")
-  "America/Cayman",             //PSTR("EST5")
-  "America/Chicago",            //PSTR("CST6CDT",M3.2.0",M11.1.0")
-  "America/Chihuahua",          //PSTR("MST7MDT",M4.1.0",M10.5.0")
-  "America/Costa_Rica",         //PSTR("CST6")
-  "America/Creston",            //PSTR("MST7")
-  "America/Cuiaba",             //PSTR("<-04>4")
-  "America/Curacao",            //PSTR("AST4")
-  "America/Danmarkshavn",       //PSTR("GMT0")
-  "America/Dawson",             //PSTR("MST7")
-  "America/Dawson_Creek",       //PSTR("MST7")
-  "America/Denver",             //PSTR("MST7MDT",M3.2.0",M11.1.0")
-  "America/Detroit",            //PSTR("EST5EDT",M3.2.0",M11.1.0")
-  "America/Dominica",           //PSTR("AST4")
-  "America/Edmonton",           //PSTR("MST7MDT",M3.2.0",M11.1.0")
-  "America/Eirunepe",           //PSTR("<-05>5")
-  "America/El_Salvador",        //PSTR("CST6")
-  "America/Fortaleza",          //PSTR("<-03>3")
-  "America/Fort_Nelson",        //PSTR("MST7")
-  "America/Glace_Bay",          //PSTR("AST4ADT",M3.2.0",M11.1.0")
-  "America/Godthab",            //PSTR("<-03>3<-02>",M3.5.0/-2",M10.5.0/-1")
-  "America/Goose_Bay",          //PSTR("AST4ADT",M3.2.0",M11.1.0")
-  "America/Grand_Turk",         //PSTR("EST5EDT",M3.2.0",M11.1.0")
-  "America/Grenada",            //PSTR("AST4")
-  "America/Guadeloupe",         //PSTR("AST4")
-  "America/Guatemala",          //PSTR("CST6")
-  "America/Guayaquil",          //PSTR("<-05>5")
-  "America/Guyana",             //PSTR("<-04>4")
-  "America/Halifax",            //PSTR("AST4ADT",M3.2.0",M11.1.0")
-  "America/Havana",             //PSTR("CST5CDT",M3.2.0/0",M11.1.0/1")
-  "America/Hermosillo",         //PSTR("MST7")
-  "America/Indiana_Indianapolis",   //PSTR("EST5EDT",M3.2.0",M11.1.0")
-  "America/Indiana_Knox",           //PSTR("CST6CDT",M3.2.0",M11.1.0")
-  "America/Indiana_Marengo",        //PSTR("EST5EDT",M3.2.0",M11.1.0")
-  "America/Indiana_Petersburg",     //PSTR("EST5EDT",M3.2.0",M11.1.0")
-  "America/Indiana_Tell_City",      //PSTR("CST6CDT",M3.2.0",M11.1.0")
-  "America/Indiana_Vevay",          //PSTR("EST5EDT",M3.2.0",M11.1.0")
-  "America/Indiana_Vincennes",      //PSTR("EST5EDT",M3.2.0",M11.1.0")
-  "America/Indiana_Winamac",        //PSTR("EST5EDT",M3.2.0",M11.1.0")
-  "America/Inuvik",             //PSTR("MST7MDT",M3.2.0",M11.1.0")
-  "America/Iqaluit",            //PSTR("EST5EDT",M3.2.0",M11.1.0")
-  "America/Jamaica",            //PSTR("EST5")
-  "America/Juneau",             //PSTR("AKST9AKDT",M3.2.0",M11.1.0")
-  "America/Kentucky_Louisville",  //PSTR("EST5EDT",M3.2.0",M11.1.0")
-  "America/Kentucky_Monticello",  //PSTR("EST5EDT",M3.2.0",M11.1.0")
-  "America/Kralendijk",           //PSTR("AST4")
-  "America/La_Paz",               //PSTR("<-04>4")
-  "America/Lima",               //PSTR("<-05>5")
-  "America/Los_Angeles",        //PSTR("PST8PDT",M3.2.0",M11.1.0")
-  "America/Lower_Princes",      //PSTR("AST4")
-  "America/Maceio",             //PSTR("<-03>3")
-  "America/Managua",            //PSTR("CST6")
-  "America/Manaus",             //PSTR("<-04>4")
-  "America/Marigot",            //PSTR("AST4")
-  "America/Martinique",         //PSTR("AST4")
-  "America/Matamoros",          //PSTR("CST6CDT",M3.2.0",M11.1.0")
-  "America/Mazatlan",           //PSTR("MST7MDT",M4.1.0",M10.5.0")
-  "America/Menominee",          //PSTR("CST6CDT",M3.2.0",M11.1.0")
-  "America/Merida",             //PSTR("CST6CDT",M4.1.0",M10.5.0")
-  "America/Metlakatla",         //PSTR("AKST9AKDT",M3.2.0",M11.1.0")
-  "America/Mexico_City",        //PSTR("CST6CDT",M4.1.0",M10.5.0")
-  "America/Miquelon",           //PSTR("<-03>3<-02>",M3.2.0",M11.1.0")
-  "America/Moncton",            //PSTR("AST4ADT",M3.2.0",M11.1.0")
-  "America/Monterrey",          //PSTR("CST6CDT",M4.1.0",M10.5.0")
-  "America/Montevideo",         //PSTR("<-03>3")
-  "America/Montreal",           //PSTR("EST5EDT",M3.2.0",M11.1.0")
-  "America/Montserrat",         //PSTR("AST4")
-  "America/Nassau",             //PSTR("EST5EDT",M3.2.0",M11.1.0")
-  "America/New_York",           //PSTR("EST5EDT",M3.2.0",M11.1.0")
-  "America/Nipigon",            //PSTR("EST5EDT",M3.2.0",M11.1.0")
-  "America/Nome",               //PSTR("AKST9AKDT",M3.2.0",M11.1.0")
-  "America/Noronha",            //PSTR("<-02>2")
-  "America/North_Dakota_Beulah",      //PSTR("CST6CDT",M3.2.0",M11.1.0")
-  "America/North_Dakota_Center",      //PSTR("CST6CDT",M3.2.0",M11.1.0")
-  "America/North_Dakota_New_Salem",   //PSTR("CST6CDT",M3.2.0",M11.1.0")
-  "America/Ojinaga",            //PSTR("MST7MDT",M3.2.0",M11.1.0")
-  "America/Panama",             //PSTR("EST5")
-  "America/Pangnirtung",        //PSTR("EST5EDT",M3.2.0",M11.1.0")
-  "America/Paramaribo",         //PSTR("<-03>3")
-  "America/Phoenix",            //PSTR("MST7")
-  "America/PortmaumPrince",     //PSTR("EST5EDT",M3.2.0",M11.1.0")
-  "America/Port_of_Spain",      //PSTR("AST4")
-  "America/Porto_Velho",        //PSTR("<-04>4")
-  "America/Puerto_Rico",        //PSTR("AST4")
-  "America/Punta_Arenas",       //PSTR("<-03>3")
-  "America/Rainy_River",        //PSTR("CST6CDT",M3.2.0",M11.1.0")
-  "America/Rankin_Inlet",       //PSTR("CST6CDT",M3.2.0",M11.1.0")
-  "America/Recife",             //PSTR("<-03>3")
-  "America/Regina",             //PSTR("CST6")
-  "America/Resolute",           //PSTR("CST6CDT",M3.2.0",M11.1.0")
-  "America/Rio_Branco",         //PSTR("<-05>5")
-  "America/Santarem",           //PSTR("<-03>3")
-  "America/Santiago",           //PSTR("<-04>4<-03>",M9.1.6/24",M4.1.6/24")
-  "America/Santo_Domingo",      //PSTR("AST4")
-  "America/Sao_Paulo",          //PSTR("<-03>3")
-  "America/Scoresbysund",       //PSTR("<-01>1<+00>",M3.5.0/0",M10.5.0/1")
-  "America/Sitka",              //PSTR("AKST9AKDT",M3.2.0",M11.1.0")
-  "America/St_Barthelemy",      //PSTR("AST4")
-  "America/St_Johns",           //PSTR("NST3:30NDT",M3.2.0",M11.1.0")
-  "America/St_Kitts",           //PSTR("AST4")
-  "America/St_Lucia",           //PSTR("AST4")
-  "America/St_Thomas",          //PSTR("AST4")
-  "America/St_Vincent",         //PSTR("AST4")
-  "America/Swift_Current",      //PSTR("CST6")
-  "America/Tegucigalpa",        //PSTR("CST6")
-  "America/Thule",              //PSTR("AST4ADT",M3.2.0",M11.1.0")
-  "America/Thunder_Bay",        //PSTR("EST5EDT",M3.2.0",M11.1.0")
-  "America/Tijuana",            //PSTR("PST8PDT",M3.2.0",M11.1.0")
-  "America/Toronto",            //PSTR("EST5EDT",M3.2.0",M11.1.0")
-  "America/Tortola",            //PSTR("AST4")
-  "America/Vancouver",          //PSTR("PST8PDT",M3.2.0",M11.1.0")
-  "America/Whitehorse",         //PSTR("MST7")
-  "America/Winnipeg",           //PSTR("CST6CDT",M3.2.0",M11.1.0")
-  "America/Yakutat",            //PSTR("AKST9AKDT",M3.2.0",M11.1.0")
-  "America/Yellowknife",        //PSTR("MST7MDT",M3.2.0",M11.1.0")
-#endif
+#define WM_TZ_COUNT               460
+#define WM_TZ_NAME_MAX_LEN        30
+#define WM_TZ_RULE_MAX_LEN        44
+#define WM_TZ_RESTART_INTERVAL    16
+#define WM_TZ_RESTART_COUNT       29
 
-#if USING_ANTARCTICA  
-  "Antarctica/Casey",           //PSTR("<+11>-11")
-  "Antarctica/Davis",           //PSTR("<+07>-7")
-  "Antarctica/DumontDUrville",  //PSTR("<+10>-10")
-  "Antarctica/Macquarie",       //PSTR("AEST-10AEDT",M10.1.0",M4.1.0/3")
-  "Antarctica/Mawson",          //PSTR("<+05>-5")
-  "Antarctica/McMurdo",         //PSTR("NZST-12NZDT",M9.5.0",M4.1.0/3")
-  "Antarctica/Palmer",          //PSTR("<-03>3")
-  "Antarctica/Rothera",         //PSTR("<-03>3")
-  "Antarctica/Syowa",           //PSTR("<+03>-3")
-  "Antarctica/Troll",           //PSTR("<+00>0<+02>-2",M3.5.0/1",M10.5.0/3")
-  "Antarctica/Vostok",          //PSTR("<+06>-6")
-  "Arctic/Longyearbyen",        //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-#endif
+static const uint8_t WM_TZ_NAMES[] PROGMEM =
+{
+  0x00, 0x41, 0x66, 0x72, 0x69, 0x63, 0x61, 0x2F, 0x41, 0x62, 0x69, 0x64, 0x6A, 0x61, 0x6E, 0xC8,
+  0x08, 0x63, 0x63, 0x72, 0x61, 0xC8, 0x08, 0x64, 0x64, 0x69, 0x73, 0x5F, 0x41, 0x62, 0x61, 0x62,
+  0x61, 0xBE, 0x08, 0x6C, 0x67, 0x69, 0x65, 0x72, 0x73, 0xB6, 0x08, 0x73, 0x6D, 0x61, 0x72, 0x61,
+  0xBE, 0x07, 0x42, 0x61, 0x6D, 0x61, 0x6B, 0x6F, 0xC8, 0x09, 0x6E, 0x67, 0x75, 0x69, 0xDE, 0x0A,
+  0x6A, 0x75, 0x6C, 0xC8, 0x08, 0x69, 0x73, 0x73, 0x61, 0x75, 0xC8, 0x08, 0x6C, 0x61, 0x6E, 0x74,
+  0x79, 0x72, 0x65, 0xB5, 0x08, 0x72, 0x61, 0x7A, 0x7A, 0x61, 0x76, 0x69, 0x6C, 0x6C, 0x65, 0xDE,
+  0x08, 0x75, 0x6A, 0x75, 0x6D, 0x62, 0x75, 0x72, 0x61, 0xB5, 0x07, 0x43, 0x61, 0x69, 0x72, 0x6F,
+  0xBF, 0x09, 0x73, 0x61, 0x62, 0x6C, 0x61, 0x6E, 0x63, 0x61, 0x81, 0x08, 0x65, 0x75, 0x74, 0x61,
+  0xB7, 0x08, 0x6F, 0x6E, 0x61, 0x6B, 0x72, 0x79, 0xC8, 0x00, 0x41, 0x66, 0x72, 0x69, 0x63, 0x61,
+  0x2F, 0x44, 0x61, 0x6B, 0x61, 0x72, 0xC8, 0x09, 0x72, 0x5F, 0x65, 0x73, 0x5F, 0x53, 0x61, 0x6C,
+  0x61, 0x61, 0x6D, 0xBE, 0x08, 0x6A, 0x69, 0x62, 0x6F, 0x75, 0x74, 0x69, 0xBE, 0x08, 0x6F, 0x75,
+  0x61, 0x6C, 0x61, 0xDE, 0x07, 0x45, 0x6C, 0x5F, 0x41, 0x61, 0x69, 0x75, 0x6E, 0x81, 0x07, 0x46,
+  0x72, 0x65, 0x65, 0x74, 0x6F, 0x77, 0x6E, 0xC8, 0x07, 0x47, 0x61, 0x62, 0x6F, 0x72, 0x6F, 0x6E,
+  0x65, 0xB5, 0x07, 0x48, 0x61, 0x72, 0x61, 0x72, 0x65, 0xB5, 0x07, 0x4A, 0x6F, 0x68, 0x61, 0x6E,
+  0x6E, 0x65, 0x73, 0x62, 0x75, 0x72, 0x67, 0xDB, 0x08, 0x75, 0x62, 0x61, 0xBE, 0x07, 0x4B, 0x61,
+  0x6D, 0x70, 0x61, 0x6C, 0x61, 0xBE, 0x08, 0x68, 0x61, 0x72, 0x74, 0x6F, 0x75, 0x6D, 0xB5, 0x08,
+  0x69, 0x67, 0x61, 0x6C, 0x69, 0xB5, 0x09, 0x6E, 0x73, 0x68, 0x61, 0x73, 0x61, 0xDE, 0x07, 0x4C,
+  0x61, 0x67, 0x6F, 0x73, 0xDE, 0x08, 0x69, 0x62, 0x72, 0x65, 0x76, 0x69, 0x6C, 0x6C, 0x65, 0xDE,
+  0x00, 0x41, 0x66, 0x72, 0x69, 0x63, 0x61, 0x2F, 0x4C, 0x6F, 0x6D, 0x65, 0xC8, 0x08, 0x75, 0x61,
+  0x6E, 0x64, 0x61, 0xDE, 0x09, 0x62, 0x75, 0x6D, 0x62, 0x61, 0x73, 0x68, 0x69, 0xB5, 0x09, 0x73,
+  0x61, 0x6B, 0x61, 0xB5, 0x07, 0x4D, 0x61, 0x6C, 0x61, 0x62, 0x6F, 0xDE, 0x09, 0x70, 0x75, 0x74,
+  0x6F, 0xB5, 0x09, 0x73, 0x65, 0x72, 0x75, 0xDB, 0x08, 0x62, 0x61, 0x62, 0x61, 0x6E, 0x65, 0xDB,
+  0x08, 0x6F, 0x67, 0x61, 0x64, 0x69, 0x73, 0x68, 0x75, 0xBE, 0x09, 0x6E, 0x72, 0x6F, 0x76, 0x69,
+  0x61, 0xC8, 0x07, 0x4E, 0x61, 0x69, 0x72, 0x6F, 0x62, 0x69, 0xBE, 0x08, 0x64, 0x6A, 0x61, 0x6D,
+  0x65, 0x6E, 0x61, 0xDE, 0x08, 0x69, 0x61, 0x6D, 0x65, 0x79, 0xDE, 0x08, 0x6F, 0x75, 0x61, 0x6B,
+  0x63, 0x68, 0x6F, 0x74, 0x74, 0xC8, 0x07, 0x4F, 0x75, 0x61, 0x67, 0x61, 0x64, 0x6F, 0x75, 0x67,
+  0x6F, 0x75, 0xC8, 0x07, 0x50, 0x6F, 0x72, 0x74, 0x6F, 0x6D, 0x4E, 0x6F, 0x76, 0x6F, 0xDE, 0x00,
+  0x41, 0x66, 0x72, 0x69, 0x63, 0x61, 0x2F, 0x53, 0x61, 0x6F, 0x5F, 0x54, 0x6F, 0x6D, 0x65, 0xC8,
+  0x07, 0x54, 0x72, 0x69, 0x70, 0x6F, 0x6C, 0x69, 0xBF, 0x08, 0x75, 0x6E, 0x69, 0x73, 0xB6, 0x07,
+  0x57, 0x69, 0x6E, 0x64, 0x68, 0x6F, 0x65, 0x6B, 0xB5, 0x01, 0x6D, 0x65, 0x72, 0x69, 0x63, 0x61,
+  0x2F, 0x41, 0x64, 0x61, 0x6B, 0xCC, 0x09, 0x6E, 0x63, 0x68, 0x6F, 0x72, 0x61, 0x67, 0x65, 0xB1,
+  0x0A, 0x67, 0x75, 0x69, 0x6C, 0x6C, 0x61, 0xB2, 0x0A, 0x74, 0x69, 0x67, 0x75, 0x61, 0xB2, 0x09,
+  0x72, 0x61, 0x67, 0x75, 0x61, 0x69, 0x6E, 0x61, 0x9D, 0x0A, 0x67, 0x65, 0x6E, 0x74, 0x69, 0x6E,
+  0x61, 0x2F, 0x42, 0x75, 0x65, 0x6E, 0x6F, 0x73, 0x5F, 0x41, 0x69, 0x72, 0x65, 0x73, 0x9D, 0x12,
+  0x43, 0x61, 0x74, 0x61, 0x6D, 0x61, 0x72, 0x63, 0x61, 0x9D, 0x13, 0x6F, 0x72, 0x64, 0x6F, 0x62,
+  0x61, 0x9D, 0x12, 0x4A, 0x75, 0x6A, 0x75, 0x79, 0x9D, 0x12, 0x4C, 0x61, 0x5F, 0x52, 0x69, 0x6F,
+  0x6A, 0x61, 0x9D, 0x12, 0x4D, 0x65, 0x6E, 0x64, 0x6F, 0x7A, 0x61, 0x9D, 0x12, 0x52, 0x69, 0x6F,
+  0x5F, 0x47, 0x61, 0x6C, 0x6C, 0x65, 0x67, 0x6F, 0x73, 0x9D, 0x00, 0x41, 0x6D, 0x65, 0x72, 0x69,
+  0x63, 0x61, 0x2F, 0x41, 0x72, 0x67, 0x65, 0x6E, 0x74, 0x69, 0x6E, 0x61, 0x2F, 0x53, 0x61, 0x6C,
+  0x74, 0x61, 0x9D, 0x14, 0x6E, 0x5F, 0x4A, 0x75, 0x61, 0x6E, 0x9D, 0x16, 0x4C, 0x75, 0x69, 0x73,
+  0x9D, 0x12, 0x54, 0x75, 0x63, 0x75, 0x6D, 0x61, 0x6E, 0x9D, 0x12, 0x55, 0x73, 0x68, 0x75, 0x61,
+  0x69, 0x61, 0x9D, 0x0A, 0x75, 0x62, 0x61, 0xB2, 0x09, 0x73, 0x75, 0x6E, 0x63, 0x69, 0x6F, 0x6E,
+  0xA1, 0x09, 0x74, 0x69, 0x6B, 0x6F, 0x6B, 0x61, 0x6E, 0xC6, 0x08, 0x42, 0x61, 0x68, 0x69, 0x61,
+  0x9D, 0x0D, 0x5F, 0x42, 0x61, 0x6E, 0x64, 0x65, 0x72, 0x61, 0x73, 0xBC, 0x0A, 0x72, 0x62, 0x61,
+  0x64, 0x6F, 0x73, 0xB2, 0x09, 0x65, 0x6C, 0x65, 0x6D, 0x9D, 0x0B, 0x69, 0x7A, 0x65, 0xBA, 0x09,
+  0x6C, 0x61, 0x6E, 0x63, 0x6D, 0x53, 0x61, 0x62, 0x6C, 0x6F, 0x6E, 0xB2, 0x09, 0x6F, 0x61, 0x5F,
+  0x56, 0x69, 0x73, 0x74, 0x61, 0xA0, 0x0A, 0x67, 0x6F, 0x74, 0x61, 0xA3, 0x00, 0x41, 0x6D, 0x65,
+  0x72, 0x69, 0x63, 0x61, 0x2F, 0x42, 0x6F, 0x69, 0x73, 0x65, 0xD4, 0x08, 0x43, 0x61, 0x6D, 0x62,
+  0x72, 0x69, 0x64, 0x67, 0x65, 0x5F, 0x42, 0x61, 0x79, 0xD4, 0x0B, 0x70, 0x6F, 0x5F, 0x47, 0x72,
+  0x61, 0x6E, 0x64, 0x65, 0xA0, 0x0A, 0x6E, 0x63, 0x75, 0x6E, 0xC6, 0x0A, 0x72, 0x61, 0x63, 0x61,
+  0x73, 0xA0, 0x0A, 0x79, 0x65, 0x6E, 0x6E, 0x65, 0x9D, 0x0B, 0x6D, 0x61, 0x6E, 0xC6, 0x09, 0x68,
+  0x69, 0x63, 0x61, 0x67, 0x6F, 0xBB, 0x0B, 0x68, 0x75, 0x61, 0x68, 0x75, 0x61, 0xD5, 0x09, 0x6F,
+  0x73, 0x74, 0x61, 0x5F, 0x52, 0x69, 0x63, 0x61, 0xBA, 0x09, 0x72, 0x65, 0x73, 0x74, 0x6F, 0x6E,
+  0xD3, 0x09, 0x75, 0x69, 0x61, 0x62, 0x61, 0xA0, 0x0A, 0x72, 0x61, 0x63, 0x61, 0x6F, 0xB2, 0x08,
+  0x44, 0x61, 0x6E, 0x6D, 0x61, 0x72, 0x6B, 0x73, 0x68, 0x61, 0x76, 0x6E, 0xC8, 0x0A, 0x77, 0x73,
+  0x6F, 0x6E, 0xD3, 0x0E, 0x5F, 0x43, 0x72, 0x65, 0x65, 0x6B, 0xD3, 0x00, 0x41, 0x6D, 0x65, 0x72,
+  0x69, 0x63, 0x61, 0x2F, 0x44, 0x65, 0x6E, 0x76, 0x65, 0x72, 0xD4, 0x0A, 0x74, 0x72, 0x6F, 0x69,
+  0x74, 0xC7, 0x09, 0x6F, 0x6D, 0x69, 0x6E, 0x69, 0x63, 0x61, 0xB2, 0x08, 0x45, 0x64, 0x6D, 0x6F,
+  0x6E, 0x74, 0x6F, 0x6E, 0xD4, 0x09, 0x69, 0x72, 0x75, 0x6E, 0x65, 0x70, 0x65, 0xA3, 0x09, 0x6C,
+  0x5F, 0x53, 0x61, 0x6C, 0x76, 0x61, 0x64, 0x6F, 0x72, 0xBA, 0x08, 0x46, 0x6F, 0x72, 0x74, 0x5F,
+  0x4E, 0x65, 0x6C, 0x73, 0x6F, 0x6E, 0xD3, 0x0C, 0x61, 0x6C, 0x65, 0x7A, 0x61, 0x9D, 0x08, 0x47,
+  0x6C, 0x61, 0x63, 0x65, 0x5F, 0x42, 0x61, 0x79, 0xB3, 0x09, 0x6F, 0x64, 0x74, 0x68, 0x61, 0x62,
+  0x9F, 0x0A, 0x6F, 0x73, 0x65, 0x5F, 0x42, 0x61, 0x79, 0xB3, 0x09, 0x72, 0x61, 0x6E, 0x64, 0x5F,
+  0x54, 0x75, 0x72, 0x6B, 0xC7, 0x0A, 0x65, 0x6E, 0x61, 0x64, 0x61, 0xB2, 0x09, 0x75, 0x61, 0x64,
+  0x65, 0x6C, 0x6F, 0x75, 0x70, 0x65, 0xB2, 0x0B, 0x74, 0x65, 0x6D, 0x61, 0x6C, 0x61, 0xBA, 0x0B,
+  0x79, 0x61, 0x71, 0x75, 0x69, 0x6C, 0xA3, 0x00, 0x41, 0x6D, 0x65, 0x72, 0x69, 0x63, 0x61, 0x2F,
+  0x47, 0x75, 0x79, 0x61, 0x6E, 0x61, 0xA0, 0x08, 0x48, 0x61, 0x6C, 0x69, 0x66, 0x61, 0x78, 0xB3,
+  0x0A, 0x76, 0x61, 0x6E, 0x61, 0xB9, 0x09, 0x65, 0x72, 0x6D, 0x6F, 0x73, 0x69, 0x6C, 0x6C, 0x6F,
+  0xD3, 0x08, 0x49, 0x6E, 0x64, 0x69, 0x61, 0x6E, 0x61, 0x5F, 0x49, 0x6E, 0x64, 0x69, 0x61, 0x6E,
+  0x61, 0x70, 0x6F, 0x6C, 0x69, 0x73, 0xC7, 0x10, 0x4B, 0x6E, 0x6F, 0x78, 0xBB, 0x10, 0x4D, 0x61,
+  0x72, 0x65, 0x6E, 0x67, 0x6F, 0xC7, 0x10, 0x50, 0x65, 0x74, 0x65, 0x72, 0x73, 0x62, 0x75, 0x72,
+  0x67, 0xC7, 0x10, 0x54, 0x65, 0x6C, 0x6C, 0x5F, 0x43, 0x69, 0x74, 0x79, 0xBB, 0x10, 0x56, 0x65,
+  0x76, 0x61, 0x79, 0xC7, 0x11, 0x69, 0x6E, 0x63, 0x65, 0x6E, 0x6E, 0x65, 0x73, 0xC7, 0x10, 0x57,
+  0x69, 0x6E, 0x61, 0x6D, 0x61, 0x63, 0xC7, 0x0A, 0x75, 0x76, 0x69, 0x6B, 0xD4, 0x09, 0x71, 0x61,
+  0x6C, 0x75, 0x69, 0x74, 0xC7, 0x08, 0x4A, 0x61, 0x6D, 0x61, 0x69, 0x63, 0x61, 0xC6, 0x09, 0x75,
+  0x6E, 0x65, 0x61, 0x75, 0xB1, 0x00, 0x41, 0x6D, 0x65, 0x72, 0x69, 0x63, 0x61, 0x2F, 0x4B, 0x65,
+  0x6E, 0x74, 0x75, 0x63, 0x6B, 0x79, 0x5F, 0x4C, 0x6F, 0x75, 0x69, 0x73, 0x76, 0x69, 0x6C, 0x6C,
+  0x65, 0xC7, 0x11, 0x4D, 0x6F, 0x6E, 0x74, 0x69, 0x63, 0x65, 0x6C, 0x6C, 0x6F, 0xC7, 0x09, 0x72,
+  0x61, 0x6C, 0x65, 0x6E, 0x64, 0x69, 0x6A, 0x6B, 0xB2, 0x08, 0x4C, 0x61, 0x5F, 0x50, 0x61, 0x7A,
+  0xA0, 0x09, 0x69, 0x6D, 0x61, 0xA3, 0x09, 0x6F, 0x73, 0x5F, 0x41, 0x6E, 0x67, 0x65, 0x6C, 0x65,
+  0x73, 0xDA, 0x0A, 0x77, 0x65, 0x72, 0x5F, 0x50, 0x72, 0x69, 0x6E, 0x63, 0x65, 0x73, 0xB2, 0x08,
+  0x4D, 0x61, 0x63, 0x65, 0x69, 0x6F, 0x9D, 0x0A, 0x6E, 0x61, 0x67, 0x75, 0x61, 0xBA, 0x0C, 0x75,
+  0x73, 0xA0, 0x0A, 0x72, 0x69, 0x67, 0x6F, 0x74, 0xB2, 0x0B, 0x74, 0x69, 0x6E, 0x69, 0x71, 0x75,
+  0x65, 0xB2, 0x0A, 0x74, 0x61, 0x6D, 0x6F, 0x72, 0x6F, 0x73, 0xBB, 0x0A, 0x7A, 0x61, 0x74, 0x6C,
+  0x61, 0x6E, 0xD5, 0x09, 0x65, 0x6E, 0x6F, 0x6D, 0x69, 0x6E, 0x65, 0x65, 0xBB, 0x0A, 0x72, 0x69,
+  0x64, 0x61, 0xBC, 0x00, 0x41, 0x6D, 0x65, 0x72, 0x69, 0x63, 0x61, 0x2F, 0x4D, 0x65, 0x74, 0x6C,
+  0x61, 0x6B, 0x61, 0x74, 0x6C, 0x61, 0xB1, 0x0A, 0x78, 0x69, 0x63, 0x6F, 0x5F, 0x43, 0x69, 0x74,
+  0x79, 0xBC, 0x09, 0x69, 0x71, 0x75, 0x65, 0x6C, 0x6F, 0x6E, 0x9E, 0x09, 0x6F, 0x6E, 0x63, 0x74,
+  0x6F, 0x6E, 0xB3, 0x0B, 0x74, 0x65, 0x72, 0x72, 0x65, 0x79, 0xBC, 0x0D, 0x76, 0x69, 0x64, 0x65,
+  0x6F, 0x9D, 0x0C, 0x72, 0x65, 0x61, 0x6C, 0xC7, 0x0C, 0x73, 0x65, 0x72, 0x72, 0x61, 0x74, 0xB2,
+  0x08, 0x4E, 0x61, 0x73, 0x73, 0x61, 0x75, 0xC7, 0x09, 0x65, 0x77, 0x5F, 0x59, 0x6F, 0x72, 0x6B,
+  0xC7, 0x09, 0x69, 0x70, 0x69, 0x67, 0x6F, 0x6E, 0xC7, 0x09, 0x6F, 0x6D, 0x65, 0xB1, 0x0A, 0x72,
+  0x6F, 0x6E, 0x68, 0x61, 0x9C, 0x0B, 0x74, 0x68, 0x5F, 0x44, 0x61, 0x6B, 0x6F, 0x74, 0x61, 0x5F,
+  0x42, 0x65, 0x75, 0x6C, 0x61, 0x68, 0xBB, 0x15, 0x43, 0x65, 0x6E, 0x74, 0x65, 0x72, 0xBB, 0x15,
+  0x4E, 0x65, 0x77, 0x5F, 0x53, 0x61, 0x6C, 0x65, 0x6D, 0xBB, 0x00, 0x41, 0x6D, 0x65, 0x72, 0x69,
+  0x63, 0x61, 0x2F, 0x4F, 0x6A, 0x69, 0x6E, 0x61, 0x67, 0x61, 0xD4, 0x08, 0x50, 0x61, 0x6E, 0x61,
+  0x6D, 0x61, 0xC6, 0x0B, 0x67, 0x6E, 0x69, 0x72, 0x74, 0x75, 0x6E, 0x67, 0xC7, 0x0A, 0x72, 0x61,
+  0x6D, 0x61, 0x72, 0x69, 0x62, 0x6F, 0x9D, 0x09, 0x68, 0x6F, 0x65, 0x6E, 0x69, 0x78, 0xD3, 0x09,
+  0x6F, 0x72, 0x74, 0x5F, 0x6F, 0x66, 0x5F, 0x53, 0x70, 0x61, 0x69, 0x6E, 0xB2, 0x0C, 0x6D, 0x61,
+  0x75, 0x6D, 0x50, 0x72, 0x69, 0x6E, 0x63, 0x65, 0xC7, 0x0C, 0x6F, 0x5F, 0x56, 0x65, 0x6C, 0x68,
+  0x6F, 0xA0, 0x09, 0x75, 0x65, 0x72, 0x74, 0x6F, 0x5F, 0x52, 0x69, 0x63, 0x6F, 0xB2, 0x0A, 0x6E,
+  0x74, 0x61, 0x5F, 0x41, 0x72, 0x65, 0x6E, 0x61, 0x73, 0x9D, 0x08, 0x52, 0x61, 0x69, 0x6E, 0x79,
+  0x5F, 0x52, 0x69, 0x76, 0x65, 0x72, 0xBB, 0x0A, 0x6E, 0x6B, 0x69, 0x6E, 0x5F, 0x49, 0x6E, 0x6C,
+  0x65, 0x74, 0xBB, 0x09, 0x65, 0x63, 0x69, 0x66, 0x65, 0x9D, 0x0A, 0x67, 0x69, 0x6E, 0x61, 0xBA,
+  0x0A, 0x73, 0x6F, 0x6C, 0x75, 0x74, 0x65, 0xBB, 0x09, 0x69, 0x6F, 0x5F, 0x42, 0x72, 0x61, 0x6E,
+  0x63, 0x6F, 0xA3, 0x00, 0x41, 0x6D, 0x65, 0x72, 0x69, 0x63, 0x61, 0x2F, 0x53, 0x61, 0x6E, 0x74,
+  0x61, 0x72, 0x65, 0x6D, 0x9D, 0x0C, 0x69, 0x61, 0x67, 0x6F, 0xA2, 0x0C, 0x6F, 0x5F, 0x44, 0x6F,
+  0x6D, 0x69, 0x6E, 0x67, 0x6F, 0xB2, 0x0A, 0x6F, 0x5F, 0x50, 0x61, 0x75, 0x6C, 0x6F, 0x9D, 0x09,
+  0x63, 0x6F, 0x72, 0x65, 0x73, 0x62, 0x79, 0x73, 0x75, 0x6E, 0x64, 0x9B, 0x09, 0x69, 0x74, 0x6B,
+  0x61, 0xB1, 0x09, 0x74, 0x5F, 0x42, 0x61, 0x72, 0x74, 0x68, 0x65, 0x6C, 0x65, 0x6D, 0x79, 0xB2,
+  0x0B, 0x4A, 0x6F, 0x68, 0x6E, 0x73, 0xD6, 0x0B, 0x4B, 0x69, 0x74, 0x74, 0x73, 0xB2, 0x0B, 0x4C,
+  0x75, 0x63, 0x69, 0x61, 0xB2, 0x0B, 0x54, 0x68, 0x6F, 0x6D, 0x61, 0x73, 0xB2, 0x0B, 0x56, 0x69,
+  0x6E, 0x63, 0x65, 0x6E, 0x74, 0xB2, 0x09, 0x77, 0x69, 0x66, 0x74, 0x5F, 0x43, 0x75, 0x72, 0x72,
+  0x65, 0x6E, 0x74, 0xBA, 0x08, 0x54, 0x65, 0x67, 0x75, 0x63, 0x69, 0x67, 0x61, 0x6C, 0x70, 0x61,
+  0xBA, 0x09, 0x68, 0x75, 0x6C, 0x65, 0xB3, 0x0B, 0x6E, 0x64, 0x65, 0x72, 0x5F, 0x42, 0x61, 0x79,
+  0xC7, 0x00, 0x41, 0x6D, 0x65, 0x72, 0x69, 0x63, 0x61, 0x2F, 0x54, 0x69, 0x6A, 0x75, 0x61, 0x6E,
+  0x61, 0xDA, 0x09, 0x6F, 0x72, 0x6F, 0x6E, 0x74, 0x6F, 0xC7, 0x0B, 0x74, 0x6F, 0x6C, 0x61, 0xB2,
+  0x08, 0x56, 0x61, 0x6E, 0x63, 0x6F, 0x75, 0x76, 0x65, 0x72, 0xDA, 0x08, 0x57, 0x68, 0x69, 0x74,
+  0x65, 0x68, 0x6F, 0x72, 0x73, 0x65, 0xD3, 0x09, 0x69, 0x6E, 0x6E, 0x69, 0x70, 0x65, 0x67, 0xBB,
+  0x08, 0x59, 0x61, 0x6B, 0x75, 0x74, 0x61, 0x74, 0xB1, 0x09, 0x65, 0x6C, 0x6C, 0x6F, 0x77, 0x6B,
+  0x6E, 0x69, 0x66, 0x65, 0xD4, 0x01, 0x6E, 0x74, 0x61, 0x72, 0x63, 0x74, 0x69, 0x63, 0x61, 0x2F,
+  0x43, 0x61, 0x73, 0x65, 0x79, 0x92, 0x0B, 0x44, 0x61, 0x76, 0x69, 0x73, 0x8C, 0x0C, 0x75, 0x6D,
+  0x6F, 0x6E, 0x74, 0x44, 0x55, 0x72, 0x76, 0x69, 0x6C, 0x6C, 0x65, 0x91, 0x0B, 0x4D, 0x61, 0x63,
+  0x71, 0x75, 0x61, 0x72, 0x69, 0x65, 0xB0, 0x0D, 0x77, 0x73, 0x6F, 0x6E, 0x89, 0x0C, 0x63, 0x4D,
+  0x75, 0x72, 0x64, 0x6F, 0xD7, 0x0B, 0x50, 0x61, 0x6C, 0x6D, 0x65, 0x72, 0x9D, 0x0B, 0x52, 0x6F,
+  0x74, 0x68, 0x65, 0x72, 0x61, 0x9D, 0x00, 0x41, 0x6E, 0x74, 0x61, 0x72, 0x63, 0x74, 0x69, 0x63,
+  0x61, 0x2F, 0x53, 0x79, 0x6F, 0x77, 0x61, 0x84, 0x0B, 0x54, 0x72, 0x6F, 0x6C, 0x6C, 0x80, 0x0B,
+  0x56, 0x6F, 0x73, 0x74, 0x6F, 0x6B, 0x8B, 0x01, 0x72, 0x63, 0x74, 0x69, 0x63, 0x2F, 0x4C, 0x6F,
+  0x6E, 0x67, 0x79, 0x65, 0x61, 0x72, 0x62, 0x79, 0x65, 0x6E, 0xB7, 0x01, 0x73, 0x69, 0x61, 0x2F,
+  0x41, 0x64, 0x65, 0x6E, 0x84, 0x06, 0x6C, 0x6D, 0x61, 0x74, 0x79, 0x8B, 0x06, 0x6D, 0x6D, 0x61,
+  0x6E, 0xC4, 0x06, 0x6E, 0x61, 0x64, 0x79, 0x72, 0x95, 0x06, 0x71, 0x74, 0x61, 0x75, 0x89, 0x08,
+  0x6F, 0x62, 0x65, 0x89, 0x06, 0x73, 0x68, 0x67, 0x61, 0x62, 0x61, 0x74, 0x89, 0x06, 0x74, 0x79,
+  0x72, 0x61, 0x75, 0x89, 0x05, 0x42, 0x61, 0x67, 0x68, 0x64, 0x61, 0x64, 0x84, 0x07, 0x68, 0x72,
+  0x61, 0x69, 0x6E, 0x84, 0x07, 0x6B, 0x75, 0x86, 0x07, 0x6E, 0x67, 0x6B, 0x6F, 0x6B, 0x8C, 0x00,
+  0x41, 0x73, 0x69, 0x61, 0x2F, 0x42, 0x61, 0x72, 0x6E, 0x61, 0x75, 0x6C, 0x8C, 0x06, 0x65, 0x69,
+  0x72, 0x75, 0x74, 0xC2, 0x06, 0x69, 0x73, 0x68, 0x6B, 0x65, 0x6B, 0x8B, 0x06, 0x72, 0x75, 0x6E,
+  0x65, 0x69, 0x8E, 0x05, 0x43, 0x68, 0x69, 0x74, 0x61, 0x8F, 0x07, 0x6F, 0x69, 0x62, 0x61, 0x6C,
+  0x73, 0x61, 0x6E, 0x8E, 0x06, 0x6F, 0x6C, 0x6F, 0x6D, 0x62, 0x6F, 0x87, 0x05, 0x44, 0x61, 0x6D,
+  0x61, 0x73, 0x63, 0x75, 0x73, 0xC5, 0x06, 0x68, 0x61, 0x6B, 0x61, 0x8B, 0x06, 0x69, 0x6C, 0x69,
+  0x8F, 0x06, 0x75, 0x62, 0x61, 0x69, 0x86, 0x07, 0x73, 0x68, 0x61, 0x6E, 0x62, 0x65, 0x89, 0x05,
+  0x46, 0x61, 0x6D, 0x61, 0x67, 0x75, 0x73, 0x74, 0x61, 0xC3, 0x05, 0x47, 0x61, 0x7A, 0x61, 0xC0,
+  0x05, 0x48, 0x65, 0x62, 0x72, 0x6F, 0x6E, 0xC0, 0x06, 0x6F, 0x5F, 0x43, 0x68, 0x69, 0x5F, 0x4D,
+  0x69, 0x6E, 0x68, 0x8C, 0x00, 0x41, 0x73, 0x69, 0x61, 0x2F, 0x48, 0x6F, 0x6E, 0x67, 0x5F, 0x4B,
+  0x6F, 0x6E, 0x67, 0xCA, 0x07, 0x76, 0x64, 0x8C, 0x05, 0x49, 0x72, 0x6B, 0x75, 0x74, 0x73, 0x6B,
+  0x8E, 0x05, 0x4A, 0x61, 0x6B, 0x61, 0x72, 0x74, 0x61, 0xE0, 0x07, 0x79, 0x61, 0x70, 0x75, 0x72,
+  0x61, 0xE1, 0x06, 0x65, 0x72, 0x75, 0x73, 0x61, 0x6C, 0x65, 0x6D, 0xCE, 0x05, 0x4B, 0x61, 0x62,
+  0x75, 0x6C, 0x85, 0x07, 0x6D, 0x63, 0x68, 0x61, 0x74, 0x6B, 0x61, 0x95, 0x07, 0x72, 0x61, 0x63,
+  0x68, 0x69, 0xD8, 0x07, 0x74, 0x68, 0x6D, 0x61, 0x6E, 0x64, 0x75, 0x88, 0x06, 0x68, 0x61, 0x6E,
+  0x64, 0x79, 0x67, 0x61, 0x8F, 0x06, 0x6F, 0x6C, 0x6B, 0x61, 0x74, 0x61, 0xCF, 0x06, 0x72, 0x61,
+  0x73, 0x6E, 0x6F, 0x79, 0x61, 0x72, 0x73, 0x6B, 0x8C, 0x06, 0x75, 0x61, 0x6C, 0x61, 0x5F, 0x4C,
+  0x75, 0x6D, 0x70, 0x75, 0x72, 0x8E, 0x07, 0x63, 0x68, 0x69, 0x6E, 0x67, 0x8E, 0x07, 0x77, 0x61,
+  0x69, 0x74, 0x84, 0x00, 0x41, 0x73, 0x69, 0x61, 0x2F, 0x4D, 0x61, 0x63, 0x61, 0x75, 0xB8, 0x07,
+  0x67, 0x61, 0x64, 0x61, 0x6E, 0x92, 0x07, 0x6B, 0x61, 0x73, 0x73, 0x61, 0x72, 0xE2, 0x07, 0x6E,
+  0x69, 0x6C, 0x61, 0xD9, 0x06, 0x75, 0x73, 0x63, 0x61, 0x74, 0x86, 0x05, 0x4E, 0x69, 0x63, 0x6F,
+  0x73, 0x69, 0x61, 0xC3, 0x06, 0x6F, 0x76, 0x6F, 0x6B, 0x75, 0x7A, 0x6E, 0x65, 0x74, 0x73, 0x6B,
+  0x8C, 0x09, 0x73, 0x69, 0x62, 0x69, 0x72, 0x73, 0x6B, 0x8C, 0x05, 0x4F, 0x6D, 0x73, 0x6B, 0x8B,
+  0x06, 0x72, 0x61, 0x6C, 0x89, 0x05, 0x50, 0x68, 0x6E, 0x6F, 0x6D, 0x5F, 0x50, 0x65, 0x6E, 0x68,
+  0x8C, 0x06, 0x6F, 0x6E, 0x74, 0x69, 0x61, 0x6E, 0x61, 0x6B, 0xE0, 0x06, 0x79, 0x6F, 0x6E, 0x67,
+  0x79, 0x61, 0x6E, 0x67, 0xD1, 0x05, 0x51, 0x61, 0x74, 0x61, 0x72, 0x84, 0x06, 0x79, 0x7A, 0x79,
+  0x6C, 0x6F, 0x72, 0x64, 0x61, 0x89, 0x05, 0x52, 0x69, 0x79, 0x61, 0x64, 0x68, 0x84, 0x00, 0x41,
+  0x73, 0x69, 0x61, 0x2F, 0x53, 0x61, 0x6B, 0x68, 0x61, 0x6C, 0x69, 0x6E, 0x92, 0x07, 0x6D, 0x61,
+  0x72, 0x6B, 0x61, 0x6E, 0x64, 0x89, 0x06, 0x65, 0x6F, 0x75, 0x6C, 0xD1, 0x06, 0x68, 0x61, 0x6E,
+  0x67, 0x68, 0x61, 0x69, 0xB8, 0x06, 0x69, 0x6E, 0x67, 0x61, 0x70, 0x6F, 0x72, 0x65, 0x8E, 0x06,
+  0x72, 0x65, 0x64, 0x6E, 0x65, 0x6B, 0x6F, 0x6C, 0x79, 0x6D, 0x73, 0x6B, 0x92, 0x05, 0x54, 0x61,
+  0x69, 0x70, 0x65, 0x69, 0xB8, 0x07, 0x73, 0x68, 0x6B, 0x65, 0x6E, 0x74, 0x89, 0x06, 0x62, 0x69,
+  0x6C, 0x69, 0x73, 0x69, 0x86, 0x06, 0x65, 0x68, 0x72, 0x61, 0x6E, 0x83, 0x06, 0x68, 0x69, 0x6D,
+  0x70, 0x68, 0x75, 0x8B, 0x06, 0x6F, 0x6B, 0x79, 0x6F, 0xD0, 0x07, 0x6D, 0x73, 0x6B, 0x8C, 0x05,
+  0x55, 0x6C, 0x61, 0x61, 0x6E, 0x62, 0x61, 0x61, 0x74, 0x61, 0x72, 0x8E, 0x06, 0x72, 0x75, 0x6D,
+  0x71, 0x69, 0x8B, 0x06, 0x73, 0x74, 0x6D, 0x4E, 0x65, 0x72, 0x61, 0x91, 0x00, 0x41, 0x73, 0x69,
+  0x61, 0x2F, 0x56, 0x69, 0x65, 0x6E, 0x74, 0x69, 0x61, 0x6E, 0x65, 0x8C, 0x06, 0x6C, 0x61, 0x64,
+  0x69, 0x76, 0x6F, 0x73, 0x74, 0x6F, 0x6B, 0x91, 0x05, 0x59, 0x61, 0x6B, 0x75, 0x74, 0x73, 0x6B,
+  0x8F, 0x07, 0x6E, 0x67, 0x6F, 0x6E, 0x8A, 0x06, 0x65, 0x6B, 0x61, 0x74, 0x65, 0x72, 0x69, 0x6E,
+  0x62, 0x75, 0x72, 0x67, 0x89, 0x07, 0x72, 0x65, 0x76, 0x61, 0x6E, 0x86, 0x01, 0x74, 0x6C, 0x61,
+  0x6E, 0x74, 0x69, 0x63, 0x2F, 0x41, 0x7A, 0x6F, 0x72, 0x65, 0x73, 0x9B, 0x09, 0x42, 0x65, 0x72,
+  0x6D, 0x75, 0x64, 0x61, 0xB3, 0x09, 0x43, 0x61, 0x6E, 0x61, 0x72, 0x79, 0xDF, 0x0B, 0x70, 0x65,
+  0x5F, 0x56, 0x65, 0x72, 0x64, 0x65, 0x9A, 0x09, 0x46, 0x61, 0x72, 0x6F, 0x65, 0xDF, 0x09, 0x4D,
+  0x61, 0x64, 0x65, 0x69, 0x72, 0x61, 0xDF, 0x09, 0x52, 0x65, 0x79, 0x6B, 0x6A, 0x61, 0x76, 0x69,
+  0x6B, 0xC8, 0x09, 0x53, 0x6F, 0x75, 0x74, 0x68, 0x5F, 0x47, 0x65, 0x6F, 0x72, 0x67, 0x69, 0x61,
+  0x9C, 0x0A, 0x74, 0x5F, 0x48, 0x65, 0x6C, 0x65, 0x6E, 0x61, 0xC8, 0x0B, 0x61, 0x6E, 0x6C, 0x65,
+  0x79, 0x9D, 0x00, 0x41, 0x75, 0x73, 0x74, 0x72, 0x61, 0x6C, 0x69, 0x61, 0x2F, 0x41, 0x64, 0x65,
+  0x6C, 0x61, 0x69, 0x64, 0x65, 0xAE, 0x0A, 0x42, 0x72, 0x69, 0x73, 0x62, 0x61, 0x6E, 0x65, 0xAF,
+  0x0C, 0x6F, 0x6B, 0x65, 0x6E, 0x5F, 0x48, 0x69, 0x6C, 0x6C, 0xAE, 0x0A, 0x43, 0x75, 0x72, 0x72,
+  0x69, 0x65, 0xB0, 0x0A, 0x44, 0x61, 0x72, 0x77, 0x69, 0x6E, 0xAD, 0x0A, 0x45, 0x75, 0x63, 0x6C,
+  0x61, 0x8D, 0x0A, 0x48, 0x6F, 0x62, 0x61, 0x72, 0x74, 0xB0, 0x0A, 0x4C, 0x69, 0x6E, 0x64, 0x65,
+  0x6D, 0x61, 0x6E, 0xAF, 0x0B, 0x6F, 0x72, 0x64, 0x5F, 0x48, 0x6F, 0x77, 0x65, 0x90, 0x0A, 0x4D,
+  0x65, 0x6C, 0x62, 0x6F, 0x75, 0x72, 0x6E, 0x65, 0xB0, 0x0A, 0x50, 0x65, 0x72, 0x74, 0x68, 0xB4,
+  0x0A, 0x53, 0x79, 0x64, 0x6E, 0x65, 0x79, 0xB0, 0x00, 0x45, 0x74, 0x63, 0x2F, 0x47, 0x4D, 0x54,
+  0xC8, 0x07, 0x30, 0xC8, 0x07, 0x6D, 0x30, 0xC8, 0x08, 0x31, 0x81, 0x00, 0x45, 0x74, 0x63, 0x2F,
+  0x47, 0x4D, 0x54, 0x6D, 0x31, 0x30, 0x91, 0x09, 0x31, 0x92, 0x09, 0x32, 0x95, 0x09, 0x33, 0x97,
+  0x09, 0x34, 0x99, 0x08, 0x32, 0x82, 0x08, 0x33, 0x84, 0x08, 0x34, 0x86, 0x08, 0x35, 0x89, 0x08,
+  0x36, 0x8B, 0x08, 0x37, 0x8C, 0x08, 0x38, 0x8E, 0x08, 0x39, 0x8F, 0x07, 0x70, 0x30, 0xC8, 0x08,
+  0x31, 0x9A, 0x09, 0x30, 0xAA, 0x00, 0x45, 0x74, 0x63, 0x2F, 0x47, 0x4D, 0x54, 0x70, 0x31, 0x31,
+  0xAB, 0x09, 0x32, 0xAC, 0x08, 0x32, 0x9C, 0x08, 0x33, 0x9D, 0x08, 0x34, 0xA0, 0x08, 0x35, 0xA3,
+  0x08, 0x36, 0xA4, 0x08, 0x37, 0xA6, 0x08, 0x38, 0xA7, 0x08, 0x39, 0xA9, 0x05, 0x72, 0x65, 0x65,
+  0x6E, 0x77, 0x69, 0x63, 0x68, 0xC8, 0x04, 0x55, 0x43, 0x54, 0xDD, 0x05, 0x54, 0x43, 0xDD, 0x05,
+  0x6E, 0x69, 0x76, 0x65, 0x72, 0x73, 0x61, 0x6C, 0xDD, 0x04, 0x5A, 0x75, 0x6C, 0x75, 0xDD, 0x01,
+  0x75, 0x72, 0x6F, 0x70, 0x65, 0x2F, 0x41, 0x6D, 0x73, 0x74, 0x65, 0x72, 0x64, 0x61, 0x6D, 0xB7,
+  0x00, 0x45, 0x75, 0x72, 0x6F, 0x70, 0x65, 0x2F, 0x41, 0x6E, 0x64, 0x6F, 0x72, 0x72, 0x61, 0xB7,
+  0x08, 0x73, 0x74, 0x72, 0x61, 0x6B, 0x68, 0x61, 0x6E, 0x86, 0x08, 0x74, 0x68, 0x65, 0x6E, 0x73,
+  0xC3, 0x07, 0x42, 0x65, 0x6C, 0x67, 0x72, 0x61, 0x64, 0x65, 0xB7, 0x09, 0x72, 0x6C, 0x69, 0x6E,
+  0xB7, 0x08, 0x72, 0x61, 0x74, 0x69, 0x73, 0x6C, 0x61, 0x76, 0x61, 0xB7, 0x09, 0x75, 0x73, 0x73,
+  0x65, 0x6C, 0x73, 0xB7, 0x08, 0x75, 0x63, 0x68, 0x61, 0x72, 0x65, 0x73, 0x74, 0xC3, 0x09, 0x64,
+  0x61, 0x70, 0x65, 0x73, 0x74, 0xB7, 0x09, 0x73, 0x69, 0x6E, 0x67, 0x65, 0x6E, 0xB7, 0x07, 0x43,
+  0x68, 0x69, 0x73, 0x69, 0x6E, 0x61, 0x75, 0xC1, 0x08, 0x6F, 0x70, 0x65, 0x6E, 0x68, 0x61, 0x67,
+  0x65, 0x6E, 0xB7, 0x07, 0x44, 0x75, 0x62, 0x6C, 0x69, 0x6E, 0xCD, 0x07, 0x47, 0x69, 0x62, 0x72,
+  0x61, 0x6C, 0x74, 0x61, 0x72, 0xB7, 0x08, 0x75, 0x65, 0x72, 0x6E, 0x73, 0x65, 0x79, 0xC9, 0x07,
+  0x48, 0x65, 0x6C, 0x73, 0x69, 0x6E, 0x6B, 0x69, 0xC3, 0x00, 0x45, 0x75, 0x72, 0x6F, 0x70, 0x65,
+  0x2F, 0x49, 0x73, 0x6C, 0x65, 0x5F, 0x6F, 0x66, 0x5F, 0x4D, 0x61, 0x6E, 0xC9, 0x09, 0x74, 0x61,
+  0x6E, 0x62, 0x75, 0x6C, 0x84, 0x07, 0x4A, 0x65, 0x72, 0x73, 0x65, 0x79, 0xC9, 0x07, 0x4B, 0x61,
+  0x6C, 0x69, 0x6E, 0x69, 0x6E, 0x67, 0x72, 0x61, 0x64, 0xBF, 0x08, 0x69, 0x65, 0x76, 0xC3, 0x09,
+  0x72, 0x6F, 0x76, 0x84, 0x07, 0x4C, 0x69, 0x73, 0x62, 0x6F, 0x6E, 0xDF, 0x08, 0x6A, 0x75, 0x62,
+  0x6C, 0x6A, 0x61, 0x6E, 0x61, 0xB7, 0x08, 0x6F, 0x6E, 0x64, 0x6F, 0x6E, 0xC9, 0x08, 0x75, 0x78,
+  0x65, 0x6D, 0x62, 0x6F, 0x75, 0x72, 0x67, 0xB7, 0x07, 0x4D, 0x61, 0x64, 0x72, 0x69, 0x64, 0xB7,
+  0x09, 0x6C, 0x74, 0x61, 0xB7, 0x09, 0x72, 0x69, 0x65, 0x68, 0x61, 0x6D, 0x6E, 0xC3, 0x08, 0x69,
+  0x6E, 0x73, 0x6B, 0x84, 0x08, 0x6F, 0x6E, 0x61, 0x63, 0x6F, 0xB7, 0x09, 0x73, 0x63, 0x6F, 0x77,
+  0xD2, 0x00, 0x45, 0x75, 0x72, 0x6F, 0x70, 0x65, 0x2F, 0x4F, 0x73, 0x6C, 0x6F, 0xB7, 0x07, 0x50,
+  0x61, 0x72, 0x69, 0x73, 0xB7, 0x08, 0x6F, 0x64, 0x67, 0x6F, 0x72, 0x69, 0x63, 0x61, 0xB7, 0x08,
+  0x72, 0x61, 0x67, 0x75, 0x65, 0xB7, 0x07, 0x52, 0x69, 0x67, 0x61, 0xC3, 0x08, 0x6F, 0x6D, 0x65,
+  0xB7, 0x07, 0x53, 0x61, 0x6D, 0x61, 0x72, 0x61, 0x86, 0x09, 0x6E, 0x5F, 0x4D, 0x61, 0x72, 0x69,
+  0x6E, 0x6F, 0xB7, 0x09, 0x72, 0x61, 0x6A, 0x65, 0x76, 0x6F, 0xB7, 0x0B, 0x74, 0x6F, 0x76, 0x86,
+  0x08, 0x69, 0x6D, 0x66, 0x65, 0x72, 0x6F, 0x70, 0x6F, 0x6C, 0xD2, 0x08, 0x6B, 0x6F, 0x70, 0x6A,
+  0x65, 0xB7, 0x08, 0x6F, 0x66, 0x69, 0x61, 0xC3, 0x08, 0x74, 0x6F, 0x63, 0x6B, 0x68, 0x6F, 0x6C,
+  0x6D, 0xB7, 0x07, 0x54, 0x61, 0x6C, 0x6C, 0x69, 0x6E, 0x6E, 0xC3, 0x08, 0x69, 0x72, 0x61, 0x6E,
+  0x65, 0xB7, 0x00, 0x45, 0x75, 0x72, 0x6F, 0x70, 0x65, 0x2F, 0x55, 0x6C, 0x79, 0x61, 0x6E, 0x6F,
+  0x76, 0x73, 0x6B, 0x86, 0x08, 0x7A, 0x68, 0x67, 0x6F, 0x72, 0x6F, 0x64, 0xC3, 0x07, 0x56, 0x61,
+  0x64, 0x75, 0x7A, 0xB7, 0x09, 0x74, 0x69, 0x63, 0x61, 0x6E, 0xB7, 0x08, 0x69, 0x65, 0x6E, 0x6E,
+  0x61, 0xB7, 0x09, 0x6C, 0x6E, 0x69, 0x75, 0x73, 0xC3, 0x08, 0x6F, 0x6C, 0x67, 0x6F, 0x67, 0x72,
+  0x61, 0x64, 0x86, 0x07, 0x57, 0x61, 0x72, 0x73, 0x61, 0x77, 0xB7, 0x07, 0x5A, 0x61, 0x67, 0x72,
+  0x65, 0x62, 0xB7, 0x09, 0x70, 0x6F, 0x72, 0x6F, 0x7A, 0x68, 0x79, 0x65, 0xC3, 0x08, 0x75, 0x72,
+  0x69, 0x63, 0x68, 0xB7, 0x00, 0x49, 0x6E, 0x64, 0x69, 0x61, 0x6E, 0x2F, 0x41, 0x6E, 0x74, 0x61,
+  0x6E, 0x61, 0x6E, 0x61, 0x72, 0x69, 0x76, 0x6F, 0xBE, 0x07, 0x43, 0x68, 0x61, 0x67, 0x6F, 0x73,
+  0x8B, 0x09, 0x72, 0x69, 0x73, 0x74, 0x6D, 0x61, 0x73, 0x8C, 0x08, 0x6F, 0x63, 0x6F, 0x73, 0x8A,
+  0x09, 0x6D, 0x6F, 0x72, 0x6F, 0xBE, 0x00, 0x49, 0x6E, 0x64, 0x69, 0x61, 0x6E, 0x2F, 0x4B, 0x65,
+  0x72, 0x67, 0x75, 0x65, 0x6C, 0x65, 0x6E, 0x89, 0x07, 0x4D, 0x61, 0x68, 0x65, 0x86, 0x09, 0x6C,
+  0x64, 0x69, 0x76, 0x65, 0x73, 0x89, 0x09, 0x75, 0x72, 0x69, 0x74, 0x69, 0x75, 0x73, 0x86, 0x09,
+  0x79, 0x6F, 0x74, 0x74, 0x65, 0xBE, 0x07, 0x52, 0x65, 0x75, 0x6E, 0x69, 0x6F, 0x6E, 0x86, 0x00,
+  0x50, 0x61, 0x63, 0x69, 0x66, 0x69, 0x63, 0x2F, 0x41, 0x70, 0x69, 0x61, 0x98, 0x09, 0x75, 0x63,
+  0x6B, 0x6C, 0x61, 0x6E, 0x64, 0xD7, 0x08, 0x42, 0x6F, 0x75, 0x67, 0x61, 0x69, 0x6E, 0x76, 0x69,
+  0x6C, 0x6C, 0x65, 0x92, 0x08, 0x43, 0x68, 0x61, 0x74, 0x68, 0x61, 0x6D, 0x94, 0x0A, 0x75, 0x75,
+  0x6B, 0x91, 0x08, 0x45, 0x61, 0x73, 0x74, 0x65, 0x72, 0xA5, 0x09, 0x66, 0x61, 0x74, 0x65, 0x92,
+  0x09, 0x6E, 0x64, 0x65, 0x72, 0x62, 0x75, 0x72, 0x79, 0x97, 0x08, 0x46, 0x61, 0x6B, 0x61, 0x6F,
+  0x66, 0x6F, 0x97, 0x09, 0x69, 0x6A, 0x69, 0x96, 0x00, 0x50, 0x61, 0x63, 0x69, 0x66, 0x69, 0x63,
+  0x2F, 0x46, 0x75, 0x6E, 0x61, 0x66, 0x75, 0x74, 0x69, 0x95, 0x08, 0x47, 0x61, 0x6C, 0x61, 0x70,
+  0x61, 0x67, 0x6F, 0x73, 0xA4, 0x0A, 0x6D, 0x62, 0x69, 0x65, 0x72, 0xA9, 0x09, 0x75, 0x61, 0x64,
+  0x61, 0x6C, 0x63, 0x61, 0x6E, 0x61, 0x6C, 0x92, 0x0B, 0x6D, 0xBD, 0x08, 0x48, 0x6F, 0x6E, 0x6F,
+  0x6C, 0x75, 0x6C, 0x75, 0xCB, 0x08, 0x4B, 0x69, 0x72, 0x69, 0x74, 0x69, 0x6D, 0x61, 0x74, 0x69,
+  0x99, 0x09, 0x6F, 0x73, 0x72, 0x61, 0x65, 0x92, 0x09, 0x77, 0x61, 0x6A, 0x61, 0x6C, 0x65, 0x69,
+  0x6E, 0x95, 0x08, 0x4D, 0x61, 0x6A, 0x75, 0x72, 0x6F, 0x95, 0x0A, 0x72, 0x71, 0x75, 0x65, 0x73,
+  0x61, 0x73, 0xA8, 0x09, 0x69, 0x64, 0x77, 0x61, 0x79, 0xDC, 0x08, 0x4E, 0x61, 0x75, 0x72, 0x75,
+  0x95, 0x09, 0x69, 0x75, 0x65, 0xAB, 0x09, 0x6F, 0x72, 0x66, 0x6F, 0x6C, 0x6B, 0x93, 0x0A, 0x75,
+  0x6D, 0x65, 0x61, 0x92, 0x00, 0x50, 0x61, 0x63, 0x69, 0x66, 0x69, 0x63, 0x2F, 0x50, 0x61, 0x67,
+  0x6F, 0x5F, 0x50, 0x61, 0x67, 0x6F, 0xDC, 0x0A, 0x6C, 0x61, 0x75, 0x8F, 0x09, 0x69, 0x74, 0x63,
+  0x61, 0x69, 0x72, 0x6E, 0xA7, 0x09, 0x6F, 0x68, 0x6E, 0x70, 0x65, 0x69, 0x92, 0x0A, 0x72, 0x74,
+  0x5F, 0x4D, 0x6F, 0x72, 0x65, 0x73, 0x62, 0x79, 0x91, 0x08, 0x52, 0x61, 0x72, 0x6F, 0x74, 0x6F,
+  0x6E, 0x67, 0x61, 0xAA, 0x08, 0x53, 0x61, 0x69, 0x70, 0x61, 0x6E, 0xBD, 0x08, 0x54, 0x61, 0x68,
+  0x69, 0x74, 0x69, 0xAA, 0x0A, 0x72, 0x61, 0x77, 0x61, 0x95, 0x09, 0x6F, 0x6E, 0x67, 0x61, 0x74,
+  0x61, 0x70, 0x75, 0x97, 0x08, 0x57, 0x61, 0x6B, 0x65, 0x95, 0x0A, 0x6C, 0x6C, 0x69, 0x73, 0x95,
+};
 
-#if USING_ASIA  
-  "Asia/Aden",                  //PSTR("<+03>-3")
-  "Asia/Almaty",                //PSTR("<+06>-6")
-  "Asia/Amman",                 //PSTR("EET-2EEST",M3.5.4/24",M10.5.5/1")
-  "Asia/Anadyr",                //PSTR("<+12>-12")
-  "Asia/Aqtau",                 //PSTR("<+05>-5")
-  "Asia/Aqtobe",                //PSTR("<+05>-5")
-  "Asia/Ashgabat",              //PSTR("<+05>-5")
-  "Asia/Atyrau",                //PSTR("<+05>-5")
-  "Asia/Baghdad",               //PSTR("<+03>-3")
-  "Asia/Bahrain",               //PSTR("<+03>-3")
-  "Asia/Baku",                  //PSTR("<+04>-4")
-  "Asia/Bangkok",               //PSTR("<+07>-7")
-  "Asia/Barnaul",               //PSTR("<+07>-7")
-  "Asia/Beirut",                //PSTR("EET-2EEST",M3.5.0/0",M10.5.0/0")
-  "Asia/Bishkek",               //PSTR("<+06>-6")
-  "Asia/Brunei",                //PSTR("<+08>-8")
-  "Asia/Chita",                 //PSTR("<+09>-9")
-  "Asia/Choibalsan",            //PSTR("<+08>-8")
-  "Asia/Colombo",               //PSTR("<+0530>-5:30")
-  "Asia/Damascus",              //PSTR("EET-2EEST",M3.5.5/0",M10.5.5/0")
-  "Asia/Dhaka",                 //PSTR("<+06>-6")
-  "Asia/Dili",                  //PSTR("<+09>-9")
-  "Asia/Dubai",                 //PSTR("<+04>-4")
-  "Asia/Dushanbe",              //PSTR("<+05>-5")
-  "Asia/Famagusta",             //PSTR("EET-2EEST",M3.5.0/3",M10.5.0/4")
-  "Asia/Gaza",                  //PSTR("EET-2EEST",M3.4.4/48",M10.4.4/49")
-  "Asia/Hebron",                //PSTR("EET-2EEST",M3.4.4/48",M10.4.4/49")
-  "Asia/Ho_Chi_Minh",           //PSTR("<+07>-7")
-  "Asia/Hong_Kong",             //PSTR("HKT-8")
-  "Asia/Hovd",                  //PSTR("<+07>-7")
-  "Asia/Irkutsk",               //PSTR("<+08>-8")
-  "Asia/Jakarta",               //PSTR("WIB-7")
-  "Asia/Jayapura",              //PSTR("WIT-9")
-  "Asia/Jerusalem",             //PSTR("IST-2IDT",M3.4.4/26",M10.5.0")
-  "Asia/Kabul",                 //PSTR("<+0430>-4:30")
-  "Asia/Kamchatka",             //PSTR("<+12>-12")
-  "Asia/Karachi",               //PSTR("PKT-5")
-  "Asia/Kathmandu",             //PSTR("<+0545>-5:45")
-  "Asia/Khandyga",              //PSTR("<+09>-9")
-  "Asia/Kolkata",               //PSTR("IST-5:30")
-  "Asia/Krasnoyarsk",           //PSTR("<+07>-7")
-  "Asia/Kuala_Lumpur",          //PSTR("<+08>-8")
-  "Asia/Kuching",               //PSTR("<+08>-8")
-  "Asia/Kuwait",                //PSTR("<+03>-3")
-  "Asia/Macau",                 //PSTR("CST-8")
-  "Asia/Magadan",               //PSTR("<+11>-11")
-  "Asia/Makassar",              //PSTR("WITA-8")
-  "Asia/Manila",                //PSTR("PST-8")
-  "Asia/Muscat",                //PSTR("<+04>-4")
-  "Asia/Nicosia",               //PSTR("EET-2EEST",M3.5.0/3",M10.5.0/4")
-  "Asia/Novokuznetsk",          //PSTR("<+07>-7")
-  "Asia/Novosibirsk",           //PSTR("<+07>-7")
-  "Asia/Omsk",                  //PSTR("<+06>-6")
-  "Asia/Oral",                  //PSTR("<+05>-5")
-  "Asia/Phnom_Penh",            //PSTR("<+07>-7")
-  "Asia/Pontianak",             //PSTR("WIB-7")
-  "Asia/Pyongyang",             //PSTR("KST-9")
-  "Asia/Qatar",                 //PSTR("<+03>-3")
-  "Asia/Qyzylorda",             //PSTR("<+05>-5")
-  "Asia/Riyadh",                //PSTR("<+03>-3")
-  "Asia/Sakhalin",              //PSTR("<+11>-11")
-  "Asia/Samarkand",             //PSTR("<+05>-5")
-  "Asia/Seoul",                 //PSTR("KST-9")
-  "Asia/Shanghai",              //PSTR("CST-8")
-  "Asia/Singapore",             //PSTR("<+08>-8")
-  "Asia/Srednekolymsk",         //PSTR("<+11>-11")
-  "Asia/Taipei",                //PSTR("CST-8")
-  "Asia/Tashkent",              //PSTR("<+05>-5")
-  "Asia/Tbilisi",               //PSTR("<+04>-4")
-  "Asia/Tehran",                //PSTR("<+0330>-3:30<+0430>",J79/24",J263/24")
-  "Asia/Thimphu",               //PSTR("<+06>-6")
-  "Asia/Tokyo",                 //PSTR("JST-9")
-  "Asia/Tomsk",                 //PSTR("<+07>-7")
-  "Asia/Ulaanbaatar",           //PSTR("<+08>-8")
-  "Asia/Urumqi",                //PSTR("<+06>-6")
-  "Asia/UstmNera",              //PSTR("<+10>-10")
-  "Asia/Vientiane",             //PSTR("<+07>-7")
-  "Asia/Vladivostok",           //PSTR("<+10>-10")
-  "Asia/Yakutsk",               //PSTR("<+09>-9")
-  "Asia/Yangon",                //PSTR("<+0630>-6:30")
-  "Asia/Yekaterinburg",         //PSTR("<+05>-5")
-  "Asia/Yerevan",               //PSTR("<+04>-4")
-#endif
+static const uint16_t WM_TZ_RESTARTS[] PROGMEM =
+{
+  0, 137, 288, 431, 602, 748, 891, 1047, 1205, 1363, 1514, 1683,
+  1841, 2006, 2143, 2276, 2419, 2558, 2700, 2866, 3003, 3061, 3152, 3305,
+  3441, 3570, 3718, 3864, 4004,
+};
 
+static const char WM_TZ_RULES[] PROGMEM =
+  "<+00>0<+02>-2,M3.5.0/1,M10.5.0/3\0"
+  "<+01>-1\0"
+  "<+02>-2\0"
+  "<+0330>-3:30<+0430>,J79/24,J263/24\0"
+  "<+03>-3\0"
+  "<+0430>-4:30\0"
+  "<+04>-4\0"
+  "<+0530>-5:30\0"
+  "<+0545>-5:45\0"
+  "<+05>-5\0"
+  "<+0630>-6:30\0"
+  "<+06>-6\0"
+  "<+07>-7\0"
+  "<+0845>-8:45\0"
+  "<+08>-8\0"
+  "<+09>-9\0"
+  "<+1030>-10:30<+11>-11,M10.1.0,M4.1.0\0"
+  "<+10>-10\0"
+  "<+11>-11\0"
+  "<+11>-11<+12>,M10.1.0,M4.1.0/3\0"
+  "<+1245>-12:45<+1345>,M9.5.0/2:45,M4.1.0/3:45\0"
+  "<+12>-12\0"
+  "<+12>-12<+13>,M11.2.0,M1.2.3/99\0"
+  "<+13>-13\0"
+  "<+13>-13<+14>,M9.5.0/3,M4.1.0/4\0"
+  "<+14>-14\0"
+  "<-01>1\0"
+  "<-01>1<+00>,M3.5.0/0,M10.5.0/1\0"
+  "<-02>2\0"
+  "<-03>3\0"
+  "<-03>3<-02>,M3.2.0,M11.1.0\0"
+  "<-03>3<-02>,M3.5.0/-2,M10.5.0/-1\0"
+  "<-04>4\0"
+  "<-04>4<-03>,M10.1.0/0,M3.4.0/0\0"
+  "<-04>4<-03>,M9.1.6/24,M4.1.6/24\0"
+  "<-05>5\0"
+  "<-06>6\0"
+  "<-06>6<-05>,M9.1.6/22,M4.1.6/22\0"
+  "<-07>7\0"
+  "<-08>8\0"
+  "<-0930>9:30\0"
+  "<-09>9\0"
+  "<-10>10\0"
+  "<-11>11\0"
+  "<-12>12\0"
+  "ACST-9:30\0"
+  "ACST-9:30ACDT,M10.1.0,M4.1.0/3\0"
+  "AEST-10\0"
+  "AEST-10AEDT,M10.1.0,M4.1.0/3\0"
+  "AKST9AKDT,M3.2.0,M11.1.0\0"
+  "AST4\0"
+  "AST4ADT,M3.2.0,M11.1.0\0"
+  "AWST-8\0"
+  "CAT-2\0"
+  "CET-1\0"
+  "CET-1CEST,M3.5.0,M10.5.0/3\0"
+  "CST-8\0"
+  "CST5CDT,M3.2.0/0,M11.1.0/1\0"
+  "CST6\0"
+  "CST6CDT,M3.2.0,M11.1.0\0"
+  "CST6CDT,M4.1.0,M10.5.0\0"
+  "ChST-10\0"
+  "EAT-3\0"
+  "EET-2\0"
+  "EET-2EEST,M3.4.4/48,M10.4.4/49\0"
+  "EET-2EEST,M3.5.0,M10.5.0/3\0"
+  "EET-2EEST,M3.5.0/0,M10.5.0/0\0"
+  "EET-2EEST,M3.5.0/3,M10.5.0/4\0"
+  "EET-2EEST,M3.5.4/24,M10.5.5/1\0"
+  "EET-2EEST,M3.5.5/0,M10.5.5/0\0"
+  "EST5\0"
+  "EST5EDT,M3.2.0,M11.1.0\0"
+  "GMT0\0"
+  "GMT0BST,M3.5.0/1,M10.5.0\0"
+  "HKT-8\0"
+  "HST10\0"
+  "HST10HDT,M3.2.0,M11.1.0\0"
+  "IST-1GMT0,M10.5.0,M3.5.0/1\0"
+  "IST-2IDT,M3.4.4/26,M10.5.0\0"
+  "IST-5:30\0"
+  "JST-9\0"
+  "KST-9\0"
+  "MSK-3\0"
+  "MST7\0"
+  "MST7MDT,M3.2.0,M11.1.0\0"
+  "MST7MDT,M4.1.0,M10.5.0\0"
+  "NST3:30NDT,M3.2.0,M11.1.0\0"
+  "NZST-12NZDT,M9.5.0,M4.1.0/3\0"
+  "PKT-5\0"
+  "PST-8\0"
+  "PST8PDT,M3.2.0,M11.1.0\0"
+  "SAST-2\0"
+  "SST11\0"
+  "UTC0\0"
+  "WAT-1\0"
+  "WET0WEST,M3.5.0/1,M10.5.0\0"
+  "WIB-7\0"
+  "WIT-9\0"
+  "WITA-8\0"
+  ;
+
+static const uint16_t WM_TZ_RULE_INDEX[] PROGMEM =
+{
+  0, 33, 41, 49, 84, 92, 105, 113, 126, 139, 147, 160,
+  168, 176, 189, 197, 205, 242, 251, 260, 291, 336, 345, 377,
+  386, 418, 427, 434, 465, 472, 479, 506, 539, 546, 577, 609,
+  616, 623, 655, 662, 669, 681, 688, 696, 704, 712, 722, 753,
+  761, 790, 815, 820, 843, 850, 856, 862, 889, 895, 922, 927,
+  950, 973, 981, 987, 993, 1024, 1051, 1080, 1109, 1139, 1168, 1173,
+  1196, 1201, 1226, 1232, 1238, 1262, 1289, 1316, 1325, 1331, 1337, 1343,
+  1348, 1371, 1394, 1420, 1448, 1454, 1460, 1483, 1490, 1496, 1501, 1507,
+  1533, 1539, 1545,
+};
 
-#if USING_ATLANTIC  
-  "Atlantic/Azores",            //PSTR("<-01>1<+00>",M3.5.0/0",M10.5.0/1")
-  "Atlantic/Bermuda",           //PSTR("AST4ADT",M3.2.0",M11.1.0")
-  "Atlantic/Canary",            //PSTR("WET0WEST",M3.5.0/1",M10.5.0")
-  "Atlantic/Cape_Verde",        //PSTR("<-01>1")
-  "Atlantic/Faroe",             //PSTR("WET0WEST",M3.5.0/1",M10.5.0")
-  "Atlantic/Madeira",           //PSTR("WET0WEST",M3.5.0/1",M10.5.0")
-  "Atlantic/Reykjavik",         //PSTR("GMT0")
-  "Atlantic/South_Georgia",     //PSTR("<-02>2")
-  "Atlantic/Stanley",           //PSTR("<-03>3")
-  "Atlantic/St_Helena",         //PSTR("GMT0")
-#endif
+////////////////////////////////////////////////////////////
 
-#if USING_AUSTRALIA  
-  "Australia/Adelaide",         //PSTR("ACST-9:30ACDT",M10.1.0",M4.1.0/3")
-  "Australia/Brisbane",         //PSTR("AEST-10")
-  "Australia/Broken_Hill",      //PSTR("ACST-9:30ACDT",M10.1.0",M4.1.0/3")
-  "Australia/Currie",           //PSTR("AEST-10AEDT",M10.1.0",M4.1.0/3")
-  "Australia/Darwin",           //PSTR("ACST-9:30")
-  "Australia/Eucla",            //PSTR("<+0845>-8:45")
-  "Australia/Hobart",           //PSTR("AEST-10AEDT",M10.1.0",M4.1.0/3")
-  "Australia/Lindeman",         //PSTR("AEST-10")
-  "Australia/Lord_Howe",        //PSTR("<+1030>-10:30<+11>-11",M10.1.0",M4.1.0")
-  "Australia/Melbourne",        //PSTR("AEST-10AEDT",M10.1.0",M4.1.0/3")
-  "Australia/Perth",            //PSTR("AWST-8")
-  "Australia/Sydney",           //PSTR("AEST-10AEDT",M10.1.0",M4.1.0/3")
-#endif
+// Compares timezoneName with the name of the restart entry at offset. Returns <0, 0 or >0 like strcmp().
+inline int WM_compareTZRestart(const char * timezoneName, const uint16_t& offset)
+{
+  // Restart entries share no prefix : the name starts right after the zero length
+  const uint8_t* entry = &WM_TZ_NAMES[offset + 1];
 
-#if USING_EUROPE
-  "Europe/Amsterdam",           //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Andorra",             //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Astrakhan",           //PSTR("<+04>-4")
-  "Europe/Athens",              //PSTR("EET-2EEST",M3.5.0/3",M10.5.0/4")
-  "Europe/Belgrade",            //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Berlin",              //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Bratislava",          //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Brussels",            //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Bucharest",           //PSTR("EET-2EEST",M3.5.0/3",M10.5.0/4")
-  "Europe/Budapest",            //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Busingen",            //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Chisinau",            //PSTR("EET-2EEST",M3.5.0",M10.5.0/3")
-  "Europe/Copenhagen",          //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Dublin",              //PSTR("IST-1GMT0",M10.5.0",M3.5.0/1")
-  "Europe/Gibraltar",           //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Guernsey",            //PSTR("GMT0BST",M3.5.0/1",M10.5.0")
-  "Europe/Helsinki",            //PSTR("EET-2EEST",M3.5.0/3",M10.5.0/4")
-  "Europe/Isle_of_Man",         //PSTR("GMT0BST",M3.5.0/1",M10.5.0")
-  "Europe/Istanbul",            //PSTR("<+03>-3")
-  "Europe/Jersey",              //PSTR("GMT0BST",M3.5.0/1",M10.5.0")
-  "Europe/Kaliningrad",         //PSTR("EET-2")
-  "Europe/Kiev",                //PSTR("EET-2EEST",M3.5.0/3",M10.5.0/4")
-  "Europe/Kirov",               //PSTR("<+03>-3")
-  "Europe/Lisbon",              //PSTR("WET0WEST",M3.5.0/1",M10.5.0")
-  "Europe/Ljubljana",           //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/London",              //PSTR("GMT0BST",M3.5.0/1",M10.5.0")
-  "Europe/Luxembourg",          //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Madrid",              //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Malta",               //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Mariehamn",           //PSTR("EET-2EEST",M3.5.0/3",M10.5.0/4")
-  "Europe/Minsk",               //PSTR("<+03>-3")
-  "Europe/Monaco",              //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Moscow",              //PSTR("MSK-3")
-  "Europe/Oslo",                //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Paris",               //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Podgorica",           //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Prague",              //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Riga",                //PSTR("EET-2EEST",M3.5.0/3",M10.5.0/4")
-  "Europe/Rome",                //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Samara",              //PSTR("<+04>-4")
-  "Europe/San_Marino",          //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Sarajevo",            //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Saratov",             //PSTR("<+04>-4")
-  "Europe/Simferopol",          //PSTR("MSK-3")
-  "Europe/Skopje",              //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Sofia",               //PSTR("EET-2EEST",M3.5.0/3",M10.5.0/4")
-  "Europe/Stockholm",           //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Tallinn",             //PSTR("EET-2EEST",M3.5.0/3",M10.5.0/4")
-  "Europe/Tirane",              //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Ulyanovsk",           //PSTR("<+04>-4")
-  "Europe/Uzhgorod",            //PSTR("EET-2EEST",M3.5.0/3",M10.5.0/4")
-  "Europe/Vaduz",               //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Vatican",             //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Vienna",              //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Vilnius",             //PSTR("EET-2EEST",M3.5.0/3",M10.5.0/4")
-  "Europe/Volgograd",           //PSTR("<+04>-4")
-  "Europe/Warsaw",              //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Zagreb",              //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-  "Europe/Zaporozhye",          //PSTR("EET-2EEST",M3.5.0/3",M10.5.0/4")
-  "Europe/Zurich",              //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
-#endif
+  for (uint8_t i = 0; ; i++)
+  {
+    uint8_t c = pgm_read_byte(&entry[i]);
 
-#if USING_INDIAN  
-  "Indian/Antananarivo",        //PSTR("EAT-3")
-  "Indian/Chagos",              //PSTR("<+06>-6")
-  "Indian/Christmas",           //PSTR("<+07>-7")
-  "Indian/Cocos",               //PSTR("<+0630>-6:30")
-  "Indian/Comoro",              //PSTR("EAT-3")
-  "Indian/Kerguelen",           //PSTR("<+05>-5")
-  "Indian/Mahe",                //PSTR("<+04>-4")
-  "Indian/Maldives",            //PSTR("<+05>-5")
-  "Indian/Mauritius",           //PSTR("<+04>-4")
-  "Indian/Mayotte",             //PSTR("EAT-3")
-  "Indian/Reunion",             //PSTR("<+04>-4")
-#endif
-  
-#if USING_PACIFIC   
-  "Pacific/Apia",               //PSTR("<+13>-13<+14>",M9.5.0/3",M4.1.0/4")
-  "Pacific/Auckland",           //PSTR("NZST-12NZDT",M9.5.0",M4.1.0/3")
-  "Pacific/Bougainville",       //PSTR("<+11>-11")
-  "Pacific/Chatham",            //PSTR("<+1245>-12:45<+1345>",M9.5.0/2:45",M4.1.0/3:45")
-  "Pacific/Chuuk",              //PSTR("<+10>-10")
-  "Pacific/Easter",             //PSTR("<-06>6<-05>",M9.1.6/22",M4.1.6/22")
-  "Pacific/Efate",              //PSTR("<+11>-11")
-  "Pacific/Enderbury",          //PSTR("<+13>-13")
-  "Pacific/Fakaofo",            //PSTR("<+13>-13")
-  "Pacific/Fiji",               //PSTR("<+12>-12<+13>",M11.2.0",M1.2.3/99")
-  "Pacific/Funafuti",           //PSTR("<+12>-12")
-  "Pacific/Galapagos",          //PSTR("<-06>6")
-  "Pacific/Gambier",            //PSTR("<-09>9")
-  "Pacific/Guadalcanal",        //PSTR("<+11>-11")
-  "Pacific/Guam",               //PSTR("ChST-10")
-  "Pacific/Honolulu",           //PSTR("HST10")
-  "Pacific/Kiritimati",         //PSTR("<+14>-14")
-  "Pacific/Kosrae",             //PSTR("<+11>-11")
-  "Pacific/Kwajalein",          //PSTR("<+12>-12")
-  "Pacific/Majuro",             //PSTR("<+12>-12")
-  "Pacific/Marquesas",          //PSTR("<-0930>9:30")
-  "Pacific/Midway",             //PSTR("SST11")
-  "Pacific/Nauru",              //PSTR("<+12>-12")
-  "Pacific/Niue",               //PSTR("<-11>11")
-  "Pacific/Norfolk",            //PSTR("<+11>-11<+12>",M10.1.0",M4.1.0/3")
-  "Pacific/Noumea",             //PSTR("<+11>-11")
-  "Pacific/Pago_Pago",          //PSTR("SST11")
-  "Pacific/Palau",              //PSTR("<+09>-9")
-  "Pacific/Pitcairn",           //PSTR("<-08>8")
-  "Pacific/Pohnpei",            //PSTR("<+11>-11")
-  "Pacific/Port_Moresby",       //PSTR("<+10>-10")
-  "Pacific/Rarotonga",          //PSTR("<-10>10")
-  "Pacific/Saipan",             //PSTR("ChST-10")
-  "Pacific/Tahiti",             //PSTR("<-10>10")
-  "Pacific/Tarawa",             //PSTR("<+12>-12")
-  "Pacific/Tongatapu",          //PSTR("<+13>-13")
-  "Pacific/Wake",               //PSTR("<+12>-12")
-  "Pacific/Wallis",             //PSTR("<+12>-12")
-#endif
+    // End of name : equal if the query ends too
+    if (c & 0x80)
+      return (uint8_t) timezoneName[i];
 
-#if USING_ETC_GMT  
-  "Etc/GMT",                    //PSTR("GMT0")
-  "Etc/GMTm0",                  //PSTR("GMT0")
-  "Etc/GMTm1",                  //PSTR("<+01>-1")
-  "Etc/GMTm2",                  //PSTR("<+02>-2")
-  "Etc/GMTm3",                  //PSTR("<+03>-3")
-  "Etc/GMTm4",                  //PSTR("<+04>-4")
-  "Etc/GMTm5",                  //PSTR("<+05>-5")
-  "Etc/GMTm6",                  //PSTR("<+06>-6")
-  "Etc/GMTm7",                  //PSTR("<+07>-7")
-  "Etc/GMTm8",                  //PSTR("<+08>-8")
-  "Etc/GMTm9",                  //PSTR("<+09>-9")
-  "Etc/GMTm10",                 //PSTR("<+10>-10")
-  "Etc/GMTm11",                 //PSTR("<+11>-11")
-  "Etc/GMTm12",                 //PSTR("<+12>-12")
-  "Etc/GMTm13",                 //PSTR("<+13>-13")
-  "Etc/GMTm14",                 //PSTR("<+14>-14")
-  "Etc/GMT0",                   //PSTR("GMT0")
-  "Etc/GMTp0",                  //PSTR("GMT0")
-  "Etc/GMTp1",                  //PSTR("<-01>1")
-  "Etc/GMTp2",                  //PSTR("<-02>2")
-  "Etc/GMTp3",                  //PSTR("<-03>3")
-  "Etc/GMTp4",                  //PSTR("<-04>4")
-  "Etc/GMTp5",                  //PSTR("<-05>5")
-  "Etc/GMTp6",                  //PSTR("<-06>6")
-  "Etc/GMTp7",                  //PSTR("<-07>7")
-  "Etc/GMTp8",                  //PSTR("<-08>8")
-  "Etc/GMTp9",                  //PSTR("<-09>9")
-  "Etc/GMTp10",                 //PSTR("<-10>10")
-  "Etc/GMTp11",                 //PSTR("<-11>11")
-  "Etc/GMTp12",                 //PSTR("<-12>12")
-  "Etc/UCT",                    //PSTR("UTC0")
-  "Etc/UTC",                    //PSTR("UTC0")
-  "Etc/Greenwich",              //PSTR("GMT0")
-  "Etc/Universal",              //PSTR("UTC0")
-  "Etc/Zulu",                   //PSTR("UTC0")
-#endif  
-};
+    if ((uint8_t) timezoneName[i] != c)
+      return (int) (uint8_t) timezoneName[i] - (int) c;
+  }
+}
 
 ////////////////////////////////////////////////////////////
 
-static const char ESP_TZ_NAME[][TIMEZONE_MAX_LEN] /*PROGMEM*/ =
+// Copies the POSIX rule of the exact timezoneName into rule. Returns false if the name is unknown.
+inline bool WM_findTZRule(const char * timezoneName, char * rule, const size_t& ruleLen)
 {
-#if USING_AFRICA
-  TZ_Africa_Abidjan,  //PSTR("GMT0")
-  TZ_Africa_Accra,  //PSTR("GMT0")
-  TZ_Africa_Addis_Ababa,  //PSTR("EAT-3")
-  TZ_Africa_Algiers,  //PSTR("CET-1")
-  TZ_Africa_Asmara,  //PSTR("EAT-3")
-  TZ_Africa_Bamako,  //PSTR("GMT0")
-  TZ_Africa_Bangui,  //PSTR("WAT-1")
-  TZ_Africa_Banjul,  //PSTR("GMT0")
-  TZ_Africa_Bissau,  //PSTR("GMT0")
-  TZ_Africa_Blantyre,  //PSTR("CAT-2")
-  TZ_Africa_Brazzaville,  //PSTR("WAT-1")
-  TZ_Africa_Bujumbura,  //PSTR("CAT-2")
-  TZ_Africa_Cairo,  //PSTR("EET-2")
-  TZ_Africa_Casablanca,  //PSTR("<+01>-1")
-  TZ_Africa_Ceuta,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Africa_Conakry,  //PSTR("GMT0")
-  TZ_Africa_Dakar,  //PSTR("GMT0")
-  TZ_Africa_Dar_es_Salaam,  //PSTR("EAT-3")
-  TZ_Africa_Djibouti,  //PSTR("EAT-3")
-  TZ_Africa_Douala,  //PSTR("WAT-1")
-  TZ_Africa_El_Aaiun,  //PSTR("<+01>-1")
-  TZ_Africa_Freetown,  //PSTR("GMT0")
-  TZ_Africa_Gaborone,  //PSTR("CAT-2")
-  TZ_Africa_Harare,  //PSTR("CAT-2")
-  TZ_Africa_Johannesburg,  //PSTR("SAST-2")
-  TZ_Africa_Juba,  //PSTR("EAT-3")
-  TZ_Africa_Kampala,  //PSTR("EAT-3")
-  TZ_Africa_Khartoum,  //PSTR("CAT-2")
-  TZ_Africa_Kigali,  //PSTR("CAT-2")
-  TZ_Africa_Kinshasa,  //PSTR("WAT-1")
-  TZ_Africa_Lagos,  //PSTR("WAT-1")
-  TZ_Africa_Libreville,  //PSTR("WAT-1")
-  TZ_Africa_Lome,  //PSTR("GMT0")
-  TZ_Africa_Luanda,  //PSTR("WAT-1")
-  TZ_Africa_Lubumbashi,  //PSTR("CAT-2")
-  TZ_Africa_Lusaka,  //PSTR("CAT-2")
-  TZ_Africa_Malabo,  //PSTR("WAT-1")
-  TZ_Africa_Maputo,  //PSTR("CAT-2")
-  TZ_Africa_Maseru,  //PSTR("SAST-2")
-  TZ_Africa_Mbabane,  //PSTR("SAST-2")
-  TZ_Africa_Mogadishu,  //PSTR("EAT-3")
-  TZ_Africa_Monrovia,  //PSTR("GMT0")
-  TZ_Africa_Nairobi,  //PSTR("EAT-3")
-  TZ_Africa_Ndjamena,  //PSTR("WAT-1")
-  TZ_Africa_Niamey,  //PSTR("WAT-1")
-  TZ_Africa_Nouakchott,  //PSTR("GMT0")
-  TZ_Africa_Ouagadougou,  //PSTR("GMT0")
-  TZ_Africa_PortomNovo,  //PSTR("WAT-1")
-  TZ_Africa_Sao_Tome,  //PSTR("GMT0")
-  TZ_Africa_Tripoli,  //PSTR("EET-2")
-  TZ_Africa_Tunis,  //PSTR("CET-1")
-  TZ_Africa_Windhoek,  //PSTR("CAT-2")
-#endif
+  if (!timezoneName || !rule || (ruleLen == 0) || (strlen(timezoneName) > WM_TZ_NAME_MAX_LEN))
+    return false;
 
+  // Last restart entry not after the name
+  uint16_t low  = 0;
+  uint16_t high = WM_TZ_RESTART_COUNT;
 
-#if USING_AMERICA  
-  TZ_America_Adak,  //PSTR("HST10HDT,M3.2.0,M11.1.0")
-  TZ_America_Anchorage,  //PSTR("AKST9AKDT,M3.2.0,M11.1.0")
-  TZ_America_Anguilla,  //PSTR("AST4")
-  TZ_America_Antigua,  //PSTR("AST4")
-  TZ_America_Araguaina,  //PSTR("<-03>3")
-  TZ_America_Argentina_Buenos_Aires,  //PSTR("<-03>3")
-  TZ_America_Argentina_Catamarca,  //PSTR("<-03>3")
-  TZ_America_Argentina_Cordoba,  //PSTR("<-03>3")
-  TZ_America_Argentina_Jujuy,  //PSTR("<-03>3")
-  TZ_America_Argentina_La_Rioja,  //PSTR("<-03>3")
-  TZ_America_Argentina_Mendoza,  //PSTR("<-03>3")
-  TZ_America_Argentina_Rio_Gallegos,  //PSTR("<-03>3")
-  TZ_America_Argentina_Salta,  //PSTR("<-03>3")
-  TZ_America_Argentina_San_Juan,  //PSTR("<-03>3")
-  TZ_America_Argentina_San_Luis,  //PSTR("<-03>3")
-  TZ_America_Argentina_Tucuman,  //PSTR("<-03>3")
-  TZ_America_Argentina_Ushuaia,  //PSTR("<-03>3")
-  TZ_America_Aruba,  //PSTR("AST4")
-  TZ_America_Asuncion,  //PSTR("<-04>4<-03>,M10.1.0/0,M3.4.0/0")
-  TZ_America_Atikokan,  //PSTR("EST5")
-  TZ_America_Bahia,  //PSTR("<-03>3")
-  TZ_America_Bahia_Banderas,  //PSTR("CST6CDT,M4.1.0,M10.5.0")
-  TZ_America_Barbados,  //PSTR("AST4")
-  TZ_America_Belem,  //PSTR("<-03>3")
-  TZ_America_Belize,  //PSTR("CST6")
-  TZ_America_BlancmSablon,  //PSTR("AST4")
-  TZ_America_Boa_Vista,  //PSTR("<-04>4")
-  TZ_America_Bogota,  //PSTR("<-05>5")
-  TZ_America_Boise,  //PSTR("MST7MDT,M3.2.0,M11.1.0")
-  TZ_America_Cambridge_Bay,  //PSTR("MST7MDT,M3.2.0,M11.1.0")
-  TZ_America_Campo_Grande,  //PSTR("<-04>4")
-  TZ_America_Cancun,  //PSTR("EST5")
-  TZ_America_Caracas,  //PSTR("<-04>4")
-  TZ_America_Cayenne,  //PSTR("<-03>3")
-  TZ_America_Cayman,  //PSTR("EST5")
-  TZ_America_Chicago,  //PSTR("CST6CDT,M3.2.0,M11.1.0")
-  TZ_America_Chihuahua,  //PSTR("MST7MDT,M4.1.0,M10.5.0")
-  TZ_America_Costa_Rica,  //PSTR("CST6")
-  TZ_America_Creston,  //PSTR("MST7")
-  TZ_America_Cuiaba,  //PSTR("<-04>4")
-  TZ_America_Curacao,  //PSTR("AST4")
-  TZ_America_Danmarkshavn,  //PSTR("GMT0")
-  TZ_America_Dawson,  //PSTR("MST7")
-  TZ_America_Dawson_Creek,  //PSTR("MST7")
-  TZ_America_Denver,  //PSTR("MST7MDT,M3.2.0,M11.1.0")
-  TZ_America_Detroit,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
-  TZ_America_Dominica,  //PSTR("AST4")
-  TZ_America_Edmonton,  //PSTR("MST7MDT,M3.2.0,M11.1.0")
-  TZ_America_Eirunepe,  //PSTR("<-05>5")
-  TZ_America_El_Salvador,  //PSTR("CST6")
-  TZ_America_Fortaleza,  //PSTR("<-03>3")
-  TZ_America_Fort_Nelson,  //PSTR("MST7")
-  TZ_America_Glace_Bay,  //PSTR("AST4ADT,M3.2.0,M11.1.0")
-  TZ_America_Godthab,  //PSTR("<-03>3<-02>,M3.5.0/-2,M10.5.0/-1")
-  TZ_America_Goose_Bay,  //PSTR("AST4ADT,M3.2.0,M11.1.0")
-  TZ_America_Grand_Turk,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
-  TZ_America_Grenada,  //PSTR("AST4")
-  TZ_America_Guadeloupe,  //PSTR("AST4")
-  TZ_America_Guatemala,  //PSTR("CST6")
-  TZ_America_Guayaquil,  //PSTR("<-05>5")
-  TZ_America_Guyana,  //PSTR("<-04>4")
-  TZ_America_Halifax,  //PSTR("AST4ADT,M3.2.0,M11.1.0")
-  TZ_America_Havana,  //PSTR("CST5CDT,M3.2.0/0,M11.1.0/1")
-  TZ_America_Hermosillo,  //PSTR("MST7")
-  TZ_America_Indiana_Indianapolis,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
-  TZ_America_Indiana_Knox,  //PSTR("CST6CDT,M3.2.0,M11.1.0")
-  TZ_America_Indiana_Marengo,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
-  TZ_America_Indiana_Petersburg,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
-  TZ_America_Indiana_Tell_City,  //PSTR("CST6CDT,M3.2.0,M11.1.0")
-  TZ_America_Indiana_Vevay,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
-  TZ_America_Indiana_Vincennes,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
-  TZ_America_Indiana_Winamac,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
-  TZ_America_Inuvik,  //PSTR("MST7MDT,M3.2.0,M11.1.0")
-  TZ_America_Iqaluit,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
-  TZ_America_Jamaica,  //PSTR("EST5")
-  TZ_America_Juneau,  //PSTR("AKST9AKDT,M3.2.0,M11.1.0")
-  TZ_America_Kentucky_Louisville,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
-  TZ_America_Kentucky_Monticello,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
-  TZ_America_Kralendijk,  //PSTR("AST4")
-  TZ_America_La_Paz,  //PSTR("<-04>4")
-  TZ_America_Lima,  //PSTR("<-05>5")
-  TZ_America_Los_Angeles,  //PSTR("PST8PDT,M3.2.0,M11.1.0")
-  TZ_America_Lower_Princes,  //PSTR("AST4")
-  TZ_America_Maceio,  //PSTR("<-03>3")
-  TZ_America_Managua,  //PSTR("CST6")
-  TZ_America_Manaus,  //PSTR("<-04>4")
-  TZ_America_Marigot,  //PSTR("AST4")
-  TZ_America_Martinique,  //PSTR("AST4")
-  TZ_America_Matamoros,  //PSTR("CST6CDT,M3.2.0,M11.1.0")
-  TZ_America_Mazatlan,  //PSTR("MST7MDT,M4.1.0,M10.5.0")
-  TZ_America_Menominee,  //PSTR("CST6CDT,M3.2.0,M11.1.0")
-  TZ_America_Merida,  //PSTR("CST6CDT,M4.1.0,M10.5.0")
-  TZ_America_Metlakatla,  //PSTR("AKST9AKDT,M3.2.0,M11.1.0")
-  TZ_America_Mexico_City,  //PSTR("CST6CDT,M4.1.0,M10.5.0")
-  TZ_America_Miquelon,  //PSTR("<-03>3<-02>,M3.2.0,M11.1.0")
-  TZ_America_Moncton,  //PSTR("AST4ADT,M3.2.0,M11.1.0")
-  TZ_America_Monterrey,  //PSTR("CST6CDT,M4.1.0,M10.5.0")
-  TZ_America_Montevideo,  //PSTR("<-03>3")
-  TZ_America_Montreal,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
-  TZ_America_Montserrat,  //PSTR("AST4")
-  TZ_America_Nassau,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
-  TZ_America_New_York,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
-  TZ_America_Nipigon,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
-  TZ_America_Nome,  //PSTR("AKST9AKDT,M3.2.0,M11.1.0")
-  TZ_America_Noronha,  //PSTR("<-02>2")
-  TZ_America_North_Dakota_Beulah,  //PSTR("CST6CDT,M3.2.0,M11.1.0")
-  TZ_America_North_Dakota_Center,  //PSTR("CST6CDT,M3.2.0,M11.1.0")
-  TZ_America_North_Dakota_New_Salem,  //PSTR("CST6CDT,M3.2.0,M11.1.0")
-  TZ_America_Ojinaga,  //PSTR("MST7MDT,M3.2.0,M11.1.0")
-  TZ_America_Panama,  //PSTR("EST5")
-  TZ_America_Pangnirtung,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
-  TZ_America_Paramaribo,  //PSTR("<-03>3")
-  TZ_America_Phoenix,  //PSTR("MST7")
-  TZ_America_PortmaumPrince,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
-  TZ_America_Port_of_Spain,  //PSTR("AST4")
-  TZ_America_Porto_Velho,  //PSTR("<-04>4")
-  TZ_America_Puerto_Rico,  //PSTR("AST4")
-  TZ_America_Punta_Arenas,  //PSTR("<-03>3")
-  TZ_America_Rainy_River,  //PSTR("CST6CDT,M3.2.0,M11.1.0")
-  TZ_America_Rankin_Inlet,  //PSTR("CST6CDT,M3.2.0,M11.1.0")
-  TZ_America_Recife,  //PSTR("<-03>3")
-  TZ_America_Regina,  //PSTR("CST6")
-  TZ_America_Resolute,  //PSTR("CST6CDT,M3.2.0,M11.1.0")
-  TZ_America_Rio_Branco,  //PSTR("<-05>5")
-  TZ_America_Santarem,  //PSTR("<-03>3")
-  TZ_America_Santiago,  //PSTR("<-04>4<-03>,M9.1.6/24,M4.1.6/24")
-  TZ_America_Santo_Domingo,  //PSTR("AST4")
-  TZ_America_Sao_Paulo,  //PSTR("<-03>3")
-  TZ_America_Scoresbysund,  //PSTR("<-01>1<+00>,M3.5.0/0,M10.5.0/1")
-  TZ_America_Sitka,  //PSTR("AKST9AKDT,M3.2.0,M11.1.0")
-  TZ_America_St_Barthelemy,  //PSTR("AST4")
-  TZ_America_St_Johns,  //PSTR("NST3:30NDT,M3.2.0,M11.1.0")
-  TZ_America_St_Kitts,  //PSTR("AST4")
-  TZ_America_St_Lucia,  //PSTR("AST4")
-  TZ_America_St_Thomas,  //PSTR("AST4")
-  TZ_America_St_Vincent,  //PSTR("AST4")
-  TZ_America_Swift_Current,  //PSTR("CST6")
-  TZ_America_Tegucigalpa,  //PSTR("CST6")
-  TZ_America_Thule,  //PSTR("AST4ADT,M3.2.0,M11.1.0")
-  TZ_America_Thunder_Bay,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
-  TZ_America_Tijuana,  //PSTR("PST8PDT,M3.2.0,M11.1.0")
-  TZ_America_Toronto,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
-  TZ_America_Tortola,  //PSTR("AST4")
-  TZ_America_Vancouver,  //PSTR("PST8PDT,M3.2.0,M11.1.0")
-  TZ_America_Whitehorse,  //PSTR("MST7")
-  TZ_America_Winnipeg,  //PSTR("CST6CDT,M3.2.0,M11.1.0")
-  TZ_America_Yakutat,  //PSTR("AKST9AKDT,M3.2.0,M11.1.0")
-  TZ_America_Yellowknife,  //PSTR("MST7MDT,M3.2.0,M11.1.0")
-#endif
-  
-#if USING_ANTARCTICA  
-  TZ_Antarctica_Casey,  //PSTR("<+11>-11")
-  TZ_Antarctica_Davis,  //PSTR("<+07>-7")
-  TZ_Antarctica_DumontDUrville,  //PSTR("<+10>-10")
-  TZ_Antarctica_Macquarie,  //PSTR("AEST-10AEDT,M10.1.0,M4.1.0/3")
-  TZ_Antarctica_Mawson,  //PSTR("<+05>-5")
-  TZ_Antarctica_McMurdo,  //PSTR("NZST-12NZDT,M9.5.0,M4.1.0/3")
-  TZ_Antarctica_Palmer,  //PSTR("<-03>3")
-  TZ_Antarctica_Rothera,  //PSTR("<-03>3")
-  TZ_Antarctica_Syowa,  //PSTR("<+03>-3")
-  TZ_Antarctica_Troll,  //PSTR("<+00>0<+02>-2,M3.5.0/1,M10.5.0/3")
-  TZ_Antarctica_Vostok,  //PSTR("<+06>-6")
-  TZ_Arctic_Longyearbyen,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-#endif
+  while (low < high)
+  {
+    uint16_t mid = (low + high) / 2;
 
+    if (WM_compareTZRestart(timezoneName, pgm_read_word(&WM_TZ_RESTARTS[mid])) < 0)
+      high = mid;
+    else
+      low = mid + 1;
+  }
 
-#if USING_ASIA  
-  TZ_Asia_Aden,  //PSTR("<+03>-3")
-  TZ_Asia_Almaty,  //PSTR("<+06>-6")
-  TZ_Asia_Amman,  //PSTR("EET-2EEST,M3.5.4/24,M10.5.5/1")
-  TZ_Asia_Anadyr,  //PSTR("<+12>-12")
-  TZ_Asia_Aqtau,  //PSTR("<+05>-5")
-  TZ_Asia_Aqtobe,  //PSTR("<+05>-5")
-  TZ_Asia_Ashgabat,  //PSTR("<+05>-5")
-  TZ_Asia_Atyrau,  //PSTR("<+05>-5")
-  TZ_Asia_Baghdad,  //PSTR("<+03>-3")
-  TZ_Asia_Bahrain,  //PSTR("<+03>-3")
-  TZ_Asia_Baku,  //PSTR("<+04>-4")
-  TZ_Asia_Bangkok,  //PSTR("<+07>-7")
-  TZ_Asia_Barnaul,  //PSTR("<+07>-7")
-  TZ_Asia_Beirut,  //PSTR("EET-2EEST,M3.5.0/0,M10.5.0/0")
-  TZ_Asia_Bishkek,  //PSTR("<+06>-6")
-  TZ_Asia_Brunei,  //PSTR("<+08>-8")
-  TZ_Asia_Chita,  //PSTR("<+09>-9")
-  TZ_Asia_Choibalsan,  //PSTR("<+08>-8")
-  TZ_Asia_Colombo,  //PSTR("<+0530>-5:30")
-  TZ_Asia_Damascus,  //PSTR("EET-2EEST,M3.5.5/0,M10.5.5/0")
-  TZ_Asia_Dhaka,  //PSTR("<+06>-6")
-  TZ_Asia_Dili,  //PSTR("<+09>-9")
-  TZ_Asia_Dubai,  //PSTR("<+04>-4")
-  TZ_Asia_Dushanbe,  //PSTR("<+05>-5")
-  TZ_Asia_Famagusta,  //PSTR("EET-2EEST,M3.5.0/3,M10.5.0/4")
-  TZ_Asia_Gaza,  //PSTR("EET-2EEST,M3.4.4/48,M10.4.4/49")
-  TZ_Asia_Hebron,  //PSTR("EET-2EEST,M3.4.4/48,M10.4.4/49")
-  TZ_Asia_Ho_Chi_Minh,  //PSTR("<+07>-7")
-  TZ_Asia_Hong_Kong,  //PSTR("HKT-8")
-  TZ_Asia_Hovd,  //PSTR("<+07>-7")
-  TZ_Asia_Irkutsk,  //PSTR("<+08>-8")
-  TZ_Asia_Jakarta,  //PSTR("WIB-7")
-  TZ_Asia_Jayapura,  //PSTR("WIT-9")
-  TZ_Asia_Jerusalem,  //PSTR("IST-2IDT,M3.4.4/26,M10.5.0")
-  TZ_Asia_Kabul,  //PSTR("<+0430>-4:30")
-  TZ_Asia_Kamchatka,  //PSTR("<+12>-12")
-  TZ_Asia_Karachi,  //PSTR("PKT-5")
-  TZ_Asia_Kathmandu,  //PSTR("<+0545>-5:45")
-  TZ_Asia_Khandyga,  //PSTR("<+09>-9")
-  TZ_Asia_Kolkata,  //PSTR("IST-5:30")
-  TZ_Asia_Krasnoyarsk,  //PSTR("<+07>-7")
-  TZ_Asia_Kuala_Lumpur,  //PSTR("<+08>-8")
-  TZ_Asia_Kuching,  //PSTR("<+08>-8")
-  TZ_Asia_Kuwait,  //PSTR("<+03>-3")
-  TZ_Asia_Macau,  //PSTR("CST-8")
-  TZ_Asia_Magadan,  //PSTR("<+11>-11")
-  TZ_Asia_Makassar,  //PSTR("WITA-8")
-  TZ_Asia_Manila,  //PSTR("PST-8")
-  TZ_Asia_Muscat,  //PSTR("<+04>-4")
-  TZ_Asia_Nicosia,  //PSTR("EET-2EEST,M3.5.0/3,M10.5.0/4")
-  TZ_Asia_Novokuznetsk,  //PSTR("<+07>-7")
-  TZ_Asia_Novosibirsk,  //PSTR("<+07>-7")
-  TZ_Asia_Omsk,  //PSTR("<+06>-6")
-  TZ_Asia_Oral,  //PSTR("<+05>-5")
-  TZ_Asia_Phnom_Penh,  //PSTR("<+07>-7")
-  TZ_Asia_Pontianak,  //PSTR("WIB-7")
-  TZ_Asia_Pyongyang,  //PSTR("KST-9")
-  TZ_Asia_Qatar,  //PSTR("<+03>-3")
-  TZ_Asia_Qyzylorda,  //PSTR("<+05>-5")
-  TZ_Asia_Riyadh,  //PSTR("<+03>-3")
-  TZ_Asia_Sakhalin,  //PSTR("<+11>-11")
-  TZ_Asia_Samarkand,  //PSTR("<+05>-5")
-  TZ_Asia_Seoul,  //PSTR("KST-9")
-  TZ_Asia_Shanghai,  //PSTR("CST-8")
-  TZ_Asia_Singapore,  //PSTR("<+08>-8")
-  TZ_Asia_Srednekolymsk,  //PSTR("<+11>-11")
-  TZ_Asia_Taipei,  //PSTR("CST-8")
-  TZ_Asia_Tashkent,  //PSTR("<+05>-5")
-  TZ_Asia_Tbilisi,  //PSTR("<+04>-4")
-  TZ_Asia_Tehran,  //PSTR("<+0330>-3:30<+0430>,J79/24,J263/24")
-  TZ_Asia_Thimphu,  //PSTR("<+06>-6")
-  TZ_Asia_Tokyo,  //PSTR("JST-9")
-  TZ_Asia_Tomsk,  //PSTR("<+07>-7")
-  TZ_Asia_Ulaanbaatar,  //PSTR("<+08>-8")
-  TZ_Asia_Urumqi,  //PSTR("<+06>-6")
-  TZ_Asia_UstmNera,  //PSTR("<+10>-10")
-  TZ_Asia_Vientiane,  //PSTR("<+07>-7")
-  TZ_Asia_Vladivostok,  //PSTR("<+10>-10")
-  TZ_Asia_Yakutsk,  //PSTR("<+09>-9")
-  TZ_Asia_Yangon,  //PSTR("<+0630>-6:30")
-  TZ_Asia_Yekaterinburg,  //PSTR("<+05>-5")
-  TZ_Asia_Yerevan,  //PSTR("<+04>-4")
-#endif
-  
-#if USING_ATLANTIC  
-  TZ_Atlantic_Azores,  //PSTR("<-01>1<+00>,M3.5.0/0,M10.5.0/1")
-  TZ_Atlantic_Bermuda,  //PSTR("AST4ADT,M3.2.0,M11.1.0")
-  TZ_Atlantic_Canary,  //PSTR("WET0WEST,M3.5.0/1,M10.5.0")
-  TZ_Atlantic_Cape_Verde,  //PSTR("<-01>1")
-  TZ_Atlantic_Faroe,  //PSTR("WET0WEST,M3.5.0/1,M10.5.0")
-  TZ_Atlantic_Madeira,  //PSTR("WET0WEST,M3.5.0/1,M10.5.0")
-  TZ_Atlantic_Reykjavik,  //PSTR("GMT0")
-  TZ_Atlantic_South_Georgia,  //PSTR("<-02>2")
-  TZ_Atlantic_Stanley,  //PSTR("<-03>3")
-  TZ_Atlantic_St_Helena,  //PSTR("GMT0")
-#endif
+  if (low == 0)
+    return false;
 
-#if USING_AUSTRALIA  
-  TZ_Australia_Adelaide,  //PSTR("ACST-9:30ACDT,M10.1.0,M4.1.0/3")
-  TZ_Australia_Brisbane,  //PSTR("AEST-10")
-  TZ_Australia_Broken_Hill,  //PSTR("ACST-9:30ACDT,M10.1.0,M4.1.0/3")
-  TZ_Australia_Currie,  //PSTR("AEST-10AEDT,M10.1.0,M4.1.0/3")
-  TZ_Australia_Darwin,  //PSTR("ACST-9:30")
-  TZ_Australia_Eucla,  //PSTR("<+0845>-8:45")
-  TZ_Australia_Hobart,  //PSTR("AEST-10AEDT,M10.1.0,M4.1.0/3")
-  TZ_Australia_Lindeman,  //PSTR("AEST-10")
-  TZ_Australia_Lord_Howe,  //PSTR("<+1030>-10:30<+11>-11,M10.1.0,M4.1.0")
-  TZ_Australia_Melbourne,  //PSTR("AEST-10AEDT,M10.1.0,M4.1.0/3")
-  TZ_Australia_Perth,  //PSTR("AWST-8")
-  TZ_Australia_Sydney,  //PSTR("AEST-10AEDT,M10.1.0,M4.1.0/3")
-#endif
+  // Rebuild the names of that block one by one
+  char     name[WM_TZ_NAME_MAX_LEN + 1];
+  uint16_t offset = pgm_read_word(&WM_TZ_RESTARTS[low - 1]);
 
-#if USING_EUROPE  
-  TZ_Europe_Amsterdam,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Andorra,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Astrakhan,  //PSTR("<+04>-4")
-  TZ_Europe_Athens,  //PSTR("EET-2EEST,M3.5.0/3,M10.5.0/4")
-  TZ_Europe_Belgrade,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Berlin,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Bratislava,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Brussels,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Bucharest,  //PSTR("EET-2EEST,M3.5.0/3,M10.5.0/4")
-  TZ_Europe_Budapest,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Busingen,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Chisinau,  //PSTR("EET-2EEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Copenhagen,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Dublin,  //PSTR("IST-1GMT0,M10.5.0,M3.5.0/1")
-  TZ_Europe_Gibraltar,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Guernsey,  //PSTR("GMT0BST,M3.5.0/1,M10.5.0")
-  TZ_Europe_Helsinki,  //PSTR("EET-2EEST,M3.5.0/3,M10.5.0/4")
-  TZ_Europe_Isle_of_Man,  //PSTR("GMT0BST,M3.5.0/1,M10.5.0")
-  TZ_Europe_Istanbul,  //PSTR("<+03>-3")
-  TZ_Europe_Jersey,  //PSTR("GMT0BST,M3.5.0/1,M10.5.0")
-  TZ_Europe_Kaliningrad,  //PSTR("EET-2")
-  TZ_Europe_Kiev,  //PSTR("EET-2EEST,M3.5.0/3,M10.5.0/4")
-  TZ_Europe_Kirov,  //PSTR("<+03>-3")
-  TZ_Europe_Lisbon,  //PSTR("WET0WEST,M3.5.0/1,M10.5.0")
-  TZ_Europe_Ljubljana,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_London,  //PSTR("GMT0BST,M3.5.0/1,M10.5.0")
-  TZ_Europe_Luxembourg,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Madrid,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Malta,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Mariehamn,  //PSTR("EET-2EEST,M3.5.0/3,M10.5.0/4")
-  TZ_Europe_Minsk,  //PSTR("<+03>-3")
-  TZ_Europe_Monaco,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Moscow,  //PSTR("MSK-3")
-  TZ_Europe_Oslo,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Paris,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Podgorica,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Prague,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Riga,  //PSTR("EET-2EEST,M3.5.0/3,M10.5.0/4")
-  TZ_Europe_Rome,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Samara,  //PSTR("<+04>-4")
-  TZ_Europe_San_Marino,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Sarajevo,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Saratov,  //PSTR("<+04>-4")
-  TZ_Europe_Simferopol,  //PSTR("MSK-3")
-  TZ_Europe_Skopje,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Sofia,  //PSTR("EET-2EEST,M3.5.0/3,M10.5.0/4")
-  TZ_Europe_Stockholm,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Tallinn,  //PSTR("EET-2EEST,M3.5.0/3,M10.5.0/4")
-  TZ_Europe_Tirane,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Ulyanovsk,  //PSTR("<+04>-4")
-  TZ_Europe_Uzhgorod,  //PSTR("EET-2EEST,M3.5.0/3,M10.5.0/4")
-  TZ_Europe_Vaduz,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Vatican,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Vienna,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Vilnius,  //PSTR("EET-2EEST,M3.5.0/3,M10.5.0/4")
-  TZ_Europe_Volgograd,  //PSTR("<+04>-4")
-  TZ_Europe_Warsaw,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Zagreb,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-  TZ_Europe_Zaporozhye,  //PSTR("EET-2EEST,M3.5.0/3,M10.5.0/4")
-  TZ_Europe_Zurich,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
-#endif
-  
-#if USING_INDIAN  
-  TZ_Indian_Antananarivo,  //PSTR("EAT-3")
-  TZ_Indian_Chagos,  //PSTR("<+06>-6")
-  TZ_Indian_Christmas,  //PSTR("<+07>-7")
-  TZ_Indian_Cocos,  //PSTR("<+0630>-6:30")
-  TZ_Indian_Comoro,  //PSTR("EAT-3")
-  TZ_Indian_Kerguelen,  //PSTR("<+05>-5")
-  TZ_Indian_Mahe,  //PSTR("<+04>-4")
-  TZ_Indian_Maldives,  //PSTR("<+05>-5")
-  TZ_Indian_Mauritius,  //PSTR("<+04>-4")
-  TZ_Indian_Mayotte,  //PSTR("EAT-3")
-  TZ_Indian_Reunion,  //PSTR("<+04>-4")
-#endif
+  for (uint8_t entry = 0; (entry < WM_TZ_RESTART_INTERVAL) && (offset < sizeof(WM_TZ_NAMES)); entry++)
+  {
+    uint8_t len = pgm_read_byte(&WM_TZ_NAMES[offset++]);
+    uint8_t c;
 
+    while ( !((c = pgm_read_byte(&WM_TZ_NAMES[offset++])) & 0x80) )
+    {
+      name[len++] = c;
+    }
 
-#if USING_PACIFIC  
-  TZ_Pacific_Apia,  //PSTR("<+13>-13<+14>,M9.5.0/3,M4.1.0/4")
-  TZ_Pacific_Auckland,  //PSTR("NZST-12NZDT,M9.5.0,M4.1.0/3")
-  TZ_Pacific_Bougainville,  //PSTR("<+11>-11")
-  TZ_Pacific_Chatham,  //PSTR("<+1245>-12:45<+1345>,M9.5.0/2:45,M4.1.0/3:45")
-  TZ_Pacific_Chuuk,  //PSTR("<+10>-10")
-  TZ_Pacific_Easter,  //PSTR("<-06>6<-05>,M9.1.6/22,M4.1.6/22")
-  TZ_Pacific_Efate,  //PSTR("<+11>-11")
-  TZ_Pacific_Enderbury,  //PSTR("<+13>-13")
-  TZ_Pacific_Fakaofo,  //PSTR("<+13>-13")
-  TZ_Pacific_Fiji,  //PSTR("<+12>-12<+13>,M11.2.0,M1.2.3/99")
-  TZ_Pacific_Funafuti,  //PSTR("<+12>-12")
-  TZ_Pacific_Galapagos,  //PSTR("<-06>6")
-  TZ_Pacific_Gambier,  //PSTR("<-09>9")
-  TZ_Pacific_Guadalcanal,  //PSTR("<+11>-11")
-  TZ_Pacific_Guam,  //PSTR("ChST-10")
-  TZ_Pacific_Honolulu,  //PSTR("HST10")
-  TZ_Pacific_Kiritimati,  //PSTR("<+14>-14")
-  TZ_Pacific_Kosrae,  //PSTR("<+11>-11")
-  TZ_Pacific_Kwajalein,  //PSTR("<+12>-12")
-  TZ_Pacific_Majuro,  //PSTR("<+12>-12")
-  TZ_Pacific_Marquesas,  //PSTR("<-0930>9:30")
-  TZ_Pacific_Midway,  //PSTR("SST11")
-  TZ_Pacific_Nauru,  //PSTR("<+12>-12")
-  TZ_Pacific_Niue,  //PSTR("<-11>11")
-  TZ_Pacific_Norfolk,  //PSTR("<+11>-11<+12>,M10.1.0,M4.1.0/3")
-  TZ_Pacific_Noumea,  //PSTR("<+11>-11")
-  TZ_Pacific_Pago_Pago,  //PSTR("SST11")
-  TZ_Pacific_Palau,  //PSTR("<+09>-9")
-  TZ_Pacific_Pitcairn,  //PSTR("<-08>8")
-  TZ_Pacific_Pohnpei,  //PSTR("<+11>-11")
-  TZ_Pacific_Port_Moresby,  //PSTR("<+10>-10")
-  TZ_Pacific_Rarotonga,  //PSTR("<-10>10")
-  TZ_Pacific_Saipan,  //PSTR("ChST-10")
-  TZ_Pacific_Tahiti,  //PSTR("<-10>10")
-  TZ_Pacific_Tarawa,  //PSTR("<+12>-12")
-  TZ_Pacific_Tongatapu,  //PSTR("<+13>-13")
-  TZ_Pacific_Wake,  //PSTR("<+12>-12")
-  TZ_Pacific_Wallis,  //PSTR("<+12>-12")
-#endif
+    name[len] = 0;
 
-#if USING_ETC_GMT  
-  TZ_Etc_GMT,  //PSTR("GMT0")
-  TZ_Etc_GMTm0,  //PSTR("GMT0")
-  TZ_Etc_GMTm1,  //PSTR("<+01>-1")
-  TZ_Etc_GMTm2,  //PSTR("<+02>-2")
-  TZ_Etc_GMTm3,  //PSTR("<+03>-3")
-  TZ_Etc_GMTm4,  //PSTR("<+04>-4")
-  TZ_Etc_GMTm5,  //PSTR("<+05>-5")
-  TZ_Etc_GMTm6,  //PSTR("<+06>-6")
-  TZ_Etc_GMTm7,  //PSTR("<+07>-7")
-  TZ_Etc_GMTm8,  //PSTR("<+08>-8")
-  TZ_Etc_GMTm9,  //PSTR("<+09>-9")
-  TZ_Etc_GMTm10,  //PSTR("<+10>-10")
-  TZ_Etc_GMTm11,  //PSTR("<+11>-11")
-  TZ_Etc_GMTm12,  //PSTR("<+12>-12")
-  TZ_Etc_GMTm13,  //PSTR("<+13>-13")
-  TZ_Etc_GMTm14,  //PSTR("<+14>-14")
-  TZ_Etc_GMT0,  //PSTR("GMT0")
-  TZ_Etc_GMTp0,  //PSTR("GMT0")
-  TZ_Etc_GMTp1,  //PSTR("<-01>1")
-  TZ_Etc_GMTp2,  //PSTR("<-02>2")
-  TZ_Etc_GMTp3,  //PSTR("<-03>3")
-  TZ_Etc_GMTp4,  //PSTR("<-04>4")
-  TZ_Etc_GMTp5,  //PSTR("<-05>5")
-  TZ_Etc_GMTp6,  //PSTR("<-06>6")
-  TZ_Etc_GMTp7,  //PSTR("<-07>7")
-  TZ_Etc_GMTp8,  //PSTR("<-08>8")
-  TZ_Etc_GMTp9,  //PSTR("<-09>9")
-  TZ_Etc_GMTp10,  //PSTR("<-10>10")
-  TZ_Etc_GMTp11,  //PSTR("<-11>11")
-  TZ_Etc_GMTp12,  //PSTR("<-12>12")
-  TZ_Etc_UCT,  //PSTR("UTC0")
-  TZ_Etc_UTC,  //PSTR("UTC0")
-  TZ_Etc_Greenwich,  //PSTR("GMT0")
-  TZ_Etc_Universal,  //PSTR("UTC0")
-  TZ_Etc_Zulu,  //PSTR("UTC0")
-#endif  
-};
+    int cmp = strcmp(timezoneName, name);
+
+    if (cmp == 0)
+    {
+      strncpy_P(rule, WM_TZ_RULES + pgm_read_word(&WM_TZ_RULE_INDEX[c & 0x7F]), ruleLen - 1);
+      rule[ruleLen - 1] = 0;
+
+      return true;
+    }
+
+    // Names are sorted, it can't be further
+    if (cmp < 0)
+      break;
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////
 
 #endif // TZDB_H
@@ -0,0 +1,369 @@
+/****************************************************************************************************************************
+  WM_AllocTracker.h
+  For ESP8266 / ESP32 boards
+
+  ESP_WiFiManager is a library for the ESP8266/Arduino platform
+  (https://github.com/esp8266/Arduino) to enable easy
+  configuration and reconfiguration of WiFi credentials using a Captive Portal
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Heap operations per Config Portal request and per manager operation (scan, connect, save) : malloc, free
+  and realloc calls, bytes requested, and the change of free heap and of the largest free block. One row is
+  printed after each request or operation, printTable() gives the totals per route. To check that a change
+  really allocates less, and fragments the heap less.
+
+  The counts come from the platform :
+    - Host build  : WM_Host::onAlloc(), every malloc / calloc / realloc / free of the program
+    - ESP32       : ESP-IDF heap hooks, with CONFIG_HEAP_USE_HOOKS (ESP-IDF v5.0+, custom sdkconfig).
+                    A realloc shows as a malloc.
+    - ESP8266     : umm_malloc statistics, when built with -DUMM_STATS_FULL. No byte count.
+  Otherwise only the heap changes are reported. The counts include other tasks allocating at the time.
+  With USE_WM_ALLOC_TRACKING false, ESP_WMAllocTracker is an empty class.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WM_AllocTracker_h
+#define WM_AllocTracker_h
+
+#include <Arduino.h>
+
+#include "WM_Metrics.h"
+#include "WM_NameList.h"
+
+////////////////////////////////////////////////////
+
+// Manager operations, in WM_ALLOC_OP_NAMES order
+enum WM_AllocOp : uint8_t
+{
+  WM_ALLOC_SCAN = 0,        // scanWifiNetworks()
+  WM_ALLOC_CONNECT,         // connectWifi()
+  WM_ALLOC_SAVE,            // The save config callback
+  WM_ALLOC_OPS
+};
+
+////////////////////////////////////////////////////
+
+#if USE_WM_ALLOC_TRACKING
+
+#if defined(WM_HOST)
+  #include "WM_Host.h"
+#elif defined(ESP32)
+  #if defined(CONFIG_HEAP_USE_HOOKS)
+    #include <esp_heap_caps.h>
+  #else
+    #warning USE_WM_ALLOC_TRACKING : no CONFIG_HEAP_USE_HOOKS in this ESP-IDF build, only heap changes are reported
+  #endif
+#elif defined(ESP8266)
+  #if defined(UMM_STATS_FULL)
+    #include <umm_malloc/umm_malloc.h>
+  #else
+    #warning USE_WM_ALLOC_TRACKING : build with -DUMM_STATS_FULL for allocation counts, only heap changes are reported
+  #endif
+#endif
+
+const char WM_ALLOC_OP_NAMES[] PROGMEM = "op:scan\0op:connect\0op:save\0";
+
+typedef struct
+{
+  uint32_t  mallocs;
+  uint32_t  reallocs;
+  uint32_t  frees;
+  uint32_t  bytes;        // Requested by malloc and realloc
+} WM_AllocCounts;
+
+// Since start, fed by the allocator hooks in ESP_WiFiManager-Impl.h
+extern WM_AllocCounts WM_allocCounts;
+
+////////////////////////////////////////////////////
+
+class ESP_WMAllocTracker
+{
+  public:
+
+    ESP_WMAllocTracker()
+    {
+      memset(_routes, 0, sizeof(_routes));
+      memset(_ops, 0, sizeof(_ops));
+
+#if defined(WM_HOST)
+      WM_Host::onAlloc(hostHook);
+#endif
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Request on route starting. Route may be changed by setRoute() until endRequest().
+    void beginRequest(const uint8_t& route)
+    {
+      _route = route;
+      begin(_request);
+    }
+
+    void setRoute(const uint8_t& route)
+    {
+      _route = route;
+    }
+
+    void endRequest()
+    {
+      end(_request, _routes[_route], WM_METRICS_ROUTE_NAMES, _route);
+    }
+
+    // Manager operation, also inside a request. Nested ones count in the outer one.
+    void beginOp(const uint8_t& op)
+    {
+      if (_opDepth++ == 0)
+      {
+        _op = op;
+        begin(_opStart);
+      }
+    }
+
+    void endOp()
+    {
+      if ( (_opDepth > 0) && (--_opDepth == 0) )
+        end(_opStart, _ops[_op], WM_ALLOC_OP_NAMES, _op);
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Where the row of each request and operation goes, nullptr : nowhere
+    void setOutput(Print* out)
+    {
+      _out = out;
+    }
+
+    // Per route and operation : count, then per request the average calls and bytes, the average free
+    // heap change, and the largest drop of the largest free block
+    void printTable(Print& out)
+    {
+      printHeader(out, true);
+
+      for (uint8_t i = 0; i < WM_ROUTES; i++)
+        printTotals(out, _routes[i], WM_METRICS_ROUTE_NAMES, i, true);
+
+      for (uint8_t i = 0; i < WM_ALLOC_OPS; i++)
+        printTotals(out, _ops[i], WM_ALLOC_OP_NAMES, i, true);
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Since start
+    static WM_AllocCounts current()
+    {
+#if ( defined(ESP8266) && defined(UMM_STATS_FULL) )
+      WM_AllocCounts counts;
+
+      counts.mallocs  = umm_get_malloc_count();
+      counts.reallocs = umm_get_realloc_count();
+      counts.frees    = umm_get_free_count();
+      counts.bytes    = 0;
+
+      return counts;
+#else
+      return WM_allocCounts;
+#endif
+    }
+
+    ////////////////////////////////////////////////////
+
+  private:
+
+    struct Start
+    {
+      WM_AllocCounts  counts;
+      uint32_t        freeHeap;
+      uint32_t        maxBlock;
+    };
+
+    struct Totals
+    {
+      uint32_t  n;
+      uint32_t  mallocs;
+      uint32_t  reallocs;
+      uint32_t  frees;
+      uint32_t  bytes;
+      int32_t   heap;         // Sum of the free heap changes
+      int32_t   worstBlock;   // Largest drop of the largest free block, <= 0
+    };
+
+    Totals    _routes[WM_ROUTES];
+    Totals    _ops[WM_ALLOC_OPS];
+
+    Start     _request;
+    Start     _opStart;
+    uint8_t   _route    = WM_ROUTE_NOT_FOUND;
+    uint8_t   _op       = WM_ALLOC_SCAN;
+    uint8_t   _opDepth  = 0;
+    bool      _header   = false;
+
+    Print*    _out      = &Serial;
+
+    ////////////////////////////////////////////////////
+
+#if defined(WM_HOST)
+    static void hostHook(WM_Host::AllocEvent event, size_t size)
+    {
+      if (event == WM_Host::ALLOC_MALLOC)
+      {
+        WM_allocCounts.mallocs++;
+        WM_allocCounts.bytes += size;
+      }
+      else if (event == WM_Host::ALLOC_REALLOC)
+      {
+        WM_allocCounts.reallocs++;
+        WM_allocCounts.bytes += size;
+      }
+      else
+      {
+        WM_allocCounts.frees++;
+      }
+    }
+#endif
+
+    static uint32_t maxBlock()
+    {
+#ifdef ESP8266
+      return ESP.getMaxFreeBlockSize();
+#else
+      return ESP.getMaxAllocHeap();
+#endif
+    }
+
+    void begin(Start& start)
+    {
+      start.freeHeap  = ESP.getFreeHeap();
+      start.maxBlock  = maxBlock();
+      start.counts    = current();
+    }
+
+    // Heap read before printing, which may allocate
+    void end(const Start& start, Totals& totals, const char* names, const uint8_t& index)
+    {
+      WM_AllocCounts  now       = current();
+      int32_t         heap      = (int32_t) (ESP.getFreeHeap() - start.freeHeap);
+      int32_t         block     = (int32_t) (maxBlock() - start.maxBlock);
+      Totals          row;
+
+      row.n           = 1;
+      row.mallocs     = now.mallocs  - start.counts.mallocs;
+      row.reallocs    = now.reallocs - start.counts.reallocs;
+      row.frees       = now.frees    - start.counts.frees;
+      row.bytes       = now.bytes    - start.counts.bytes;
+      row.heap        = heap;
+      row.worstBlock  = block;
+
+      totals.n++;
+      totals.mallocs  += row.mallocs;
+      totals.reallocs += row.reallocs;
+      totals.frees    += row.frees;
+      totals.bytes    += row.bytes;
+      totals.heap     += heap;
+
+      if (block < totals.worstBlock)
+        totals.worstBlock = block;
+
+      if (_out)
+      {
+        if (!_header)
+        {
+          printHeader(*_out, false);
+          _header = true;
+        }
+
+        printTotals(*_out, row, names, index, false);
+      }
+    }
+
+    ////////////////////////////////////////////////////
+
+    static void printHeader(Print& out, const bool& totals)
+    {
+      out.print(totals ? F("[WM] alloc route            n  malloc    free realloc    bytes     heap maxBlock\n") :
+                         F("[WM] alloc route                 malloc    free realloc    bytes     heap maxBlock\n"));
+    }
+
+    // One row : a request, or the per request averages of totals.n requests. Routes not used : no row.
+    static void printTotals(Print& out, const Totals& totals, const char* names, const uint8_t& index, const bool& average)
+    {
+      char     route[16];
+      char     line[96];
+      uint32_t n = totals.n;
+
+      if (n == 0)
+        return;
+
+      strncpy_P(route, WM_listName(names, index), sizeof(route) - 1);
+      route[sizeof(route) - 1] = 0;
+
+      // Averages with one decimal, without floating point
+      auto avg = [n](const uint32_t& sum) -> uint32_t
+      {
+        return (uint32_t) ( ( (uint64_t) sum * 10 + n / 2) / n);
+      };
+
+      if (!average)
+      {
+        snprintf(line, sizeof(line), "[WM] alloc %-16s %6s %7lu %7lu %7lu %8lu %8ld %8ld\n", route, "",
+                 (unsigned long) totals.mallocs, (unsigned long) totals.frees, (unsigned long) totals.reallocs,
+                 (unsigned long) totals.bytes, (long) totals.heap, (long) totals.worstBlock);
+      }
+      else
+      {
+        snprintf(line, sizeof(line), "[WM] alloc %-16s %6lu %5lu.%lu %5lu.%lu %5lu.%lu %8lu %8ld %8ld\n", route,
+                 (unsigned long) n, (unsigned long) avg(totals.mallocs) / 10, (unsigned long) avg(totals.mallocs) % 10,
+                 (unsigned long) avg(totals.frees) / 10, (unsigned long) avg(totals.frees) % 10,
+                 (unsigned long) avg(totals.reallocs) / 10, (unsigned long) avg(totals.reallocs) % 10,
+                 (unsigned long) (avg(totals.bytes) / 10), (long) (totals.heap / (int32_t) n), (long) totals.worstBlock);
+      }
+
+      out.print(line);
+    }
+};
+
+////////////////////////////////////////////////////
+
+#else   // USE_WM_ALLOC_TRACKING
+
+// Tracking disabled : the calls compile to nothing
+class ESP_WMAllocTracker
+{
+  public:
+
+    void beginRequest(const uint8_t&) {}
+    void setRoute(const uint8_t&) {}
+    void endRequest() {}
+    void beginOp(const uint8_t&) {}
+    void endOp() {}
+};
+
+#endif    // USE_WM_ALLOC_TRACKING
+
+////////////////////////////////////////////////////
+
+// Counts the scope as a manager operation
+class ESP_WMAllocScope
+{
+  public:
+
+    ESP_WMAllocScope(ESP_WMAllocTracker& tracker, const uint8_t& op) : _tracker(tracker)
+    {
+      _tracker.beginOp(op);
+    }
+
+    ~ESP_WMAllocScope()
+    {
+      _tracker.endOp();
+    }
+
+  private:
+
+    ESP_WMAllocTracker& _tracker;
+};
+
+////////////////////////////////////////////////////
+
+#endif    // WM_AllocTracker_h
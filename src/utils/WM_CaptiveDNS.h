@@ -0,0 +1,321 @@
+/****************************************************************************************************************************
+  WM_CaptiveDNS.h
+  For ESP8266 / ESP32 boards
+
+  ESP_WiFiManager is a library for the ESP8266/Arduino platform
+  (https://github.com/esp8266/Arduino) to enable easy
+  configuration and reconfiguration of WiFi credentials using a Captive Portal
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Captive DNS responder used by the Config Portal in place of the core DNSServer.
+  Every query waiting in the socket is answered on each call, up to a budget :
+  A (and ANY) with the portal IP from a prebuilt answer, anything else (AAAA, HTTPS, ...) with an
+  immediate empty NOERROR, so clients don't sit waiting for retries before showing the portal.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WM_CaptiveDNS_h
+#define WM_CaptiveDNS_h
+
+#ifdef ESP8266
+  #include <WiFiUdp.h>
+#else		//ESP32
+  #include <lwip/sockets.h>
+#endif
+
+////////////////////////////////////////////////////
+
+// Max number of queries answered by one processNextRequest() call
+#ifndef WM_DNS_MAX_PACKETS_PER_TICK
+  #define WM_DNS_MAX_PACKETS_PER_TICK     16
+#endif
+
+// TTL, in seconds, of the A records pointing to the portal
+#ifndef WM_DNS_DEFAULT_TTL
+  #define WM_DNS_DEFAULT_TTL              60
+#endif
+
+#define WM_DNS_HEADER_SIZE                12
+#define WM_DNS_ANSWER_SIZE                16
+#define WM_DNS_MAX_PACKET_SIZE            512
+
+#define WM_DNS_QTYPE_A                    1
+#define WM_DNS_QTYPE_ANY                  255
+#define WM_DNS_QCLASS_IN                  1
+#define WM_DNS_QCLASS_ANY                 255
+
+////////////////////////////////////////////////////
+
+class ESP_WMCaptiveDNS
+{
+  public:
+
+    ESP_WMCaptiveDNS() {}
+
+    ~ESP_WMCaptiveDNS()
+    {
+      stop();
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Same signature as DNSServer::start(). Only the "*" domain used by the portal is supported,
+    // every name resolves to resolvedIP.
+    bool start(const uint16_t& port, const String& domainName, const IPAddress& resolvedIP)
+    {
+      (void) domainName;
+
+      stop();
+
+      _ip = resolvedIP;
+      buildAnswer();
+
+#ifdef ESP8266
+      _started = (_udp.begin(port) == 1);
+
+      return _started;
+#else
+      _fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+      if (_fd < 0)
+      {
+        return false;
+      }
+
+      struct sockaddr_in addr;
+
+      memset(&addr, 0, sizeof(addr));
+      addr.sin_family       = AF_INET;
+      addr.sin_port         = htons(port);
+      addr.sin_addr.s_addr  = htonl(INADDR_ANY);
+
+      if (bind(_fd, (struct sockaddr *) &addr, sizeof(addr)) < 0)
+      {
+        ::close(_fd);
+        _fd = -1;
+
+        return false;
+      }
+
+      fcntl(_fd, F_SETFL, fcntl(_fd, F_GETFL, 0) | O_NONBLOCK);
+
+      return true;
+#endif
+    }
+
+    ////////////////////////////////////////////////////
+
+    void stop()
+    {
+#ifdef ESP8266
+      if (_started)
+      {
+        _udp.stop();
+        _started = false;
+      }
+#else
+      if (_fd >= 0)
+      {
+        ::close(_fd);
+        _fd = -1;
+      }
+#endif
+    }
+
+    ////////////////////////////////////////////////////
+
+    void setTTL(const uint32_t& ttl)
+    {
+      _ttl = ttl;
+      buildAnswer();
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Answers every query waiting in the socket, up to maxPackets. Returns the number of packets read.
+    int processNextRequest(const uint8_t& maxPackets = WM_DNS_MAX_PACKETS_PER_TICK)
+    {
+      WM_LOG_MODULE(WM_LOG_DNS);
+
+      int count = 0;
+
+#ifdef ESP8266
+      if (!_started)
+        return 0;
+
+      while ( (count < maxPackets) && (_udp.parsePacket() > 0) )
+      {
+        int len = _udp.read(_packet, sizeof(_packet));
+
+        count++;
+
+        size_t respLen = (len > 0) ? buildResponse(_packet, len, sizeof(_packet), _answer) : 0;
+
+        LOGDEBUG3(F("DNS query from"), _udp.remoteIP(), F("reply len ="), respLen);
+
+        if (respLen)
+        {
+          _udp.beginPacket(_udp.remoteIP(), _udp.remotePort());
+          _udp.write(_packet, respLen);
+          _udp.endPacket();
+        }
+      }
+#else
+      if (_fd < 0)
+        return 0;
+
+      while (count < maxPackets)
+      {
+        struct sockaddr_in from;
+        socklen_t fromLen = sizeof(from);
+
+        int len = recvfrom(_fd, _packet, sizeof(_packet), MSG_DONTWAIT, (struct sockaddr *) &from, &fromLen);
+
+        if (len <= 0)
+          break;
+
+        count++;
+
+        size_t respLen = buildResponse(_packet, len, sizeof(_packet), _answer);
+
+        LOGDEBUG3(F("DNS query from"), IPAddress(from.sin_addr.s_addr), F("reply len ="), respLen);
+
+        if (respLen)
+        {
+          sendto(_fd, _packet, respLen, 0, (struct sockaddr *) &from, fromLen);
+        }
+      }
+#endif
+
+      return count;
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Socket to wait on, so the portal loop wakes up as soon as a query arrives. -1 if not available.
+    int fd() const
+    {
+#ifdef ESP8266
+      return -1;
+#else
+      return _fd;
+#endif
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Turns the query in packet[0..len) into its reply, in place. answer is the WM_DNS_ANSWER_SIZE bytes
+    // A record appended to A/ANY queries. Returns the reply length, or 0 if the packet must be dropped.
+    static size_t buildResponse(uint8_t* packet, const size_t& len, const size_t& maxLen, const uint8_t* answer)
+    {
+      if (len < WM_DNS_HEADER_SIZE)
+        return 0;
+
+      // Only standard queries (QR = 0, OPCODE = 0) with exactly one question
+      if ( (packet[2] & 0xF8) != 0 )
+        return 0;
+
+      if ( (packet[4] != 0) || (packet[5] != 1) )
+        return 0;
+
+      size_t pos = WM_DNS_HEADER_SIZE;
+
+      // QNAME, uncompressed labels ending with a zero length
+      for (;;)
+      {
+        if (pos >= len)
+          return 0;
+
+        uint8_t labelLen = packet[pos];
+
+        if (labelLen == 0)
+        {
+          pos++;
+          break;
+        }
+
+        if (labelLen > 63)
+          return 0;
+
+        pos += labelLen + 1;
+      }
+
+      if (pos + 4 > len)
+        return 0;
+
+      uint16_t qtype  = (packet[pos] << 8)     | packet[pos + 1];
+      uint16_t qclass = (packet[pos + 2] << 8) | packet[pos + 3];
+
+      pos += 4;
+
+      bool withAnswer = ( (qtype == WM_DNS_QTYPE_A) || (qtype == WM_DNS_QTYPE_ANY) ) &&
+                        ( (qclass == WM_DNS_QCLASS_IN) || (qclass == WM_DNS_QCLASS_ANY) );
+
+      if (withAnswer && (pos + WM_DNS_ANSWER_SIZE > maxLen))
+        return 0;
+
+      // QR, AA, keep RD. RCODE = NOERROR
+      packet[2] = 0x84 | (packet[2] & 0x01);
+      packet[3] = 0;
+
+      // ANCOUNT, NSCOUNT, ARCOUNT. EDNS records after the question are dropped.
+      packet[6]   = 0;
+      packet[7]   = withAnswer ? 1 : 0;
+      memset(&packet[8], 0, 4);
+
+      if (withAnswer)
+      {
+        memcpy(&packet[pos], answer, WM_DNS_ANSWER_SIZE);
+        pos += WM_DNS_ANSWER_SIZE;
+      }
+
+      return pos;
+    }
+
+    ////////////////////////////////////////////////////
+
+  private:
+
+    // Pointer to the question name, TYPE A, CLASS IN, TTL, RDLENGTH 4 and the portal IP
+    void buildAnswer()
+    {
+      _answer[0]  = 0xC0;
+      _answer[1]  = WM_DNS_HEADER_SIZE;
+      _answer[2]  = 0;
+      _answer[3]  = WM_DNS_QTYPE_A;
+      _answer[4]  = 0;
+      _answer[5]  = WM_DNS_QCLASS_IN;
+      _answer[6]  = (_ttl >> 24) & 0xFF;
+      _answer[7]  = (_ttl >> 16) & 0xFF;
+      _answer[8]  = (_ttl >> 8) & 0xFF;
+      _answer[9]  = _ttl & 0xFF;
+      _answer[10] = 0;
+      _answer[11] = 4;
+
+      for (uint8_t i = 0; i < 4; i++)
+      {
+        _answer[12 + i] = _ip[i];
+      }
+    }
+
+    ////////////////////////////////////////////////////
+
+    IPAddress _ip;
+    uint32_t  _ttl = WM_DNS_DEFAULT_TTL;
+    uint8_t   _answer[WM_DNS_ANSWER_SIZE];
+    uint8_t   _packet[WM_DNS_MAX_PACKET_SIZE];
+
+#ifdef ESP8266
+    WiFiUDP   _udp;
+    bool      _started = false;
+#else
+    int       _fd = -1;
+#endif
+};
+
+////////////////////////////////////////////////////
+
+#endif    // WM_CaptiveDNS_h
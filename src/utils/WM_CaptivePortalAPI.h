@@ -0,0 +1,66 @@
+/****************************************************************************************************************************
+  WM_CaptivePortalAPI.h
+  For ESP8266 / ESP32 boards
+
+  ESP_WiFiManager is a library for the ESP8266/Arduino platform
+  (https://github.com/esp8266/Arduino) to enable easy
+  configuration and reconfiguration of WiFi credentials using a Captive Portal
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Captive-portal identification : DHCP option 114 (RFC 8910) carries the URI of the API endpoint,
+  which returns the RFC 8908 JSON document. Both builders are plain C so they can be checked on a host.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WM_CaptivePortalAPI_h
+#define WM_CaptivePortalAPI_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+////////////////////////////////////////////////////
+
+#define WM_DHCP_OPTION_CAPTIVE_PORTAL     114
+
+// DHCP option length is one byte
+#define WM_CAPTIVE_URI_MAXLEN             255
+
+#define WM_CAPTIVE_API_PATH               "/api/captive"
+#define WM_CAPTIVE_API_CONTENT_TYPE       "application/captive+json"
+
+////////////////////////////////////////////////////
+
+// URI of the API endpoint on the portal at apIP, the value of option 114 : no code or length byte, the
+// DHCP server adds them. Returns the URI length, or 0 if it doesn't fit the option's one-byte length or buf.
+inline size_t WM_buildCaptiveURI(char* buf, const size_t& bufLen, const char* apIP)
+{
+  int len = snprintf(buf, bufLen, "http://%s%s", apIP, WM_CAPTIVE_API_PATH);
+
+  if ( (len < 0) || (len > WM_CAPTIVE_URI_MAXLEN) || ((size_t) len >= bufLen) )
+    return 0;
+
+  return len;
+}
+
+////////////////////////////////////////////////////
+
+// RFC 8908 API response : the client is captive until it submits the form at portalURL.
+// Returns the JSON length, or 0 if it doesn't fit in buf.
+inline size_t WM_buildCaptiveJSON(char* buf, const size_t& bufLen, const char* portalURL)
+{
+  int len = snprintf(buf, bufLen, "{\"captive\":true,\"user-portal-url\":\"%s\"}", portalURL);
+
+  if ( (len < 0) || ((size_t) len >= bufLen) )
+    return 0;
+
+  return len;
+}
+
+////////////////////////////////////////////////////
+
+#endif    // WM_CaptivePortalAPI_h
@@ -0,0 +1,691 @@
+/****************************************************************************************************************************
+  WM_DeferredLog.h
+  For ESP8266 / ESP32 boards
+
+  ESP_WiFiManager is a library for the ESP8266/Arduino platform
+  (https://github.com/esp8266/Arduino) to enable easy
+  configuration and reconfiguration of WiFi credentials using a Captive Portal
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Deferred logging, used by the LOGxxx macros when WIFIMGR_DEFERRED_LOG is true. A LOG call only packs its
+  arguments in a small binary record (timestamp, level, F() pointers, numbers, copies of RAM strings) and
+  pushes it to a ring buffer. Records are formatted and written to WM_DBG_PORT later : by a low priority task
+  on ESP32, by a recurrent scheduled function on ESP8266, never blocking on a full UART.
+  When the ring is full, the record is dropped and counted.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WM_DeferredLog_h
+#define WM_DeferredLog_h
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include <type_traits>
+
+#ifdef ESP8266
+  #include <Schedule.h>
+#endif
+
+////////////////////////////////////////////////////
+
+// Ring size in bytes, power of 2
+#ifndef WM_LOG_BUFFER_SIZE
+  #define WM_LOG_BUFFER_SIZE        2048
+#endif
+
+// Largest record. Arguments which don't fit are left out, and the line ends with "..."
+#ifndef WM_LOG_MAX_RECORD
+  #define WM_LOG_MAX_RECORD         128
+#endif
+
+// Largest formatted line
+#ifndef WM_LOG_LINE_SIZE
+  #define WM_LOG_LINE_SIZE          192
+#endif
+
+// Time between drains
+#ifndef WM_LOG_DRAIN_MS
+  #define WM_LOG_DRAIN_MS           10
+#endif
+
+// Print the time of the LOG call, in ms, in the mark : "[WM 12345] "
+#ifndef WM_LOG_TIMESTAMP
+  #define WM_LOG_TIMESTAMP          false
+#endif
+
+#ifndef WM_LOG_TASK_STACK
+  #define WM_LOG_TASK_STACK         3072
+#endif
+
+static_assert( (WM_LOG_BUFFER_SIZE & (WM_LOG_BUFFER_SIZE - 1)) == 0, "WM_LOG_BUFFER_SIZE must be a power of 2");
+static_assert( WM_LOG_MAX_RECORD <= 255, "WM_LOG_MAX_RECORD must fit in a byte");
+
+// Record flags
+#define WM_LOG_MARK                 0x01      // Starts with "[WM] "
+#define WM_LOG_NEWLINE              0x02      // Ends the line
+#define WM_LOG_TRUNCATED            0x04
+
+// Record : length (written last), level << 4 | flags, timestamp (4 bytes), arguments
+#define WM_LOG_HEADER_SIZE          6
+
+// Argument types
+#define WM_LOG_ARG_FSTR             1         // Pointer to a flash string
+#define WM_LOG_ARG_STR              2         // Length, then the characters
+#define WM_LOG_ARG_INT32            3
+#define WM_LOG_ARG_UINT32           4
+#define WM_LOG_ARG_INT64            5
+#define WM_LOG_ARG_UINT64           6
+#define WM_LOG_ARG_DOUBLE           7
+#define WM_LOG_ARG_CHAR             8
+#define WM_LOG_ARG_IP               9
+
+// Single core, no preemption on ESP8266 : plain accesses are enough
+#ifdef ESP32
+  #define WM_LOG_LOAD(p)            __atomic_load_n(p, __ATOMIC_ACQUIRE)
+  #define WM_LOG_STORE(p, v)        __atomic_store_n(p, v, __ATOMIC_RELEASE)
+#else
+  #define WM_LOG_LOAD(p)            (*(volatile __typeof__(*(p)) *) (p))
+  #define WM_LOG_STORE(p, v)        (*(volatile __typeof__(*(p)) *) (p) = (v))
+#endif
+
+////////////////////////////////////////////////////
+
+// Print into a fixed buffer, for formatting
+class WM_LogLine : public Print
+{
+  public:
+
+    size_t write(uint8_t c) override
+    {
+      if (_len < sizeof(_buf))
+      {
+        _buf[_len++] = c;
+
+        return 1;
+      }
+
+      return 0;
+    }
+
+    using Print::write;
+
+    const uint8_t* data() const
+    {
+      return _buf;
+    }
+
+    size_t length() const
+    {
+      return _len;
+    }
+
+  private:
+
+    uint8_t _buf[WM_LOG_LINE_SIZE];
+    size_t  _len = 0;
+};
+
+////////////////////////////////////////////////////
+
+class ESP_WMLogRing
+{
+  public:
+
+    ////////////////////////////////////////////////////
+
+    // Any task. Returns false, and counts a drop, if the ring is full.
+    bool write(const uint8_t* record, const uint8_t& len)
+    {
+      start();
+
+      uint32_t head = WM_LOG_LOAD(&_head);
+
+#ifdef ESP32
+      do
+      {
+        if (head + len - WM_LOG_LOAD(&_tail) > WM_LOG_BUFFER_SIZE)
+        {
+          __atomic_fetch_add(&_dropped, 1, __ATOMIC_RELAXED);
+
+          return false;
+        }
+      } while (!__atomic_compare_exchange_n(&_head, &head, head + len, true, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+#else
+      if (head + len - _tail > WM_LOG_BUFFER_SIZE)
+      {
+        _dropped++;
+
+        return false;
+      }
+
+      _head = head + len;
+#endif
+
+      for (uint8_t i = 1; i < len; i++)
+      {
+        _buf[(head + i) & (WM_LOG_BUFFER_SIZE - 1)] = record[i];
+      }
+
+      // Publishes the record. Free space is kept zeroed, so the reader sees 0 until then.
+      WM_LOG_STORE(&_buf[head & (WM_LOG_BUFFER_SIZE - 1)], len);
+
+      return true;
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Formats and writes up to maxRecords records, stops early if out can't take a whole line without
+    // blocking. Returns the number of records written.
+    uint16_t drain(Print& out, const uint16_t& maxRecords = 16)
+    {
+      // One reader at a time
+#ifdef ESP32
+      uint8_t idle = 0;
+
+      if (!__atomic_compare_exchange_n(&_draining, &idle, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        return 0;
+#else
+      if (_draining)
+        return 0;
+
+      _draining = 1;
+#endif
+
+      uint16_t count = 0;
+
+      reportDrops(out);
+
+      while (count < maxRecords)
+      {
+        uint32_t tail = _tail;
+        uint8_t  len  = WM_LOG_LOAD(&_buf[tail & (WM_LOG_BUFFER_SIZE - 1)]);
+
+        if (len == 0)
+          break;
+
+        uint8_t record[WM_LOG_MAX_RECORD];
+
+        for (uint8_t i = 0; i < len; i++)
+        {
+          record[i] = _buf[(tail + i) & (WM_LOG_BUFFER_SIZE - 1)];
+        }
+
+        WM_LogLine line;
+
+        format(record, len, line);
+
+        int room = out.availableForWrite();
+
+        // 0 : the port can't tell
+        if ( (room > 0) && ((size_t) room < line.length()) )
+          break;
+
+        out.write(line.data(), line.length());
+
+        for (uint8_t i = 0; i < len; i++)
+        {
+          _buf[(tail + i) & (WM_LOG_BUFFER_SIZE - 1)] = 0;
+        }
+
+        WM_LOG_STORE(&_tail, tail + len);
+
+        count++;
+      }
+
+      WM_LOG_STORE(&_draining, (uint8_t) 0);
+
+      return count;
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Writes everything left, blocking. Before a restart or deep sleep.
+    void flush(Print& out)
+    {
+      while (WM_LOG_LOAD(&_buf[_tail & (WM_LOG_BUFFER_SIZE - 1)]) != 0)
+      {
+        if (drain(out) == 0)
+          yield();
+      }
+
+      reportDrops(out);
+    }
+
+    ////////////////////////////////////////////////////
+
+    uint32_t dropped() const
+    {
+      return _droppedTotal + WM_LOG_LOAD(&_dropped);
+    }
+
+    ////////////////////////////////////////////////////
+
+    static void format(const uint8_t* record, const uint8_t& len, Print& out)
+    {
+      uint8_t flags = record[1] & 0x0F;
+      uint8_t pos   = WM_LOG_HEADER_SIZE;
+      bool    first = true;
+
+      if (flags & WM_LOG_MARK)
+      {
+#if WM_LOG_TIMESTAMP
+        uint32_t timestamp;
+
+        memcpy(&timestamp, &record[2], sizeof(timestamp));
+
+        out.print(F("[WM "));
+        out.print((unsigned long) timestamp);
+        out.print(F("] "));
+#else
+        out.print(F("[WM] "));
+#endif
+      }
+
+      while (pos < len)
+      {
+        if (!first)
+          out.print(' ');
+
+        first = false;
+
+        uint8_t type = record[pos++];
+
+        switch (type)
+        {
+          case WM_LOG_ARG_FSTR:
+          {
+            const __FlashStringHelper* str;
+
+            memcpy(&str, &record[pos], sizeof(str));
+            pos += sizeof(str);
+            out.print(str);
+
+            break;
+          }
+
+          case WM_LOG_ARG_STR:
+          {
+            uint8_t strLen = record[pos++];
+
+            out.write(&record[pos], strLen);
+            pos += strLen;
+
+            break;
+          }
+
+          case WM_LOG_ARG_INT32:
+          {
+            int32_t value;
+
+            memcpy(&value, &record[pos], sizeof(value));
+            pos += sizeof(value);
+            out.print((long) value);
+
+            break;
+          }
+
+          case WM_LOG_ARG_UINT32:
+          {
+            uint32_t value;
+
+            memcpy(&value, &record[pos], sizeof(value));
+            pos += sizeof(value);
+            out.print((unsigned long) value);
+
+            break;
+          }
+
+          case WM_LOG_ARG_INT64:
+          {
+            int64_t value;
+
+            memcpy(&value, &record[pos], sizeof(value));
+            pos += sizeof(value);
+            out.print((long long) value);
+
+            break;
+          }
+
+          case WM_LOG_ARG_UINT64:
+          {
+            uint64_t value;
+
+            memcpy(&value, &record[pos], sizeof(value));
+            pos += sizeof(value);
+            out.print((unsigned long long) value);
+
+            break;
+          }
+
+          case WM_LOG_ARG_DOUBLE:
+          {
+            double value;
+
+            memcpy(&value, &record[pos], sizeof(value));
+            pos += sizeof(value);
+            out.print(value);
+
+            break;
+          }
+
+          case WM_LOG_ARG_CHAR:
+
+            out.print((char) record[pos++]);
+
+            break;
+
+          case WM_LOG_ARG_IP:
+
+            out.print(IPAddress(record[pos], record[pos + 1], record[pos + 2], record[pos + 3]));
+            pos += 4;
+
+            break;
+
+          default:
+
+            // Corrupted record
+            pos = len;
+
+            break;
+        }
+      }
+
+      if (flags & WM_LOG_TRUNCATED)
+        out.print(F(" ..."));
+
+      if (flags & WM_LOG_NEWLINE)
+        out.println();
+    }
+
+    ////////////////////////////////////////////////////
+
+  private:
+
+    uint8_t   _buf[WM_LOG_BUFFER_SIZE] = { 0 };
+    uint32_t  _head         = 0;      // Bytes reserved by writers, ever
+    uint32_t  _tail         = 0;      // Bytes consumed by the reader, ever
+    uint32_t  _dropped      = 0;
+    uint32_t  _droppedTotal = 0;
+    uint8_t   _draining     = 0;
+    uint8_t   _started      = 0;
+
+    ////////////////////////////////////////////////////
+
+    void reportDrops(Print& out)
+    {
+#ifdef ESP32
+      uint32_t dropped = __atomic_exchange_n(&_dropped, 0, __ATOMIC_RELAXED);
+#else
+      uint32_t dropped = _dropped;
+
+      _dropped = 0;
+#endif
+
+      if (dropped)
+      {
+        _droppedTotal += dropped;
+
+        out.print(F("[WM] "));
+        out.print((unsigned long) dropped);
+        out.println(F(" log records dropped"));
+      }
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Starts the drain on first use
+    void start()
+    {
+      if (WM_LOG_LOAD(&_started))
+        return;
+
+#ifdef ESP32
+      uint8_t notStarted = 0;
+
+      if (!__atomic_compare_exchange_n(&_started, &notStarted, 1, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+        return;
+
+      xTaskCreate(drainTask, "WM_log", WM_LOG_TASK_STACK, this, tskIDLE_PRIORITY + 1, NULL);
+#else
+      _started = 1;
+
+      schedule_recurrent_function_us([this]()
+      {
+        drain(WM_DBG_PORT);
+
+        return true;
+      }, WM_LOG_DRAIN_MS * 1000UL);
+#endif
+    }
+
+    ////////////////////////////////////////////////////
+
+#ifdef ESP32
+    static void drainTask(void* param)
+    {
+      ESP_WMLogRing* ring = (ESP_WMLogRing*) param;
+
+      for (;;)
+      {
+        ring->drain(WM_DBG_PORT);
+
+        vTaskDelay(WM_LOG_DRAIN_MS / portTICK_PERIOD_MS ? WM_LOG_DRAIN_MS / portTICK_PERIOD_MS : 1);
+      }
+    }
+#endif
+};
+
+////////////////////////////////////////////////////
+
+// Shared by every translation unit
+inline ESP_WMLogRing& WM_logRing()
+{
+  static ESP_WMLogRing ring;
+
+  return ring;
+}
+
+////////////////////////////////////////////////////
+
+// One LOG call, packed on the stack then pushed to the ring in one go
+class WM_LogRecord
+{
+  public:
+
+    WM_LogRecord(const uint8_t& level, const uint8_t& flags)
+    {
+      uint32_t now = millis();
+
+      _buf[1] = (level << 4) | flags;
+      memcpy(&_buf[2], &now, sizeof(now));
+    }
+
+    ////////////////////////////////////////////////////
+
+    void addAll() {}
+
+    template<typename T, typename... Rest>
+    void addAll(const T& first, const Rest&... rest)
+    {
+      add(first);
+      addAll(rest...);
+    }
+
+    ////////////////////////////////////////////////////
+
+    template<typename T>
+    void add(const T& value)
+    {
+      addArg(value, std::integral_constant<int,
+             std::is_same<T, char>::value ? 3 :
+             (std::is_integral<T>::value || std::is_enum<T>::value) ? 1 :
+             std::is_floating_point<T>::value ? 2 : 0>());
+    }
+
+    ////////////////////////////////////////////////////
+
+    void commit()
+    {
+      _buf[0] = _len;
+
+      WM_logRing().write(_buf, _len);
+    }
+
+    ////////////////////////////////////////////////////
+
+  private:
+
+    uint8_t _buf[WM_LOG_MAX_RECORD];
+    uint8_t _len = WM_LOG_HEADER_SIZE;
+
+    ////////////////////////////////////////////////////
+
+    // Room for size more bytes, else the record is marked truncated
+    bool reserve(const uint8_t& size)
+    {
+      if (_buf[1] & WM_LOG_TRUNCATED)
+        return false;
+
+      if (_len + size > WM_LOG_MAX_RECORD)
+      {
+        _buf[1] |= WM_LOG_TRUNCATED;
+
+        return false;
+      }
+
+      return true;
+    }
+
+    void put(const uint8_t& type, const void* data, const uint8_t& size)
+    {
+      if (reserve(size + 1))
+      {
+        _buf[_len++] = type;
+        memcpy(&_buf[_len], data, size);
+        _len += size;
+      }
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Integers and enums, in 4 bytes when they fit
+    template<typename T>
+    void addArg(const T& value, std::integral_constant<int, 1>)
+    {
+      if (std::is_signed<T>::value)
+      {
+        int64_t v = (int64_t) value;
+
+        if ( (v >= INT32_MIN) && (v <= INT32_MAX) )
+        {
+          int32_t v32 = (int32_t) v;
+
+          put(WM_LOG_ARG_INT32, &v32, sizeof(v32));
+        }
+        else
+          put(WM_LOG_ARG_INT64, &v, sizeof(v));
+      }
+      else
+      {
+        uint64_t v = (uint64_t) value;
+
+        if (v <= UINT32_MAX)
+        {
+          uint32_t v32 = (uint32_t) v;
+
+          put(WM_LOG_ARG_UINT32, &v32, sizeof(v32));
+        }
+        else
+          put(WM_LOG_ARG_UINT64, &v, sizeof(v));
+      }
+    }
+
+    template<typename T>
+    void addArg(const T& value, std::integral_constant<int, 2>)
+    {
+      double v = value;
+
+      put(WM_LOG_ARG_DOUBLE, &v, sizeof(v));
+    }
+
+    template<typename T>
+    void addArg(const T& value, std::integral_constant<int, 3>)
+    {
+      put(WM_LOG_ARG_CHAR, &value, 1);
+    }
+
+    template<typename T>
+    void addArg(const T& value, std::integral_constant<int, 0>)
+    {
+      addObject(value);
+    }
+
+    ////////////////////////////////////////////////////
+
+    void addObject(const __FlashStringHelper* str)
+    {
+      put(WM_LOG_ARG_FSTR, &str, sizeof(str));
+    }
+
+    void addObject(const char* str)
+    {
+      addString(str, str ? strlen(str) : 0);
+    }
+
+    void addObject(const String& str)
+    {
+      addString(str.c_str(), str.length());
+    }
+
+    void addObject(const IPAddress& ip)
+    {
+      uint8_t bytes[4] = { ip[0], ip[1], ip[2], ip[3] };
+
+      put(WM_LOG_ARG_IP, bytes, sizeof(bytes));
+    }
+
+    // Anything else Print knows, formatted now
+    template<typename T>
+    void addObject(const T& value)
+    {
+      WM_LogLine line;
+
+      line.print(value);
+      addString((const char*) line.data(), line.length());
+    }
+
+    void addString(const char* str, size_t len)
+    {
+      if (!reserve(2))
+        return;
+
+      // Cut to what is left
+      if (_len + 2 + len > WM_LOG_MAX_RECORD)
+      {
+        len = WM_LOG_MAX_RECORD - _len - 2;
+        _buf[1] |= WM_LOG_TRUNCATED;
+      }
+
+      _buf[_len++] = WM_LOG_ARG_STR;
+      _buf[_len++] = (uint8_t) len;
+      memcpy(&_buf[_len], str, len);
+      _len += len;
+    }
+};
+
+////////////////////////////////////////////////////
+
+#define WM_LOG_DEFER(level, flags, ...)   { WM_LogRecord _wmRecord(level, flags); _wmRecord.addAll(__VA_ARGS__); _wmRecord.commit(); }
+
+// Writes all pending log lines, blocking. Call before ESP.restart() / ESP.deepSleep()
+inline void WM_logFlush()
+{
+  WM_logRing().flush(WM_DBG_PORT);
+}
+
+////////////////////////////////////////////////////
+
+#endif    // WM_DeferredLog_h
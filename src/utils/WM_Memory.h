@@ -0,0 +1,121 @@
+/****************************************************************************************************************************
+  WM_Memory.h
+  For ESP8266 / ESP32 boards
+
+  ESP_WiFiManager is a library for the ESP8266/Arduino platform
+  (https://github.com/esp8266/Arduino) to enable easy
+  configuration and reconfiguration of WiFi credentials using a Captive Portal
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Where the manager's buffers are allocated, per class of buffer. On ESP32 boards with PSRAM (ESP32-S2 / S3
+  WROVER...), the large ones that are only touched a few times per request go to PSRAM, keeping internal RAM
+  for WiFi and lwIP. The Arduino core only puts allocations of CONFIG_SPIRAM_MALLOC_ALWAYSINTERNAL (4096) bytes
+  and more in PSRAM by itself, none of these.
+
+    WM_MEM_PAGE     Chunk the Config Portal pages are printed into. In PSRAM : one WM_PSRAM_CHUNK_SIZE buffer
+                    while the portal runs. Otherwise : the WM_CHUNK_SIZE chunk on the stack of each page.
+    WM_MEM_SCAN     Sorted indices of the scan results, per /wifi and /scan request
+    WM_MEM_PARAM    ESP_WMParameter values, read by each /wifi page and by the sketch at any time
+
+  Each class is placed by its WM_MEM_*_PLACEMENT, set before including the library :
+    WM_MEM_INTERNAL   the default allocator
+    WM_MEM_PSRAM      PSRAM, internal RAM when the board has none or it is full
+
+  ESP8266 has no PSRAM : everything is internal.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WM_Memory_h
+#define WM_Memory_h
+
+#include <Arduino.h>
+
+#if defined(ESP32)
+  #include <esp_heap_caps.h>
+#endif
+
+////////////////////////////////////////////////////
+
+// Buffer classes
+enum WM_MemClass : uint8_t
+{
+  WM_MEM_PAGE = 0,
+  WM_MEM_SCAN,
+  WM_MEM_PARAM,
+  WM_MEM_CLASSES
+};
+
+enum WM_MemPlacement : uint8_t
+{
+  WM_MEM_INTERNAL = 0,
+  WM_MEM_PSRAM
+};
+
+#ifndef WM_MEM_PAGE_PLACEMENT
+  #define WM_MEM_PAGE_PLACEMENT       WM_MEM_PSRAM
+#endif
+
+#ifndef WM_MEM_SCAN_PLACEMENT
+  #define WM_MEM_SCAN_PLACEMENT       WM_MEM_PSRAM
+#endif
+
+#ifndef WM_MEM_PARAM_PLACEMENT
+  #define WM_MEM_PARAM_PLACEMENT      WM_MEM_INTERNAL
+#endif
+
+// Page chunk in PSRAM : larger than WM_CHUNK_SIZE, fewer and fuller TCP segments per page
+#ifndef WM_PSRAM_CHUNK_SIZE
+  #define WM_PSRAM_CHUNK_SIZE         2048
+#endif
+
+////////////////////////////////////////////////////
+
+inline WM_MemPlacement WM_memPlacement(const WM_MemClass& memClass)
+{
+  static const WM_MemPlacement placements[WM_MEM_CLASSES] =
+  {
+    WM_MEM_PAGE_PLACEMENT, WM_MEM_SCAN_PLACEMENT, WM_MEM_PARAM_PLACEMENT
+  };
+
+  return placements[memClass];
+}
+
+// size bytes of PSRAM, nullptr without PSRAM or room in it
+inline void* WM_psramAlloc(const size_t& size)
+{
+#if defined(ESP32)
+  return heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+#else
+  (void) size;
+
+  return nullptr;
+#endif
+}
+
+// size bytes where memClass is placed, nullptr when out of memory. Free with WM_memFree().
+inline void* WM_memAlloc(const WM_MemClass& memClass, const size_t& size)
+{
+  void* ptr = nullptr;
+
+  if (WM_memPlacement(memClass) == WM_MEM_PSRAM)
+    ptr = WM_psramAlloc(size);
+
+  if (ptr == nullptr)
+    ptr = malloc(size);
+
+  return ptr;
+}
+
+inline void WM_memFree(void* ptr)
+{
+#if defined(ESP32)
+  heap_caps_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+
+#endif    // WM_Memory_h
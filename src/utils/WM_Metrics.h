@@ -0,0 +1,518 @@
+/****************************************************************************************************************************
+  WM_Metrics.h
+  For ESP8266 / ESP32 boards
+
+  ESP_WiFiManager is a library for the ESP8266/Arduino platform
+  (https://github.com/esp8266/Arduino) to enable easy
+  configuration and reconfiguration of WiFi credentials using a Captive Portal
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Config Portal metrics, served at /metrics in Prometheus text format, or /metrics?format=json.
+  Per route : requests, bytes sent, latency histogram. Also DNS queries, WiFi scans, connection attempts by
+  result and heap. Everything is kept in fixed-size counters, and the output is written in small chunks,
+  so nothing is allocated. With USE_WM_METRICS false, ESP_WMMetrics is an empty class.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WM_Metrics_h
+#define WM_Metrics_h
+
+#include <Arduino.h>
+#include <functional>
+
+#include "WM_NameList.h"
+#include "WM_StaticString.h"
+
+////////////////////////////////////////////////////
+
+// Config Portal routes, in WM_METRICS_ROUTE_NAMES order
+enum WM_MetricsRoute : uint8_t
+{
+  WM_ROUTE_ROOT = 0,
+  WM_ROUTE_WIFI,
+  WM_ROUTE_WIFISAVE,
+  WM_ROUTE_CLOSE,
+  WM_ROUTE_INFO,
+  WM_ROUTE_RESET,
+  WM_ROUTE_STATE,
+  WM_ROUTE_SCAN,
+  WM_ROUTE_LOGLEVEL,
+  WM_ROUTE_METRICS,
+  WM_ROUTE_CAPTIVE_API,
+  WM_ROUTE_PROBE,           // OS connectivity probes, answered by handleProbe()
+  WM_ROUTE_REDIRECT,        // Other hosts, redirected to the portal
+  WM_ROUTE_NOT_FOUND,
+  WM_ROUTES
+};
+
+// Connection attempts, by result
+enum WM_MetricsConnect : uint8_t
+{
+  WM_CONNECT_OK = 0,
+  WM_CONNECT_NO_SSID,
+  WM_CONNECT_FAILED,
+  WM_CONNECT_WRONG_PASSWORD,
+  WM_CONNECT_LOST,
+  WM_CONNECT_TIMEOUT,       // Anything else when waitForConnectResult() gives up
+  WM_CONNECT_RESULTS
+};
+
+// Also the route names of WM_AllocTracker.h
+const char WM_METRICS_ROUTE_NAMES[] PROGMEM =
+  "root\0wifi\0wifisave\0close\0info\0reset\0state\0scan\0loglevel\0metrics\0captive_api\0probe\0redirect\0not_found\0";
+
+////////////////////////////////////////////////////
+
+#if USE_WM_METRICS
+
+// Latency histogram bucket bounds, in ms. Above the last one goes to +Inf
+#define WM_METRICS_BUCKETS          10
+
+const uint16_t WM_METRICS_BUCKET_MS[WM_METRICS_BUCKETS] PROGMEM = { 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000 };
+
+const char WM_METRICS_CONNECT_NAMES[] PROGMEM = "connected\0no_ssid\0failed\0wrong_password\0lost\0timeout\0";
+
+////////////////////////////////////////////////////
+
+class ESP_WMMetrics
+{
+  public:
+
+    ESP_WMMetrics()
+    {
+      memset(_routes, 0, sizeof(_routes));
+      memset(_connects, 0, sizeof(_connects));
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Request on route starting. Route may be changed by setRoute() until endRequest().
+    void beginRequest(const uint8_t& route)
+    {
+      _route = route;
+      _start = micros();
+    }
+
+    void setRoute(const uint8_t& route)
+    {
+      _route = route;
+    }
+
+    // Called with the whole response built : the route's heap low point
+    void addBytesOut(const size_t& bytes)
+    {
+      _routes[_route].bytes += bytes;
+
+      sampleRouteHeap();
+    }
+
+    void endRequest()
+    {
+      uint32_t elapsed = micros() - _start;
+      Route&   route   = _routes[_route];
+
+      route.count++;
+      route.micros += elapsed;
+
+      uint8_t bucket = 0;
+
+      while ( (bucket < WM_METRICS_BUCKETS) && (elapsed > pgm_read_word(&WM_METRICS_BUCKET_MS[bucket]) * 1000UL) )
+        bucket++;
+
+      route.buckets[bucket]++;
+
+      sampleRouteHeap();
+    }
+
+    ////////////////////////////////////////////////////
+
+    void rateLimited()
+    {
+      _rateLimited++;
+    }
+
+    void addDNSQueries(const int& queries)
+    {
+      if (queries > 0)
+        _dnsQueries += queries;
+    }
+
+    void scanDone(const uint32_t& durationMs, const int& networks)
+    {
+      _scans++;
+      _scanMs     += durationMs;
+      _lastScanMs = durationMs;
+
+      if (networks < 0)
+        _scanErrors++;
+    }
+
+    // status : result of waitForConnectResult()
+    void connectDone(const int& status)
+    {
+      uint8_t result;
+
+      switch (status)
+      {
+        case WL_CONNECTED:
+          result = WM_CONNECT_OK;
+          break;
+
+        case WL_NO_SSID_AVAIL:
+          result = WM_CONNECT_NO_SSID;
+          break;
+
+        case WL_CONNECT_FAILED:
+          result = WM_CONNECT_FAILED;
+          break;
+
+#ifdef ESP8266
+        case WL_WRONG_PASSWORD:
+          result = WM_CONNECT_WRONG_PASSWORD;
+          break;
+#endif
+
+        case WL_CONNECTION_LOST:
+          result = WM_CONNECT_LOST;
+          break;
+
+        default:
+          result = WM_CONNECT_TIMEOUT;
+          break;
+      }
+
+      _connects[result]++;
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Lowest free heap seen. The ESP32 core keeps its own.
+    void sampleHeap()
+    {
+#ifdef ESP8266
+      uint32_t freeHeap = ESP.getFreeHeap();
+
+      if ( (_minFreeHeap == 0) || (freeHeap < _minFreeHeap) )
+        _minFreeHeap = freeHeap;
+#endif
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Lines end with '\n' : Prometheus doesn't accept println()'s "\r\n"
+    void printPrometheus(Print& out)
+    {
+      uint32_t freeHeap, maxBlock, minFree;
+
+      heap(freeHeap, maxBlock, minFree);
+
+      out.print(F("# TYPE wm_http_requests_total counter\n"));
+
+      for (uint8_t i = 0; i < WM_ROUTES; i++)
+      {
+        printRouteLabel(out, F("wm_http_requests_total"), i);
+        out.print(_routes[i].count);
+        out.print('\n');
+      }
+
+      out.print(F("# TYPE wm_http_response_bytes_total counter\n"));
+
+      for (uint8_t i = 0; i < WM_ROUTES; i++)
+      {
+        printRouteLabel(out, F("wm_http_response_bytes_total"), i);
+        out.print(_routes[i].bytes);
+        out.print('\n');
+      }
+
+      out.print(F("# TYPE wm_http_request_duration_seconds histogram\n"));
+
+      for (uint8_t i = 0; i < WM_ROUTES; i++)
+      {
+        const Route& route = _routes[i];
+        uint32_t     count = 0;
+
+        // Routes never requested : no series
+        if (route.count == 0)
+          continue;
+
+        for (uint8_t b = 0; b <= WM_METRICS_BUCKETS; b++)
+        {
+          count += route.buckets[b];
+
+          out.print(F("wm_http_request_duration_seconds_bucket{route=\""));
+          out.print(FPSTR(WM_listName(WM_METRICS_ROUTE_NAMES, i)));
+          out.print(F("\",le=\""));
+
+          if (b < WM_METRICS_BUCKETS)
+            printSeconds(out, pgm_read_word(&WM_METRICS_BUCKET_MS[b]) * 1000ULL);
+          else
+            out.print(F("+Inf"));
+
+          out.print(F("\"} "));
+          out.print(count);
+          out.print('\n');
+        }
+
+        printRouteLabel(out, F("wm_http_request_duration_seconds_sum"), i);
+        printSeconds(out, route.micros);
+        out.print('\n');
+
+        printRouteLabel(out, F("wm_http_request_duration_seconds_count"), i);
+        out.print(route.count);
+        out.print('\n');
+      }
+
+      out.print(F("# TYPE wm_http_min_free_heap_bytes gauge\n"));
+
+      for (uint8_t i = 0; i < WM_ROUTES; i++)
+      {
+        if (_routes[i].count == 0)
+          continue;
+
+        printRouteLabel(out, F("wm_http_min_free_heap_bytes"), i);
+        out.print(_routes[i].minFree);
+        out.print('\n');
+      }
+
+      printCounter(out, F("wm_http_rate_limited_total"), _rateLimited);
+      printCounter(out, F("wm_dns_queries_total"), _dnsQueries);
+      printCounter(out, F("wm_wifi_scans_total"), _scans);
+      printCounter(out, F("wm_wifi_scan_errors_total"), _scanErrors);
+
+      out.print(F("# TYPE wm_wifi_scan_duration_seconds_total counter\nwm_wifi_scan_duration_seconds_total "));
+      printSeconds(out, _scanMs * 1000ULL);
+      out.print(F("\n# TYPE wm_wifi_scan_last_duration_seconds gauge\nwm_wifi_scan_last_duration_seconds "));
+      printSeconds(out, _lastScanMs * 1000ULL);
+      out.print(F("\n# TYPE wm_wifi_connect_attempts_total counter\n"));
+
+      for (uint8_t i = 0; i < WM_CONNECT_RESULTS; i++)
+      {
+        out.print(F("wm_wifi_connect_attempts_total{result=\""));
+        out.print(FPSTR(WM_listName(WM_METRICS_CONNECT_NAMES, i)));
+        out.print(F("\"} "));
+        out.print(_connects[i]);
+        out.print('\n');
+      }
+
+      printGauge(out, F("wm_heap_free_bytes"), freeHeap);
+      printGauge(out, F("wm_heap_largest_free_block_bytes"), maxBlock);
+      printGauge(out, F("wm_heap_min_free_bytes"), minFree);
+      printGauge(out, F("wm_uptime_seconds"), millis() / 1000);
+    }
+
+    ////////////////////////////////////////////////////
+
+    // {"uptime":s,"heap":{..},"dns":n,"scan":{..},"connect":{..},"limited":n,"le_ms":[..],
+    //  "routes":{"root":{"n":..,"bytes":..,"us":..,"minFree":..,"hist":[per bucket, last is +Inf]},..}}
+    void printJSON(Print& out)
+    {
+      uint32_t freeHeap, maxBlock, minFree;
+
+      heap(freeHeap, maxBlock, minFree);
+
+      out.print(F("{\"uptime\":"));
+      out.print(millis() / 1000);
+      out.print(F(",\"heap\":{\"free\":"));
+      out.print(freeHeap);
+      out.print(F(",\"maxBlock\":"));
+      out.print(maxBlock);
+      out.print(F(",\"minFree\":"));
+      out.print(minFree);
+      out.print(F("},\"dns\":"));
+      out.print(_dnsQueries);
+      out.print(F(",\"scan\":{\"n\":"));
+      out.print(_scans);
+      out.print(F(",\"errors\":"));
+      out.print(_scanErrors);
+      out.print(F(",\"ms\":"));
+      out.print(_scanMs);
+      out.print(F(",\"lastMs\":"));
+      out.print(_lastScanMs);
+      out.print(F("},\"connect\":{"));
+
+      for (uint8_t i = 0; i < WM_CONNECT_RESULTS; i++)
+      {
+        if (i)
+          out.print(',');
+
+        out.print('"');
+        out.print(FPSTR(WM_listName(WM_METRICS_CONNECT_NAMES, i)));
+        out.print(F("\":"));
+        out.print(_connects[i]);
+      }
+
+      out.print(F("},\"limited\":"));
+      out.print(_rateLimited);
+      out.print(F(",\"le_ms\":["));
+
+      for (uint8_t b = 0; b < WM_METRICS_BUCKETS; b++)
+      {
+        if (b)
+          out.print(',');
+
+        out.print(pgm_read_word(&WM_METRICS_BUCKET_MS[b]));
+      }
+
+      out.print(F("],\"routes\":{"));
+
+      for (uint8_t i = 0; i < WM_ROUTES; i++)
+      {
+        const Route& route = _routes[i];
+
+        if (i)
+          out.print(',');
+
+        out.print('"');
+        out.print(FPSTR(WM_listName(WM_METRICS_ROUTE_NAMES, i)));
+        out.print(F("\":{\"n\":"));
+        out.print(route.count);
+        out.print(F(",\"bytes\":"));
+        out.print(route.bytes);
+        out.print(F(",\"us\":"));
+        out.print((unsigned long long) route.micros);
+        out.print(F(",\"minFree\":"));
+        out.print(route.minFree);
+        out.print(F(",\"hist\":["));
+
+        for (uint8_t b = 0; b <= WM_METRICS_BUCKETS; b++)
+        {
+          if (b)
+            out.print(',');
+
+          out.print(route.buckets[b]);
+        }
+
+        out.print(F("]}"));
+      }
+
+      out.print(F("}}"));
+    }
+
+    ////////////////////////////////////////////////////
+
+  private:
+
+    struct Route
+    {
+      uint32_t  count;
+      uint32_t  bytes;
+      uint64_t  micros;
+      uint32_t  minFree;      // Lowest free heap seen while answering, 0 : none yet
+      uint32_t  buckets[WM_METRICS_BUCKETS + 1];
+    };
+
+    Route     _routes[WM_ROUTES];
+    uint32_t  _connects[WM_CONNECT_RESULTS];
+
+    uint8_t   _route        = WM_ROUTE_NOT_FOUND;
+    uint32_t  _start        = 0;
+
+    uint32_t  _rateLimited  = 0;
+    uint32_t  _dnsQueries   = 0;
+    uint32_t  _scans        = 0;
+    uint32_t  _scanErrors   = 0;
+    uint32_t  _scanMs       = 0;
+    uint32_t  _lastScanMs   = 0;
+    uint32_t  _minFreeHeap  = 0;
+
+    ////////////////////////////////////////////////////
+
+    void sampleRouteHeap()
+    {
+      uint32_t& minFree  = _routes[_route].minFree;
+      uint32_t  freeHeap = ESP.getFreeHeap();
+
+      if ( (minFree == 0) || (freeHeap < minFree) )
+        minFree = freeHeap;
+
+      if ( (_minFreeHeap == 0) || (freeHeap < _minFreeHeap) )
+        _minFreeHeap = freeHeap;
+    }
+
+    void heap(uint32_t& freeHeap, uint32_t& maxBlock, uint32_t& minFree)
+    {
+      freeHeap = ESP.getFreeHeap();
+
+#ifdef ESP8266
+      sampleHeap();
+
+      maxBlock = ESP.getMaxFreeBlockSize();
+      minFree  = _minFreeHeap;
+#else
+      maxBlock = ESP.getMaxAllocHeap();
+      minFree  = ESP.getMinFreeHeap();
+#endif
+    }
+
+    ////////////////////////////////////////////////////
+
+    static void printRouteLabel(Print& out, const __FlashStringHelper* metric, const uint8_t& route)
+    {
+      out.print(metric);
+      out.print(F("{route=\""));
+      out.print(FPSTR(WM_listName(WM_METRICS_ROUTE_NAMES, route)));
+      out.print(F("\"} "));
+    }
+
+    static void printCounter(Print& out, const __FlashStringHelper* metric, const uint32_t& value)
+    {
+      out.print(F("# TYPE "));
+      out.print(metric);
+      out.print(F(" counter\n"));
+      out.print(metric);
+      out.print(' ');
+      out.print(value);
+      out.print('\n');
+    }
+
+    static void printGauge(Print& out, const __FlashStringHelper* metric, const uint32_t& value)
+    {
+      out.print(F("# TYPE "));
+      out.print(metric);
+      out.print(F(" gauge\n"));
+      out.print(metric);
+      out.print(' ');
+      out.print(value);
+      out.print('\n');
+    }
+
+    // us as seconds, without floating point : 1234567 => 1.234567
+    static void printSeconds(Print& out, const uint64_t& us)
+    {
+      char frac[8];
+
+      snprintf(frac, sizeof(frac), ".%06lu", (unsigned long) (us % 1000000ULL));
+
+      out.print((unsigned long) (us / 1000000ULL));
+      out.print(frac);
+    }
+};
+
+////////////////////////////////////////////////////
+
+#else   // USE_WM_METRICS
+
+// Metrics disabled : the calls compile to nothing
+class ESP_WMMetrics
+{
+  public:
+
+    void beginRequest(const uint8_t&) {}
+    void setRoute(const uint8_t&) {}
+    void addBytesOut(const size_t&) {}
+    void endRequest() {}
+    void rateLimited() {}
+    void addDNSQueries(const int&) {}
+    void scanDone(const uint32_t&, const int&) {}
+    void connectDone(const int&) {}
+    void sampleHeap() {}
+};
+
+#endif    // USE_WM_METRICS
+
+////////////////////////////////////////////////////
+
+#endif    // WM_Metrics_h
@@ -0,0 +1,36 @@
+/****************************************************************************************************************************
+  WM_NameList.h
+  For ESP8266 / ESP32 boards
+
+  ESP_WiFiManager is a library for the ESP8266/Arduino platform
+  (https://github.com/esp8266/Arduino) to enable easy
+  configuration and reconfiguration of WiFi credentials using a Captive Portal
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Name lists kept in flash : one PROGMEM string of 0 terminated names, "scan\0connect\0", indexed by an enum.
+  Used for the log modules, the metrics routes and the allocation tracker operations.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WM_NameList_h
+#define WM_NameList_h
+
+#include <Arduino.h>
+
+////////////////////////////////////////////////////
+
+// index-th name of a PROGMEM list of 0 terminated names. Still in flash : print it with FPSTR().
+inline const char* WM_listName(const char* names, const uint8_t& index)
+{
+  for (uint8_t i = 0; i < index; i++)
+    names += strlen_P(names) + 1;
+
+  return names;
+}
+
+////////////////////////////////////////////////////
+
+#endif    // WM_NameList_h
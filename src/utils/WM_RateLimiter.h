@@ -0,0 +1,203 @@
+/****************************************************************************************************************************
+  WM_RateLimiter.h
+  For ESP8266 / ESP32 boards
+
+  ESP_WiFiManager is a library for the ESP8266/Arduino platform
+  (https://github.com/esp8266/Arduino) to enable easy
+  configuration and reconfiguration of WiFi credentials using a Captive Portal
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Per-client token buckets for the Config Portal. Each source IP gets one bucket for expensive routes
+  (WiFi scan, save) and one for cheap ones, in a small fixed table. When the table is full, the client
+  seen least recently is replaced.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WM_RateLimiter_h
+#define WM_RateLimiter_h
+
+#include <stdint.h>
+
+////////////////////////////////////////////////////
+
+// Number of clients tracked at the same time
+#ifndef WM_RATE_LIMIT_CLIENTS
+  #define WM_RATE_LIMIT_CLIENTS           8
+#endif
+
+// Expensive routes : burst of WM_RATE_EXPENSIVE_BURST, then WM_RATE_EXPENSIVE_PER_MIN per minute
+#ifndef WM_RATE_EXPENSIVE_BURST
+  #define WM_RATE_EXPENSIVE_BURST         4
+#endif
+
+#ifndef WM_RATE_EXPENSIVE_PER_MIN
+  #define WM_RATE_EXPENSIVE_PER_MIN       12
+#endif
+
+// Cheap routes
+#ifndef WM_RATE_CHEAP_BURST
+  #define WM_RATE_CHEAP_BURST             30
+#endif
+
+#ifndef WM_RATE_CHEAP_PER_MIN
+  #define WM_RATE_CHEAP_PER_MIN           300
+#endif
+
+// Tokens are kept in thousandths, so slow rates still refill between requests
+#define WM_RATE_TOKEN                     1000UL
+
+////////////////////////////////////////////////////
+
+class ESP_WMRateLimiter
+{
+  public:
+
+    ESP_WMRateLimiter()
+    {
+      reset();
+    }
+
+    ////////////////////////////////////////////////////
+
+    void reset()
+    {
+      for (uint8_t i = 0; i < WM_RATE_LIMIT_CLIENTS; i++)
+      {
+        _clients[i].ip = 0;
+      }
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Takes one token from the client's bucket. Returns 0 if the request can go on,
+    // else the number of seconds until a token is available, for Retry-After.
+    uint32_t check(const uint32_t& ip, const bool& expensive, const unsigned long& now)
+    {
+      Client& client = lookup(ip, now);
+      Bucket& bucket = expensive ? client.expensive : client.cheap;
+
+      const uint32_t burst  = (expensive ? WM_RATE_EXPENSIVE_BURST   : WM_RATE_CHEAP_BURST) * WM_RATE_TOKEN;
+      const uint32_t perMin = (expensive ? WM_RATE_EXPENSIVE_PER_MIN : WM_RATE_CHEAP_PER_MIN);
+
+      refill(bucket, burst, perMin, now);
+
+      if (bucket.tokens >= WM_RATE_TOKEN)
+      {
+        bucket.tokens -= WM_RATE_TOKEN;
+
+        return 0;
+      }
+
+      // ms until the missing part of the token has been refilled, rounded up to seconds
+      uint32_t waitMs = ( (WM_RATE_TOKEN - bucket.tokens) * 60UL + perMin - 1 ) / perMin;
+
+      return (waitMs + 999) / 1000;
+    }
+
+    ////////////////////////////////////////////////////
+
+  private:
+
+    typedef struct
+    {
+      uint32_t      tokens;
+      unsigned long lastRefill;
+    } Bucket;
+
+    typedef struct
+    {
+      uint32_t      ip;           // 0 for a free entry
+      unsigned long lastSeen;
+      Bucket        expensive;
+      Bucket        cheap;
+    } Client;
+
+    Client _clients[WM_RATE_LIMIT_CLIENTS];
+
+    ////////////////////////////////////////////////////
+
+    static void refill(Bucket& bucket, const uint32_t& burst, const uint32_t& perMin, const unsigned long& now)
+    {
+      unsigned long elapsed = now - bucket.lastRefill;
+
+      // Time to fill an empty bucket, more than that can't add anything
+      unsigned long fullMs = (burst * 60UL) / perMin;
+
+      if (elapsed >= fullMs)
+      {
+        bucket.tokens     = burst;
+        bucket.lastRefill = now;
+
+        return;
+      }
+
+      // Whole steps of stepMs, each adding exactly stepTokens. The rest of elapsed carries over to the next
+      // refill, so frequent requests don't lose the fraction of a token each one would round away.
+      uint32_t divisor = gcd(60, perMin);
+      uint32_t stepMs  = 60 / divisor;
+      uint32_t steps   = elapsed / stepMs;
+
+      bucket.tokens     += steps * (perMin / divisor);
+      bucket.lastRefill += steps * stepMs;
+
+      if (bucket.tokens >= burst)
+      {
+        bucket.tokens     = burst;
+        bucket.lastRefill = now;
+      }
+    }
+
+    static uint32_t gcd(uint32_t a, uint32_t b)
+    {
+      while (b)
+      {
+        uint32_t r = a % b;
+
+        a = b;
+        b = r;
+      }
+
+      return a;
+    }
+
+    ////////////////////////////////////////////////////
+
+    Client& lookup(const uint32_t& ip, const unsigned long& now)
+    {
+      uint8_t oldest = 0;
+
+      for (uint8_t i = 0; i < WM_RATE_LIMIT_CLIENTS; i++)
+      {
+        if (_clients[i].ip == ip)
+        {
+          _clients[i].lastSeen = now;
+
+          return _clients[i];
+        }
+
+        if ( (_clients[i].ip == 0) || ( (_clients[oldest].ip != 0) && (now - _clients[i].lastSeen > now - _clients[oldest].lastSeen) ) )
+        {
+          oldest = i;
+        }
+      }
+
+      // New client, or replaces the one seen least recently. Starts with full buckets.
+      Client& client = _clients[oldest];
+
+      client.ip                   = ip;
+      client.lastSeen             = now;
+      client.expensive.tokens     = WM_RATE_EXPENSIVE_BURST * WM_RATE_TOKEN;
+      client.expensive.lastRefill = now;
+      client.cheap.tokens         = WM_RATE_CHEAP_BURST * WM_RATE_TOKEN;
+      client.cheap.lastRefill     = now;
+
+      return client;
+    }
+};
+
+////////////////////////////////////////////////////
+
+#endif    // WM_RateLimiter_h
@@ -0,0 +1,668 @@
+/****************************************************************************************************************************
+  WM_SNTP.h
+  For ESP8266 / ESP32 boards
+
+  ESP_WiFiManager is a library for the ESP8266/Arduino platform
+  (https://github.com/esp8266/Arduino) to enable easy
+  configuration and reconfiguration of WiFi credentials using a Captive Portal
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  SNTP client used by the manager once connected. A sync sends a short burst of requests and sets the clock
+  from the reply with the lowest round trip, so a first valid time is usually there after one RTT.
+  The last sync and the measured clock drift are kept in RTC memory : after a deep sleep wake-up the clock
+  is restored, drift-corrected, and valid before WiFi is even up.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WM_SNTP_h
+#define WM_SNTP_h
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <time.h>
+#include <WiFiUdp.h>
+#include <sys/time.h>
+
+#ifdef ESP32
+  #include <esp_system.h>
+  #include <esp_attr.h>
+#endif
+
+////////////////////////////////////////////////////
+
+#define WM_NTP_PORT                       123
+#define WM_NTP_PACKET_SIZE                48
+
+// Seconds from 1900-01-01 (NTP era 0) to 1970-01-01
+#define WM_NTP_UNIX_OFFSET                2208988800ULL
+
+#define WM_SNTP_MAX_SERVERS               3
+
+// Requests sent by one sync, and time between them
+#ifndef WM_SNTP_BURST_COUNT
+  #define WM_SNTP_BURST_COUNT             4
+#endif
+
+#ifndef WM_SNTP_BURST_INTERVAL_MS
+  #define WM_SNTP_BURST_INTERVAL_MS       25
+#endif
+
+// Time to wait for replies after the last request
+#ifndef WM_SNTP_TIMEOUT_MS
+  #define WM_SNTP_TIMEOUT_MS              1000
+#endif
+
+// Time between syncs, and before retrying a failed one
+#ifndef WM_SNTP_INTERVAL_MS
+  #define WM_SNTP_INTERVAL_MS             3600000UL
+#endif
+
+#ifndef WM_SNTP_RETRY_MS
+  #define WM_SNTP_RETRY_MS                15000UL
+#endif
+
+// Restored time is trusted for that long after the last sync
+#ifndef WM_SNTP_VALID_FOR_SEC
+  #define WM_SNTP_VALID_FOR_SEC           (7 * 24 * 3600UL)
+#endif
+
+// Drift is only measured over at least that many seconds, and is capped at WM_SNTP_MAX_DRIFT_PPB
+#define WM_SNTP_MIN_DRIFT_SEC             600
+#define WM_SNTP_MAX_DRIFT_PPB             500000L
+
+// ESP8266 RTC user memory block (4 bytes each, 0-127) where the state is kept. Must not overlap
+// the memory used by the sketch or by ESP_DoubleResetDetector.
+#ifndef WM_SNTP_RTC_OFFSET
+  #define WM_SNTP_RTC_OFFSET              64
+#endif
+
+#define WM_SNTP_MAGIC                     0x534E5450UL
+
+////////////////////////////////////////////////////
+
+typedef struct
+{
+  uint32_t  magic;
+  uint32_t  rtcTicks;         // ESP8266 RTC counter when the clock read anchorUTC
+  uint32_t  rtcCalibration;   // ESP8266 RTC tick length, us << 12
+  int32_t   driftPPB;         // Clock rate error, positive when it runs fast
+  int64_t   anchorUTC;        // us
+  int64_t   lastSync;         // us, UTC of the last NTP sync
+  int64_t   correction;       // us, drift corrections applied to the clock since lastSync
+  uint32_t  checksum;
+} WM_SNTP_State;
+
+#ifdef ESP32
+// One copy for the whole program, whatever the number of files including this header, kept by deep sleep
+inline WM_SNTP_State& WM_sntpState()
+{
+  static RTC_DATA_ATTR WM_SNTP_State state;
+
+  return state;
+}
+#endif
+
+typedef void (*WM_TimeValidCallback)(time_t now);
+
+////////////////////////////////////////////////////
+
+class ESP_WMSNTP
+{
+  public:
+
+    ESP_WMSNTP() {}
+
+    ////////////////////////////////////////////////////
+
+    // Up to WM_SNTP_MAX_SERVERS, tried in turn when one doesn't answer. port is for test servers.
+    void setServer(const uint8_t& index, const char * server, const uint16_t& port = WM_NTP_PORT)
+    {
+      if (index < WM_SNTP_MAX_SERVERS)
+      {
+        _servers[index] = server;
+        _ports[index]   = port;
+
+        if (index == _server)
+          _resolved = false;
+      }
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Called once, when time first becomes valid. Right away if it already is.
+    void setTimeValidCallback(WM_TimeValidCallback callback)
+    {
+      _callback = callback;
+
+      if (_valid && _callback)
+        _callback(time(nullptr));
+    }
+
+    ////////////////////////////////////////////////////
+
+    bool isValid() const
+    {
+      return _valid;
+    }
+
+    // Synced from a server since boot, not only restored from RTC memory
+    bool isSynced() const
+    {
+      return _synced;
+    }
+
+    int32_t driftPPB() const
+    {
+      return _state.driftPPB;
+    }
+
+    // Offset, in us, applied to the clock by the last sync
+    int64_t lastOffset() const
+    {
+      return _lastOffset;
+    }
+
+    ////////////////////////////////////////////////////
+
+    // After a deep sleep wake-up, sets the clock from the state kept in RTC memory.
+    // Returns true if time is valid.
+    bool restore()
+    {
+      if (!loadState())
+        return false;
+
+#ifdef ESP8266
+      if (ESP.getResetInfoPtr()->reason != REASON_DEEP_SLEEP_AWAKE)
+        return false;
+
+      // System time restarts from 0 : rebuild it from the RTC counter, which kept running in deep sleep
+      uint32_t ticks  = system_get_rtc_time() - _state.rtcTicks;
+      int64_t  now    = _state.anchorUTC + (int64_t) ( ((uint64_t) ticks * _state.rtcCalibration) >> 12 );
+#else
+      if (esp_reset_reason() != ESP_RST_DEEPSLEEP)
+        return false;
+
+      // The RTC kept system time running in deep sleep
+      int64_t now = currentTime();
+#endif
+
+      if ( (now < _state.lastSync) || (now - _state.lastSync > (int64_t) WM_SNTP_VALID_FOR_SEC * 1000000LL) )
+        return false;
+
+      // Drift since the clock was last anchored
+      int64_t fix = - (now - _state.anchorUTC) * _state.driftPPB / 1000000000LL;
+
+      now += fix;
+      _state.correction += fix;
+
+      setTime(now);
+      anchor(now);
+      saveState();
+
+      setValid();
+
+      return true;
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Starts a sync, done by loop()
+    void start()
+    {
+      if (_phase == WM_SNTP_IDLE)
+      {
+        _nextSync = millis();
+      }
+    }
+
+    // As configTzTime(), without blocking : sets the local time zone (a POSIX TZ rule, as getTZ() returns)
+    // and starts a sync, done by loop()
+    void begin(const char * TZ)
+    {
+      if (TZ && *TZ)
+      {
+        setenv("TZ", TZ, 1);
+        tzset();
+      }
+
+      start();
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Sends the burst, collects replies, and starts periodic syncs. Call it often, it doesn't block except for
+    // the DNS lookup of the server : WiFi.hostByName() waits for the answer, up to its timeout of a few seconds.
+    // It is only done for the first sync and after a server stopped answering, the address is kept meanwhile.
+    void loop()
+    {
+      if (WiFi.status() != WL_CONNECTED)
+        return;
+
+      unsigned long now = millis();
+
+      switch (_phase)
+      {
+        case WM_SNTP_IDLE:
+
+          if ( (long) (now - _nextSync) >= 0 )
+            beginBurst();
+
+          break;
+
+        case WM_SNTP_BURST:
+
+          readReplies();
+
+          if ( (_received == WM_SNTP_BURST_COUNT) || (now - _lastSent >= WM_SNTP_TIMEOUT_MS) )
+            endBurst();
+          else if ( (_sent < WM_SNTP_BURST_COUNT) && (now - _lastSent >= WM_SNTP_BURST_INTERVAL_MS) )
+            sendRequest();
+
+          break;
+      }
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Blocking sync, at most timeoutMs. Returns true if time was set.
+    bool sync(const unsigned long& timeoutMs = WM_SNTP_BURST_COUNT * WM_SNTP_BURST_INTERVAL_MS + WM_SNTP_TIMEOUT_MS)
+    {
+      unsigned long startedAt = millis();
+
+      _lastResult = false;
+
+      if (_phase == WM_SNTP_IDLE)
+        beginBurst();
+
+      while ( (_phase == WM_SNTP_BURST) && (millis() - startedAt < timeoutMs) )
+      {
+        loop();
+        delay(1);
+      }
+
+      if (_phase == WM_SNTP_BURST)
+        endBurst();
+
+      return _lastResult;
+    }
+
+    ////////////////////////////////////////////////////
+
+    // NTP timestamp at us since 1970
+    static uint64_t toNTP(const int64_t& us)
+    {
+      uint64_t secs = (uint64_t) (us / 1000000) + WM_NTP_UNIX_OFFSET;
+      uint64_t frac = ( (uint64_t) (us % 1000000) << 32 ) / 1000000;
+
+      return (secs << 32) | frac;
+    }
+
+    static int64_t fromNTP(const uint64_t& ntp)
+    {
+      int64_t secs = (int64_t) (ntp >> 32) - (int64_t) WM_NTP_UNIX_OFFSET;
+      int64_t us   = (int64_t) ( ((ntp & 0xFFFFFFFFULL) * 1000000ULL) >> 32 );
+
+      return secs * 1000000LL + us;
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Checks a server reply to the request sent at originate (NTP timestamp) and received at t4 (us).
+    // Returns false if it must be ignored, else the clock offset and round trip delay, in us.
+    static bool parseReply(const uint8_t* packet, const size_t& len, const uint64_t& originate, const int64_t& t4,
+                           int64_t& offset, int64_t& delay)
+    {
+      if (len < WM_NTP_PACKET_SIZE)
+        return false;
+
+      uint8_t leap    = packet[0] >> 6;
+      uint8_t mode    = packet[0] & 0x07;
+      uint8_t stratum = packet[1];
+
+      // Server reply, synchronized, not a Kiss-o'-Death
+      if ( (mode != 4) || (leap == 3) || (stratum == 0) || (stratum > 15) )
+        return false;
+
+      if (readTimestamp(&packet[24]) != originate)
+        return false;
+
+      uint64_t received = readTimestamp(&packet[32]);
+      uint64_t sent     = readTimestamp(&packet[40]);
+
+      if ( (received == 0) || (sent == 0) )
+        return false;
+
+      int64_t t1 = fromNTP(originate);
+      int64_t t2 = fromNTP(received);
+      int64_t t3 = fromNTP(sent);
+
+      offset  = ( (t2 - t1) + (t3 - t4) ) / 2;
+      delay   = (t4 - t1) - (t3 - t2);
+
+      return (delay >= 0);
+    }
+
+    ////////////////////////////////////////////////////
+
+    static void buildRequest(uint8_t* packet, const uint64_t& transmit)
+    {
+      memset(packet, 0, WM_NTP_PACKET_SIZE);
+
+      // LI 0, version 4, client
+      packet[0] = 0x23;
+
+      // Echoed by the server as originate timestamp, identifies the reply
+      for (uint8_t i = 0; i < 8; i++)
+      {
+        packet[40 + i] = (transmit >> (56 - 8 * i)) & 0xFF;
+      }
+    }
+
+    ////////////////////////////////////////////////////
+
+  private:
+
+    typedef enum
+    {
+      WM_SNTP_IDLE,
+      WM_SNTP_BURST
+    } Phase;
+
+    const char*           _servers[WM_SNTP_MAX_SERVERS] = { "pool.ntp.org", "time.nist.gov", NULL };
+    uint16_t              _ports[WM_SNTP_MAX_SERVERS]   = { WM_NTP_PORT, WM_NTP_PORT, WM_NTP_PORT };
+    uint8_t               _server       = 0;
+
+    WiFiUDP               _udp;
+    IPAddress             _serverIP;
+    bool                  _resolved     = false;
+
+    Phase                 _phase        = WM_SNTP_IDLE;
+    unsigned long         _nextSync     = 0;
+    unsigned long         _lastSent     = 0;
+    uint8_t               _sent         = 0;
+    uint8_t               _received     = 0;
+    uint64_t              _originate[WM_SNTP_BURST_COUNT];
+
+    // Best reply of the burst
+    bool                  _haveReply    = false;
+    int64_t               _bestOffset   = 0;
+    int64_t               _bestDelay    = 0;
+
+    bool                  _valid        = false;
+    bool                  _synced       = false;
+    bool                  _lastResult   = false;
+    int64_t               _lastOffset   = 0;
+
+    WM_TimeValidCallback  _callback     = NULL;
+
+#ifdef ESP8266
+    WM_SNTP_State         _state;
+#else
+    WM_SNTP_State&        _state        = WM_sntpState();
+#endif
+
+    ////////////////////////////////////////////////////
+
+    static uint64_t readTimestamp(const uint8_t* p)
+    {
+      uint64_t value = 0;
+
+      for (uint8_t i = 0; i < 8; i++)
+      {
+        value = (value << 8) | p[i];
+      }
+
+      return value;
+    }
+
+    ////////////////////////////////////////////////////
+
+    static int64_t currentTime()
+    {
+      struct timeval tv;
+
+      gettimeofday(&tv, NULL);
+
+      return (int64_t) tv.tv_sec * 1000000LL + tv.tv_usec;
+    }
+
+    static void setTime(const int64_t& us)
+    {
+      struct timeval tv;
+
+      tv.tv_sec   = us / 1000000LL;
+      tv.tv_usec  = us % 1000000LL;
+
+      settimeofday(&tv, NULL);
+    }
+
+    ////////////////////////////////////////////////////
+
+    void beginBurst()
+    {
+      const char* server = _servers[_server];
+
+      _lastResult = false;
+
+      if (server && !_resolved)
+        _resolved = (WiFi.hostByName(server, _serverIP) == 1);
+
+      if (!server || !_resolved || !_udp.begin(0))
+      {
+        LOGINFO1(F("SNTP: can't reach"), server ? server : "(none)");
+
+        nextServer();
+        _nextSync = millis() + WM_SNTP_RETRY_MS;
+
+        return;
+      }
+
+      _phase      = WM_SNTP_BURST;
+      _sent       = 0;
+      _received   = 0;
+      _haveReply  = false;
+
+      sendRequest();
+    }
+
+    ////////////////////////////////////////////////////
+
+    void sendRequest()
+    {
+      uint8_t packet[WM_NTP_PACKET_SIZE];
+
+      _originate[_sent] = toNTP(currentTime());
+
+      buildRequest(packet, _originate[_sent]);
+
+      _udp.beginPacket(_serverIP, _ports[_server]);
+      _udp.write(packet, WM_NTP_PACKET_SIZE);
+      _udp.endPacket();
+
+      _sent++;
+      _lastSent = millis();
+    }
+
+    ////////////////////////////////////////////////////
+
+    void readReplies()
+    {
+      uint8_t packet[WM_NTP_PACKET_SIZE];
+
+      while (_udp.parsePacket() > 0)
+      {
+        int     len = _udp.read(packet, sizeof(packet));
+        int64_t t4  = currentTime();
+
+        if ( (len <= 0) || (_udp.remoteIP() != _serverIP) )
+          continue;
+
+        int64_t offset;
+        int64_t delay;
+
+        for (uint8_t i = 0; i < _sent; i++)
+        {
+          if ( (_originate[i] != 0) && parseReply(packet, len, _originate[i], t4, offset, delay) )
+          {
+            // Answered, a copy of the reply can't count twice
+            _originate[i] = 0;
+            _received++;
+
+            if (!_haveReply || (delay < _bestDelay))
+            {
+              _haveReply  = true;
+              _bestOffset = offset;
+              _bestDelay  = delay;
+            }
+
+            break;
+          }
+        }
+      }
+    }
+
+    ////////////////////////////////////////////////////
+
+    void endBurst()
+    {
+      _udp.stop();
+      _phase = WM_SNTP_IDLE;
+
+      _lastResult = _haveReply;
+
+      if (!_haveReply)
+      {
+        LOGINFO1(F("SNTP: no reply from"), _servers[_server]);
+
+        nextServer();
+        _nextSync = millis() + WM_SNTP_RETRY_MS;
+
+        return;
+      }
+
+      applyOffset(_bestOffset);
+
+      LOGINFO3(F("SNTP: offset (us) ="), (int32_t) _bestOffset, F(", delay (us) ="), (int32_t) _bestDelay);
+
+      _nextSync = millis() + WM_SNTP_INTERVAL_MS;
+    }
+
+    ////////////////////////////////////////////////////
+
+    void applyOffset(const int64_t& offset)
+    {
+      int64_t now       = currentTime() + offset;
+      bool    haveState = loadState();
+
+      if (!haveState)
+      {
+        memset(&_state, 0, sizeof(_state));
+      }
+      else if ( (_state.lastSync > 0) && (now - _state.lastSync >= WM_SNTP_MIN_DRIFT_SEC * 1000000LL) )
+      {
+        // How far ahead the clock would be without our corrections, over the time since the last sync
+        int64_t elapsed   = now - _state.lastSync;
+        int64_t raw       = - offset - _state.correction;
+        int64_t measured  = raw * 1000000000LL / elapsed;
+
+        if (measured > WM_SNTP_MAX_DRIFT_PPB)
+          measured = WM_SNTP_MAX_DRIFT_PPB;
+        else if (measured < -WM_SNTP_MAX_DRIFT_PPB)
+          measured = -WM_SNTP_MAX_DRIFT_PPB;
+
+        // Smoothed, the first measurement is taken as is
+        _state.driftPPB = (_state.driftPPB == 0) ? (int32_t) measured : (int32_t) ( (_state.driftPPB + measured) / 2 );
+      }
+
+      setTime(now);
+
+      _lastOffset         = offset;
+      _state.lastSync     = now;
+      _state.correction   = 0;
+
+      anchor(now);
+      saveState();
+
+      _synced = true;
+      setValid();
+    }
+
+    ////////////////////////////////////////////////////
+
+    void anchor(const int64_t& now)
+    {
+      _state.anchorUTC = now;
+
+#ifdef ESP8266
+      _state.rtcTicks        = system_get_rtc_time();
+      _state.rtcCalibration  = system_rtc_clock_cali_proc();
+#endif
+    }
+
+    ////////////////////////////////////////////////////
+
+    void setValid()
+    {
+      if (!_valid)
+      {
+        _valid = true;
+
+        if (_callback)
+          _callback(time(nullptr));
+      }
+    }
+
+    ////////////////////////////////////////////////////
+
+    void nextServer()
+    {
+      uint8_t next = (_server + 1) % WM_SNTP_MAX_SERVERS;
+
+      _server   = _servers[next] ? next : 0;
+      _resolved = false;
+    }
+
+    ////////////////////////////////////////////////////
+
+    static uint32_t checksum(const WM_SNTP_State& state)
+    {
+      const uint32_t* words = (const uint32_t*) &state;
+      uint32_t        sum   = 0x5A5A5A5AUL;
+
+      for (uint8_t i = 0; i < offsetof(WM_SNTP_State, checksum) / 4; i++)
+      {
+        sum = (sum << 5) + (sum >> 27) + words[i];
+      }
+
+      return sum;
+    }
+
+    ////////////////////////////////////////////////////
+
+    bool loadState()
+    {
+#ifdef ESP8266
+      if (!ESP.rtcUserMemoryRead(WM_SNTP_RTC_OFFSET, (uint32_t*) &_state, sizeof(_state)))
+        return false;
+#endif
+
+      return (_state.magic == WM_SNTP_MAGIC) && (_state.checksum == checksum(_state));
+    }
+
+    void saveState()
+    {
+      _state.magic    = WM_SNTP_MAGIC;
+      _state.checksum = checksum(_state);
+
+#ifdef ESP8266
+      ESP.rtcUserMemoryWrite(WM_SNTP_RTC_OFFSET, (uint32_t*) &_state, sizeof(_state));
+#endif
+    }
+};
+
+////////////////////////////////////////////////////
+
+#endif    // WM_SNTP_h
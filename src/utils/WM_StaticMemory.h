@@ -0,0 +1,134 @@
+/****************************************************************************************************************************
+  WM_StaticMemory.h
+  For ESP8266 / ESP32 boards
+
+  ESP_WiFiManager is a library for the ESP8266/Arduino platform
+  (https://github.com/esp8266/Arduino) to enable easy
+  configuration and reconfiguration of WiFi credentials using a Captive Portal
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Storage of USE_WM_STATIC_MEMORY : what the manager allocated on the heap is reserved at build time instead.
+
+    WM_InPlace<T>       Room for one T, constructed and destroyed in place : the DNS and web servers
+    WM_paramPool...()   Values of the ESP_WMParameter, WM_STATIC_PARAM_POOL bytes used as a stack
+    WM_STATIC_MAX_NETWORKS   scan results kept, the strongest ones
+
+  Sizes are set before including the library. Running out is logged, never taken from the heap.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WM_StaticMemory_h
+#define WM_StaticMemory_h
+
+#include <Arduino.h>
+#include <new>
+#include <utility>
+
+////////////////////////////////////////////////////
+
+// Bytes for the values of all ESP_WMParameter alive at the same time, each one length + 1
+#ifndef WM_STATIC_PARAM_POOL
+  #define WM_STATIC_PARAM_POOL          512
+#endif
+
+// Networks of a scan shown in the portal, the strongest ones
+#ifndef WM_STATIC_MAX_NETWORKS
+  #define WM_STATIC_MAX_NETWORKS        32
+#endif
+
+static_assert(WM_STATIC_PARAM_POOL > 0,   "WM_STATIC_PARAM_POOL must be > 0");
+static_assert(WM_STATIC_MAX_NETWORKS > 0, "WM_STATIC_MAX_NETWORKS must be > 0");
+
+////////////////////////////////////////////////////
+
+// Room for one T. Same use as the std::unique_ptr it replaces : emplace() instead of reset(new T()).
+template<typename T>
+class WM_InPlace
+{
+  public:
+
+    WM_InPlace() {}
+
+    WM_InPlace(const WM_InPlace&) = delete;
+    WM_InPlace& operator = (const WM_InPlace&) = delete;
+
+    ~WM_InPlace()
+    {
+      reset();
+    }
+
+    template<typename... Args>
+    T* emplace(Args&&... args)
+    {
+      reset();
+
+      _object = new (_storage) T(std::forward<Args>(args)...);
+
+      return _object;
+    }
+
+    void reset()
+    {
+      if (_object)
+      {
+        _object->~T();
+        _object = nullptr;
+      }
+    }
+
+    T* get() const
+    {
+      return _object;
+    }
+
+    T* operator -> () const
+    {
+      return _object;
+    }
+
+    explicit operator bool () const
+    {
+      return (_object != nullptr);
+    }
+
+  private:
+
+    alignas(T) uint8_t  _storage[sizeof(T)];
+    T*                  _object = nullptr;
+};
+
+////////////////////////////////////////////////////
+
+// Defined in ESP_WiFiManager-Impl.h
+extern char   WM_paramPool[WM_STATIC_PARAM_POOL];
+extern size_t WM_paramPoolUsed;
+
+// size bytes on top of the pool, nullptr when full
+inline char* WM_paramPoolAlloc(const size_t& size)
+{
+  if (size > WM_STATIC_PARAM_POOL - WM_paramPoolUsed)
+    return nullptr;
+
+  char* value = WM_paramPool + WM_paramPoolUsed;
+
+  WM_paramPoolUsed += size;
+
+  return value;
+}
+
+// Gives the value back if it is on top of the pool, as when parameters that are local variables are destroyed,
+// newest first. Returns false otherwise : freed out of order, its space isn't used again.
+inline bool WM_paramPoolFree(char* value, const size_t& size)
+{
+  if ( (value == nullptr) || (value + size != WM_paramPool + WM_paramPoolUsed) )
+    return false;
+
+  WM_paramPoolUsed -= size;
+
+  return true;
+}
+
+#endif    // WM_StaticMemory_h
@@ -0,0 +1,369 @@
+/****************************************************************************************************************************
+  WM_StaticString.h
+  For ESP8266 / ESP32 boards
+
+  ESP_WiFiManager is a library for the ESP8266/Arduino platform
+  (https://github.com/esp8266/Arduino) to enable easy
+  configuration and reconfiguration of WiFi credentials using a Captive Portal
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Text output without the heap, for the Config Portal pages :
+
+    WM_StaticString<N>  Print into a fixed buffer of N characters, for short values (numbers, IPs, headers)
+    WM_FunctionRef      Non-owning reference to a callable, where std::function would allocate its captures
+    WM_ChunkedPrint     Print buffered in a chunk of the caller's, sent as a chunked response each time it is full
+    WM_StackChunkedPrint  The same, in a WM_CHUNK_SIZE chunk of its own
+    WM_MACAddress       Printable MAC address, as WiFi.macAddress() formats it
+    WM_printTemplate()  Prints a PROGMEM page template with its {v}, {i}... tokens replaced, in one pass
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WM_StaticString_h
+#define WM_StaticString_h
+
+#include <Arduino.h>
+
+////////////////////////////////////////////////////
+
+// Chunk size of the streamed pages
+#ifndef WM_CHUNK_SIZE
+  #define WM_CHUNK_SIZE             512
+#endif
+
+////////////////////////////////////////////////////
+
+// Print into a fixed buffer, always 0 terminated. What doesn't fit is dropped, and overflowed() tells.
+template<size_t N>
+class WM_StaticString : public Print
+{
+  public:
+
+    WM_StaticString()
+    {
+      _buf[0] = 0;
+    }
+
+    template<typename T>
+    explicit WM_StaticString(const T& value) : WM_StaticString()
+    {
+      print(value);
+    }
+
+    size_t write(uint8_t c) override
+    {
+      if (_len == N)
+      {
+        _overflowed = true;
+
+        return 0;
+      }
+
+      _buf[_len++] = c;
+      _buf[_len]   = 0;
+
+      return 1;
+    }
+
+    size_t write(const uint8_t* buffer, size_t size) override
+    {
+      if (size > N - _len)
+      {
+        size        = N - _len;
+        _overflowed = true;
+      }
+
+      memcpy(_buf + _len, buffer, size);
+      _len        += size;
+      _buf[_len]   = 0;
+
+      return size;
+    }
+
+    using Print::write;
+
+    template<typename T>
+    WM_StaticString& operator += (const T& value)
+    {
+      print(value);
+
+      return *this;
+    }
+
+    const char* c_str() const
+    {
+      return _buf;
+    }
+
+    operator const char* () const
+    {
+      return _buf;
+    }
+
+    size_t length() const
+    {
+      return _len;
+    }
+
+    static constexpr size_t capacity()
+    {
+      return N;
+    }
+
+    bool overflowed() const
+    {
+      return _overflowed;
+    }
+
+    void clear()
+    {
+      _len        = 0;
+      _buf[0]     = 0;
+      _overflowed = false;
+    }
+
+  private:
+
+    char    _buf[N + 1];
+    size_t  _len        = 0;
+    bool    _overflowed = false;
+};
+
+////////////////////////////////////////////////////
+
+// Reference to a callable, a function pointer and its object : nothing copied, nothing allocated, whatever the
+// number of captures of a lambda. The callable must outlive the reference, as a lambda passed to a call does.
+template<typename Signature>
+class WM_FunctionRef;
+
+template<typename R, typename... Args>
+class WM_FunctionRef<R(Args...)>
+{
+  public:
+
+    template<typename F>
+    WM_FunctionRef(const F& callable) : _call(&call<F>), _object((void*) &callable)
+    {
+    }
+
+    // A plain function, called with object first
+    WM_FunctionRef(R (*function)(void*, Args...), void* object) : _call(function), _object(object)
+    {
+    }
+
+    R operator()(Args... args) const
+    {
+      return _call(_object, args...);
+    }
+
+  private:
+
+    template<typename F>
+    static R call(void* object, Args... args)
+    {
+      return (*(const F*) object)(args...);
+    }
+
+    R     (*_call)(void*, Args...);
+    void*   _object;
+};
+
+////////////////////////////////////////////////////
+
+// Print buffered in a chunk of the caller's, handed to a sender (WebServer::sendContent) each time it is full.
+// Writes larger than the chunk go to the sender directly. Holds no chunk itself : see WM_StackChunkedPrint.
+class WM_ChunkedPrint : public Print
+{
+  public:
+
+    typedef WM_FunctionRef<void(const char*, size_t)> Sender;
+
+    WM_ChunkedPrint(const Sender& sender, char* buffer, const size_t& size) : _sender(sender), _buf(buffer), _size(size)
+    {
+    }
+
+    ~WM_ChunkedPrint()
+    {
+      flush();
+    }
+
+    size_t write(uint8_t c) override
+    {
+      if (_len == _size)
+        flush();
+
+      _buf[_len++] = c;
+
+      return 1;
+    }
+
+    size_t write(const uint8_t* buffer, size_t size) override
+    {
+      if (size > _size - _len)
+      {
+        flush();
+
+        if (size >= _size)
+        {
+          _sender((const char*) buffer, size);
+
+          return size;
+        }
+      }
+
+      memcpy(_buf + _len, buffer, size);
+      _len += size;
+
+      return size;
+    }
+
+    using Print::write;
+
+    void flush() override
+    {
+      if (_len)
+      {
+        _sender(_buf, _len);
+        _len = 0;
+      }
+    }
+
+  private:
+
+    Sender  _sender;
+    char*   _buf;
+    size_t  _size;
+    size_t  _len  = 0;
+};
+
+////////////////////////////////////////////////////
+
+// WM_ChunkedPrint in its own WM_CHUNK_SIZE bytes : on the stack, as a local
+class WM_StackChunkedPrint : public WM_ChunkedPrint
+{
+  public:
+
+    WM_StackChunkedPrint(const Sender& sender) : WM_ChunkedPrint(sender, _chunk, WM_CHUNK_SIZE)
+    {
+    }
+
+    // Sent while the chunk is still there
+    ~WM_StackChunkedPrint()
+    {
+      flush();
+    }
+
+  private:
+
+    char    _chunk[WM_CHUNK_SIZE];
+};
+
+////////////////////////////////////////////////////
+
+// "AA:BB:CC:DD:EE:FF"
+class WM_MACAddress : public Printable
+{
+  public:
+
+    WM_MACAddress(const uint8_t* mac)
+    {
+      memcpy(_mac, mac, sizeof(_mac));
+    }
+
+    size_t printTo(Print& p) const override
+    {
+      size_t n = 0;
+
+      for (uint8_t i = 0; i < sizeof(_mac); i++)
+      {
+        if (i)
+          n += p.print(':');
+
+        if (_mac[i] < 0x10)
+          n += p.print('0');
+
+        n += p.print(_mac[i], HEX);
+      }
+
+      return n;
+    }
+
+  private:
+
+    uint8_t _mac[6];
+};
+
+////////////////////////////////////////////////////
+
+// Writes len bytes of PROGMEM text. Only ESP8266 needs them read one by one
+inline size_t WM_writeProgmem(Print& out, PGM_P text, const size_t& len)
+{
+#if defined(ESP8266)
+  size_t n = 0;
+
+  for (size_t i = 0; i < len; i++)
+    n += out.write((uint8_t) pgm_read_byte(text + i));
+
+  return n;
+#else
+  return out.write((const uint8_t*) text, len);
+#endif
+}
+
+// A token of a page template ("{v}", "[[ssid]]"...) and its value
+typedef struct
+{
+  const char* token;
+  const char* value;
+} WM_TemplateVar;
+
+// Prints the PROGMEM text with each token replaced by its value. Single pass : a value is never searched
+// for tokens, and text without any token (styles, scripts) comes out as it is.
+inline size_t WM_printTemplate(Print& out, PGM_P text, const WM_TemplateVar* vars, const uint8_t& count)
+{
+  size_t  n = 0;
+  PGM_P   plain = text;
+  char    c;
+
+  while ( (c = (char) pgm_read_byte(text)) )
+  {
+    uint8_t i;
+
+    for (i = 0; i < count; i++)
+    {
+      if ( (c == vars[i].token[0]) && (strncmp_P(vars[i].token, text, strlen(vars[i].token)) == 0) )
+        break;
+    }
+
+    if (i == count)
+    {
+      text++;
+
+      continue;
+    }
+
+    // Text before the token, then its value
+    n += WM_writeProgmem(out, plain, text - plain);
+
+    if (vars[i].value)
+      n += out.print(vars[i].value);
+
+    text  += strlen(vars[i].token);
+    plain  = text;
+  }
+
+  n += WM_writeProgmem(out, plain, text - plain);
+
+  return n;
+}
+
+inline size_t WM_printTemplate(Print& out, PGM_P text, const char* token, const char* value)
+{
+  WM_TemplateVar var = { token, value };
+
+  return WM_printTemplate(out, text, &var, 1);
+}
+
+#endif    // WM_StaticString_h
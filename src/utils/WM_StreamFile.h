@@ -0,0 +1,172 @@
+/****************************************************************************************************************************
+  WM_StreamFile.h
+  For ESP8266 / ESP32 boards
+
+  ESP_WiFiManager is a library for the ESP8266/Arduino platform
+  (https://github.com/esp8266/Arduino) to enable easy
+  configuration and reconfiguration of WiFi credentials using a Captive Portal
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Serving files of a sketch's own web server with validators : ETag from size and modification time, 304 on
+  If-None-Match, a single Range answered 206 unless If-Range names another version. The patched ESP32
+  WebServer (WEBSERVER_HAS_CONDITIONAL_STREAMFILE) does all of it in streamFile() itself, other servers get it
+  here. Files without a modification time (SPIFFS) get no ETag, hence no 304 : size alone can't tell two
+  versions of a file apart.
+
+    WM_collectStreamFileHeaders(server);            // in setup(), replaces headers collected before
+    WM_streamFile(server, file, path, contentType); // in the file handler
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WM_StreamFile_h
+#define WM_StreamFile_h
+
+#include <Arduino.h>
+
+////////////////////////////////////////////////////
+
+// Request headers WM_streamFile() needs, to collect when the server doesn't
+template<typename ServerType>
+void WM_collectStreamFileHeaders(ServerType& server)
+{
+#if defined(WEBSERVER_HAS_CONDITIONAL_STREAMFILE)
+  (void) server;
+#else
+  const char* headers[] = { "If-None-Match", "Range", "If-Range" };
+
+  server.collectHeaders(headers, sizeof(headers) / sizeof(headers[0]));
+#endif
+}
+
+// Strong validator from size and modification time, empty without a modification time
+inline String WM_fileETag(const size_t& fileSize, const time_t& lastWrite)
+{
+  if (lastWrite == 0)
+    return String();
+
+  char etag[24];
+
+  snprintf(etag, sizeof(etag), "\"%x-%lx\"", (unsigned) fileSize, (unsigned long) lastWrite);
+
+  return String(etag);
+}
+
+// Returns 0 to send the whole file, 1 for a valid single range and -1 if the range can't be satisfied.
+// Multiple ranges and malformed headers are ignored, as RFC 7233 allows.
+inline int WM_parseRange(const String& range, const size_t& fileSize, size_t& first, size_t& last)
+{
+  if (!range.startsWith("bytes=") || (range.indexOf(',') >= 0))
+    return 0;
+
+  int dash = range.indexOf('-');
+
+  if (dash < 6)
+    return 0;
+
+  String from = range.substring(6, dash);
+  String to   = range.substring(dash + 1);
+
+  if (from.length() == 0)
+  {
+    // bytes=-N : the last N bytes
+    size_t suffix = to.toInt();
+
+    if ( (suffix == 0) || (fileSize == 0) )
+      return -1;
+
+    first = (suffix < fileSize) ? fileSize - suffix : 0;
+    last  = fileSize - 1;
+
+    return 1;
+  }
+
+  first = from.toInt();
+  last  = (to.length() > 0) ? (size_t) to.toInt() : fileSize - 1;
+
+  if (first >= fileSize)
+    return -1;
+
+  if (last < first)
+    return 0;
+
+  if (last >= fileSize)
+    last = fileSize - 1;
+
+  return 1;
+}
+
+////////////////////////////////////////////////////
+
+// file at path, of contentType, with 200, 206, 304 or 416. Returns the bytes of the file sent.
+template<typename ServerType, typename FileType>
+size_t WM_streamFile(ServerType& server, FileType& file, const String& path, const String& contentType)
+{
+#if defined(WEBSERVER_HAS_CONDITIONAL_STREAMFILE)
+  (void) path;
+
+  return server.streamFile(file, contentType);
+#else
+  size_t fileSize = file.size();
+  String etag     = WM_fileETag(fileSize, file.getLastWrite());
+
+  if (etag.length())
+  {
+    server.sendHeader("ETag", etag);
+
+    if (server.hasHeader("If-None-Match") && (server.header("If-None-Match").indexOf(etag) >= 0))
+    {
+      server.send(304);
+
+      return 0;
+    }
+  }
+
+  server.sendHeader("Accept-Ranges", "bytes");
+
+  // A Range of another version of the file : the whole file instead
+  bool   ifRange = !server.hasHeader("If-Range") || (etag.length() && (server.header("If-Range") == etag));
+  size_t first   = 0;
+  size_t last    = 0;
+  int    range   = (ifRange && server.hasHeader("Range")) ? WM_parseRange(server.header("Range"), fileSize, first, last) : 0;
+
+  if (range < 0)
+  {
+    server.sendHeader("Content-Range", "bytes */" + String(fileSize));
+    server.send(416);
+
+    return 0;
+  }
+
+  if ( (range == 0) || !file.seek(first) )
+    return server.streamFile(file, contentType);
+
+  if (path.endsWith(".gz") && (contentType != "application/x-gzip"))
+    server.sendHeader("Content-Encoding", "gzip");
+
+  server.sendHeader("Content-Range", "bytes " + String(first) + "-" + String(last) + "/" + String(fileSize));
+  server.setContentLength(last - first + 1);
+  server.send(206, contentType, "");
+
+  uint8_t buf[1024];
+  size_t  left = last - first + 1;
+  size_t  sent = 0;
+
+  while (left > 0)
+  {
+    size_t len = file.read(buf, (left < sizeof(buf)) ? left : sizeof(buf));
+
+    if ( (len == 0) || (server.client().write(buf, len) != len) )
+      break;
+
+    left -= len;
+    sent += len;
+  }
+
+  return sent;
+#endif
+}
+
+#endif    // WM_StreamFile_h
@@ -0,0 +1,536 @@
+/****************************************************************************************************************************
+  WM_TimeZone.h
+  For ESP8266 / ESP32 boards
+
+  ESP_WiFiManager is a library for the ESP8266/Arduino platform
+  (https://github.com/esp8266/Arduino) to enable easy
+  configuration and reconfiguration of WiFi credentials using a Captive Portal
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Compiled POSIX timezone, as returned by getTZ(). The rule is parsed once into offsets and DST transition
+  rules. UTC <-> local conversions then compute the transition instants of the year on the stack, instead of
+  setenv("TZ") / tzset() / localtime() reparsing the rule and sharing global state. Conversions are const
+  and write nothing : one object can be used by several tasks at once.
+  Transitions are computed for the UTC year of the converted time, like glibc and newlib do.
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef WM_TimeZone_h
+#define WM_TimeZone_h
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+////////////////////////////////////////////////////
+
+// Abbreviations longer than this are truncated
+#define WM_TZ_ABBR_MAX_LEN          7
+
+#define WM_SECS_PER_DAY             86400L
+
+////////////////////////////////////////////////////
+
+class ESP_WMTimeZone
+{
+  public:
+
+    // UTC until begin() succeeds
+    ESP_WMTimeZone()
+    {
+      strcpy(_stdName, "UTC");
+      _dstName[0] = 0;
+    }
+
+    explicit ESP_WMTimeZone(const char * posixRule) : ESP_WMTimeZone()
+    {
+      begin(posixRule);
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Parses a POSIX TZ rule, "std offset [dst [offset] [,start[/time],end[/time]]]". Returns false, and
+    // leaves the object unchanged, if the rule is not valid.
+    bool begin(const char * posixRule)
+    {
+      ESP_WMTimeZone zone;
+
+      if (!posixRule || !zone.parse(posixRule))
+        return false;
+
+      *this = zone;
+
+      return true;
+    }
+
+    ////////////////////////////////////////////////////
+
+    bool hasDST() const
+    {
+      return _hasDST;
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Seconds east of UTC at that instant, DST included
+    int32_t offset(const time_t& utc) const
+    {
+      return isDST(utc) ? _dstOffset : _stdOffset;
+    }
+
+    ////////////////////////////////////////////////////
+
+    bool isDST(const time_t& utc) const
+    {
+      if (!_hasDST)
+        return false;
+
+      int64_t t = utc;
+      int64_t dstStart;
+      int64_t dstEnd;
+
+      transitions(t, dstStart, dstEnd);
+
+      // Southern hemisphere : DST spans the new year
+      if (dstStart > dstEnd)
+        return (t < dstEnd) || (t >= dstStart);
+
+      return (t >= dstStart) && (t < dstEnd);
+    }
+
+    ////////////////////////////////////////////////////
+
+    time_t toLocal(const time_t& utc) const
+    {
+      return utc + offset(utc);
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Local times skipped by a DST start are taken as standard time, those repeated by a DST end as DST
+    time_t toUTC(const time_t& local) const
+    {
+      time_t dst = local - _dstOffset;
+
+      if (_hasDST && isDST(dst))
+        return dst;
+
+      return local - _stdOffset;
+    }
+
+    ////////////////////////////////////////////////////
+
+    const char * abbreviation(const time_t& utc) const
+    {
+      return isDST(utc) ? _dstName : _stdName;
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Same fields as localtime_r(). tm_zone / tm_gmtoff are not set, not every libc has them.
+    struct tm * localTime(const time_t& utc, struct tm& tm) const
+    {
+      bool dst = isDST(utc);
+
+      breakDown((int64_t) utc + (dst ? _dstOffset : _stdOffset), tm);
+      tm.tm_isdst = dst ? 1 : 0;
+
+      return &tm;
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Days since 1970-01-01 of a proleptic Gregorian date, month 1..12
+    static int64_t daysFromCivil(int64_t year, const uint8_t& month, const uint8_t& day)
+    {
+      year -= (month <= 2);
+
+      int64_t  era = (year >= 0 ? year : year - 399) / 400;
+      uint32_t yoe = (uint32_t) (year - era * 400);
+      uint32_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+      uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+      return era * 146097 + (int64_t) doe - 719468;
+    }
+
+    ////////////////////////////////////////////////////
+
+    static bool isLeap(const int64_t& year)
+    {
+      return ( (year % 4 == 0) && (year % 100 != 0) ) || (year % 400 == 0);
+    }
+
+    ////////////////////////////////////////////////////
+
+  private:
+
+    typedef enum
+    {
+      WM_TZ_RULE_JULIAN_NO_LEAP,    // Jn   : 1..365, Feb 29 never counted
+      WM_TZ_RULE_JULIAN,            // n    : 0..365
+      WM_TZ_RULE_MONTH_WEEK_DAY     // Mm.w.d
+    } RuleType;
+
+    typedef struct
+    {
+      RuleType  type;
+      uint16_t  day;            // n, or d for Mm.w.d
+      uint8_t   month;
+      uint8_t   week;
+      int32_t   secs;           // Local time of the transition
+    } Rule;
+
+    char      _stdName[WM_TZ_ABBR_MAX_LEN + 1];
+    char      _dstName[WM_TZ_ABBR_MAX_LEN + 1];
+
+    int32_t   _stdOffset  = 0;      // Seconds east of UTC
+    int32_t   _dstOffset  = 0;
+    bool      _hasDST     = false;
+
+    Rule      _start;
+    Rule      _end;
+
+    ////////////////////////////////////////////////////
+
+    bool parse(const char * p)
+    {
+      int32_t value;
+
+      if (!parseName(p, _stdName) || !parseTime(p, value, 24))
+        return false;
+
+      // POSIX offsets are west of UTC
+      _stdOffset  = -value;
+      _dstOffset  = _stdOffset;
+      _hasDST     = false;
+      _dstName[0] = 0;
+
+      if (*p == 0)
+        return true;
+
+      if (!parseName(p, _dstName))
+        return false;
+
+      _hasDST     = true;
+      _dstOffset  = _stdOffset + 3600;
+
+      if ( (*p != ',') && (*p != 0) )
+      {
+        if (!parseTime(p, value, 24))
+          return false;
+
+        _dstOffset = -value;
+      }
+
+      if (*p == 0)
+      {
+        // Rules left out : US rules, as glibc does
+        const char * start = "M3.2.0";
+        const char * end   = "M11.1.0";
+
+        return parseRule(start, _start) && parseRule(end, _end);
+      }
+
+      p++;
+
+      if (!parseRule(p, _start) || (*p++ != ','))
+        return false;
+
+      if (!parseRule(p, _end))
+        return false;
+
+      return (*p == 0);
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Alphabetic name of 3 or more characters, or any <quoted> name
+    static bool parseName(const char *& p, char * name)
+    {
+      uint8_t len = 0;
+      uint8_t stored = 0;
+
+      if (*p == '<')
+      {
+        p++;
+
+        while ( (*p != '>') && (*p != 0) )
+        {
+          if ( !isAlnum(*p) && (*p != '+') && (*p != '-') )
+            return false;
+
+          if (stored < WM_TZ_ABBR_MAX_LEN)
+            name[stored++] = *p;
+
+          p++;
+          len++;
+        }
+
+        if (*p++ != '>')
+          return false;
+      }
+      else
+      {
+        while (isAlpha(*p))
+        {
+          if (stored < WM_TZ_ABBR_MAX_LEN)
+            name[stored++] = *p;
+
+          p++;
+          len++;
+        }
+      }
+
+      name[stored] = 0;
+
+      return (len >= 3);
+    }
+
+    ////////////////////////////////////////////////////
+
+    // [+|-]hh[:mm[:ss]], hours up to maxHours
+    static bool parseTime(const char *& p, int32_t& secs, const uint8_t& maxHours)
+    {
+      int32_t sign = 1;
+
+      if ( (*p == '+') || (*p == '-') )
+      {
+        sign = (*p == '-') ? -1 : 1;
+        p++;
+      }
+
+      int32_t parts[3] = { 0, 0, 0 };
+
+      for (uint8_t i = 0; i < 3; i++)
+      {
+        if (!isDigit(*p))
+          return false;
+
+        int32_t value = 0;
+
+        while (isDigit(*p))
+        {
+          value = value * 10 + (*p++ - '0');
+
+          if (value > 999)
+            return false;
+        }
+
+        parts[i] = value;
+
+        if ( (*p != ':') || (i == 2) )
+          break;
+
+        p++;
+      }
+
+      if ( (parts[0] > maxHours) || (parts[1] > 59) || (parts[2] > 59) )
+        return false;
+
+      secs = sign * (parts[0] * 3600 + parts[1] * 60 + parts[2]);
+
+      return true;
+    }
+
+    ////////////////////////////////////////////////////
+
+    static bool parseNumber(const char *& p, uint16_t& value, const uint16_t& minValue, const uint16_t& maxValue)
+    {
+      if (!isDigit(*p))
+        return false;
+
+      uint32_t number = 0;
+
+      while (isDigit(*p))
+      {
+        number = number * 10 + (*p++ - '0');
+
+        if (number > maxValue)
+          return false;
+      }
+
+      value = number;
+
+      return (number >= minValue);
+    }
+
+    ////////////////////////////////////////////////////
+
+    static bool parseRule(const char *& p, Rule& rule)
+    {
+      uint16_t value;
+
+      if (*p == 'M')
+      {
+        p++;
+        rule.type = WM_TZ_RULE_MONTH_WEEK_DAY;
+
+        if (!parseNumber(p, value, 1, 12) || (*p++ != '.'))
+          return false;
+
+        rule.month = value;
+
+        if (!parseNumber(p, value, 1, 5) || (*p++ != '.'))
+          return false;
+
+        rule.week = value;
+
+        if (!parseNumber(p, value, 0, 6))
+          return false;
+
+        rule.day = value;
+      }
+      else if (*p == 'J')
+      {
+        p++;
+        rule.type = WM_TZ_RULE_JULIAN_NO_LEAP;
+
+        if (!parseNumber(p, rule.day, 1, 365))
+          return false;
+      }
+      else
+      {
+        rule.type = WM_TZ_RULE_JULIAN;
+
+        if (!parseNumber(p, rule.day, 0, 365))
+          return false;
+      }
+
+      // Default transition time 02:00:00. Out of 0..24 hours is allowed, as in RFC 8536.
+      rule.secs = 7200;
+
+      if (*p == '/')
+      {
+        p++;
+
+        if (!parseTime(p, rule.secs, 167))
+          return false;
+      }
+
+      return true;
+    }
+
+    ////////////////////////////////////////////////////
+
+    static bool isDigit(const char& c)
+    {
+      return (c >= '0') && (c <= '9');
+    }
+
+    static bool isAlpha(const char& c)
+    {
+      return ( (c >= 'a') && (c <= 'z') ) || ( (c >= 'A') && (c <= 'Z') );
+    }
+
+    static bool isAlnum(const char& c)
+    {
+      return isAlpha(c) || isDigit(c);
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Floor division, for times before 1970
+    static int64_t floorDiv(const int64_t& a, const int64_t& b)
+    {
+      int64_t q = a / b;
+
+      return ( (a % b != 0) && ((a < 0) != (b < 0)) ) ? q - 1 : q;
+    }
+
+    ////////////////////////////////////////////////////
+
+    static int64_t yearOf(const int64_t& days)
+    {
+      // Shift to an era starting on March 1st, as in daysFromCivil()
+      int64_t  z    = days + 719468;
+      int64_t  era  = floorDiv(z, 146097);
+      uint32_t doe  = (uint32_t) (z - era * 146097);
+      uint32_t yoe  = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+      uint32_t doy  = doe - (365 * yoe + yoe / 4 - yoe / 100);
+      uint32_t mp   = (5 * doy + 2) / 153;
+
+      return (int64_t) yoe + era * 400 + (mp >= 10 ? 1 : 0);
+    }
+
+    ////////////////////////////////////////////////////
+
+    // Days since 1970-01-01 of the day the rule falls on in that year
+    static int64_t ruleDay(const Rule& rule, const int64_t& year)
+    {
+      int64_t yearStart = daysFromCivil(year, 1, 1);
+
+      switch (rule.type)
+      {
+        case WM_TZ_RULE_JULIAN_NO_LEAP:
+          return yearStart + rule.day - 1 + ( (rule.day >= 60) && isLeap(year) ? 1 : 0 );
+
+        case WM_TZ_RULE_JULIAN:
+          return yearStart + rule.day;
+
+        default:
+          break;
+      }
+
+      static const uint8_t monthDays[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+      int64_t first   = daysFromCivil(year, rule.month, 1);
+      uint8_t length  = monthDays[rule.month - 1] + ( (rule.month == 2) && isLeap(year) ? 1 : 0 );
+
+      // 1970-01-01 was a Thursday
+      int64_t day = first + (rule.day - (first + 4 - floorDiv(first + 4, 7) * 7) + 7) % 7 + (rule.week - 1) * 7;
+
+      // Week 5 is the last one
+      while (day >= first + length)
+        day -= 7;
+
+      return day;
+    }
+
+    ////////////////////////////////////////////////////
+
+    // DST start and end, UTC, in the UTC year of utc
+    void transitions(const int64_t& utc, int64_t& dstStart, int64_t& dstEnd) const
+    {
+      int64_t year = yearOf(floorDiv(utc, WM_SECS_PER_DAY));
+
+      // Start is given in standard time, end in DST
+      dstStart = ruleDay(_start, year) * WM_SECS_PER_DAY + _start.secs - _stdOffset;
+      dstEnd   = ruleDay(_end, year)   * WM_SECS_PER_DAY + _end.secs   - _dstOffset;
+    }
+
+    ////////////////////////////////////////////////////
+
+    static void breakDown(const int64_t& t, struct tm& tm)
+    {
+      int64_t days  = floorDiv(t, WM_SECS_PER_DAY);
+      int32_t secs  = (int32_t) (t - days * WM_SECS_PER_DAY);
+
+      tm.tm_hour    = secs / 3600;
+      tm.tm_min     = (secs / 60) % 60;
+      tm.tm_sec     = secs % 60;
+      tm.tm_wday    = (int) ((days + 4) - floorDiv(days + 4, 7) * 7);
+
+      int64_t year  = yearOf(days);
+      int32_t yday  = (int32_t) (days - daysFromCivil(year, 1, 1));
+
+      tm.tm_year    = (int) (year - 1900);
+      tm.tm_yday    = yday;
+
+      static const uint16_t monthStart[12] = { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 };
+      uint8_t leap  = isLeap(year) ? 1 : 0;
+      uint8_t month = 11;
+
+      while ( yday < monthStart[month] + (month >= 2 ? leap : 0) )
+        month--;
+
+      tm.tm_mon     = month;
+      tm.tm_mday    = yday - monthStart[month] - (month >= 2 ? leap : 0) + 1;
+    }
+};
+
+////////////////////////////////////////////////////
+
+#endif    // WM_TimeZone_h
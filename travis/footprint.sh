@@ -0,0 +1,273 @@
+#!/bin/bash
+#
+# Flash and RAM footprint of ESP_WiFiManager per feature flag
+#
+#   travis/footprint.sh [-b esp32|host] [-a] [-o dir] [-c previous.csv] [-t bytes]
+#
+# Builds travis/footprint/footprint.ino with the library's defaults, then once per feature flag set the
+# other way, then the lean configuration : every flag whose setting saved flash. Reports per build :
+#
+#   flash   code + rodata + data, what the app partition holds
+#   code    .flash.text + .iram0.text     (host : .text)
+#   rodata  .flash.rodata                 (host : .rodata), where PROGMEM strings and tables are on ESP32
+#   ram     static RAM, data + bss        .dram0.data + .dram0.bss (host : .data + .bss)
+#
+# and the difference to the defaults, then the library's assets (WM_* and ESP_WiFiManager data symbols) of
+# the defaults and those each flag adds or removes.
+#
+#   -b esp32  (default) arduino-cli with FQBN (esp32:esp32:esp32), sizes by SIZE / NM (xtensa-esp32-elf-size /
+#             xtensa-esp32-elf-nm, riscv32-esp-elf-* for ESP32-C3)
+#   -b host   the Linux host build, MinSizeRel : same assets and flags, x86-64 code
+#   -a        every combination of the flags instead, 2^N builds
+#   -o dir    builds and reports, default footprint : footprint.csv, assets.csv, footprint.txt
+#   -c file   footprint.csv of an earlier run : exits 1 if the flash or ram of a build grew by more than
+#   -t bytes  (default 0)
+
+# Set the other way than the library's default, one build each
+FEATURES=(
+  "USE_ESP_WIFIMANAGER_NTP=false"
+  "USE_CLOUDFLARE_NTP=true"
+  "USING_CORS_FEATURE=true"
+  "USE_AVAILABLE_PAGES=true"
+  "USE_CONFIGURABLE_DNS=true"
+  "USE_STATIC_IP_CONFIG_IN_CP=false"
+  "DISPLAY_STORED_CREDENTIALS_IN_CP=false"
+  "USE_WM_RATE_LIMIT=true"
+  "USE_WM_METRICS=true"
+  "USE_WM_ALLOC_TRACKING=true"
+  "USE_WM_STATIC_MEMORY=true"
+  "WIFIMGR_DEFERRED_LOG=true"
+)
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+SKETCH="$ROOT/travis/footprint/footprint.ino"
+
+BACKEND=esp32
+ALL=0
+OUT=footprint
+PREVIOUS=
+TOLERANCE=0
+
+FQBN=${FQBN:-esp32:esp32:esp32}
+
+function usage()
+{
+  echo "usage: $0 [-b esp32|host] [-a] [-o dir] [-c previous.csv] [-t bytes]" >&2
+  exit 2
+}
+
+# build <dir> <define>... : leaves <dir>/footprint.elf
+function build()
+{
+  local dir=$1
+  shift
+
+  mkdir -p "$dir"
+
+  local build_stdout
+
+  if [ "$BACKEND" = "host" ]; then
+    local defines=$(IFS=';'; echo "$*")
+
+    build_stdout=$( (cmake -S "$ROOT/linux" -B "$OUT/host" -DCMAKE_BUILD_TYPE=MinSizeRel -DWM_HOST_METRICS=OFF \
+                      -DWM_HOST_LOGLEVEL=0 -DWM_HOST_SKETCH="$SKETCH" -DWM_HOST_DEFINES="$defines" && \
+                     cmake --build "$OUT/host" -j"$(nproc)" --target host_sketch && \
+                     cp "$OUT/host/host_sketch" "$dir/footprint.elf") 2>&1)
+  else
+    local flags=""
+    local define
+
+    for define in "$@"; do
+      flags="$flags -D$define"
+    done
+
+    build_stdout=$( (arduino-cli compile --fqbn "$FQBN" --library "$ROOT" --output-dir "$dir" \
+                      --build-property "compiler.cpp.extra_flags=$flags" "$SKETCH" && \
+                     cp "$dir/footprint.ino.elf" "$dir/footprint.elf") 2>&1)
+  fi
+
+  if [ $? -ne 0 ]; then
+    # heavy X
+    echo -e "\xe2\x9c\x96 ${*:-defaults}" >&2
+    echo -e "----------------------------- DEBUG OUTPUT -----------------------------\n" >&2
+    echo "$build_stdout" >&2
+    echo -e "\n------------------------------------------------------------------------\n" >&2
+
+    return 1
+  fi
+
+  return 0
+}
+
+# measure <config> <elf> : one line of footprint.csv, config,flash,code,rodata,data,bss,ram
+function measure()
+{
+  $SIZE -A "$2" | awk -v config="$1" '
+    $1 ~ /^\.(flash\.text|iram0\.text|iram0\.vectors|text)$/  { code   += $2 }
+    $1 ~ /^\.(flash\.rodata|rodata)$/                         { rodata += $2 }
+    $1 ~ /^\.(dram0\.data|data)$/                             { data   += $2 }
+    $1 ~ /^\.(dram0\.bss|bss)$/                               { bss    += $2 }
+    END { printf "%s,%d,%d,%d,%d,%d,%d\n", config, code + rodata + data, code, rodata, data, bss, data + bss }'
+}
+
+# assets <config> <elf> : lines of assets.csv, config,kind,size,symbol
+function assets()
+{
+  $NM -S -t d -C "$2" | awk -v config="$1" '
+    NF >= 4 && $3 ~ /^[rRdDbB]$/ {
+      name = $4
+      for (i = 5; i <= NF; i++) name = name " " $i
+      if (name !~ /^(WM_|ESP_WM)/ && name !~ /ESP_WiFiManager::/) next
+      kind = ($3 ~ /[rR]/) ? "rodata" : "ram"
+      gsub(/"/, "\"\"", name)
+      printf "%s,%s,%d,\"%s\"\n", config, kind, $2 + 0, name
+    }'
+}
+
+# run <config> <define>...
+function run()
+{
+  local config=$1
+  shift
+
+  local dir="$OUT/builds/$(echo "$config" | tr -c 'A-Za-z0-9_=\n' '_')"
+
+  build "$dir" "$@" || return 1
+
+  measure "$config" "$dir/footprint.elf" >> "$OUT/footprint.csv"
+  assets "$config" "$dir/footprint.elf" >> "$OUT/assets.csv"
+
+  # heavy checkmark
+  echo -e "\xe2\x9c\x93 $config" >&2
+}
+
+function report()
+{
+  awk -F, '
+    NR == 1 { next }
+    $1 == "defaults" { f = $2; r = $4; m = $7 }
+    { line[NR] = $0 }
+    END {
+      printf "%-40s %9s %8s %9s %8s %7s %7s\n", "build", "flash", "+/-", "rodata", "+/-", "ram", "+/-"
+      for (i = 2; i <= NR; i++) {
+        split(line[i], v, ",")
+        printf "%-40s %9d %+8d %9d %+8d %7d %+7d\n", v[1], v[2], v[2] - f, v[4], v[4] - r, v[7], v[7] - m
+      }
+    }' "$OUT/footprint.csv"
+
+  echo
+  echo "Assets of the defaults, 32 bytes and more"
+  echo
+
+  awk -F, '$1 == "defaults" && $3 >= 32 { name = $0; sub(/^[^,]*,[^,]*,[^,]*,/, "", name); gsub(/^"|"$/, "", name);
+                                          printf "%7d  %-6s  %s\n", $3, $2, name }' "$OUT/assets.csv" | sort -rn
+
+  echo
+  echo "Assets each build adds (+) or removes (-), 32 bytes and more"
+
+  # build number, change, asset : sorted by build, its name first, then largest savings first
+  awk -F, '
+    NR == 1 { next }
+    {
+      name = $0; sub(/^[^,]*,[^,]*,[^,]*,/, "", name); gsub(/^"|"$/, "", name)
+      key = sprintf("%-6s  %s", $2, name)
+      if ($1 == "defaults") { base[key] = $3; next }
+      if (!($1 in number)) { number[$1] = ++n; order[n] = $1 }
+      size[$1, key] = $3
+    }
+    END {
+      for (i = 1; i <= n; i++) {
+        c = order[i]
+        printf "%d\t-1000000000\t%s\n", i, c
+        for (k in base) if (!((c, k) in size)) size[c, k] = 0
+        for (ck in size) {
+          split(ck, p, SUBSEP)
+          if (p[1] != c) continue
+          d = (p[2] in base) ? size[ck] - base[p[2]] : size[ck]
+          if (d >= 32 || d <= -32) printf "%d\t%d\t%s\n", i, d, p[2]
+        }
+      }
+    }' "$OUT/assets.csv" | sort -t$'\t' -k1,1n -k2,2n | \
+  awk -F'\t' '
+    $2 == -1000000000 { printf "\n%s\n", $3; next }
+    { printf "  %+7d  %s\n", $2, $3 }'
+}
+
+# compare <previous.csv> : builds of both runs whose flash or ram grew by more than TOLERANCE
+function compare()
+{
+  awk -F, -v tolerance="$TOLERANCE" '
+    NR == FNR { if (FNR > 1) { flash[$1] = $2; ram[$1] = $7 } next }
+    FNR == 1 || !($1 in flash) { next }
+    $2 - flash[$1] > tolerance || $7 - ram[$1] > tolerance {
+      printf "Footprint regression : %s flash %+d, ram %+d\n", $1, $2 - flash[$1], $7 - ram[$1]
+      failed = 1
+    }
+    END { exit failed }' "$1" "$OUT/footprint.csv"
+}
+
+while getopts "b:ao:c:t:" opt; do
+  case $opt in
+    b) BACKEND=$OPTARG ;;
+    a) ALL=1 ;;
+    o) OUT=$OPTARG ;;
+    c) PREVIOUS=$OPTARG ;;
+    t) TOLERANCE=$OPTARG ;;
+    *) usage ;;
+  esac
+done
+
+case $BACKEND in
+  esp32)
+    SIZE=${SIZE:-xtensa-esp32-elf-size}
+    NM=${NM:-xtensa-esp32-elf-nm}
+    ;;
+  host)
+    SIZE=${SIZE:-size}
+    NM=${NM:-nm}
+    ;;
+  *)
+    usage
+    ;;
+esac
+
+mkdir -p "$OUT"
+OUT=$(cd "$OUT" && pwd)
+
+echo "config,flash,code,rodata,data,bss,ram" > "$OUT/footprint.csv"
+echo "config,kind,size,symbol" > "$OUT/assets.csv"
+
+run defaults || exit 1
+
+if [ $ALL -eq 1 ]; then
+  count=${#FEATURES[@]}
+
+  for (( mask = 1; mask < (1 << count); mask++ )); do
+    defines=()
+
+    for (( i = 0; i < count; i++ )); do
+      (( mask & (1 << i) )) && defines+=("${FEATURES[$i]}")
+    done
+
+    run "$(IFS='+'; echo "${defines[*]}")" "${defines[@]}" || exit 1
+  done
+else
+  for feature in "${FEATURES[@]}"; do
+    run "$feature" "$feature" || exit 1
+  done
+
+  # Every flag that saved flash
+  lean=($(awk -F, 'NR > 1 { if ($1 == "defaults") f = $2; else if ($2 < f) print $1 }' "$OUT/footprint.csv"))
+
+  if [ ${#lean[@]} -gt 1 ]; then
+    run lean "${lean[@]}" || exit 1
+  fi
+fi
+
+report | tee "$OUT/footprint.txt"
+
+if [ -n "$PREVIOUS" ]; then
+  compare "$PREVIOUS" || exit 1
+fi
+
+exit 0
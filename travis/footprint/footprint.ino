@@ -0,0 +1,48 @@
+/****************************************************************************************************************************
+  footprint.ino
+  For ESP8266 / ESP32 boards
+
+  ESP_WiFiManager is a library for the ESP8266/ESP32 platform (https://github.com/esp8266/Arduino) to enable easy
+  configuration and reconfiguration of WiFi credentials using a Captive Portal.
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP_WiFiManager
+  Licensed under MIT license
+
+  Sketch of travis/footprint.sh : what most sketches use, autoConnect() with its Config Portal, a custom
+  parameter and the time zone chosen in the portal. No feature flag is set here, footprint.sh passes them.
+ *****************************************************************************************************************************/
+#if !( defined(ESP8266) ||  defined(ESP32) )
+  #error This code is intended to run on the ESP8266 or ESP32 platform! Please check your Tools->Board setting.
+#endif
+
+#include <ESP_WiFiManager.h>              //https://github.com/khoih-prog/ESP_WiFiManager
+
+ESP_WMParameter customServer("server", "Server", "", 40);
+
+void setup()
+{
+  Serial.begin(115200);
+
+  ESP_WiFiManager ESP_wifiManager("Footprint");
+
+  ESP_wifiManager.addParameter(&customServer);
+
+  if (!ESP_wifiManager.autoConnect("ESP_Footprint"))
+    ESP.restart();
+
+#if USE_ESP_WIFIMANAGER_NTP
+  String tzName = ESP_wifiManager.getTimezoneName();
+
+  if (tzName.length())
+  {
+    setenv("TZ", ESP_wifiManager.getTZ(tzName), 1);
+    tzset();
+  }
+#endif
+
+  Serial.println(customServer.getValue());
+}
+
+void loop()
+{
+}